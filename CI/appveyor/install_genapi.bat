@@ -0,0 +1,22 @@
+REM @file    CI/appveyor/install_genapi.bat
+REM @date    Oct. 2026
+REM @author  PhRG / opticalp.fr
+REM @license MIT
+
+REM Install the GenICam reference implementation (GenAPI) into %GENAPI_ROOT%, 
+REM for the builds testing the GenICam path with the simulated GenTL producer. 
+
+set CURRENT_DIR=%CD%
+
+echo Install GenAPI using curl and 7zip
+curl -fSL -o genicam.zip -m 600 https://www.emva.org/wp-content/uploads/GenICam_V3_0_2_public_data.zip
+echo Downloading from emva.org done. 
+call 7z x genicam.zip -ogenicam -y
+
+REM the development and runtime archives of the platform are extracted
+REM in the same directory (see doc/features/genicam.md)
+call 7z x genicam\*Win64_x64*.zip -o"%GENAPI_ROOT%" -y
+dir "%GENAPI_ROOT%"
+echo GenAPI installed
+
+cd %CURRENT_DIR%
@@ -57,6 +57,12 @@ else ( NOT PYTHONLIBS_FOUND )
                 )
         endif ( UNIX )
         
+        # a test that can not run in this build (e.g. missing optional
+        # dependency) prints "Test skipped: <reason>" (CMake >= 3.16)
+        set_tests_properties ( ${shortPyScriptNoExt} PROPERTIES
+            SKIP_REGULAR_EXPRESSION "Test skipped: "
+            )
+        
         get_filename_component ( shortPyScript "${pyTestScript}" NAME )
         message ( STATUS "Python test ${shortPyScript} added. " )
         
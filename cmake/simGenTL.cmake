@@ -0,0 +1,38 @@
+## @file     cmake/simGenTL.cmake
+## @date     Oct. 2026
+## @author   PhRG / opticalp.fr
+## @license  MIT
+
+## this config file is loaded if the simulated GenTL producer is built
+
+message (STATUS "Configuring the simulated GenTL producer SimGenTL.cti")
+
+file (
+    GLOB
+    simGenTL_files
+    ${PROJECT_SOURCE_DIR}/simGenTL/*.cpp
+    ${PROJECT_SOURCE_DIR}/simGenTL/*.h
+    )
+
+add_library ( SimGenTL SHARED ${simGenTL_files} )
+
+target_link_libraries ( SimGenTL Poco::Foundation ${CMAKE_THREAD_LIBS_INIT} )
+
+# a GenTL producer is a shared library with the .cti extension,
+# placed next to the instrumentall binary to be found by the tests
+set_target_properties ( SimGenTL PROPERTIES
+    PREFIX ""
+    SUFFIX ".cti"
+    COMPILE_DEFINITIONS GCTLIDLL
+    LIBRARY_OUTPUT_DIRECTORY ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}
+    LIBRARY_OUTPUT_DIRECTORY_DEBUG ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}
+    LIBRARY_OUTPUT_DIRECTORY_RELEASE ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}
+    )
+
+add_dependencies ( instrumentall SimGenTL )
+
+# sample device configuration for the simulated camera
+file (
+  COPY "${PROJECT_SOURCE_DIR}/testsuite/resources/simCam.yml"
+  DESTINATION ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}
+  )
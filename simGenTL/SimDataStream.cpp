@@ -0,0 +1,576 @@
+/**
+ * @file	simGenTL/SimDataStream.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "SimGenTL.h"
+
+
+#include <algorithm>
+#include <cstring>
+
+SimBuffer::SimBuffer(SimDataStream* stream, void* pBuffer, size_t bufSize, void* pPrivate):
+    SimModule(kindBuffer), parent(stream),
+    data(pBuffer), size(bufSize), userPtr(pPrivate),
+    queued(false), acquiring(false), newData(false), incomplete(false),
+    sizeFilled(0), timestampNs(0), frameID(0),
+    width(0), height(0), pixelFormat(0)
+{
+}
+
+SimDataStream::SimDataStream(SimDevice* parent, const std::string& streamID):
+    SimModule(kindDataStream), mID(streamID), device(parent),
+    flushCount(0),
+    newBufferEvent(NULL), eventKilled(false),
+    numToAcquire(GENTL_INFINITE),
+    numDelivered(0), numUnderrun(0), numStarted(0), lastFrameID(0),
+    grabbing(false), stopping(false),
+    acqRunnable(*this, &SimDataStream::acquisitionLoop)
+{
+    random.seed();
+}
+
+SimDataStream::~SimDataStream()
+{
+    stopAcquisition();
+    unregisterEvent();
+
+    for (std::vector<SimBuffer*>::iterator it = buffers.begin(),
+            ite = buffers.end(); it != ite; it++)
+        delete *it;
+
+    device->dataStreamClosed();
+}
+
+GenTL::BUFFER_HANDLE SimDataStream::announceBuffer(void* pBuffer, size_t bufSize, void* pPrivate)
+{
+    if (pBuffer == NULL || bufSize == 0)
+        throw SimGenTLError("DSAnnounceBuffer: invalid buffer",
+                GenTL::GC_ERR_INVALID_PARAMETER);
+
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+    SimBuffer* pBuf = new SimBuffer(this, pBuffer, bufSize, pPrivate);
+    buffers.push_back(pBuf);
+
+    return pBuf;
+}
+
+SimBuffer* SimDataStream::buffer(GenTL::BUFFER_HANDLE hBuffer)
+{
+    SimBuffer* pBuf = static_cast<SimBuffer*>(
+            SimModule::check(hBuffer, kindBuffer));
+
+    if (pBuf->parent != this)
+        throw SimGenTLError("the buffer was not announced to this data stream",
+                GenTL::GC_ERR_INVALID_HANDLE);
+
+    return pBuf;
+}
+
+void SimDataStream::revokeBuffer(GenTL::BUFFER_HANDLE hBuffer, void** ppBuffer, void** ppPrivate)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+    SimBuffer* pBuf = buffer(hBuffer);
+
+    if (pBuf->queued || pBuf->acquiring)
+        throw SimGenTLError("DSRevokeBuffer: the buffer is still queued",
+                GenTL::GC_ERR_RESOURCE_IN_USE);
+
+    if (ppBuffer)
+        *ppBuffer = pBuf->data;
+    if (ppPrivate)
+        *ppPrivate = pBuf->userPtr;
+
+    buffers.erase(std::find(buffers.begin(), buffers.end(), pBuf));
+    delete pBuf;
+}
+
+void SimDataStream::queueBuffer(GenTL::BUFFER_HANDLE hBuffer)
+{
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+        SimBuffer* pBuf = buffer(hBuffer);
+
+        if (pBuf->queued || pBuf->acquiring)
+            throw SimGenTLError("DSQueueBuffer: the buffer is already queued",
+                    GenTL::GC_ERR_INVALID_PARAMETER);
+
+        pBuf->queued = true;
+        pBuf->newData = false;
+        pBuf->incomplete = false;
+        pBuf->sizeFilled = 0;
+        inputPool.push_back(pBuf);
+    }
+
+    inputReady.set();
+}
+
+void SimDataStream::flushQueue(GenTL::ACQ_QUEUE_TYPE operation)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+    std::deque<SimBuffer*>::iterator it, ite;
+
+    switch (operation)
+    {
+    case GenTL::ACQ_QUEUE_INPUT_TO_OUTPUT:
+        for (it = inputPool.begin(), ite = inputPool.end(); it != ite; it++)
+            outputQueue.push_back(*it);
+        inputPool.clear();
+        outputReady.set();
+        break;
+
+    case GenTL::ACQ_QUEUE_OUTPUT_DISCARD:
+        for (it = outputQueue.begin(), ite = outputQueue.end(); it != ite; it++)
+            (*it)->queued = false;
+        outputQueue.clear();
+        break;
+
+    case GenTL::ACQ_QUEUE_ALL_TO_INPUT:
+        for (it = outputQueue.begin(), ite = outputQueue.end(); it != ite; it++)
+            inputPool.push_back(*it);
+        outputQueue.clear();
+        inputReady.set();
+        break;
+
+    case GenTL::ACQ_QUEUE_UNQUEUED_TO_INPUT:
+        for (std::vector<SimBuffer*>::iterator bit = buffers.begin(),
+                bite = buffers.end(); bit != bite; bit++)
+        {
+            if (!(*bit)->queued && !(*bit)->acquiring)
+            {
+                (*bit)->queued = true;
+                inputPool.push_back(*bit);
+            }
+        }
+        inputReady.set();
+        break;
+
+    case GenTL::ACQ_QUEUE_ALL_DISCARD:
+        for (it = inputPool.begin(), ite = inputPool.end(); it != ite; it++)
+            (*it)->queued = false;
+        for (it = outputQueue.begin(), ite = outputQueue.end(); it != ite; it++)
+            (*it)->queued = false;
+        inputPool.clear();
+        outputQueue.clear();
+        break;
+
+    default:
+        throw SimGenTLError("DSFlushQueue: unknown operation",
+                GenTL::GC_ERR_INVALID_PARAMETER);
+    }
+
+    // a buffer being filled is flushed too
+    flushCount++;
+}
+
+size_t SimDataStream::bufferCount()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+    return buffers.size();
+}
+
+GenTL::BUFFER_HANDLE SimDataStream::bufferAt(size_t index)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+    if (index >= buffers.size())
+        throw SimGenTLError("buffer index out of range",
+                GenTL::GC_ERR_INVALID_INDEX);
+
+    return buffers[index];
+}
+
+void SimDataStream::startAcquisition(uint64_t count)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+    if (grabbing)
+        throw SimGenTLError("DSStartAcquisition: already started",
+                GenTL::GC_ERR_RESOURCE_IN_USE);
+
+    if (buffers.empty())
+        throw SimGenTLError("DSStartAcquisition: no announced buffer",
+                GenTL::GC_ERR_RESOURCE_EXHAUSTED);
+
+    numToAcquire = (count == 0) ? GENTL_INFINITE : count;
+    numDelivered = 0;
+    numUnderrun = 0;
+    numStarted = 0;
+    lastFrameID = 0;
+
+    stopping = false;
+    stopRequest.reset();
+
+    grabbing = true;
+    acqThread.start(acqRunnable);
+}
+
+void SimDataStream::stopAcquisition()
+{
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+        if (!grabbing)
+            return;
+
+        stopping = true;
+    }
+
+    stopRequest.set();
+    inputReady.set();
+    acqThread.join();
+
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+    grabbing = false;
+}
+
+bool SimDataStream::isGrabbing()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+    return grabbing && !stopping;
+}
+
+uint64_t SimDataStream::deliveredCount()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+    return numDelivered;
+}
+
+uint64_t SimDataStream::underrunCount()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+    return numUnderrun;
+}
+
+uint64_t SimDataStream::startedCount()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+    return numStarted;
+}
+
+size_t SimDataStream::queuedCount()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+    return inputPool.size();
+}
+
+size_t SimDataStream::awaitDeliveryCount()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+    return outputQueue.size();
+}
+
+SimEvent* SimDataStream::registerEvent()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+    if (newBufferEvent)
+        throw SimGenTLError("GCRegisterEvent: new buffer event already registered",
+                GenTL::GC_ERR_RESOURCE_IN_USE);
+
+    newBufferEvent = new SimEvent(this);
+    eventKilled = false;
+
+    return newBufferEvent;
+}
+
+void SimDataStream::unregisterEvent()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+    if (newBufferEvent)
+    {
+        delete newBufferEvent;
+        newBufferEvent = NULL;
+    }
+}
+
+SimBuffer* SimDataStream::waitNewBuffer(uint64_t timeout)
+{
+    Poco::Timestamp start;
+
+    for (;;)
+    {
+        {
+            Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+            if (eventKilled)
+            {
+                eventKilled = false;
+                throw SimGenTLError("EventGetData: aborted by EventKill",
+                        GenTL::GC_ERR_ABORT);
+            }
+
+            if (!outputQueue.empty())
+            {
+                SimBuffer* pBuf = outputQueue.front();
+                outputQueue.pop_front();
+                pBuf->queued = false;
+                return pBuf;
+            }
+        }
+
+        if (timeout == GENTL_INFINITE)
+        {
+            outputReady.wait();
+        }
+        else
+        {
+            Poco::Timestamp::TimeDiff elapsed = start.elapsed() / 1000; // ms
+
+            if (static_cast<uint64_t>(elapsed) >= timeout)
+                throw SimGenTLError("EventGetData: timeout",
+                        GenTL::GC_ERR_TIMEOUT);
+
+            uint64_t remain = timeout - elapsed;
+            outputReady.tryWait(static_cast<long>(
+                    std::min<uint64_t>(remain, 0x7FFFFFFF)));
+        }
+    }
+}
+
+void SimDataStream::killEvent()
+{
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+        eventKilled = true;
+    }
+
+    outputReady.set();
+}
+
+bool SimDataStream::waitUntil(const Poco::Timestamp& time)
+{
+    for (;;)
+    {
+        Poco::Timestamp::TimeDiff remain = time - Poco::Timestamp();
+
+        if (remain <= 0)
+            return !stopping;
+
+        if (remain > 1000)
+        {
+            // ms resolution
+            if (stopRequest.tryWait(static_cast<long>(remain / 1000)))
+                return false;
+        }
+        else
+        {
+            Poco::Thread::yield();
+            if (stopping)
+                return false;
+        }
+    }
+}
+
+void SimDataStream::acquisitionLoop()
+{
+    uint64_t frameID = 0;
+    Poco::Timestamp nextFrame;
+
+    while (!stopping)
+    {
+        // wait for the AcquisitionStart command
+        if (!device->isAcquisitionStarted())
+        {
+            if (stopRequest.tryWait(10))
+                break;
+
+            nextFrame.update();
+            continue;
+        }
+
+        SimDevice::FrameConf conf = device->frameConf();
+
+        if (conf.frameRate > 0)
+        {
+            nextFrame += static_cast<Poco::Timestamp::TimeDiff>(1000000 / conf.frameRate);
+
+            // do not try to catch up after a long pause
+            if (nextFrame < Poco::Timestamp() - 1000000)
+                nextFrame.update();
+
+            if (!waitUntil(nextFrame))
+                break;
+        }
+
+        frameID++;
+
+        // fault injection: lost frame
+        if (conf.dropInterval && (frameID % conf.dropInterval == 0))
+            continue;
+
+        SimBuffer* pBuf = NULL;
+        size_t flushed = 0;
+
+        {
+            Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+            if (inputPool.empty())
+            {
+                if (conf.frameRate > 0)
+                {
+                    // the frame is lost
+                    numUnderrun++;
+                    continue;
+                }
+            }
+            else
+            {
+                pBuf = inputPool.front();
+                inputPool.pop_front();
+                pBuf->acquiring = true;
+                flushed = flushCount;
+                numStarted++;
+            }
+        }
+
+        if (pBuf == NULL)
+        {
+            // free run: wait for a buffer to be queued
+            inputReady.tryWait(10);
+            frameID--;
+            continue;
+        }
+
+        bool incomplete = conf.incompleteInterval
+                && (frameID % conf.incompleteInterval == 0);
+
+        fillBuffer(pBuf, conf, frameID, incomplete);
+
+        // fault injection: random delivery delay
+        if (conf.delayJitter)
+        {
+            Poco::Timestamp delivery;
+            delivery += random.next(conf.delayJitter + 1);
+            waitUntil(delivery);
+        }
+
+        {
+            Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+            pBuf->acquiring = false;
+
+            if (flushed != flushCount)
+            {
+                // flushed while being filled: discarded
+                pBuf->queued = false;
+                continue;
+            }
+
+            outputQueue.push_back(pBuf);
+            numDelivered++;
+            lastFrameID = frameID;
+
+            if (numToAcquire != GENTL_INFINITE && numDelivered >= numToAcquire)
+                stopping = true;
+        }
+
+        outputReady.set();
+    }
+}
+
+void SimDataStream::fillBuffer(SimBuffer* pBuf, const SimDevice::FrameConf& conf,
+        uint64_t frameID, bool incomplete)
+{
+    size_t filled = std::min(conf.payloadSize, pBuf->size);
+    if (incomplete)
+        filled /= 2;
+
+    size_t lineSize = conf.width * conf.bytesPerPixel;
+    size_t lines = lineSize ? filled / lineSize : 0;
+
+    // moving diagonal ramp
+    size_t offset = static_cast<size_t>(frameID * 2);
+
+    if (conf.bytesPerPixel == 0)
+    {
+        // PFNC packing: LSB first, along the whole image
+        int shift = conf.bitDepth - 8;
+        unsigned char* pData = reinterpret_cast<unsigned char*>(pBuf->data);
+        size_t byteIndex = 0;
+        uint32_t bits = 0;
+        int bitCount = 0;
+
+        for (size_t y = 0; y < conf.height && byteIndex < filled; y++)
+        {
+            for (size_t x = 0; x < conf.width && byteIndex < filled; x++)
+            {
+                bits |= static_cast<uint32_t>(((x + y + offset) & 0xFF) << shift) << bitCount;
+                bitCount += conf.bitDepth;
+
+                while (bitCount >= 8 && byteIndex < filled)
+                {
+                    pData[byteIndex++] = static_cast<unsigned char>(bits & 0xFF);
+                    bits >>= 8;
+                    bitCount -= 8;
+                }
+            }
+        }
+
+        if (bitCount > 0 && byteIndex < filled)
+            pData[byteIndex] = static_cast<unsigned char>(bits & 0xFF);
+    }
+    else if (conf.bytesPerPixel == 1)
+    {
+        for (size_t y = 0; y < lines; y++)
+        {
+            unsigned char* pLine = reinterpret_cast<unsigned char*>(pBuf->data)
+                    + y * lineSize;
+            for (size_t x = 0; x < conf.width; x++)
+                pLine[x] = static_cast<unsigned char>(x + y + offset);
+        }
+    }
+    else
+    {
+        int shift = conf.bitDepth - 8;
+        uint16_t mask = static_cast<uint16_t>((1 << conf.bitDepth) - 1);
+
+        for (size_t y = 0; y < lines; y++)
+        {
+            uint16_t* pLine = reinterpret_cast<uint16_t*>(
+                    reinterpret_cast<unsigned char*>(pBuf->data) + y * lineSize);
+            for (size_t x = 0; x < conf.width; x++)
+                pLine[x] = static_cast<uint16_t>(
+                        (((x + y + offset) & 0xFF) << shift) & mask);
+        }
+    }
+
+    Poco::ScopedLock<Poco::FastMutex> lock(streamMutex);
+
+    pBuf->sizeFilled = filled;
+    pBuf->incomplete = incomplete || (conf.payloadSize > pBuf->size);
+    pBuf->newData = true;
+    pBuf->timestampNs = static_cast<uint64_t>(Poco::Timestamp().epochMicroseconds()) * 1000;
+    pBuf->frameID = frameID;
+    pBuf->width = conf.width;
+    pBuf->height = conf.height;
+    pBuf->pixelFormat = conf.pixelFormat;
+}
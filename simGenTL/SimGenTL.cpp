@@ -0,0 +1,1141 @@
+/**
+ * @file	simGenTL/SimGenTL.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+
+/*
+ * Simulated GenTL producer
+ *
+ * Exported GenTL C API. The functions check the handles, forward to the
+ * Sim* modules, and convert the SimGenTLError exceptions into GC_ERROR
+ * return values (see SIMGENTL_TRY / SIMGENTL_CATCH).
+ */
+
+#include "SimGenTL.h"
+
+#include "Poco/ThreadLocal.h"
+#include "Poco/NumberFormatter.h"
+
+#include <cstring>
+
+using namespace GenTL;
+
+namespace
+{
+
+struct LastError
+{
+    LastError(): code(GC_ERR_SUCCESS) { }
+
+    GC_ERROR code;
+    std::string text;
+};
+
+Poco::ThreadLocal<LastError> lastError;
+
+bool initialized = false;
+SimSystem* pSystem = NULL;
+Poco::FastMutex systemMutex;
+
+GC_ERROR setLastError(GC_ERROR code, const std::string& text)
+{
+    lastError->code = code;
+    lastError->text = text;
+    return code;
+}
+
+void checkInit()
+{
+    if (!initialized)
+        throw SimGenTLError("GCInitLib was not called",
+                GC_ERR_NOT_INITIALIZED);
+}
+
+void checkParam(const void* ptr)
+{
+    if (ptr == NULL)
+        throw SimGenTLError("NULL pointer given", GC_ERR_INVALID_PARAMETER);
+}
+
+/**
+ * Copy an info value to the consumer buffer
+ *
+ * If pBuffer is NULL, only the size is returned.
+ */
+void setInfo(INFO_DATATYPE type, const void* pValue, size_t valueSize,
+        INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    checkParam(piSize);
+
+    if (piType)
+        *piType = type;
+
+    if (pBuffer == NULL)
+    {
+        *piSize = valueSize;
+        return;
+    }
+
+    if (*piSize < valueSize)
+        throw SimGenTLError("the given buffer is too small",
+                GC_ERR_BUFFER_TOO_SMALL);
+
+    memcpy(pBuffer, pValue, valueSize);
+    *piSize = valueSize;
+}
+
+void infoString(const std::string& value,
+        INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    setInfo(INFO_DATATYPE_STRING, value.c_str(), value.size() + 1,
+            piType, pBuffer, piSize);
+}
+
+template <typename T>
+void infoValue(INFO_DATATYPE type, T value,
+        INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    setInfo(type, &value, sizeof(T), piType, pBuffer, piSize);
+}
+
+void notAvailable(int infoCmd)
+{
+    throw SimGenTLError("info command not available: "
+            + Poco::NumberFormatter::format(infoCmd),
+            GC_ERR_NOT_AVAILABLE);
+}
+
+SimSystem* tlSystem(TL_HANDLE hTL)
+{
+    return static_cast<SimSystem*>(SimModule::check(hTL, SimModule::kindSystem));
+}
+
+SimInterface* iface(IF_HANDLE hIface)
+{
+    return static_cast<SimInterface*>(SimModule::check(hIface, SimModule::kindInterface));
+}
+
+SimDevice* device(DEV_HANDLE hDevice)
+{
+    SimDevice* pDev = static_cast<SimDevice*>(
+            SimModule::check(hDevice, SimModule::kindDevice));
+
+    if (!pDev->isOpen())
+        throw SimGenTLError("the device is not opened", GC_ERR_INVALID_HANDLE);
+
+    return pDev;
+}
+
+SimDataStream* stream(DS_HANDLE hDataStream)
+{
+    return static_cast<SimDataStream*>(
+            SimModule::check(hDataStream, SimModule::kindDataStream));
+}
+
+SimDataStream* eventStream(EVENT_HANDLE hEvent)
+{
+    return static_cast<SimEvent*>(
+            SimModule::check(hEvent, SimModule::kindEvent))->parent;
+}
+
+/// remote device of a port handle, or NULL if it is a module port
+SimDevice* remoteDevice(PORT_HANDLE hPort)
+{
+    SimModule* module = SimModule::check(hPort);
+
+    if (module->kind() == SimModule::kindRemotePort)
+        return static_cast<SimRemotePort*>(module)->parent();
+    else
+        return NULL;
+}
+
+std::string moduleID(SimModule* module)
+{
+    switch (module->kind())
+    {
+    case SimModule::kindSystem:
+        return static_cast<SimSystem*>(module)->id();
+    case SimModule::kindInterface:
+        return static_cast<SimInterface*>(module)->id();
+    case SimModule::kindDevice:
+        return static_cast<SimDevice*>(module)->id();
+    case SimModule::kindRemotePort:
+        return static_cast<SimRemotePort*>(module)->parent()->id();
+    case SimModule::kindDataStream:
+        return static_cast<SimDataStream*>(module)->id();
+    default:
+        return "";
+    }
+}
+
+void tlInfo(TL_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    switch (iInfoCmd)
+    {
+    case TL_INFO_ID:
+    case TL_INFO_MODEL:
+    case TL_INFO_DISPLAYNAME:
+        infoString(SIMGENTL_MODEL, piType, pBuffer, piSize);
+        break;
+    case TL_INFO_VENDOR:
+        infoString(SIMGENTL_VENDOR, piType, pBuffer, piSize);
+        break;
+    case TL_INFO_VERSION:
+        infoString(SIMGENTL_VERSION, piType, pBuffer, piSize);
+        break;
+    case TL_INFO_TLTYPE:
+        infoString(TLTypeCustomName, piType, pBuffer, piSize);
+        break;
+    case TL_INFO_NAME:
+        infoString(SIMGENTL_MODEL ".cti", piType, pBuffer, piSize);
+        break;
+    case TL_INFO_CHAR_ENCODING:
+        infoValue<int32_t>(INFO_DATATYPE_INT32, TL_CHAR_ENCODING_ASCII,
+                piType, pBuffer, piSize);
+        break;
+    case TL_INFO_GENTL_VER_MAJOR:
+        infoValue<uint32_t>(INFO_DATATYPE_UINT32, GenTLMajorVersion,
+                piType, pBuffer, piSize);
+        break;
+    case TL_INFO_GENTL_VER_MINOR:
+        infoValue<uint32_t>(INFO_DATATYPE_UINT32, GenTLMinorVersion,
+                piType, pBuffer, piSize);
+        break;
+    default:
+        notAvailable(iInfoCmd);
+    }
+}
+
+void ifaceInfo(const std::string& ifaceID, INTERFACE_INFO_CMD iInfoCmd,
+        INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    switch (iInfoCmd)
+    {
+    case INTERFACE_INFO_ID:
+        infoString(ifaceID, piType, pBuffer, piSize);
+        break;
+    case INTERFACE_INFO_DISPLAYNAME:
+        infoString("Simulated interface " + ifaceID, piType, pBuffer, piSize);
+        break;
+    case INTERFACE_INFO_TLTYPE:
+        infoString(TLTypeCustomName, piType, pBuffer, piSize);
+        break;
+    default:
+        notAvailable(iInfoCmd);
+    }
+}
+
+void deviceInfo(SimDevice* pDev, DEVICE_INFO_CMD iInfoCmd,
+        INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    switch (iInfoCmd)
+    {
+    case DEVICE_INFO_ID:
+    case DEVICE_INFO_SERIAL_NUMBER:
+    case DEVICE_INFO_USER_DEFINED_NAME:
+        infoString(pDev->id(), piType, pBuffer, piSize);
+        break;
+    case DEVICE_INFO_VENDOR:
+        infoString(SIMGENTL_VENDOR, piType, pBuffer, piSize);
+        break;
+    case DEVICE_INFO_MODEL:
+        infoString("SimCam", piType, pBuffer, piSize);
+        break;
+    case DEVICE_INFO_TLTYPE:
+        infoString(TLTypeCustomName, piType, pBuffer, piSize);
+        break;
+    case DEVICE_INFO_DISPLAYNAME:
+        infoString(SIMGENTL_VENDOR " SimCam (" + pDev->id() + ")",
+                piType, pBuffer, piSize);
+        break;
+    case DEVICE_INFO_VERSION:
+        infoString(SIMGENTL_VERSION, piType, pBuffer, piSize);
+        break;
+    case DEVICE_INFO_ACCESS_STATUS:
+        infoValue<int32_t>(INFO_DATATYPE_INT32,
+                pDev->isOpen() ? DEVICE_ACCESS_STATUS_OPEN_READWRITE
+                               : DEVICE_ACCESS_STATUS_READWRITE,
+                piType, pBuffer, piSize);
+        break;
+    case DEVICE_INFO_TIMESTAMP_FREQUENCY:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, 1000000000,
+                piType, pBuffer, piSize);
+        break;
+    default:
+        notAvailable(iInfoCmd);
+    }
+}
+
+} // namespace
+
+/**
+ * Wrap the body of the API functions.
+ *
+ * The exceptions are converted to the GC_ERROR return value and stored
+ * for GCGetLastError.
+ */
+#define SIMGENTL_TRY try {
+#define SIMGENTL_CATCH \
+    } \
+    catch (SimGenTLError& e) \
+    { \
+        return setLastError(e.code(), e.message()); \
+    } \
+    catch (Poco::Exception& e) \
+    { \
+        return setLastError(GC_ERR_ERROR, e.displayText()); \
+    } \
+    catch (std::bad_alloc&) \
+    { \
+        return setLastError(GC_ERR_OUT_OF_MEMORY, "out of memory"); \
+    } \
+    return GC_ERR_SUCCESS;
+
+namespace GenTL
+{
+
+GC_API GCGetInfo(TL_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    tlInfo(iInfoCmd, piType, pBuffer, piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API GCGetLastError(GC_ERROR* piErrorCode, char* sErrText, size_t* piSize)
+{
+    if (piErrorCode == NULL || piSize == NULL)
+        return GC_ERR_INVALID_PARAMETER;
+
+    *piErrorCode = lastError->code;
+
+    size_t len = lastError->text.size() + 1;
+
+    if (sErrText == NULL)
+    {
+        *piSize = len;
+        return GC_ERR_SUCCESS;
+    }
+
+    if (*piSize < len)
+        return GC_ERR_BUFFER_TOO_SMALL;
+
+    memcpy(sErrText, lastError->text.c_str(), len);
+    *piSize = len;
+    return GC_ERR_SUCCESS;
+}
+
+GC_API GCInitLib(void)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(systemMutex);
+
+    if (initialized)
+        return setLastError(GC_ERR_RESOURCE_IN_USE, "GCInitLib already called");
+
+    initialized = true;
+    return GC_ERR_SUCCESS;
+}
+
+GC_API GCCloseLib(void)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(systemMutex);
+
+    if (!initialized)
+        return setLastError(GC_ERR_NOT_INITIALIZED, "GCInitLib was not called");
+
+    delete pSystem;
+    pSystem = NULL;
+
+    initialized = false;
+    return GC_ERR_SUCCESS;
+}
+
+GC_API GCReadPort(PORT_HANDLE hPort, uint64_t iAddress, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(pBuffer);
+    checkParam(piSize);
+
+    SimDevice* pDev = remoteDevice(hPort);
+    if (pDev == NULL)
+        throw SimGenTLError("the module ports have no register map",
+                GC_ERR_NOT_AVAILABLE);
+
+    pDev->readRegisters(iAddress, pBuffer, *piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API GCWritePort(PORT_HANDLE hPort, uint64_t iAddress, const void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(pBuffer);
+    checkParam(piSize);
+
+    SimDevice* pDev = remoteDevice(hPort);
+    if (pDev == NULL)
+        throw SimGenTLError("the module ports have no register map",
+                GC_ERR_NOT_AVAILABLE);
+
+    pDev->writeRegisters(iAddress, pBuffer, *piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API GCGetPortURL(PORT_HANDLE hPort, char* sURL, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+
+    SimDevice* pDev = remoteDevice(hPort);
+    if (pDev == NULL)
+        throw SimGenTLError("no XML for the module ports", GC_ERR_NOT_AVAILABLE);
+
+    infoString(pDev->nodeMapURL(), NULL, sURL, piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API GCGetPortInfo(PORT_HANDLE hPort, PORT_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+
+    SimModule* module = SimModule::check(hPort);
+
+    switch (iInfoCmd)
+    {
+    case PORT_INFO_ID:
+        infoString(moduleID(module), piType, pBuffer, piSize);
+        break;
+    case PORT_INFO_VENDOR:
+        infoString(SIMGENTL_VENDOR, piType, pBuffer, piSize);
+        break;
+    case PORT_INFO_MODEL:
+        infoString(SIMGENTL_MODEL, piType, pBuffer, piSize);
+        break;
+    case PORT_INFO_TLTYPE:
+        infoString(TLTypeCustomName, piType, pBuffer, piSize);
+        break;
+    case PORT_INFO_MODULE:
+    case PORT_INFO_PORTNAME:
+        infoString(module->moduleName(), piType, pBuffer, piSize);
+        break;
+    case PORT_INFO_VERSION:
+        infoString(SIMGENTL_VERSION, piType, pBuffer, piSize);
+        break;
+    case PORT_INFO_LITTLE_ENDIAN:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, true, piType, pBuffer, piSize);
+        break;
+    case PORT_INFO_BIG_ENDIAN:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, false, piType, pBuffer, piSize);
+        break;
+    case PORT_INFO_ACCESS_READ:
+    case PORT_INFO_ACCESS_WRITE:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8,
+                module->kind() == SimModule::kindRemotePort,
+                piType, pBuffer, piSize);
+        break;
+    case PORT_INFO_ACCESS_NA:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, false, piType, pBuffer, piSize);
+        break;
+    case PORT_INFO_ACCESS_NI:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8,
+                module->kind() != SimModule::kindRemotePort,
+                piType, pBuffer, piSize);
+        break;
+    default:
+        notAvailable(iInfoCmd);
+    }
+    SIMGENTL_CATCH
+}
+
+GC_API GCGetNumPortURLs(PORT_HANDLE hPort, uint32_t* piNumURLs)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(piNumURLs);
+
+    *piNumURLs = remoteDevice(hPort) ? 1 : 0;
+    SIMGENTL_CATCH
+}
+
+GC_API GCGetPortURLInfo(PORT_HANDLE hPort, uint32_t iURLIndex, URL_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+
+    SimDevice* pDev = remoteDevice(hPort);
+    if (pDev == NULL || iURLIndex > 0)
+        throw SimGenTLError("URL index out of range", GC_ERR_INVALID_INDEX);
+
+    switch (iInfoCmd)
+    {
+    case URL_INFO_URL:
+        infoString(pDev->nodeMapURL(), piType, pBuffer, piSize);
+        break;
+    case URL_INFO_SCHEMA_VER_MAJOR:
+    case URL_INFO_SCHEMA_VER_MINOR:
+    case URL_INFO_FILE_VER_MAJOR:
+        infoValue<int32_t>(INFO_DATATYPE_INT32, 1, piType, pBuffer, piSize);
+        break;
+    case URL_INFO_FILE_VER_MINOR:
+    case URL_INFO_FILE_VER_SUBMINOR:
+        infoValue<int32_t>(INFO_DATATYPE_INT32, 0, piType, pBuffer, piSize);
+        break;
+    case URL_INFO_FILE_REGISTER_ADDRESS:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, regXml, piType, pBuffer, piSize);
+        break;
+    case URL_INFO_FILE_SIZE:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, pDev->nodeMapSize(),
+                piType, pBuffer, piSize);
+        break;
+    case URL_INFO_SCHEME:
+        infoValue<int32_t>(INFO_DATATYPE_INT32, URL_SCHEME_LOCAL,
+                piType, pBuffer, piSize);
+        break;
+    default:
+        notAvailable(iInfoCmd);
+    }
+    SIMGENTL_CATCH
+}
+
+GC_API GCRegisterEvent(EVENTSRC_HANDLE hEventSrc, EVENT_TYPE iEventID, EVENT_HANDLE* phEvent)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(phEvent);
+
+    if (iEventID != EVENT_NEW_BUFFER)
+        throw SimGenTLError("only the new buffer event is supported",
+                GC_ERR_NOT_IMPLEMENTED);
+
+    *phEvent = stream(hEventSrc)->registerEvent();
+    SIMGENTL_CATCH
+}
+
+GC_API GCUnregisterEvent(EVENTSRC_HANDLE hEventSrc, EVENT_TYPE iEventID)
+{
+    SIMGENTL_TRY
+    checkInit();
+
+    if (iEventID != EVENT_NEW_BUFFER)
+        throw SimGenTLError("only the new buffer event is supported",
+                GC_ERR_NOT_IMPLEMENTED);
+
+    SimDataStream* pStream = stream(hEventSrc);
+
+    if (pStream->event() == NULL)
+        throw SimGenTLError("the new buffer event is not registered",
+                GC_ERR_NOT_AVAILABLE);
+
+    pStream->unregisterEvent();
+    SIMGENTL_CATCH
+}
+
+GC_API EventGetData(EVENT_HANDLE hEvent, void* pBuffer, size_t* piSize, uint64_t iTimeout)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(pBuffer);
+    checkParam(piSize);
+
+    if (*piSize < sizeof(EVENT_NEW_BUFFER_DATA))
+        throw SimGenTLError("the given buffer is too small",
+                GC_ERR_BUFFER_TOO_SMALL);
+
+    SimBuffer* pBuf = eventStream(hEvent)->waitNewBuffer(iTimeout);
+
+    EVENT_NEW_BUFFER_DATA* pData = reinterpret_cast<EVENT_NEW_BUFFER_DATA*>(pBuffer);
+    pData->BufferHandle = pBuf;
+    pData->pUserPointer = pBuf->userPtr;
+    *piSize = sizeof(EVENT_NEW_BUFFER_DATA);
+    SIMGENTL_CATCH
+}
+
+GC_API EventGetDataInfo(EVENT_HANDLE hEvent, const void* pInBuffer, size_t iInSize, EVENT_DATA_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pOutBuffer, size_t* piOutSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    eventStream(hEvent);
+    checkParam(pInBuffer);
+
+    if (iInSize < sizeof(EVENT_NEW_BUFFER_DATA))
+        throw SimGenTLError("invalid event data", GC_ERR_INVALID_PARAMETER);
+
+    const EVENT_NEW_BUFFER_DATA* pData =
+            reinterpret_cast<const EVENT_NEW_BUFFER_DATA*>(pInBuffer);
+
+    switch (iInfoCmd)
+    {
+    case EVENT_DATA_ID:
+        infoValue<BUFFER_HANDLE>(INFO_DATATYPE_PTR, pData->BufferHandle,
+                piType, pOutBuffer, piOutSize);
+        break;
+    case EVENT_DATA_VALUE:
+        infoValue<void*>(INFO_DATATYPE_PTR, pData->pUserPointer,
+                piType, pOutBuffer, piOutSize);
+        break;
+    default:
+        notAvailable(iInfoCmd);
+    }
+    SIMGENTL_CATCH
+}
+
+GC_API EventGetInfo(EVENT_HANDLE hEvent, EVENT_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    SimDataStream* pStream = eventStream(hEvent);
+
+    switch (iInfoCmd)
+    {
+    case EVENT_EVENT_TYPE:
+        infoValue<int32_t>(INFO_DATATYPE_INT32, EVENT_NEW_BUFFER,
+                piType, pBuffer, piSize);
+        break;
+    case EVENT_NUM_IN_QUEUE:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, pStream->awaitDeliveryCount(),
+                piType, pBuffer, piSize);
+        break;
+    case EVENT_NUM_FIRED:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, pStream->deliveredCount(),
+                piType, pBuffer, piSize);
+        break;
+    case EVENT_SIZE_MAX:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, sizeof(EVENT_NEW_BUFFER_DATA),
+                piType, pBuffer, piSize);
+        break;
+    case EVENT_INFO_DATA_SIZE_MAX:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, sizeof(void*),
+                piType, pBuffer, piSize);
+        break;
+    default:
+        notAvailable(iInfoCmd);
+    }
+    SIMGENTL_CATCH
+}
+
+GC_API EventFlush(EVENT_HANDLE hEvent)
+{
+    SIMGENTL_TRY
+    checkInit();
+    eventStream(hEvent)->flushQueue(ACQ_QUEUE_OUTPUT_DISCARD);
+    SIMGENTL_CATCH
+}
+
+GC_API EventKill(EVENT_HANDLE hEvent)
+{
+    SIMGENTL_TRY
+    checkInit();
+    eventStream(hEvent)->killEvent();
+    SIMGENTL_CATCH
+}
+
+GC_API TLOpen(TL_HANDLE* phTL)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(phTL);
+
+    Poco::ScopedLock<Poco::FastMutex> lock(systemMutex);
+
+    if (pSystem)
+        throw SimGenTLError("the system module is already opened",
+                GC_ERR_RESOURCE_IN_USE);
+
+    pSystem = new SimSystem;
+    *phTL = pSystem;
+    SIMGENTL_CATCH
+}
+
+GC_API TLClose(TL_HANDLE hTL)
+{
+    SIMGENTL_TRY
+    checkInit();
+    tlSystem(hTL);
+
+    Poco::ScopedLock<Poco::FastMutex> lock(systemMutex);
+
+    delete pSystem;
+    pSystem = NULL;
+    SIMGENTL_CATCH
+}
+
+GC_API TLGetInfo(TL_HANDLE hTL, TL_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    tlSystem(hTL);
+    tlInfo(iInfoCmd, piType, pBuffer, piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API TLGetNumInterfaces(TL_HANDLE hTL, uint32_t* piNumIfaces)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(piNumIfaces);
+    *piNumIfaces = static_cast<uint32_t>(tlSystem(hTL)->interfaceCount());
+    SIMGENTL_CATCH
+}
+
+GC_API TLGetInterfaceID(TL_HANDLE hTL, uint32_t iIndex, char* sID, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    infoString(tlSystem(hTL)->interfaceID(iIndex), NULL, sID, piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API TLGetInterfaceInfo(TL_HANDLE hTL, const char* sIfaceID, INTERFACE_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(sIfaceID);
+    SimInterface* pIface = tlSystem(hTL)->findInterface(sIfaceID);
+    ifaceInfo(pIface->id(), iInfoCmd, piType, pBuffer, piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API TLOpenInterface(TL_HANDLE hTL, const char* sIfaceID, IF_HANDLE* phIface)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(sIfaceID);
+    checkParam(phIface);
+
+    SimInterface* pIface = tlSystem(hTL)->findInterface(sIfaceID);
+
+    if (pIface->isOpen())
+        throw SimGenTLError("the interface is already opened",
+                GC_ERR_RESOURCE_IN_USE);
+
+    pIface->open();
+    *phIface = pIface;
+    SIMGENTL_CATCH
+}
+
+GC_API TLUpdateInterfaceList(TL_HANDLE hTL, bool8_t* pbChanged, uint64_t iTimeout)
+{
+    SIMGENTL_TRY
+    checkInit();
+    tlSystem(hTL);
+
+    if (pbChanged)
+        *pbChanged = false;
+    SIMGENTL_CATCH
+}
+
+GC_API IFClose(IF_HANDLE hIface)
+{
+    SIMGENTL_TRY
+    checkInit();
+    iface(hIface)->close();
+    SIMGENTL_CATCH
+}
+
+GC_API IFGetInfo(IF_HANDLE hIface, INTERFACE_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    ifaceInfo(iface(hIface)->id(), iInfoCmd, piType, pBuffer, piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API IFGetNumDevices(IF_HANDLE hIface, uint32_t* piNumDevices)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(piNumDevices);
+    *piNumDevices = static_cast<uint32_t>(iface(hIface)->deviceCount());
+    SIMGENTL_CATCH
+}
+
+GC_API IFGetDeviceID(IF_HANDLE hIface, uint32_t iIndex, char* sIDeviceID, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    infoString(iface(hIface)->deviceID(iIndex), NULL, sIDeviceID, piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API IFUpdateDeviceList(IF_HANDLE hIface, bool8_t* pbChanged, uint64_t iTimeout)
+{
+    SIMGENTL_TRY
+    checkInit();
+    iface(hIface);
+
+    if (pbChanged)
+        *pbChanged = false;
+    SIMGENTL_CATCH
+}
+
+GC_API IFGetDeviceInfo(IF_HANDLE hIface, const char* sDeviceID, DEVICE_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(sDeviceID);
+    deviceInfo(iface(hIface)->findDevice(sDeviceID), iInfoCmd,
+            piType, pBuffer, piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API IFOpenDevice(IF_HANDLE hIface, const char* sDeviceID, DEVICE_ACCESS_FLAGS iOpenFlags, DEV_HANDLE* phDevice)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(sDeviceID);
+    checkParam(phDevice);
+
+    SimDevice* pDev = iface(hIface)->findDevice(sDeviceID);
+    pDev->open();
+    *phDevice = pDev;
+    SIMGENTL_CATCH
+}
+
+GC_API IFGetParentTL(IF_HANDLE hIface, TL_HANDLE* phSystem)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(phSystem);
+    iface(hIface);
+    *phSystem = pSystem;
+    SIMGENTL_CATCH
+}
+
+GC_API DevGetPort(DEV_HANDLE hDevice, PORT_HANDLE* phRemoteDevice)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(phRemoteDevice);
+    *phRemoteDevice = device(hDevice)->remotePort();
+    SIMGENTL_CATCH
+}
+
+GC_API DevGetNumDataStreams(DEV_HANDLE hDevice, uint32_t* piNumDataStreams)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(piNumDataStreams);
+    *piNumDataStreams = static_cast<uint32_t>(device(hDevice)->dataStreamCount());
+    SIMGENTL_CATCH
+}
+
+GC_API DevGetDataStreamID(DEV_HANDLE hDevice, uint32_t iIndex, char* sDataStreamID, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+
+    SimDevice* pDev = device(hDevice);
+    if (iIndex >= pDev->dataStreamCount())
+        throw SimGenTLError("data stream index out of range",
+                GC_ERR_INVALID_INDEX);
+
+    infoString(pDev->dataStreamID(), NULL, sDataStreamID, piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API DevOpenDataStream(DEV_HANDLE hDevice, const char* sDataStreamID, DS_HANDLE* phDataStream)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(sDataStreamID);
+    checkParam(phDataStream);
+    *phDataStream = device(hDevice)->openDataStream(sDataStreamID);
+    SIMGENTL_CATCH
+}
+
+GC_API DevGetInfo(DEV_HANDLE hDevice, DEVICE_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    deviceInfo(device(hDevice), iInfoCmd, piType, pBuffer, piSize);
+    SIMGENTL_CATCH
+}
+
+GC_API DevClose(DEV_HANDLE hDevice)
+{
+    SIMGENTL_TRY
+    checkInit();
+    device(hDevice)->close();
+    SIMGENTL_CATCH
+}
+
+GC_API DevGetParentIF(DEV_HANDLE hDevice, IF_HANDLE* phIface)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(phIface);
+    device(hDevice);
+    *phIface = pSystem->findInterface(pSystem->interfaceID(0));
+    SIMGENTL_CATCH
+}
+
+GC_API DSAnnounceBuffer(DS_HANDLE hDataStream, void* pBuffer, size_t iSize, void* pPrivate, BUFFER_HANDLE* phBuffer)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(phBuffer);
+    *phBuffer = stream(hDataStream)->announceBuffer(pBuffer, iSize, pPrivate);
+    SIMGENTL_CATCH
+}
+
+GC_API DSAllocAndAnnounceBuffer(DS_HANDLE hDataStream, size_t iSize, void* pPrivate, BUFFER_HANDLE* phBuffer)
+{
+    return setLastError(GC_ERR_NOT_IMPLEMENTED,
+            "DSAllocAndAnnounceBuffer: the consumer has to allocate the buffers");
+}
+
+GC_API DSFlushQueue(DS_HANDLE hDataStream, ACQ_QUEUE_TYPE iOperation)
+{
+    SIMGENTL_TRY
+    checkInit();
+    stream(hDataStream)->flushQueue(iOperation);
+    SIMGENTL_CATCH
+}
+
+GC_API DSStartAcquisition(DS_HANDLE hDataStream, ACQ_START_FLAGS iStartFlags, uint64_t iNumToAcquire)
+{
+    SIMGENTL_TRY
+    checkInit();
+    stream(hDataStream)->startAcquisition(iNumToAcquire);
+    SIMGENTL_CATCH
+}
+
+GC_API DSStopAcquisition(DS_HANDLE hDataStream, ACQ_STOP_FLAGS iStopFlags)
+{
+    SIMGENTL_TRY
+    checkInit();
+    stream(hDataStream)->stopAcquisition();
+    SIMGENTL_CATCH
+}
+
+GC_API DSGetInfo(DS_HANDLE hDataStream, STREAM_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    SimDataStream* pStream = stream(hDataStream);
+
+    switch (iInfoCmd)
+    {
+    case STREAM_INFO_ID:
+        infoString(pStream->id(), piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_NUM_DELIVERED:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, pStream->deliveredCount(),
+                piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_NUM_UNDERRUN:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, pStream->underrunCount(),
+                piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_NUM_ANNOUNCED:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, pStream->bufferCount(),
+                piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_NUM_QUEUED:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, pStream->queuedCount(),
+                piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_NUM_AWAIT_DELIVERY:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, pStream->awaitDeliveryCount(),
+                piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_NUM_STARTED:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, pStream->startedCount(),
+                piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_PAYLOAD_SIZE:
+        infoValue<size_t>(INFO_DATATYPE_SIZET,
+                pStream->parent()->frameConf().payloadSize,
+                piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_IS_GRABBING:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, pStream->isGrabbing(),
+                piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_DEFINES_PAYLOADSIZE:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, false, piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_TLTYPE:
+        infoString(TLTypeCustomName, piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_BUF_ANNOUNCE_MIN:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, 1, piType, pBuffer, piSize);
+        break;
+    case STREAM_INFO_BUF_ALIGNMENT:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, 1, piType, pBuffer, piSize);
+        break;
+    default:
+        notAvailable(iInfoCmd);
+    }
+    SIMGENTL_CATCH
+}
+
+GC_API DSGetBufferID(DS_HANDLE hDataStream, uint32_t iIndex, BUFFER_HANDLE* phBuffer)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(phBuffer);
+    *phBuffer = stream(hDataStream)->bufferAt(iIndex);
+    SIMGENTL_CATCH
+}
+
+GC_API DSClose(DS_HANDLE hDataStream)
+{
+    SIMGENTL_TRY
+    checkInit();
+    delete stream(hDataStream);
+    SIMGENTL_CATCH
+}
+
+GC_API DSRevokeBuffer(DS_HANDLE hDataStream, BUFFER_HANDLE hBuffer, void** pBuffer, void** pPrivate)
+{
+    SIMGENTL_TRY
+    checkInit();
+    stream(hDataStream)->revokeBuffer(hBuffer, pBuffer, pPrivate);
+    SIMGENTL_CATCH
+}
+
+GC_API DSQueueBuffer(DS_HANDLE hDataStream, BUFFER_HANDLE hBuffer)
+{
+    SIMGENTL_TRY
+    checkInit();
+    stream(hDataStream)->queueBuffer(hBuffer);
+    SIMGENTL_CATCH
+}
+
+GC_API DSGetBufferInfo(DS_HANDLE hDataStream, BUFFER_HANDLE hBuffer, BUFFER_INFO_CMD iInfoCmd, INFO_DATATYPE* piType, void* pBuffer, size_t* piSize)
+{
+    SIMGENTL_TRY
+    checkInit();
+    SimDataStream* pStream = stream(hDataStream);
+
+    Poco::ScopedLock<Poco::FastMutex> lock(pStream->mutex());
+    SimBuffer* pBuf = pStream->buffer(hBuffer);
+
+    switch (iInfoCmd)
+    {
+    case BUFFER_INFO_BASE:
+        infoValue<void*>(INFO_DATATYPE_PTR, pBuf->data, piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_SIZE:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, pBuf->size, piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_USER_PTR:
+        infoValue<void*>(INFO_DATATYPE_PTR, pBuf->userPtr, piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_TIMESTAMP:
+    case BUFFER_INFO_TIMESTAMP_NS:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, pBuf->timestampNs,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_NEW_DATA:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, pBuf->newData,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_IS_QUEUED:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, pBuf->queued,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_IS_ACQUIRING:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, pBuf->acquiring,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_IS_INCOMPLETE:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, pBuf->incomplete,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_TLTYPE:
+        infoString(TLTypeCustomName, piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_SIZE_FILLED:
+    case BUFFER_INFO_DATA_SIZE:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, pBuf->sizeFilled,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_WIDTH:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, pBuf->width, piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_HEIGHT:
+    case BUFFER_INFO_DELIVERED_IMAGEHEIGHT:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, pBuf->height, piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_XOFFSET:
+    case BUFFER_INFO_YOFFSET:
+    case BUFFER_INFO_XPADDING:
+    case BUFFER_INFO_YPADDING:
+    case BUFFER_INFO_IMAGEOFFSET:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, 0, piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_FRAMEID:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, pBuf->frameID,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_IMAGEPRESENT:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, pBuf->sizeFilled > 0,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_PAYLOADTYPE:
+        infoValue<size_t>(INFO_DATATYPE_SIZET, PAYLOAD_TYPE_IMAGE,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_PIXELFORMAT:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, pBuf->pixelFormat,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_PIXELFORMAT_NAMESPACE:
+        infoValue<uint64_t>(INFO_DATATYPE_UINT64, PIXELFORMAT_NAMESPACE_PFNC_32BIT,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_PIXEL_ENDIANNESS:
+        infoValue<int32_t>(INFO_DATATYPE_INT32, PIXELENDIANNESS_LITTLE,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_DATA_LARGER_THAN_BUFFER:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8,
+                pBuf->incomplete && pBuf->sizeFilled == pBuf->size,
+                piType, pBuffer, piSize);
+        break;
+    case BUFFER_INFO_CONTAINS_CHUNKDATA:
+        infoValue<bool8_t>(INFO_DATATYPE_BOOL8, false, piType, pBuffer, piSize);
+        break;
+    default:
+        notAvailable(iInfoCmd);
+    }
+    SIMGENTL_CATCH
+}
+
+GC_API DSGetParentDev(DS_HANDLE hDataStream, DEV_HANDLE* phDevice)
+{
+    SIMGENTL_TRY
+    checkInit();
+    checkParam(phDevice);
+    *phDevice = stream(hDataStream)->parent();
+    SIMGENTL_CATCH
+}
+
+} // namespace GenTL
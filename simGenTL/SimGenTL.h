@@ -0,0 +1,468 @@
+/**
+ * @file	simGenTL/SimGenTL.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SIMGENTL_SIMGENTL_H_
+#define SIMGENTL_SIMGENTL_H_
+
+#include "modules/devices/genicam/GenTL_v1_5.h"
+
+#include "Poco/Exception.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Random.h"
+#include "Poco/Timestamp.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+
+/**
+ * Error of the simulated producer
+ *
+ * The exception code is the GenTL::GC_ERROR returned by the API function.
+ */
+POCO_DECLARE_EXCEPTION( , SimGenTLError, Poco::Exception)
+
+#define SIMGENTL_VENDOR "Opticalp"
+#define SIMGENTL_MODEL  "SimGenTL"
+#define SIMGENTL_VERSION "1.0"
+
+/**
+ * Register map of the simulated remote device
+ *
+ * All registers are 4-byte little endian unsigned integers,
+ * but the frame rate (8-byte IEEE double).
+ * The node map XML is exposed at regXml.
+ */
+enum SimRegisters
+{
+    regWidth = 0x00,
+    regHeight = 0x04,
+    regPixelFormat = 0x08,
+    regPayloadSize = 0x0C, ///< read-only
+    regAcquisitionStart = 0x10, ///< command, self-clearing
+    regAcquisitionStop = 0x14, ///< command, self-clearing
+    regAcquisitionFrameRate = 0x18, ///< Hz, 0 means: as fast as possible
+    regSimDropInterval = 0x20, ///< drop every Nth frame. 0: never
+    regSimDelayJitter = 0x24, ///< random delivery delay, in us
+    regSimIncompleteInterval = 0x28, ///< every Nth frame incomplete. 0: never
+    regMapSize = 0x30,
+    regXml = 0x1000
+};
+
+/// PFNC codes of the supported pixel formats
+enum SimPixelFormats
+{
+    pixMono8 = 0x01080001,
+    pixMono10 = 0x01100003,
+    pixMono12 = 0x01100005,
+    pixMono16 = 0x01100007,
+    pixMono10p = 0x010A0046,
+    pixMono12p = 0x010C0047,
+    pixBayerRG8 = 0x01080009,
+    pixBayerRG12 = 0x01100011
+};
+
+/// GenICam node map of the simulated remote device (SimNodeMap.cpp)
+extern const char* simNodeMapXml;
+
+/**
+ * SimModule
+ *
+ * Base class of the objects behind the GenTL handles.
+ *
+ * The live objects are registered, so that the handles given by the
+ * consumer can be checked before being dereferenced.
+ */
+class SimModule
+{
+public:
+    enum Kind
+    {
+        kindSystem,
+        kindInterface,
+        kindDevice,
+        kindRemotePort,
+        kindDataStream,
+        kindBuffer,
+        kindEvent
+    };
+
+    SimModule(Kind kind);
+    virtual ~SimModule();
+
+    Kind kind() const { return mKind; }
+
+    /// GenTL module name, as returned by PORT_INFO_MODULE
+    std::string moduleName() const;
+
+    /**
+     * Check that the handle is a live module of the given kind
+     *
+     * @throw SimGenTLError(GC_ERR_INVALID_HANDLE) if not
+     */
+    static SimModule* check(void* handle, Kind kind);
+
+    /// same as check, accepting any kind of module (port functions)
+    static SimModule* check(void* handle);
+
+private:
+    SimModule();
+
+    Kind mKind;
+
+    static std::set<SimModule*> live;
+    static Poco::FastMutex liveMutex;
+};
+
+class SimInterface;
+class SimDevice;
+class SimDataStream;
+
+/**
+ * SimSystem
+ *
+ * Transport layer module. Owns a single interface.
+ */
+class SimSystem: public SimModule
+{
+public:
+    SimSystem();
+    ~SimSystem();
+
+    std::string id() { return SIMGENTL_MODEL; }
+
+    size_t interfaceCount() { return 1; }
+    std::string interfaceID(size_t index);
+
+    /// @throw SimGenTLError(GC_ERR_INVALID_ID) if not found
+    SimInterface* findInterface(const std::string& ifaceID);
+
+private:
+    SimInterface* iface;
+};
+
+/**
+ * SimInterface
+ *
+ * Interface module. Owns the simulated devices.
+ */
+class SimInterface: public SimModule
+{
+public:
+    SimInterface(SimSystem* parent, const std::string& ifaceID);
+    ~SimInterface();
+
+    std::string id() { return mID; }
+
+    bool isOpen() { return opened; }
+    void open() { opened = true; }
+    void close();
+
+    size_t deviceCount() { return devices.size(); }
+    std::string deviceID(size_t index);
+
+    /// @throw SimGenTLError(GC_ERR_INVALID_ID) if not found
+    SimDevice* findDevice(const std::string& devID);
+
+private:
+    std::string mID;
+    bool opened;
+    std::vector<SimDevice*> devices;
+};
+
+/**
+ * SimRemotePort
+ *
+ * Port of the remote device, giving access to its register map
+ */
+class SimRemotePort: public SimModule
+{
+public:
+    SimRemotePort(SimDevice* parent):
+        SimModule(kindRemotePort), device(parent) { }
+
+    SimDevice* parent() { return device; }
+
+private:
+    SimDevice* device;
+};
+
+/**
+ * SimDevice
+ *
+ * Device module and simulated remote device (register map).
+ */
+class SimDevice: public SimModule
+{
+public:
+    SimDevice(SimInterface* parent, const std::string& devID);
+    ~SimDevice();
+
+    std::string id() { return mID; }
+
+    bool isOpen() { return opened; }
+
+    /// @throw SimGenTLError(GC_ERR_RESOURCE_IN_USE) if already opened
+    void open();
+
+    /// close the device and its data stream
+    void close();
+
+    SimRemotePort* remotePort() { return &port; }
+
+    size_t dataStreamCount() { return 1; }
+    std::string dataStreamID() { return "Stream0"; }
+
+    /// @throw SimGenTLError(GC_ERR_RESOURCE_IN_USE) if already opened
+    SimDataStream* openDataStream(const std::string& streamID);
+
+    /// called by the data stream when it is closed
+    void dataStreamClosed() { stream = NULL; }
+
+    /// @name remote device register map
+    ///@{
+    void readRegisters(uint64_t address, void* pBuffer, size_t size);
+    void writeRegisters(uint64_t address, const void* pBuffer, size_t size);
+
+    /// URL of the node map, e.g. local:SimGenTL.xml;1000;1f4a
+    std::string nodeMapURL();
+    size_t nodeMapSize();
+    ///@}
+
+    /// Image generation settings, as read from the register map
+    struct FrameConf
+    {
+        size_t width;
+        size_t height;
+        uint32_t pixelFormat;
+        size_t bytesPerPixel; ///< 0 if packed
+        int bitDepth;
+        size_t payloadSize;
+        double frameRate;
+        uint32_t dropInterval;
+        uint32_t delayJitter;
+        uint32_t incompleteInterval;
+    };
+
+    FrameConf frameConf();
+
+    /// true between the AcquisitionStart and AcquisitionStop commands
+    bool isAcquisitionStarted();
+
+private:
+    SimDevice();
+
+    uint32_t reg32(size_t address);
+    void setReg32(size_t address, uint32_t value);
+    size_t payloadSize();
+
+    std::string mID;
+    bool opened;
+
+    SimRemotePort port;
+    SimDataStream* stream;
+
+    unsigned char regs[regMapSize];
+    bool acquisitionStarted;
+    Poco::FastMutex regMutex;
+};
+
+/**
+ * SimBuffer
+ *
+ * Buffer announced to a data stream. The fields are protected by the
+ * data stream mutex.
+ */
+class SimBuffer: public SimModule
+{
+public:
+    SimBuffer(SimDataStream* parent, void* pBuffer, size_t bufSize, void* pPrivate);
+
+    SimDataStream* parent;
+
+    void* data;
+    size_t size;
+    void* userPtr;
+
+    bool queued; ///< in the input pool or in the output queue
+    bool acquiring; ///< being filled
+    bool newData; ///< filled since it was queued
+    bool incomplete;
+
+    size_t sizeFilled;
+    uint64_t timestampNs;
+    uint64_t frameID;
+    size_t width;
+    size_t height;
+    uint32_t pixelFormat;
+};
+
+/**
+ * SimEvent
+ *
+ * New buffer event of a data stream
+ */
+class SimEvent: public SimModule
+{
+public:
+    SimEvent(SimDataStream* stream):
+        SimModule(kindEvent), parent(stream) { }
+
+    SimDataStream* parent;
+};
+
+/**
+ * SimDataStream
+ *
+ * Data stream module. Generates the synthetic frames in a thread.
+ *
+ * The frames are delivered at the frame rate set in the remote device
+ * register map, only if the device acquisition is started
+ * (AcquisitionStart command).
+ * If the frame rate is 0, the frames are delivered as fast as the
+ * consumer requeues the buffers.
+ *
+ * Fault injection, as set in the register map:
+ *  - drop interval: each Nth frame is lost (frame ID gap)
+ *  - delay jitter: random additional delay before delivery
+ *  - incomplete interval: each Nth frame is half filled and flagged
+ *  incomplete
+ *
+ * If the input pool is empty when a frame is due, it is lost and
+ * counted as underrun.
+ */
+class SimDataStream: public SimModule
+{
+public:
+    SimDataStream(SimDevice* parent, const std::string& streamID);
+
+    /// stop the acquisition, unregister the event, delete the buffers
+    ~SimDataStream();
+
+    std::string id() { return mID; }
+    SimDevice* parent() { return device; }
+
+    GenTL::BUFFER_HANDLE announceBuffer(void* pBuffer, size_t bufSize, void* pPrivate);
+    void revokeBuffer(GenTL::BUFFER_HANDLE hBuffer, void** ppBuffer, void** ppPrivate);
+    void queueBuffer(GenTL::BUFFER_HANDLE hBuffer);
+    void flushQueue(GenTL::ACQ_QUEUE_TYPE operation);
+
+    size_t bufferCount();
+
+    /// @throw SimGenTLError(GC_ERR_INVALID_INDEX)
+    GenTL::BUFFER_HANDLE bufferAt(size_t index);
+
+    /**
+     * Check that the given handle is a buffer of this stream
+     *
+     * The returned buffer fields have to be accessed with the stream
+     * mutex locked.
+     */
+    SimBuffer* buffer(GenTL::BUFFER_HANDLE hBuffer);
+
+    Poco::FastMutex& mutex() { return streamMutex; }
+
+    void startAcquisition(uint64_t numToAcquire);
+    void stopAcquisition();
+
+    /// @name counters and status
+    ///@{
+    bool isGrabbing();
+    uint64_t deliveredCount();
+    uint64_t underrunCount();
+    uint64_t startedCount();
+    size_t queuedCount();
+    size_t awaitDeliveryCount();
+    ///@}
+
+    /// @name new buffer event
+    ///@{
+    SimEvent* registerEvent();
+    void unregisterEvent();
+    SimEvent* event() { return newBufferEvent; }
+
+    /**
+     * Wait for a filled buffer in the output queue
+     *
+     * @param timeout in ms, or GENTL_INFINITE
+     * @throw SimGenTLError(GC_ERR_TIMEOUT)
+     * @throw SimGenTLError(GC_ERR_ABORT) if killEvent was called
+     */
+    SimBuffer* waitNewBuffer(uint64_t timeout);
+
+    /// abort the current, or the next, waitNewBuffer call
+    void killEvent();
+    ///@}
+
+private:
+    SimDataStream();
+
+    /// acquisition thread
+    void acquisitionLoop();
+
+    /// wait until the given time or a stop request. mutex unlocked
+    bool waitUntil(const Poco::Timestamp& time);
+
+    /// fill the buffer with the test pattern. mutex unlocked
+    void fillBuffer(SimBuffer* pBuf, const SimDevice::FrameConf& conf,
+            uint64_t frameID, bool incomplete);
+
+    std::string mID;
+    SimDevice* device;
+
+    std::vector<SimBuffer*> buffers; ///< announced buffers
+    std::deque<SimBuffer*> inputPool;
+    std::deque<SimBuffer*> outputQueue;
+    size_t flushCount; ///< incremented by each flush. detect a flush during a fill
+
+    SimEvent* newBufferEvent;
+    bool eventKilled;
+    Poco::Event outputReady;
+    Poco::Event inputReady;
+
+    uint64_t numToAcquire;
+    uint64_t numDelivered;
+    uint64_t numUnderrun;
+    uint64_t numStarted;
+    uint64_t lastFrameID;
+
+    bool grabbing;
+    bool stopping;
+    Poco::Event stopRequest;
+    Poco::Thread acqThread;
+    Poco::RunnableAdapter<SimDataStream> acqRunnable;
+    Poco::Random random;
+
+    Poco::FastMutex streamMutex;
+};
+
+#endif /* SIMGENTL_SIMGENTL_H_ */
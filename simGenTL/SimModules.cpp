@@ -0,0 +1,396 @@
+/**
+ * @file	simGenTL/SimModules.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "SimGenTL.h"
+
+#include "Poco/NumberFormatter.h"
+
+#include <cstring>
+
+POCO_IMPLEMENT_EXCEPTION( SimGenTLError, Poco::Exception, "Simulated GenTL producer error")
+
+std::set<SimModule*> SimModule::live;
+Poco::FastMutex SimModule::liveMutex;
+
+SimModule::SimModule(Kind kind):
+    mKind(kind)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(liveMutex);
+    live.insert(this);
+}
+
+SimModule::~SimModule()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(liveMutex);
+    live.erase(this);
+}
+
+std::string SimModule::moduleName() const
+{
+    switch (mKind)
+    {
+    case kindSystem:
+        return TLSystemModuleName;
+    case kindInterface:
+        return TLInterfaceModuleName;
+    case kindDevice:
+        return TLDeviceModuleName;
+    case kindRemotePort:
+        return TLRemoteDeviceModuleName;
+    case kindDataStream:
+        return TLDataStreamModuleName;
+    case kindBuffer:
+        return TLBufferModuleName;
+    default:
+        return "";
+    }
+}
+
+SimModule* SimModule::check(void* handle, Kind kind)
+{
+    SimModule* module = check(handle);
+
+    if (module->mKind != kind)
+        throw SimGenTLError("the handle does not refer to a "
+                + module->moduleName() + " module",
+                GenTL::GC_ERR_INVALID_HANDLE);
+
+    return module;
+}
+
+SimModule* SimModule::check(void* handle)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(liveMutex);
+
+    std::set<SimModule*>::iterator it =
+            live.find(reinterpret_cast<SimModule*>(handle));
+
+    if (it == live.end())
+        throw SimGenTLError("invalid handle", GenTL::GC_ERR_INVALID_HANDLE);
+
+    return *it;
+}
+
+SimSystem::SimSystem():
+    SimModule(kindSystem)
+{
+    iface = new SimInterface(this, "SimInterface");
+}
+
+SimSystem::~SimSystem()
+{
+    delete iface;
+}
+
+std::string SimSystem::interfaceID(size_t index)
+{
+    if (index >= interfaceCount())
+        throw SimGenTLError("interface index out of range",
+                GenTL::GC_ERR_INVALID_INDEX);
+
+    return iface->id();
+}
+
+SimInterface* SimSystem::findInterface(const std::string& ifaceID)
+{
+    if (ifaceID != iface->id())
+        throw SimGenTLError("unknown interface: " + ifaceID,
+                GenTL::GC_ERR_INVALID_ID);
+
+    return iface;
+}
+
+SimInterface::SimInterface(SimSystem* parent, const std::string& ifaceID):
+    SimModule(kindInterface), mID(ifaceID), opened(false)
+{
+    devices.push_back(new SimDevice(this, "SimCam0"));
+    devices.push_back(new SimDevice(this, "SimCam1"));
+}
+
+SimInterface::~SimInterface()
+{
+    for (std::vector<SimDevice*>::iterator it = devices.begin(),
+            ite = devices.end(); it != ite; it++)
+        delete *it;
+}
+
+void SimInterface::close()
+{
+    for (std::vector<SimDevice*>::iterator it = devices.begin(),
+            ite = devices.end(); it != ite; it++)
+        (*it)->close();
+
+    opened = false;
+}
+
+std::string SimInterface::deviceID(size_t index)
+{
+    if (index >= devices.size())
+        throw SimGenTLError("device index out of range",
+                GenTL::GC_ERR_INVALID_INDEX);
+
+    return devices[index]->id();
+}
+
+SimDevice* SimInterface::findDevice(const std::string& devID)
+{
+    for (std::vector<SimDevice*>::iterator it = devices.begin(),
+            ite = devices.end(); it != ite; it++)
+    {
+        if ((*it)->id() == devID)
+            return *it;
+    }
+
+    throw SimGenTLError("unknown device: " + devID, GenTL::GC_ERR_INVALID_ID);
+}
+
+SimDevice::SimDevice(SimInterface* parent, const std::string& devID):
+    SimModule(kindDevice), mID(devID), opened(false),
+    port(this), stream(NULL),
+    acquisitionStarted(false)
+{
+    memset(regs, 0, regMapSize);
+
+    setReg32(regWidth, 640);
+    setReg32(regHeight, 480);
+    setReg32(regPixelFormat, pixMono8);
+
+    double frameRate = 30;
+    memcpy(regs + regAcquisitionFrameRate, &frameRate, sizeof(double));
+}
+
+SimDevice::~SimDevice()
+{
+    close();
+}
+
+void SimDevice::open()
+{
+    if (opened)
+        throw SimGenTLError("device " + mID + " is already opened",
+                GenTL::GC_ERR_RESOURCE_IN_USE);
+
+    opened = true;
+}
+
+void SimDevice::close()
+{
+    if (stream)
+        delete stream; // calls dataStreamClosed()
+
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(regMutex);
+        acquisitionStarted = false;
+    }
+
+    opened = false;
+}
+
+SimDataStream* SimDevice::openDataStream(const std::string& streamID)
+{
+    if (streamID != dataStreamID())
+        throw SimGenTLError("unknown data stream: " + streamID,
+                GenTL::GC_ERR_INVALID_ID);
+
+    if (stream)
+        throw SimGenTLError("data stream " + streamID + " is already opened",
+                GenTL::GC_ERR_RESOURCE_IN_USE);
+
+    stream = new SimDataStream(this, streamID);
+    return stream;
+}
+
+uint32_t SimDevice::reg32(size_t address)
+{
+    return static_cast<uint32_t>(regs[address])
+            | (static_cast<uint32_t>(regs[address + 1]) << 8)
+            | (static_cast<uint32_t>(regs[address + 2]) << 16)
+            | (static_cast<uint32_t>(regs[address + 3]) << 24);
+}
+
+void SimDevice::setReg32(size_t address, uint32_t value)
+{
+    regs[address] = static_cast<unsigned char>(value & 0xFF);
+    regs[address + 1] = static_cast<unsigned char>((value >> 8) & 0xFF);
+    regs[address + 2] = static_cast<unsigned char>((value >> 16) & 0xFF);
+    regs[address + 3] = static_cast<unsigned char>((value >> 24) & 0xFF);
+}
+
+size_t SimDevice::payloadSize()
+{
+    size_t pixels = static_cast<size_t>(reg32(regWidth)) * reg32(regHeight);
+
+    switch (reg32(regPixelFormat))
+    {
+    case pixMono8:
+    case pixBayerRG8:
+        return pixels;
+    case pixMono10p:
+        return (pixels * 10 + 7) / 8;
+    case pixMono12p:
+        return (pixels * 12 + 7) / 8;
+    default:
+        return pixels * 2;
+    }
+}
+
+void SimDevice::readRegisters(uint64_t address, void* pBuffer, size_t size)
+{
+    if (address >= regXml)
+    {
+        if (address + size > regXml + nodeMapSize())
+            throw SimGenTLError("read out of the node map XML range",
+                    GenTL::GC_ERR_INVALID_ADDRESS);
+
+        memcpy(pBuffer, simNodeMapXml + (address - regXml), size);
+        return;
+    }
+
+    if (address + size > regMapSize)
+        throw SimGenTLError("read out of the register map: 0x"
+                + Poco::NumberFormatter::formatHex(address),
+                GenTL::GC_ERR_INVALID_ADDRESS);
+
+    Poco::ScopedLock<Poco::FastMutex> lock(regMutex);
+
+    setReg32(regPayloadSize, static_cast<uint32_t>(payloadSize()));
+    memcpy(pBuffer, regs + address, size);
+}
+
+void SimDevice::writeRegisters(uint64_t address, const void* pBuffer, size_t size)
+{
+    if (address + size > regMapSize)
+        throw SimGenTLError("write out of the register map: 0x"
+                + Poco::NumberFormatter::formatHex(address),
+                GenTL::GC_ERR_INVALID_ADDRESS);
+
+    if (address < regPayloadSize + 4 && address + size > regPayloadSize)
+        throw SimGenTLError("PayloadSize is read-only",
+                GenTL::GC_ERR_ACCESS_DENIED);
+
+    Poco::ScopedLock<Poco::FastMutex> lock(regMutex);
+
+    // the image format can not change while acquiring
+    if (acquisitionStarted && address < regPayloadSize)
+        throw SimGenTLError("the image format is locked during the acquisition",
+                GenTL::GC_ERR_ACCESS_DENIED);
+
+    unsigned char previous[regMapSize];
+    memcpy(previous, regs, regMapSize);
+    memcpy(regs + address, pBuffer, size);
+
+    uint32_t format = reg32(regPixelFormat);
+    if (format != pixMono8 && format != pixMono10
+            && format != pixMono12 && format != pixMono16
+            && format != pixMono10p && format != pixMono12p
+            && format != pixBayerRG8 && format != pixBayerRG12)
+    {
+        memcpy(regs, previous, regMapSize);
+        throw SimGenTLError("unsupported pixel format",
+                GenTL::GC_ERR_INVALID_VALUE);
+    }
+
+    if (reg32(regWidth) == 0 || reg32(regHeight) == 0)
+    {
+        memcpy(regs, previous, regMapSize);
+        throw SimGenTLError("null image size", GenTL::GC_ERR_INVALID_VALUE);
+    }
+
+    // self-clearing commands
+    if (reg32(regAcquisitionStart))
+    {
+        acquisitionStarted = true;
+        setReg32(regAcquisitionStart, 0);
+    }
+
+    if (reg32(regAcquisitionStop))
+    {
+        acquisitionStarted = false;
+        setReg32(regAcquisitionStop, 0);
+    }
+}
+
+std::string SimDevice::nodeMapURL()
+{
+    return "local:" SIMGENTL_MODEL ".xml;"
+            + Poco::NumberFormatter::formatHex(static_cast<unsigned>(regXml))
+            + ";" + Poco::NumberFormatter::formatHex(nodeMapSize());
+}
+
+size_t SimDevice::nodeMapSize()
+{
+    return strlen(simNodeMapXml);
+}
+
+SimDevice::FrameConf SimDevice::frameConf()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(regMutex);
+
+    FrameConf conf;
+    conf.width = reg32(regWidth);
+    conf.height = reg32(regHeight);
+    conf.pixelFormat = reg32(regPixelFormat);
+
+    switch (conf.pixelFormat)
+    {
+    case pixMono10:
+    case pixMono10p:
+        conf.bitDepth = 10;
+        break;
+    case pixMono12:
+    case pixMono12p:
+    case pixBayerRG12:
+        conf.bitDepth = 12;
+        break;
+    case pixMono16:
+        conf.bitDepth = 16;
+        break;
+    case pixMono8:
+    default:
+        conf.bitDepth = 8;
+        break;
+    }
+
+    if (conf.pixelFormat == pixMono10p || conf.pixelFormat == pixMono12p)
+        conf.bytesPerPixel = 0;
+    else
+        conf.bytesPerPixel = (conf.bitDepth > 8) ? 2 : 1;
+    conf.payloadSize = payloadSize();
+    memcpy(&conf.frameRate, regs + regAcquisitionFrameRate, sizeof(double));
+    conf.dropInterval = reg32(regSimDropInterval);
+    conf.delayJitter = reg32(regSimDelayJitter);
+    conf.incompleteInterval = reg32(regSimIncompleteInterval);
+
+    return conf;
+}
+
+bool SimDevice::isAcquisitionStarted()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(regMutex);
+    return acquisitionStarted;
+}
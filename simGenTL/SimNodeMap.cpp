@@ -0,0 +1,267 @@
+/**
+ * @file	simGenTL/SimNodeMap.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+
+#include "SimGenTL.h"
+
+/*
+ * GenApi schema v1.1 description of the simulated remote device.
+ * The register addresses are the ones of SimRegisters.
+ * All the registers are NoCache: their values are changed by the
+ * commands and by the acquisition.
+ */
+const char* simNodeMapXml =
+"<?xml version='1.0' encoding='utf-8'?>\n"
+"<RegisterDescription ModelName='SimCam' VendorName='Opticalp'\n"
+"    ToolTip='Simulated camera of the SimGenTL producer'\n"
+"    StandardNameSpace='None'\n"
+"    SchemaMajorVersion='1' SchemaMinorVersion='1' SchemaSubMinorVersion='0'\n"
+"    MajorVersion='1' MinorVersion='0' SubMinorVersion='0'\n"
+"    ProductGuid='6f1d2b8e-3c47-4a15-9d0e-5b7a1c2e4f60'\n"
+"    VersionGuid='b2e47a19-8d5c-4f3e-a610-7c9d0e1f2a38'\n"
+"    xmlns='http://www.genicam.org/GenApi/Version_1_1'\n"
+"    xmlns:xsi='http://www.w3.org/2001/XMLSchema-instance'\n"
+"    xsi:schemaLocation='http://www.genicam.org/GenApi/Version_1_1 http://www.genicam.org/GenApi/GenApiSchema_Version_1_1.xsd'>\n"
+"\n"
+"  <Category Name='Root' NameSpace='Standard'>\n"
+"    <pFeature>ImageFormatControl</pFeature>\n"
+"    <pFeature>AcquisitionControl</pFeature>\n"
+"    <pFeature>TransportLayerControl</pFeature>\n"
+"    <pFeature>SimulationControl</pFeature>\n"
+"  </Category>\n"
+"\n"
+"  <Category Name='ImageFormatControl' NameSpace='Standard'>\n"
+"    <pFeature>Width</pFeature>\n"
+"    <pFeature>Height</pFeature>\n"
+"    <pFeature>PixelFormat</pFeature>\n"
+"  </Category>\n"
+"\n"
+"  <Category Name='AcquisitionControl' NameSpace='Standard'>\n"
+"    <pFeature>AcquisitionStart</pFeature>\n"
+"    <pFeature>AcquisitionStop</pFeature>\n"
+"    <pFeature>AcquisitionFrameRate</pFeature>\n"
+"  </Category>\n"
+"\n"
+"  <Category Name='TransportLayerControl' NameSpace='Standard'>\n"
+"    <pFeature>PayloadSize</pFeature>\n"
+"  </Category>\n"
+"\n"
+"  <Category Name='SimulationControl' NameSpace='Custom'>\n"
+"    <pFeature>SimDropInterval</pFeature>\n"
+"    <pFeature>SimDelayJitter</pFeature>\n"
+"    <pFeature>SimIncompleteInterval</pFeature>\n"
+"  </Category>\n"
+"\n"
+"  <Integer Name='Width' NameSpace='Standard'>\n"
+"    <ToolTip>Width of the image in pixels</ToolTip>\n"
+"    <pValue>WidthReg</pValue>\n"
+"    <Min>16</Min>\n"
+"    <Max>4096</Max>\n"
+"    <Inc>4</Inc>\n"
+"  </Integer>\n"
+"  <IntReg Name='WidthReg'>\n"
+"    <Address>0x00</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"\n"
+"  <Integer Name='Height' NameSpace='Standard'>\n"
+"    <ToolTip>Height of the image in pixels</ToolTip>\n"
+"    <pValue>HeightReg</pValue>\n"
+"    <Min>16</Min>\n"
+"    <Max>4096</Max>\n"
+"    <Inc>1</Inc>\n"
+"  </Integer>\n"
+"  <IntReg Name='HeightReg'>\n"
+"    <Address>0x04</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"\n"
+"  <Enumeration Name='PixelFormat' NameSpace='Standard'>\n"
+"    <ToolTip>Format of the pixels. Mono10 to Mono16 use 2 bytes per pixel, "
+"Mono10p and Mono12p are packed along the whole image. "
+"BayerRG formats deliver the same ramp as the mono formats</ToolTip>\n"
+"    <EnumEntry Name='Mono8' NameSpace='Standard'>\n"
+"      <Value>17301505</Value>\n"
+"    </EnumEntry>\n"
+"    <EnumEntry Name='Mono10' NameSpace='Standard'>\n"
+"      <Value>17825795</Value>\n"
+"    </EnumEntry>\n"
+"    <EnumEntry Name='Mono12' NameSpace='Standard'>\n"
+"      <Value>17825797</Value>\n"
+"    </EnumEntry>\n"
+"    <EnumEntry Name='Mono16' NameSpace='Standard'>\n"
+"      <Value>17825799</Value>\n"
+"    </EnumEntry>\n"
+"    <EnumEntry Name='Mono10p' NameSpace='Standard'>\n"
+"      <Value>17432646</Value>\n"
+"    </EnumEntry>\n"
+"    <EnumEntry Name='Mono12p' NameSpace='Standard'>\n"
+"      <Value>17563719</Value>\n"
+"    </EnumEntry>\n"
+"    <EnumEntry Name='BayerRG8' NameSpace='Standard'>\n"
+"      <Value>17301513</Value>\n"
+"    </EnumEntry>\n"
+"    <EnumEntry Name='BayerRG12' NameSpace='Standard'>\n"
+"      <Value>17825809</Value>\n"
+"    </EnumEntry>\n"
+"    <pValue>PixelFormatReg</pValue>\n"
+"  </Enumeration>\n"
+"  <IntReg Name='PixelFormatReg'>\n"
+"    <Address>0x08</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"\n"
+"  <Integer Name='PayloadSize' NameSpace='Standard'>\n"
+"    <ToolTip>Size of the image buffers in bytes</ToolTip>\n"
+"    <pValue>PayloadSizeReg</pValue>\n"
+"  </Integer>\n"
+"  <IntReg Name='PayloadSizeReg'>\n"
+"    <Address>0x0C</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RO</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"\n"
+"  <Command Name='AcquisitionStart' NameSpace='Standard'>\n"
+"    <ToolTip>Start the image acquisition</ToolTip>\n"
+"    <pValue>AcquisitionStartReg</pValue>\n"
+"    <CommandValue>1</CommandValue>\n"
+"  </Command>\n"
+"  <IntReg Name='AcquisitionStartReg'>\n"
+"    <Address>0x10</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"\n"
+"  <Command Name='AcquisitionStop' NameSpace='Standard'>\n"
+"    <ToolTip>Stop the image acquisition</ToolTip>\n"
+"    <pValue>AcquisitionStopReg</pValue>\n"
+"    <CommandValue>1</CommandValue>\n"
+"  </Command>\n"
+"  <IntReg Name='AcquisitionStopReg'>\n"
+"    <Address>0x14</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"\n"
+"  <Float Name='AcquisitionFrameRate' NameSpace='Standard'>\n"
+"    <ToolTip>Frame rate in Hz. 0 means: as fast as the buffers are requeued</ToolTip>\n"
+"    <pValue>AcquisitionFrameRateReg</pValue>\n"
+"    <Min>0</Min>\n"
+"    <Max>100000</Max>\n"
+"    <Unit>Hz</Unit>\n"
+"  </Float>\n"
+"  <FloatReg Name='AcquisitionFrameRateReg'>\n"
+"    <Address>0x18</Address>\n"
+"    <Length>8</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </FloatReg>\n"
+"\n"
+"  <Integer Name='SimDropInterval' NameSpace='Custom'>\n"
+"    <ToolTip>Drop every Nth frame (frame ID gap). 0: no drop</ToolTip>\n"
+"    <pValue>SimDropIntervalReg</pValue>\n"
+"    <Min>0</Min>\n"
+"    <Max>1000000</Max>\n"
+"  </Integer>\n"
+"  <IntReg Name='SimDropIntervalReg'>\n"
+"    <Address>0x20</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"\n"
+"  <Integer Name='SimDelayJitter' NameSpace='Custom'>\n"
+"    <ToolTip>Maximum random delivery delay in microseconds</ToolTip>\n"
+"    <pValue>SimDelayJitterReg</pValue>\n"
+"    <Min>0</Min>\n"
+"    <Max>1000000</Max>\n"
+"    <Unit>us</Unit>\n"
+"  </Integer>\n"
+"  <IntReg Name='SimDelayJitterReg'>\n"
+"    <Address>0x24</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"\n"
+"  <Integer Name='SimIncompleteInterval' NameSpace='Custom'>\n"
+"    <ToolTip>Deliver every Nth frame incomplete. 0: never</ToolTip>\n"
+"    <pValue>SimIncompleteIntervalReg</pValue>\n"
+"    <Min>0</Min>\n"
+"    <Max>1000000</Max>\n"
+"  </Integer>\n"
+"  <IntReg Name='SimIncompleteIntervalReg'>\n"
+"    <Address>0x28</Address>\n"
+"    <Length>4</Length>\n"
+"    <AccessMode>RW</AccessMode>\n"
+"    <pPort>Device</pPort>\n"
+"    <Cachable>NoCache</Cachable>\n"
+"    <Sign>Unsigned</Sign>\n"
+"    <Endianess>LittleEndian</Endianess>\n"
+"  </IntReg>\n"
+"\n"
+"  <Port Name='Device' NameSpace='Standard'>\n"
+"    <ToolTip>Register map of the simulated camera</ToolTip>\n"
+"  </Port>\n"
+"\n"
+"</RegisterDescription>\n";
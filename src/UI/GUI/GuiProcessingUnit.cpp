@@ -148,6 +148,11 @@ void GuiProcessingUnit::showImage(cv::Mat img, int panelIndex)
     topFrame->setImage(img, panelIndex);
 }
 
+double GuiProcessingUnit::imageRefreshRate(int panelIndex)
+{
+    return topFrame->imageRefreshRate(panelIndex);
+}
+
 #endif
 
 #ifdef MANAGE_USERS
@@ -86,6 +86,9 @@ public:
 
 #ifdef HAVE_OPENCV
     void showImage(cv::Mat img, int panelIndex = 0);
+
+    /// refresh rate of the image panel, in Hz. 0 if not available
+    double imageRefreshRate(int panelIndex = 0);
 #endif
 
     std::string getStatusBarTxt(int field);
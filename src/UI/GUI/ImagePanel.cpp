@@ -33,6 +33,15 @@
 
 #include "opencv2/imgproc/imgproc.hpp"
 
+#include <wx/display.h>
+
+#include "Poco/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define DEFAULT_REFRESH_RATE 60 ///< Hz, if the monitor does not tell
+
 wxIMPLEMENT_DYNAMIC_CLASS(ImagePanel, wxPanel)
 
 wxDECLARE_EVENT(RedrawEvent, wxCommandEvent);
@@ -40,7 +49,7 @@ wxDEFINE_EVENT(RedrawEvent, wxCommandEvent);
 
 wxBEGIN_EVENT_TABLE(ImagePanel, wxPanel)
 // some useful events
- //EVT_MOTION(ImagePanel::mouseMoved)
+ EVT_MOTION(ImagePanel::mouseMoved)
  EVT_LEFT_DOWN(ImagePanel::mouseDown)
  EVT_LEFT_UP(ImagePanel::mouseReleased)
  /*
@@ -55,6 +64,7 @@ wxBEGIN_EVENT_TABLE(ImagePanel, wxPanel)
 EVT_PAINT(ImagePanel::paintEvent)
 //Size event
 EVT_SIZE(ImagePanel::OnSize)
+EVT_SHOW(ImagePanel::OnShow)
 
 EVT_COMMAND(wxID_ANY, RedrawEvent, ImagePanel::forceRedraw)
 
@@ -70,96 +80,307 @@ wxEND_EVENT_TABLE()
  void ImagePanel::keyReleased(wxKeyEvent& event) {}
  */
 
-ImagePanel::ImagePanel()
+ImagePanel::ImagePanel():
+        _converterRunnable(*this, &ImagePanel::converterLoop)
+{
+    init();
+}
+
+ImagePanel::ImagePanel(wxFrame* parent) :
+        wxPanel(parent),
+        _converterRunnable(*this, &ImagePanel::converterLoop)
+{
+    init();
+}
+
+void ImagePanel::init()
 {
     _width = -1;
     _height = -1;
     _isNewImage = false;
+    _depthScale = 1;
     _captured = false;
     zoomReset();
+
+    _newImage = false;
+    _visible = true;
+    _viewWidth = -1;
+    _viewHeight = -1;
+    _refreshRate = DEFAULT_REFRESH_RATE;
+    _stopping = false;
+
+    _converterThread.setName("ImagePanel converter");
 }
 
-ImagePanel::ImagePanel(wxFrame* parent) :
-        wxPanel(parent)
+ImagePanel::~ImagePanel()
 {
-    ImagePanel();
+    _converterMutex.lock();
+    _stopping = true;
+    _converterCond.signal();
+    _converterMutex.unlock();
+
+    if (_converterThread.isRunning())
+        _converterThread.join();
 }
 
 void ImagePanel::forceRedraw(wxCommandEvent& evt)
 {
+    updateView();
     Refresh();
 }
 
 void ImagePanel::setImage(cv::Mat& imgIn)
 {
-    _imageLock.writeLock();
+    if (!imgIn.empty() && imgIn.channels() != 1 && imgIn.channels() != 3)
+        throw Poco::DataFormatException("ImagePanel::setImage",
+                "unsupported image type");
 
-    if (imgIn.empty())
+    Poco::Mutex::ScopedLock lock(_converterMutex);
+
+    // the previous image is dropped if it was not converted yet
+    _lastImage = imgIn;
+    _newImage = true;
+
+    if (!_converterThread.isRunning())
+        _converterThread.start(_converterRunnable);
+    else
+        _converterCond.signal();
+}
+
+double ImagePanel::refreshRate()
+{
+    Poco::Mutex::ScopedLock lock(_converterMutex);
+    return _refreshRate;
+}
+
+void ImagePanel::updateView()
+{
+    int w, h;
+    GetClientSize(&w, &h);
+
+    int dispIndex = wxDisplay::GetFromWindow(this);
+    int refresh = 0;
+    if (dispIndex != wxNOT_FOUND)
+        refresh = wxDisplay(dispIndex).GetCurrentMode().refresh;
+
+    Poco::Mutex::ScopedLock lock(_converterMutex);
+
+    _refreshRate = refresh ? refresh : DEFAULT_REFRESH_RATE;
+
+    bool visible = IsShownOnScreen();
+    bool wasVisible = _visible;
+    _visible = visible;
+
+    // only used to limit the pyramid depth. The pyramid
+    // does not need to be rebuilt when the panel is resized.
+    _viewWidth = w;
+    _viewHeight = h;
+
+    if (_visible && !wasVisible && _newImage)
+        _converterCond.signal();
+}
+
+void ImagePanel::converterLoop()
+{
+    Poco::Timestamp lastConversion(0);
+
+    _converterMutex.lock();
+
+    while (true)
     {
-        if (_cvImage.empty())
-            return;
+        while (!_stopping && !(_newImage && _visible))
+            _converterCond.wait(_converterMutex);
+
+        if (_stopping)
+            break;
+
+        // do not convert faster than the monitor can display
+        Poco::Timestamp::TimeDiff period =
+                static_cast<Poco::Timestamp::TimeDiff>(1000000 / _refreshRate);
+        Poco::Timestamp::TimeDiff elapsed = lastConversion.elapsed();
+        if (elapsed < period)
+        {
+            // woken up earlier by a newer image or a stop request
+            _converterCond.tryWait(_converterMutex,
+                    static_cast<long>((period - elapsed) / 1000) + 1);
+            continue;
+        }
+
+        cv::Mat image = _lastImage;
+        _lastImage.release(); // the pyramid keeps the reference
+        int minWidth = _viewWidth;
+        int minHeight = _viewHeight;
+        _newImage = false;
+
+        _converterMutex.unlock();
+
+        std::vector<cv::Mat> pyramid;
+        double depthScale = 1;
+        try
+        {
+            buildPyramid(image, pyramid, depthScale, minWidth, minHeight);
+        }
+        catch (cv::Exception&)
+        {
+            // nothing to display. Do not stop the converter.
+            pyramid.clear();
+        }
+        image.release();
 
-        _cvImage = cv::Mat();
+        _imageLock.writeLock();
+        _pyramid.swap(pyramid);
+        _depthScale = depthScale;
         _isNewImage = true;
-        return;
+        _imageLock.unlock();
+
+        pyramid.clear(); // release the previous image out of the lock
+
+        lastConversion.update();
+
+        // do not call refresh directly! since we are in the converter thread...
+        wxCommandEvent* evt = new wxCommandEvent(RedrawEvent,GetId());
+        evt->SetEventObject(this);
+        QueueEvent( evt );
+
+        _converterMutex.lock();
     }
 
-    cv::Mat image;
-    cv::Mat tmpImg; // another temporary image
+    _converterMutex.unlock();
+}
+
+void ImagePanel::buildPyramid(const cv::Mat& imgIn,
+        std::vector<cv::Mat>& pyramid, double& depthScale,
+        int minWidth, int minHeight)
+{
+    pyramid.clear();
+    depthScale = 1;
+
+    if (imgIn.empty())
+        return;
+
+    // the full resolution level is the image itself, without copy
+    pyramid.push_back(imgIn);
 
-    switch (imgIn.channels())
+    // halve the size until the level fits in the panel
+    while (minWidth > 0 && minHeight > 0)
     {
-    case 1:
-        // cvtColor can not handle CV_64F images...
-        if (imgIn.type()==CV_64F)
-        {
-            double min,max;
-            cv::minMaxLoc(imgIn,&min,&max);
+        cv::Mat next;
 
-            imgIn.convertTo(
-                    tmpImg,      // output image
-                    CV_8U,       // depth
-                    255.0/max ); // scale factor
-        }
-        else
         {
-            tmpImg = imgIn;
+            const cv::Mat& last = pyramid.back();
+
+            if ((last.cols <= minWidth && last.rows <= minHeight)
+                    || last.cols < 2 || last.rows < 2)
+                break;
+
+            cv::resize(last, next,
+                    cv::Size((last.cols + 1) / 2, (last.rows + 1) / 2),
+                    0, 0, cv::INTER_AREA);
         }
-        cv::cvtColor(tmpImg,image,cv::COLOR_GRAY2RGB);
-            break;
-    case 3:
-        image = imgIn;
-        break;
-    default:
-        throw Poco::DataFormatException("ImagePanel::setImage",
-                "unsupported image type");
+
+        pyramid.push_back(next);
     }
 
-    if (image.type()!=CV_8UC3)
+    if (imgIn.depth() != CV_8U)
     {
-        double min,max;
-        cv::minMaxLoc(image,&min,&max);
+        // on the full resolution level: the INTER_AREA averaging of
+        // the coarser levels would lower an isolated maximum
+        double min, max;
+        cv::minMaxLoc(pyramid.front().reshape(1), &min, &max);
 
-        image.convertTo(
-                tmpImg,      // output image
-                CV_8UC3,       // depth
-                255.0/max ); // scale factor
+        if (max > 0)
+            depthScale = 255.0 / max;
     }
-    else
+}
+
+void ImagePanel::toDisplayImage(const cv::Mat& imgIn, cv::Mat& imgOut,
+        double depthScale)
+{
+    cv::Mat image = imgIn;
+
+    // cvtColor can only handle 8-bit images
+    if (image.depth() != CV_8U)
+        imgIn.convertTo(image, CV_8U, depthScale);
+
+    switch (image.channels())
     {
-        tmpImg = image.clone();
+    case 1:
+        cv::cvtColor(image,imgOut,cv::COLOR_GRAY2RGB);
+        break;
+    case 3:
+        cv::cvtColor(image,imgOut,cv::COLOR_BGR2RGB);
+        break;
+    default:
+        throw Poco::DataFormatException("ImagePanel::toDisplayImage",
+                "unsupported image type");
     }
+}
 
-    cv::cvtColor(tmpImg,_cvImage,cv::COLOR_BGR2RGB);
+wxBitmap ImagePanel::renderViewport(int width, int height)
+{
+    const double fullW = _pyramid[0].cols;
+    const double fullH = _pyramid[0].rows;
 
-    _isNewImage = true;
+    // same geometry as the zoom: the image center is displayed
+    // at (_zoomW, _zoomH) relative to the panel size
+    double ratio = _zoomFactor * std::min(width / fullW, height / fullH);
+    double centerW = _zoomW * width;
+    double centerH = _zoomH * height;
 
-    _imageLock.unlock();
+    // visible part of the full resolution image
+    double x0 = std::max(0.0, fullW/2 - centerW/ratio);
+    double y0 = std::max(0.0, fullH/2 - centerH/ratio);
+    double x1 = std::min(fullW, fullW/2 + (width - centerW)/ratio);
+    double y1 = std::min(fullH, fullH/2 + (height - centerH)/ratio);
+
+    cv::Mat canvas(height, width, CV_8UC3, cv::Scalar::all(0));
+
+    if (x1 > x0 && y1 > y0)
+    {
+        // coarsest level still giving one pixel per screen pixel
+        size_t level = 0;
+        while (level + 1 < _pyramid.size()
+                && fullW / _pyramid[level + 1].cols <= 1 / ratio
+                && fullH / _pyramid[level + 1].rows <= 1 / ratio)
+            level++;
+
+        const cv::Mat& img = _pyramid[level];
+        double fx = fullW / img.cols;
+        double fy = fullH / img.rows;
+
+        cv::Rect roi;
+        roi.x = static_cast<int>(std::floor(x0 / fx));
+        roi.y = static_cast<int>(std::floor(y0 / fy));
+        roi.width = std::min(img.cols,
+                static_cast<int>(std::ceil(x1 / fx))) - roi.x;
+        roi.height = std::min(img.rows,
+                static_cast<int>(std::ceil(y1 / fy))) - roi.y;
+
+        // position of the roi on the panel
+        cv::Rect dest;
+        dest.x = cvRound((roi.x * fx - fullW/2) * ratio + centerW);
+        dest.y = cvRound((roi.y * fy - fullH/2) * ratio + centerH);
+        dest.width = std::max(1, cvRound(roi.width * fx * ratio));
+        dest.height = std::max(1, cvRound(roi.height * fy * ratio));
+
+        cv::Rect visible = dest & cv::Rect(0, 0, width, height);
+
+        if (roi.width > 0 && roi.height > 0 && visible.area() > 0)
+        {
+            // only the viewport is converted
+            cv::Mat rgb, scaled;
+            toDisplayImage(img(roi), rgb, _depthScale);
+
+            cv::resize(rgb, scaled, dest.size(), 0, 0,
+                    (dest.width < roi.width) ? cv::INTER_AREA : cv::INTER_NEAREST);
+
+            scaled(visible - dest.tl()).copyTo(canvas(visible));
+        }
+    }
 
-    // do not call refresh directly! since we can be in a worker thread...
-    wxCommandEvent* evt = new wxCommandEvent(RedrawEvent,GetId());
-    evt->SetEventObject(this);
-    QueueEvent( evt );
+    // the bitmap copies the data
+    wxImage image(width, height, canvas.data, true);
+    return wxBitmap(image);
 }
 
 /*
@@ -169,6 +390,8 @@ void ImagePanel::setImage(cv::Mat& imgIn)
  */
 void ImagePanel::paintEvent(wxPaintEvent & evt)
 {
+    updateView();
+
     // depending on your system you may need to look at double-buffered dcs
     wxPaintDC dc(this);
     render(dc);
@@ -181,78 +404,44 @@ void ImagePanel::paintEvent(wxPaintEvent & evt)
  */
 void ImagePanel::render(wxDC&  dc)
 {
-    if (_cvImage.empty())
-        return;
+    // write lock: the rendering state (_isNewImage, _resized,
+    // _imageSize, zoom) is updated here too
+    _imageLock.writeLock();
 
-    _imageLock.readLock();
+    if (_pyramid.empty())
+    {
+        _imageLock.unlock();
+        return;
+    }
 
     int neww, newh;
     dc.GetSize( &neww, &newh );
 
+    // the cached bitmap is reused until the image, the size or the zoom change
     if( neww != _width || newh != _height || _isNewImage || _zoomChanged )
     {
-    	if (_isNewImage)
-    		zoomReset();
-
-        wxImage image(_cvImage.cols,_cvImage.rows,_cvImage.data,true);
-
-        float ratio;
-        bool filled = true;
-
-        // check which is the limiting dimension: w or h
-        if (float(_cvImage.cols)/float(neww) < float(_cvImage.rows)/float(newh))
+        // keep the zoom while the image size does not change
+        if (_isNewImage && _pyramid[0].size() != _imageSize)
         {
-        	// w is limiting
-        	ratio = _zoomFactor * float(newh)/float(_cvImage.rows);
-        	if (float(_cvImage.cols)*ratio < neww)
-        		filled = false;
+            zoomReset();
+            _imageSize = _pyramid[0].size();
         }
-        else
+
+        try
         {
-        	// h is limiting
-        	ratio = _zoomFactor * float(neww)/float(_cvImage.cols);
-        	if (float(_cvImage.rows)*ratio < newh)
-        		filled = false;
+            _resized = renderViewport(neww, newh);
         }
-
-
-    	float newCenterW = _zoomW * neww;
-    	float newCenterH = _zoomH * newh;
-
-        if (filled)
+        catch (cv::Exception&)
         {
-            _resized = wxBitmap(
-        			image
-						.Size(  wxSize(neww/ratio , newh/ratio) ,
-								wxPoint( -(float(_cvImage.cols)/2 - newCenterW/ratio),
-										 -(float(_cvImage.rows)/2 - newCenterH/ratio) ) )
-						.Scale( neww, newh /*, wxIMAGE_QUALITY_HIGH*/ )
-								);
-
+            _resized = wxBitmap();
         }
-		else
-		{
-        	_resized = wxBitmap(
-        			image
-						.Scale( _cvImage.cols*ratio,_cvImage.rows*ratio /*, wxIMAGE_QUALITY_HIGH*/ )
-						.Size(  wxSize(neww , newh) ,
-								wxPoint( -(float(_cvImage.cols)/2*ratio - newCenterW),
-										 -(float(_cvImage.rows)/2*ratio - newCenterH) ) ,
-								0, 0, 0   )
-								);
-		}
-
-
-        // _resized = wxBitmap( image.Scale( neww, newh /*, wxIMAGE_QUALITY_HIGH*/ ) );
 
         _width = neww;
         _height = newh;
-        dc.DrawBitmap( _resized, 0, 0, false );
     }
-    else
-    {
+
+    if (_resized.IsOk())
         dc.DrawBitmap( _resized, 0, 0, false );
-    }
 
     _zoomChanged = false;
     _isNewImage = false;
@@ -265,11 +454,18 @@ void ImagePanel::render(wxDC&  dc)
  * So when the user resizes the image panel the image should be resized too.
  */
 void ImagePanel::OnSize(wxSizeEvent& event){
+    updateView();
     Refresh();
     //skip the event.
     event.Skip();
 }
 
+void ImagePanel::OnShow(wxShowEvent& event)
+{
+    updateView();
+    event.Skip();
+}
+
 void ImagePanel::zoomReset()
 {
 	_zoomFactor = 1;
@@ -311,25 +507,25 @@ void ImagePanel::decZoom(float x, float y)
 	_zoomChanged = true;
 }
 
-//void ImagePanel::mouseMoved(wxMouseEvent& event)
-//{
-//	if (_captured)
-//	{
-//		long x,y;
-//		event.GetPosition(&x,&y);
-//
-//		if ((_lastX-x) || (_lastY-y))
-//		{
-//			_zoomChanged = true;
-//			_zoomW += float(x-_lastX)/_width;
-//			_zoomH += float(y-_lastY)/_height;
-//			_lastX=x;
-//			_lastY=y;
-//			Refresh();
-//		}
-//
-//	}
-//}
+void ImagePanel::mouseMoved(wxMouseEvent& event)
+{
+	if (_captured)
+	{
+		long x,y;
+		event.GetPosition(&x,&y);
+
+		if ((_lastX-x) || (_lastY-y))
+		{
+			_zoomChanged = true;
+			_zoomW += float(x-_lastX)/_width;
+			_zoomH += float(y-_lastY)/_height;
+			_lastX=x;
+			_lastY=y;
+			Refresh();
+		}
+
+	}
+}
 
 
 void ImagePanel::mouseDown(wxMouseEvent& event)
@@ -44,22 +44,52 @@
 #include "opencv2/core/core.hpp"
 
 #include "Poco/RWLock.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Timestamp.h"
+
+#include <vector>
 
 /**
  * ImagePanel
  *
  * class to show images in a custom panel
+ *
+ * setImage() only stores the image: a converter thread builds a
+ * pyramid of downsampled images from the latest image only (the
+ * intermediate images are skipped), at most at the monitor refresh
+ * rate, and not while the panel is hidden.
+ *
+ * The rendering only converts the visible part of the pyramid level
+ * matching the zoom, and the resulting bitmap is cached until the
+ * image, the zoom or the panel size change.
  */
 class ImagePanel : public wxPanel
 {
 public:
     ImagePanel(wxFrame* parent);
     ImagePanel();
-    virtual ~ImagePanel() { }
 
-    /// set a new image to be displayed
+    /// stop the converter thread
+    virtual ~ImagePanel();
+
+    /**
+     * Set a new image to be displayed
+     *
+     * Can be called from any thread. Does not wait for the conversion.
+     * The image data shall not be modified by the caller afterwards.
+     */
     void setImage(cv::Mat& imgIn);
 
+    /**
+     * Monitor refresh rate, in Hz
+     *
+     * The images given to setImage faster than that are not displayed.
+     */
+    double refreshRate();
+
     /// reset the zoom
     void zoomReset();
 
@@ -72,11 +102,12 @@ public:
 private:
     void paintEvent(wxPaintEvent & evt);
     void OnSize(wxSizeEvent& event);
+    void OnShow(wxShowEvent& event);
     void render(wxDC& dc);
     void forceRedraw(wxCommandEvent& evt);
 
     // some useful events
-     // void mouseMoved(wxMouseEvent& event);
+     void mouseMoved(wxMouseEvent& event);
      void mouseDown(wxMouseEvent& event);
      void mouseReleased(wxMouseEvent& event);
      /*
@@ -87,7 +118,43 @@ private:
      void keyReleased(wxKeyEvent& event);
      */
 
-    cv::Mat _cvImage;
+    /// Init the members. Called by the constructors
+    void init();
+
+    /**
+     * Update the visibility and the size used by the converter
+     *
+     * To be called from the GUI thread.
+     */
+    void updateView();
+
+    /// Converter thread main loop
+    void converterLoop();
+
+    /**
+     * Build the pyramid of the image: the image itself, then halved
+     * sizes until the level fits in the given size.
+     *
+     * @param depthScale scale factor to convert the levels to 8-bit
+     */
+    static void buildPyramid(const cv::Mat& imgIn,
+            std::vector<cv::Mat>& pyramid, double& depthScale,
+            int minWidth, int minHeight);
+
+    /// Convert the image to a 8-bit RGB image
+    static void toDisplayImage(const cv::Mat& imgIn, cv::Mat& imgOut,
+            double depthScale);
+
+    /**
+     * Render the visible part of the image in a bitmap of the given size
+     *
+     * To be called with _imageLock held, and a non empty pyramid.
+     */
+    wxBitmap renderViewport(int width, int height);
+
+    std::vector<cv::Mat> _pyramid; ///< full resolution image, then halved sizes
+    double _depthScale; ///< scale factor to convert the pyramid levels to 8-bit
+    cv::Size _imageSize; ///< size of the last rendered image
     wxBitmap _resized;
     int _width, _height;
     bool _isNewImage;
@@ -99,7 +166,21 @@ private:
     bool _captured;
     long _lastX,_lastY;
 
-    Poco::RWLock _imageLock;
+    Poco::RWLock _imageLock; ///< lock the pyramid and the rendering state
+
+    /// Converter thread data
+    ///@{
+    cv::Mat _lastImage; ///< last image given to setImage
+    bool _newImage; ///< _lastImage has to be converted
+    bool _visible; ///< the panel is shown on screen
+    int _viewWidth, _viewHeight; ///< panel size
+    double _refreshRate; ///< monitor refresh rate, in Hz
+    bool _stopping;
+    Poco::Mutex _converterMutex; ///< protect the converter thread data
+    Poco::Condition _converterCond; ///< new image, view change or stop request
+    Poco::RunnableAdapter<ImagePanel> _converterRunnable;
+    Poco::Thread _converterThread;
+    ///@}
 
     wxDECLARE_EVENT_TABLE();
     wxDECLARE_DYNAMIC_CLASS(ImagePanel);
@@ -275,6 +275,14 @@ std::string TopFrame::getTextCtrlTxt()
 }
 
 #ifdef HAVE_OPENCV
+double TopFrame::imageRefreshRate(int pos)
+{
+    if (pos < imgPanels.size())
+        return imgPanels[pos]->refreshRate();
+    else
+        return 0;
+}
+
 void TopFrame::setImage(cv::Mat img, int pos)
 {
 //    _waitImageOk = true;
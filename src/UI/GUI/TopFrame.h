@@ -68,6 +68,13 @@ public:
      * @param index image panel index in case of multiple image panels
      */
     void setImage(cv::Mat img, int pos = 0);
+
+    /**
+     * Refresh rate of an image panel, in Hz
+     *
+     * @return 0 if the requested image panel is not available
+     */
+    double imageRefreshRate(int pos = 0);
 #endif
 
     /**
@@ -172,6 +172,8 @@ void PythonManager::uninitialize()
     }
     _addedVarStore.clear();
 
+    clearScriptCache();
+
     Py_Finalize();
 
 #ifdef MANAGE_USERS
@@ -309,6 +311,8 @@ void PythonManager::runScript(Poco::Util::Application& app, Poco::Path scriptFil
     bool withRights = Poco::Util::Application::instance()
             .getSubsystem<UserManager>()
             .isFolderAuthorized(Poco::Path(scriptFile).makeParent(), pythonUser);
+#else
+    bool withRights = true;
 #endif
 
     ScopedGIL GIL;
@@ -316,41 +320,31 @@ void PythonManager::runScript(Poco::Util::Application& app, Poco::Path scriptFil
     PyObject *py_main, *py_global, *py_local;
     py_main = PyImport_AddModule("__main__");
     py_global = PyModule_GetDict(py_main);
+
+    // the caller deals with the NoPermissionException (e.g. login prompt,
+    // then retry) see PythonManager::setUser
+    PyObject* compiledStr = compiledScript(scriptFile, withRights);
+
     py_local = PyDict_New();
 
     PyObject* exitFct = PySys_GetObject(const_cast<char*>("exit"));
     PyDict_SetItemString(py_global, "exit", exitFct);
     PyObject* pyScript = PyString_FromString(scriptFile.toString().c_str());
     PyDict_SetItemString(py_local, "__file__", pyScript);
+    Py_DECREF(pyScript);
 
-    // transfer the script content into a string
-    std::ifstream ifs(scriptFile.toString().c_str());
-
-    ifs.seekg(0, std::ios::end);
-    std::string scriptBuf;
-    scriptBuf.reserve(ifs.tellg());
-    ifs.seekg(0, std::ios::beg);
-
-    scriptBuf.assign((std::istreambuf_iterator<char>(ifs)),
-                std::istreambuf_iterator<char>());
-
-#ifdef MANAGE_USERS
-    if (!withRights &&
-        !Poco::Util::Application::instance()
-        .getSubsystem<UserManager>()
-        .isScriptAuthorized(scriptFile.getFileName(), scriptBuf, pythonUser))
+    PyObject* result = NULL;
+    if (compiledStr != NULL)
     {
-        // the caller deals with the exception (e.g. login prompt, then retry)
-        // see PythonManager::setUser
-        throw Poco::NoPermissionException("PythonManager::runScript");
+        result = PyEval_EvalCode(
+                reinterpret_cast<PyCodeObject*>(compiledStr), py_global, py_local);
+        Py_DECREF(compiledStr);
     }
-#endif
 
-    PyCodeObject* compiledStr = reinterpret_cast<PyCodeObject*>(
-            Py_CompileString(scriptBuf.c_str(), scriptFile.getFileName().c_str(), Py_file_input) );
+    Py_DECREF(py_local);
+    Py_XDECREF(result);
 
-    // launch the string using a python command
-    if ((compiledStr==NULL) || (PyEval_EvalCode(compiledStr, py_global, py_local)==NULL))
+    if (result == NULL)
     {
         // check for system exit exception
         if (PyErr_Occurred())
@@ -390,6 +384,93 @@ void PythonManager::runScript(Poco::Util::Application& app, Poco::Path scriptFil
     poco_information(logger(), "python script gracefully executed");
 }
 
+PyObject* PythonManager::compiledScript(Poco::Path scriptFile, bool withRights)
+{
+    std::string key(scriptFile.toString());
+
+    Poco::File file(scriptFile);
+    Poco::Timestamp modified = file.getLastModified();
+    Poco::File::FileSize size = file.getSize();
+
+    std::map<std::string, CompiledScript>::iterator it = scriptCache.find(key);
+
+    if (it != scriptCache.end()
+            && (it->second.modified != modified || it->second.size != size))
+    {
+        poco_information(logger(), key + " changed since its last run");
+        Py_XDECREF(it->second.code);
+        scriptCache.erase(it);
+        it = scriptCache.end();
+    }
+
+#ifdef MANAGE_USERS
+    size_t uid = (*pythonUser)->uid;
+
+    if (it != scriptCache.end() && !withRights)
+        withRights = (it->second.authorizedUids.count(uid) > 0);
+#endif
+
+    if (it != scriptCache.end() && withRights)
+    {
+        Py_INCREF(it->second.code);
+        return it->second.code;
+    }
+
+    // transfer the script content into a string
+    std::ifstream ifs(key.c_str());
+
+    ifs.seekg(0, std::ios::end);
+    std::string scriptBuf;
+    scriptBuf.reserve(ifs.tellg());
+    ifs.seekg(0, std::ios::beg);
+
+    scriptBuf.assign((std::istreambuf_iterator<char>(ifs)),
+                std::istreambuf_iterator<char>());
+
+#ifdef MANAGE_USERS
+    if (!withRights &&
+        !Poco::Util::Application::instance()
+        .getSubsystem<UserManager>()
+        .isScriptAuthorized(scriptFile.getFileName(), scriptBuf, pythonUser))
+    {
+        throw Poco::NoPermissionException("PythonManager::runScript");
+    }
+#endif
+
+    if (it == scriptCache.end())
+    {
+        PyObject* code = Py_CompileString(scriptBuf.c_str(),
+                scriptFile.getFileName().c_str(), Py_file_input);
+
+        // compilation errors are not cached
+        if (code == NULL)
+            return NULL;
+
+        CompiledScript entry;
+        entry.modified = modified;
+        entry.size = size;
+        entry.code = code;
+
+        it = scriptCache.insert(std::make_pair(key, entry)).first;
+    }
+
+#ifdef MANAGE_USERS
+    it->second.authorizedUids.insert(uid);
+#endif
+
+    Py_INCREF(it->second.code);
+    return it->second.code;
+}
+
+void PythonManager::clearScriptCache()
+{
+    for (std::map<std::string, CompiledScript>::iterator it = scriptCache.begin(),
+            ite = scriptCache.end(); it != ite; it++)
+        Py_XDECREF(it->second.code);
+
+    scriptCache.clear();
+}
+
 void PythonManager::runConsole()
 {
 #ifdef MANAGE_USERS
@@ -452,7 +533,13 @@ void PythonManager::runConsole()
             Py_CompileString(consoleScript, "console", Py_file_input) );
 
     // launch the string using a python command
-    if ((compiledStr==NULL) || (PyEval_EvalCode(compiledStr, py_global, py_local)==NULL))
+    PyObject* result = compiledStr ?
+            PyEval_EvalCode(compiledStr, py_global, py_local) : NULL;
+
+    Py_XDECREF(reinterpret_cast<PyObject*>(compiledStr));
+    Py_DECREF(py_local);
+
+    if (result == NULL)
     {
         // check for system exit exception
         if (PyErr_Occurred())
@@ -487,6 +574,8 @@ void PythonManager::runConsole()
             throw e;
         }
     }
+
+    Py_XDECREF(result);
 }
 
 void PythonManager::checkInit()
@@ -38,11 +38,18 @@
 #include "Poco/Util/Option.h"
 #include "Poco/Util/OptionSet.h"
 
+#include "Poco/Timestamp.h"
+#include "Poco/File.h"
+
 #ifdef MANAGE_USERS
 #   include "core/User.h"
 #endif
 
+#include <map>
+#include <set>
+
 class PyThreadKeeper;
+struct _object; // PyObject, see Python.h
 
 /**
  * PythonManager
@@ -159,6 +166,38 @@ private:
      */
     void runScript(Poco::Util::Application& app, Poco::Path scriptFile);
 
+    /**
+     * Get the compiled code of a script, from the cache if possible
+     *
+     * The cache entries are keyed by the script path, and invalidated
+     * when the file modification time or size change. The result
+     * of the authorization check is cached with the code.
+     *
+     * To be called with the GIL held, that also protects the cache.
+     *
+     * @param scriptFile absolute path of the script
+     * @param withRights the script folder is authorized: no check
+     * @return new reference to the code object, or NULL if the
+     * compilation failed (python error set)
+     * @throw Poco::NoPermissionException if the script is not authorized
+     */
+    _object* compiledScript(Poco::Path scriptFile, bool withRights);
+
+    /// Release the cached code objects. To be called with the GIL held.
+    void clearScriptCache();
+
+    /// compiled script cache entry
+    struct CompiledScript
+    {
+        Poco::Timestamp modified; ///< file modification time
+        Poco::File::FileSize size; ///< file size
+        _object* code; ///< compiled code (owned reference)
+        std::set<size_t> authorizedUids; ///< users for which the script was authorized
+    };
+
+    /// compiled scripts, by absolute path
+    std::map<std::string, CompiledScript> scriptCache;
+
     /*
      * Run the python console
      */
@@ -0,0 +1,413 @@
+/**
+ * @file	src/UI/python/PythonDataArray.cpp
+ * @date	oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+Copyright (c) 2026 Ph. Renaud-Goud / Opticalp
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifdef HAVE_PYTHON27
+
+#include "PythonDataArray.h"
+
+#include "core/DataSource.h"
+
+#include "Poco/Platform.h"
+#include "Poco/Types.h"
+
+#include <cstring>
+
+#ifdef POCO_ARCH_LITTLE_ENDIAN
+#define DATAARRAY_BYTE_ORDER '<'
+#else
+#define DATAARRAY_BYTE_ORDER '>'
+#endif
+
+extern "C" void pyDataArrayDealloc(DataArrayMembers* self)
+{
+    delete self->shape;
+    delete self->strides;
+    delete self->copy;
+#ifdef HAVE_OPENCV
+    delete self->image;
+#endif
+
+    self->ob_type->tp_free((PyObject*) self); // free the object’s memory
+}
+
+extern "C" PyObject* pyDataArrayNew(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    DataArrayMembers* self;
+
+    self = (DataArrayMembers*) type->tp_alloc(type, 0);
+    if (self != NULL)
+      {
+        self->data = NULL;
+        self->itemSize = 1;
+        strcpy(self->format, "B");
+        strcpy(self->typeStr, "|u1");
+        self->shape = new std::vector<Py_ssize_t>;
+        self->strides = new std::vector<Py_ssize_t>;
+        self->copy = NULL;
+#ifdef HAVE_OPENCV
+        self->image = NULL;
+#endif
+      }
+
+    return (PyObject *) self;
+}
+
+extern "C" int pyDataArrayInit(DataArrayMembers* self, PyObject *args, PyObject *kwds)
+{
+    PyErr_SetString(PyExc_NotImplementedError, "__init__ is not implemented");
+    return -1;
+}
+
+/**
+ * Build a tuple of integers from a vector
+ */
+PyObject* dataArrayTuple(const std::vector<Py_ssize_t>& values)
+{
+    PyObject* tuple = PyTuple_New(values.size());
+    if (tuple == NULL)
+        return NULL;
+
+    for (size_t index = 0; index < values.size(); index++)
+        PyTuple_SET_ITEM(tuple, index, PyInt_FromSsize_t(values[index]));
+
+    return tuple;
+}
+
+extern "C" PyObject* pyDataArrayShape(DataArrayMembers* self, void* closure)
+{
+    return dataArrayTuple(*self->shape);
+}
+
+extern "C" PyObject* pyDataArrayFormat(DataArrayMembers* self, void* closure)
+{
+    return PyString_FromString(self->format);
+}
+
+extern "C" PyObject* pyDataArrayInterface(DataArrayMembers* self, void* closure)
+{
+    // the "N" format steals the references
+    return Py_BuildValue("{s:N,s:s,s:(NO),s:N,s:i}",
+            "shape", dataArrayTuple(*self->shape),
+            "typestr", self->typeStr,
+            "data", PyLong_FromVoidPtr(self->data), Py_True, // read-only
+            "strides", dataArrayTuple(*self->strides),
+            "version", 3 );
+}
+
+extern "C" PyObject* pyDataArrayToList(DataArrayMembers* self)
+{
+    if (self->shape->size() != 1)
+    {
+        PyErr_SetString(PyExc_NotImplementedError,
+                "tolist is only implemented for 1-D arrays");
+        return NULL;
+    }
+
+    Py_ssize_t count = self->shape->at(0);
+    Py_ssize_t stride = self->strides->at(0);
+
+    PyObject* list = PyList_New(count);
+    if (list == NULL)
+        return NULL;
+
+    for (Py_ssize_t index = 0; index < count; index++)
+    {
+        char* item = self->data + index * stride;
+        PyObject* pyItem;
+
+        switch (self->format[0])
+        {
+        case 'B':
+            pyItem = PyInt_FromLong(*reinterpret_cast<Poco::UInt8*>(item));
+            break;
+        case 'b':
+            pyItem = PyInt_FromLong(*reinterpret_cast<Poco::Int8*>(item));
+            break;
+        case 'H':
+            pyItem = PyInt_FromLong(*reinterpret_cast<Poco::UInt16*>(item));
+            break;
+        case 'h':
+            pyItem = PyInt_FromLong(*reinterpret_cast<Poco::Int16*>(item));
+            break;
+        case 'i':
+            pyItem = PyInt_FromLong(*reinterpret_cast<Poco::Int32*>(item));
+            break;
+        case 'I':
+            pyItem = PyInt_FromSize_t(*reinterpret_cast<Poco::UInt32*>(item));
+            break;
+        case 'q':
+            pyItem = PyLong_FromLongLong(*reinterpret_cast<Poco::Int64*>(item));
+            break;
+        case 'Q':
+            pyItem = PyLong_FromUnsignedLongLong(*reinterpret_cast<Poco::UInt64*>(item));
+            break;
+        case 'f':
+            pyItem = PyFloat_FromDouble(*reinterpret_cast<float*>(item));
+            break;
+        case 'd':
+        default:
+            pyItem = PyFloat_FromDouble(*reinterpret_cast<double*>(item));
+            break;
+        }
+
+        if (pyItem == NULL)
+        {
+            Py_DECREF(list);
+            return NULL;
+        }
+
+        PyList_SET_ITEM(list, index, pyItem); // steals the reference
+    }
+
+    return list;
+}
+
+extern "C" int pyDataArrayGetBuffer(DataArrayMembers* self, Py_buffer* view, int flags)
+{
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE)
+    {
+        PyErr_SetString(PyExc_BufferError, "DataArray is read-only");
+        return -1;
+    }
+
+    // total length, and C-contiguity check
+    Py_ssize_t len = self->itemSize;
+    bool contiguous = true;
+    for (size_t index = self->shape->size(); index-- > 0; )
+    {
+        if ((*self->strides)[index] != len)
+            contiguous = false;
+
+        len *= (*self->shape)[index];
+    }
+
+    if (!contiguous && (flags & PyBUF_STRIDES) != PyBUF_STRIDES)
+    {
+        PyErr_SetString(PyExc_BufferError,
+                "DataArray is not contiguous, the strides are needed");
+        return -1;
+    }
+
+    view->obj = reinterpret_cast<PyObject*>(self);
+    Py_INCREF(self); // released by PyBuffer_Release
+    view->buf = self->data;
+    view->len = len;
+    view->readonly = 1;
+    view->itemsize = self->itemSize;
+    view->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT) ? self->format : NULL;
+    view->ndim = static_cast<int>(self->shape->size());
+    view->shape = ((flags & PyBUF_ND) == PyBUF_ND) ? &(*self->shape)[0] : NULL;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? &(*self->strides)[0] : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+
+    return 0;
+}
+
+/**
+ * Allocate a new python DataArray
+ */
+DataArrayMembers* newDataArray()
+{
+    if (PyType_Ready(&PythonDataArray) < 0)
+    {
+        PyErr_SetString(PyExc_ImportError,
+                "Not able to create the DataArray Type");
+        return NULL;
+    }
+
+    return reinterpret_cast<DataArrayMembers*>(
+            pyDataArrayNew(&PythonDataArray, NULL, NULL) );
+}
+
+/**
+ * Set the element format
+ *
+ * @param format struct module format character
+ * @param kind numpy type kind: 'i', 'u' or 'f'
+ */
+void setDataArrayFormat(DataArrayMembers* self, char format, char kind, size_t itemSize)
+{
+    self->itemSize = itemSize;
+
+    self->format[0] = format;
+    self->format[1] = 0;
+
+    self->typeStr[0] = (itemSize == 1) ? '|' : DATAARRAY_BYTE_ORDER;
+    self->typeStr[1] = kind;
+    self->typeStr[2] = static_cast<char>('0' + itemSize);
+    self->typeStr[3] = 0;
+}
+
+/**
+ * Create a DataArray from a copy of a numeric vector
+ *
+ * One copy of the whole vector, since the source
+ * vector can be overwritten in place.
+ */
+template<typename T>
+PyObject* vectorDataArray(std::vector<T>* pData, char format, char kind)
+{
+    DataArrayMembers* self = newDataArray();
+    if (self == NULL)
+        return NULL;
+
+    size_t bytes = pData->size() * sizeof(T);
+
+    // at least one byte, to get a valid data pointer
+    self->copy = new std::vector<char>(bytes ? bytes : 1);
+    self->data = &(*self->copy)[0];
+    if (bytes)
+        memcpy(self->data, &(*pData)[0], bytes);
+
+    setDataArrayFormat(self, format, kind, sizeof(T));
+    self->shape->push_back(pData->size());
+    self->strides->push_back(sizeof(T));
+
+    return reinterpret_cast<PyObject*>(self);
+}
+
+#ifdef HAVE_OPENCV
+PyObject* dataArrayFromImage(const cv::Mat& image, bool adopt)
+{
+    char format, kind;
+
+    switch (image.depth())
+    {
+    case CV_8U:
+        format = 'B'; kind = 'u';
+        break;
+    case CV_8S:
+        format = 'b'; kind = 'i';
+        break;
+    case CV_16U:
+        format = 'H'; kind = 'u';
+        break;
+    case CV_16S:
+        format = 'h'; kind = 'i';
+        break;
+    case CV_32S:
+        format = 'i'; kind = 'i';
+        break;
+    case CV_32F:
+        format = 'f'; kind = 'f';
+        break;
+    case CV_64F:
+        format = 'd'; kind = 'f';
+        break;
+    default:
+        PyErr_SetString(PyExc_NotImplementedError,
+                "DataArray: unsupported image depth");
+        return NULL;
+    }
+
+    DataArrayMembers* self = newDataArray();
+    if (self == NULL)
+        return NULL;
+
+    setDataArrayFormat(self, format, kind, image.elemSize1());
+
+    if (image.empty())
+    {
+        self->copy = new std::vector<char>(1);
+        self->data = &(*self->copy)[0];
+        self->shape->push_back(0);
+        self->strides->push_back(self->itemSize);
+        return reinterpret_cast<PyObject*>(self);
+    }
+
+    // the header copy keeps the adopted image data alive
+    if (adopt)
+        self->image = new cv::Mat(image);
+    else
+        self->image = new cv::Mat(image.clone());
+
+    const cv::Mat& stored = *self->image;
+    self->data = reinterpret_cast<char*>(stored.data);
+
+    // the clone is continuous: take the strides from the stored image
+    for (int dim = 0; dim < stored.dims; dim++)
+    {
+        self->shape->push_back(stored.size[dim]);
+        self->strides->push_back(stored.step[dim]);
+    }
+
+    if (stored.channels() > 1)
+    {
+        self->shape->push_back(stored.channels());
+        self->strides->push_back(self->itemSize);
+    }
+
+    return reinterpret_cast<PyObject*>(self);
+}
+#endif /* HAVE_OPENCV */
+
+PyObject* dataArrayFromSource(DataSource* source)
+{
+    int dataType = source->dataType();
+
+    if (DataItem::isVector(dataType))
+    {
+        switch (DataItem::noContainerDataType(dataType))
+        {
+        case DataItem::typeInt32:
+            return vectorDataArray(
+                    source->getData< std::vector<Poco::Int32> >(), 'i', 'i');
+        case DataItem::typeUInt32:
+            return vectorDataArray(
+                    source->getData< std::vector<Poco::UInt32> >(), 'I', 'u');
+        case DataItem::typeInt64:
+            return vectorDataArray(
+                    source->getData< std::vector<Poco::Int64> >(), 'q', 'i');
+        case DataItem::typeUInt64:
+            return vectorDataArray(
+                    source->getData< std::vector<Poco::UInt64> >(), 'Q', 'u');
+        case DataItem::typeFloat:
+            return vectorDataArray(
+                    source->getData< std::vector<float> >(), 'f', 'f');
+        case DataItem::typeDblFloat:
+            return vectorDataArray(
+                    source->getData< std::vector<double> >(), 'd', 'f');
+        default:
+            break;
+        }
+    }
+#ifdef HAVE_OPENCV
+    else if (dataType == DataItem::typeCvMat)
+    {
+        return dataArrayFromImage(*source->getData<cv::Mat>());
+    }
+#endif
+
+    PyErr_SetString(PyExc_NotImplementedError,
+            "getDataArray is only implemented for "
+            "the numeric vectors and the images");
+    return NULL;
+}
+
+#endif /* HAVE_PYTHON27 */
@@ -0,0 +1,243 @@
+/**
+ * Definition of the DataArray python class
+ * 
+ * @file	src/UI/python/PythonDataArray.h
+ * @date	oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+Copyright (c) 2026 Ph. Renaud-Goud / Opticalp
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#ifndef SRC_PYTHONDATAARRAY_H_
+#define SRC_PYTHONDATAARRAY_H_
+
+#ifdef HAVE_PYTHON27
+
+#include "PythonAPI.h"
+#include "structmember.h"
+
+#include <vector>
+
+#ifdef HAVE_OPENCV
+#include "opencv2/core/core.hpp"
+#endif
+
+class DataSource;
+
+// -----------------------------------------------------------------------
+// Variables
+// -----------------------------------------------------------------------
+
+/**
+ * member variables for the python DataArray class
+ *
+ * The DataArray exposes numeric data through the buffer protocol and
+ * the numpy array interface, e.g. to be used via numpy.asarray()
+ * without per-element conversion.
+ *
+ * The data are copied at once, since they can be overwritten in place
+ * by their source (numeric vectors, recycled or lent image buffers)
+ * after being released: the python side never sees them change. An
+ * image that is private to the caller (e.g. queued by a subscription)
+ * is adopted without copy.
+ */
+typedef struct
+{
+    PyObject_HEAD ///< a refcount and a pointer to a type object (convenience python/C API macro)
+    char* data; ///< first element
+    Py_ssize_t itemSize; ///< size of one element, in bytes
+    char format[2]; ///< element format (struct module syntax)
+    char typeStr[4]; ///< element format (numpy array interface syntax)
+    std::vector<Py_ssize_t>* shape;
+    std::vector<Py_ssize_t>* strides; ///< in bytes
+    std::vector<char>* copy; ///< storage of the copied data, if any
+#ifdef HAVE_OPENCV
+    cv::Mat* image; ///< storage of the image, if any
+#endif
+} DataArrayMembers;
+
+// -----------------------------------------------------------------------
+// Methods
+// -----------------------------------------------------------------------
+
+/**
+ * Initializer
+ *
+ * The DataArray can not be created from python.
+ */
+extern "C" int pyDataArrayInit(DataArrayMembers* self, PyObject *args, PyObject *kwds);
+
+/// shape of the array
+extern "C" PyObject* pyDataArrayShape(DataArrayMembers* self, void* closure);
+
+/// element format of the array (struct module syntax)
+extern "C" PyObject* pyDataArrayFormat(DataArrayMembers* self, void* closure);
+
+/// numpy array interface (version 3)
+extern "C" PyObject* pyDataArrayInterface(DataArrayMembers* self, void* closure);
+
+/// python wrapper to get a list of the elements (1-D arrays only)
+extern "C" PyObject* pyDataArrayToList(DataArrayMembers* self);
+
+static PyMethodDef pyMethodDataArrayToList =
+{
+    "tolist",
+    (PyCFunction)pyDataArrayToList,
+    METH_NOARGS,
+    "Copy the elements of a 1-D array into a list"
+};
+
+/// exported methods
+static PyMethodDef pyDataArrayMethods[] = {
+        pyMethodDataArrayToList,
+
+        {NULL} // sentinel
+};
+
+/// exported attributes
+static PyGetSetDef pyDataArrayGetSet[] = {
+    {
+        const_cast<char *>("shape"),
+        (getter)pyDataArrayShape,
+        NULL,
+        const_cast<char *>("Dimensions of the array"),
+        NULL
+    },
+    {
+        const_cast<char *>("format"),
+        (getter)pyDataArrayFormat,
+        NULL,
+        const_cast<char *>("Element format, as in the struct module"),
+        NULL
+    },
+    {
+        const_cast<char *>("__array_interface__"),
+        (getter)pyDataArrayInterface,
+        NULL,
+        const_cast<char *>("numpy array interface"),
+        NULL
+    },
+    { NULL } // Sentinel
+};
+
+// -----------------------------------------------------------------------
+// Buffer protocol
+// -----------------------------------------------------------------------
+
+/// Fill a read-only buffer view on the data
+extern "C" int pyDataArrayGetBuffer(DataArrayMembers* self, Py_buffer* view, int flags);
+
+static PyBufferProcs pyDataArrayBuffer = {
+    0,                          /* bf_getreadbuffer */
+    0,                          /* bf_getwritebuffer */
+    0,                          /* bf_getsegcount */
+    0,                          /* bf_getcharbuffer */
+    (getbufferproc)pyDataArrayGetBuffer, /* bf_getbuffer */
+    0,                          /* bf_releasebuffer */
+};
+
+// -----------------------------------------------------------------------
+// General
+// -----------------------------------------------------------------------
+
+/**
+ * Deallocator
+ */
+extern "C" void pyDataArrayDealloc(DataArrayMembers* self);
+
+/**
+ * Allocator
+ */
+extern "C" PyObject* pyDataArrayNew(PyTypeObject* type, PyObject* args, PyObject* kwds);
+
+/**
+ * Create a DataArray from the data of a source
+ *
+ * The source data shall be read-locked by the caller.
+ * Supported: numeric vectors and images.
+ *
+ * @return NULL with a python exception set if the data type
+ * is not supported
+ */
+PyObject* dataArrayFromSource(DataSource* source);
+
+#ifdef HAVE_OPENCV
+/**
+ * Create a DataArray from an image
+ *
+ * @param adopt if true, the image data is referenced without copy:
+ * the image shall be private to the caller, and not modified afterwards.
+ * If false (default), the image is cloned.
+ */
+PyObject* dataArrayFromImage(const cv::Mat& image, bool adopt = false);
+#endif
+
+/// Definition of the PyTypeObject
+static PyTypeObject PythonDataArray = {                  // SPECIFIC
+    PyObject_HEAD_INIT(NULL)
+    0,                          /*ob_size*/
+    "instru.DataArray",         /*tp_name*/           // SPECIFIC
+    sizeof(DataArrayMembers),   /*tp_basicsize*/      // SPECIFIC
+    0,                          /*tp_itemsize*/
+    (destructor)pyDataArrayDealloc,/*tp_dealloc*/        // SPECIFIC
+    0,                          /*tp_print*/
+    0,                          /*tp_getattr*/
+    0,                          /*tp_setattr*/
+    0,                          /*tp_compare*/
+    0,                          /*tp_repr*/
+    0,                          /*tp_as_number*/
+    0,                          /*tp_as_sequence*/
+    0,                          /*tp_as_mapping*/
+    0,                          /*tp_hash */
+    0,                          /*tp_call*/
+    0,                          /*tp_str*/
+    0,                          /*tp_getattro*/
+    0,                          /*tp_setattro*/
+    &pyDataArrayBuffer,         /*tp_as_buffer*/      // SPECIFIC
+    Py_TPFLAGS_DEFAULT |
+        Py_TPFLAGS_HAVE_NEWBUFFER, /*tp_flags*/       // SPECIFIC
+    "Read-only numeric array "
+    "exposing port data to numpy "
+    "without conversion",       /* tp_doc */          // SPECIFIC
+    0,                          /* tp_traverse */
+    0,                          /* tp_clear */
+    0,                          /* tp_richcompare */
+    0,                          /* tp_weaklistoffset */
+    0,                          /* tp_iter */
+    0,                          /* tp_iternext */
+    pyDataArrayMethods,         /* tp_methods */    // SPECIFIC
+    0,                          /* tp_members */
+    pyDataArrayGetSet,          /* tp_getset */     // SPECIFIC
+    0,                          /* tp_base */
+    0,                          /* tp_dict */
+    0,                          /* tp_descr_get */
+    0,                          /* tp_descr_set */
+    0,                          /* tp_dictoffset */
+    (initproc)pyDataArrayInit,  /* tp_init */       // SPECIFIC
+    0,                          /* tp_alloc */
+    pyDataArrayNew,             /* tp_new */        // SPECIFIC
+};
+
+#endif /* HAVE_PYTHON27 */
+#endif /* SRC_PYTHONDATAARRAY_H_ */
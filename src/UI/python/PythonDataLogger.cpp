@@ -255,4 +255,33 @@ PyObject* pyDataLoggerGetVerbosity(DataLoggerMembers* self, PyObject* args)
     return pyGetVerbosity(*self->logger, args);
 }
 
+PyObject* pyDataLoggerSetSnapshotQueue(DataLoggerMembers* self, PyObject* args)
+{
+    long size;
+
+    if (!PyArg_ParseTuple(args, "l:setSnapshotQueue", &size))
+        return NULL;
+
+    if (size < 0)
+    {
+        PyErr_SetString(PyExc_ValueError,
+                "The snapshot queue size can not be negative");
+        return NULL;
+    }
+
+    (*self->logger)->setSnapshotQueue(static_cast<size_t>(size));
+
+    Py_RETURN_NONE;
+}
+
+PyObject* pyDataLoggerGetSnapshotQueue(DataLoggerMembers* self)
+{
+    return PyInt_FromSize_t((*self->logger)->getSnapshotQueue());
+}
+
+PyObject* pyDataLoggerDroppedSnapshots(DataLoggerMembers* self)
+{
+    return PyInt_FromSize_t((*self->logger)->droppedSnapshots());
+}
+
 #endif /* HAVE_PYTHON27 */
@@ -196,6 +196,47 @@ static PyMethodDef pyMethodDataLoggerGetVerbosity =
     "getVerbosity: set the dataLogger logger verbosity"
 };
 
+/// DataLogger::setSnapshotQueue python wrapper
+extern "C"
+PyObject* pyDataLoggerSetSnapshotQueue(DataLoggerMembers *self, PyObject *args);
+
+static PyMethodDef pyMethodDataLoggerSetSnapshotQueue =
+{
+    "setSnapshotQueue",
+    (PyCFunction)pyDataLoggerSetSnapshotQueue,
+    METH_VARARGS,
+    "setSnapshotQueue(size): copy the data and release the source at once, "
+    "then log the copies from a queue of the given size. "
+    "The oldest copy is dropped when the queue is full. "
+    "0 to log while holding the source (default). "
+};
+
+/// DataLogger::getSnapshotQueue python wrapper
+extern "C"
+PyObject* pyDataLoggerGetSnapshotQueue(DataLoggerMembers *self);
+
+static PyMethodDef pyMethodDataLoggerGetSnapshotQueue =
+{
+    "getSnapshotQueue",
+    (PyCFunction)pyDataLoggerGetSnapshotQueue,
+    METH_NOARGS,
+    "getSnapshotQueue(): get the snapshot queue size. "
+    "0 if the snapshot mode is not used"
+};
+
+/// DataLogger::droppedSnapshots python wrapper
+extern "C"
+PyObject* pyDataLoggerDroppedSnapshots(DataLoggerMembers *self);
+
+static PyMethodDef pyMethodDataLoggerDroppedSnapshots =
+{
+    "droppedSnapshots",
+    (PyCFunction)pyDataLoggerDroppedSnapshots,
+    METH_NOARGS,
+    "droppedSnapshots(): count of copies dropped because "
+    "the snapshot queue was full"
+};
+
 /// exported methods
 static PyMethodDef pyDataLoggerMethods[] = {
         pyMethodDataLoggerSource,
@@ -211,6 +252,10 @@ static PyMethodDef pyDataLoggerMethods[] = {
         pyMethodDataLoggerSetVerbosity,
         pyMethodDataLoggerGetVerbosity,
 
+        pyMethodDataLoggerSetSnapshotQueue,
+        pyMethodDataLoggerGetSnapshotQueue,
+        pyMethodDataLoggerDroppedSnapshots,
+
         {NULL} // sentinel
 };
 
@@ -31,6 +31,8 @@ THE SOFTWARE.
 #include "PythonDataSource.h"
 #include "core/DataSource.h"
 
+#include "PythonDataArray.h"
+
 extern "C" void pyDataSourceDealloc(DataSourceMembers* self)
 {
     // "name" and "description" are python objects,
@@ -404,6 +406,32 @@ PyObject* getVectorValue(DataSource* data)
         }
         break;
     }
+#ifdef HAVE_OPENCV
+    case DataItem::typeCvMat:
+    {
+        std::vector<cv::Mat>* pData;
+        pData = data->getData< std::vector<cv::Mat> >();
+
+        for (std::vector<cv::Mat>::iterator it = pData->begin(),
+                ite = pData->end(); it != ite; it++)
+        {
+            // copied: the source may overwrite its images
+            PyObject* item = dataArrayFromImage(*it);
+
+            if ( item == NULL || 0 > PyList_Append(list, item) )
+            {
+                // appending the item failed
+                if (item == NULL)
+                    PyErr_Clear();
+                PyErr_SetString(PyExc_RuntimeError,
+                        "Not able to build the return list");
+                data->unlockData();
+                return NULL;
+            }
+        }
+        break;
+    }
+#endif
     default:
         PyErr_SetString(PyExc_NotImplementedError,
                 "getValue is not implemented for this dataType");
@@ -472,6 +500,14 @@ PyObject* pyDataSourceGetDataValue(DataSourceMembers* self)
         pyObj = PyString_FromString(pData->c_str());
         break;
     }
+#ifdef HAVE_OPENCV
+    case DataItem::typeCvMat:
+    {
+        // copied: the source may overwrite its image
+        pyObj = dataArrayFromImage(*(self->source->getData<cv::Mat>()));
+        break;
+    }
+#endif
     default:
         PyErr_SetString(PyExc_NotImplementedError,
                 "getValue is not implemented for this dataType");
@@ -484,4 +520,15 @@ PyObject* pyDataSourceGetDataValue(DataSourceMembers* self)
     return pyObj;
 }
 
+PyObject* pyDataSourceGetDataArray(DataSourceMembers* self)
+{
+    self->source->readDataLock();
+
+    PyObject* pyObj = dataArrayFromSource(self->source);
+
+    self->source->unlockData();
+
+    return pyObj;
+}
+
 #endif /* HAVE_PYTHON27 */
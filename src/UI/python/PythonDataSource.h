@@ -107,10 +107,23 @@ static PyMethodDef pyMethodDataSourceGetDataValue =
     "Retrieve the data handled by this source"
 };
 
+/// python wrapper to get the numeric data as a DataArray
+extern "C" PyObject* pyDataSourceGetDataArray(DataSourceMembers *self);
+
+static PyMethodDef pyMethodDataSourceGetDataArray =
+{
+    "getDataArray",
+    (PyCFunction)pyDataSourceGetDataArray,
+    METH_NOARGS,
+    "Retrieve the numeric vector or image handled by this source "
+    "as a DataArray, usable with numpy.asarray()"
+};
+
 /// exported methods
 static PyMethodDef pyDataSourceMethods[] = {
         pyMethodDataSourceGetDataTargets,
 		pyMethodDataSourceGetDataValue,
+		pyMethodDataSourceGetDataArray,
 
         {NULL} // sentinel
 };
@@ -52,6 +52,8 @@ THE SOFTWARE.
 #include "PythonDataProxy.h"
 #include "PythonParameterGetter.h"
 #include "PythonParameterSetter.h"
+#include "PythonDataArray.h"
+#include "PythonSubscription.h"
 
 /**
  * array to bind to-be-exposed methods (C to Python wrappers)
@@ -166,6 +168,12 @@ void PythonManager::exposeAPI()
     if (PyType_Ready(&PythonParameterSetter) < 0)
         return;
 
+    if (PyType_Ready(&PythonDataArray) < 0)
+        return;
+
+    if (PyType_Ready(&PythonSubscription) < 0)
+        return;
+
     PyObject* m;
 
     m = Py_InitModule3("instru", EmbMethods,
@@ -215,6 +223,12 @@ void PythonManager::exposeAPI()
 
     Py_INCREF(&PythonParameterSetter);
     PyModule_AddObject(m, "ParameterSetter", (PyObject *)&PythonParameterSetter);
+
+    Py_INCREF(&PythonDataArray);
+    PyModule_AddObject(m, "DataArray", (PyObject *)&PythonDataArray);
+
+    Py_INCREF(&PythonSubscription);
+    PyModule_AddObject(m, "Subscription", (PyObject *)&PythonSubscription);
 }
 
 
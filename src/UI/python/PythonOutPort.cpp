@@ -38,6 +38,8 @@ THE SOFTWARE.
 #include "PythonOutPort.h"
 #include "PythonModule.h"
 #include "PythonDataLogger.h"
+#include "PythonDataArray.h"
+#include "PythonSubscription.h"
 
 extern "C" void pyOutPortDealloc(OutPortMembers* self)
 {
@@ -484,6 +486,32 @@ PyObject* port_getVectorValue(DataSource* data)
         }
         break;
     }
+#ifdef HAVE_OPENCV
+    case DataItem::typeCvMat:
+    {
+        std::vector<cv::Mat>* pData;
+        pData = data->getData< std::vector<cv::Mat> >();
+
+        for (std::vector<cv::Mat>::iterator it = pData->begin(),
+                ite = pData->end(); it != ite; it++)
+        {
+            // copied: the source may overwrite its images
+            PyObject* item = dataArrayFromImage(*it);
+
+            if ( item == NULL || 0 > PyList_Append(list, item) )
+            {
+                // appending the item failed
+                if (item == NULL)
+                    PyErr_Clear();
+                PyErr_SetString(PyExc_RuntimeError,
+                        "Not able to build the return list");
+                data->unlockData();
+                return NULL;
+            }
+        }
+        break;
+    }
+#endif
     default:
         PyErr_SetString(PyExc_NotImplementedError,
                 "getValue is not implemented for this dataType");
@@ -552,6 +580,14 @@ PyObject* pyOutPortGetDataValue(OutPortMembers* self)
         pyObj = PyString_FromString(pData->c_str());
         break;
     }
+#ifdef HAVE_OPENCV
+    case DataItem::typeCvMat:
+    {
+        // copied: the source may overwrite its image
+        pyObj = dataArrayFromImage(*((**self->outPort)->getData<cv::Mat>()));
+        break;
+    }
+#endif
     default:
         PyErr_SetString(PyExc_NotImplementedError,
                 "getValue is not implemented for this dataType");
@@ -564,6 +600,17 @@ PyObject* pyOutPortGetDataValue(OutPortMembers* self)
     return pyObj;
 }
 
+PyObject* pyOutPortGetDataArray(OutPortMembers* self)
+{
+    (**self->outPort)->readDataLock();
+
+    PyObject* pyObj = dataArrayFromSource(**self->outPort);
+
+    (**self->outPort)->unlockData();
+
+    return pyObj;
+}
+
 PyObject* pyOutPortRegister(OutPortMembers *self, PyObject* args)
 {
 	SharedPtr<OutPort*> sharedPort =  Poco::Util::Application::instance()
@@ -605,6 +652,30 @@ PyObject* pyOutPortRegister(OutPortMembers *self, PyObject* args)
     Py_RETURN_NONE;
 }
 
+PyObject* pyOutPortSubscribe(OutPortMembers *self, PyObject* args, PyObject* kwds)
+{
+    static const char* kwlist[] = { "maxQueue", NULL };
+    Py_ssize_t maxQueue = 1000;
+
+    // arguments parsing
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|n:subscribe",
+            const_cast<char**>(kwlist), &maxQueue))
+        return NULL;
+
+    if (maxQueue < 1)
+    {
+        PyErr_SetString(PyExc_ValueError,
+                "maxQueue shall be positive");
+        return NULL;
+    }
+
+    SharedPtr<OutPort*> sharedPort =  Poco::Util::Application::instance()
+                                      .getSubsystem<Dispatcher>()
+                                      .getOutPort(**self->outPort);
+
+    return newSubscription(*sharedPort, static_cast<size_t>(maxQueue));
+}
+
 PyObject* pyOutPortLoggers(OutPortMembers *self)
 {
     std::set< AutoPtr<DataLogger> > loggers;
@@ -141,6 +141,18 @@ static PyMethodDef pyMethodOutPortGetDataValue =
     "Retrieve the current value of the port data"
 };
 
+/// python wrapper to get the numeric data as a DataArray
+extern "C" PyObject* pyOutPortGetDataArray(OutPortMembers *self);
+
+static PyMethodDef pyMethodOutPortGetDataArray =
+{
+    "getDataArray",
+    (PyCFunction)pyOutPortGetDataArray,
+    METH_NOARGS,
+    "Retrieve the numeric vector or image of the port data "
+    "as a DataArray, usable with numpy.asarray()"
+};
+
 /// python wrapper to register a logger to the data item
 extern "C" PyObject* pyOutPortRegister(OutPortMembers *self, PyObject* args);
 
@@ -152,6 +164,19 @@ static PyMethodDef pyMethodOutPortRegister =
     "register(logger): Register the DataLogger \"logger\" to log the port data"
 };
 
+/// python wrapper to subscribe to the port data
+extern "C" PyObject* pyOutPortSubscribe(OutPortMembers *self, PyObject* args, PyObject* kwds);
+
+static PyMethodDef pyMethodOutPortSubscribe =
+{
+    "subscribe",
+    (PyCFunction)pyOutPortSubscribe,
+    METH_VARARGS | METH_KEYWORDS,
+    "subscribe(maxQueue=1000): Create a Subscription queuing every new "
+    "data item of the port. When more than maxQueue items are waiting, "
+    "the oldest are dropped"
+};
+
 /// python wrapper to retrieve the registered data loggers
 extern "C" PyObject* pyOutPortLoggers(OutPortMembers *self);
 
@@ -172,7 +197,9 @@ static PyMethodDef pyOutPortMethods[] = {
         pyMethodOutPortGetSeqTargetPorts,
 
 		pyMethodOutPortGetDataValue,
+		pyMethodOutPortGetDataArray,
 		pyMethodOutPortRegister,
+		pyMethodOutPortSubscribe,
 		pyMethodOutPortLoggers,
 
         {NULL} // sentinel
@@ -0,0 +1,362 @@
+/**
+ * @file	src/UI/python/PythonSubscription.cpp
+ * @date	oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+Copyright (c) 2026 Ph. Renaud-Goud / Opticalp
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifdef HAVE_PYTHON27
+
+#include "core/DataSource.h"
+#include "core/Dispatcher.h"
+
+#include "PythonSubscription.h"
+#include "PythonDataArray.h"
+
+#include "Poco/Util/Application.h"
+
+using Poco::AutoPtr;
+using Poco::SharedPtr;
+
+extern "C" void pySubscriptionDealloc(SubscriptionMembers* self)
+{
+    if (!self->subscriber->isNull() && !(*self->subscriber)->isClosed())
+    {
+        (*self->subscriber)->close();
+
+        // no exception shall leave the deallocator
+        try
+        {
+            Poco::Util::Application::instance()
+                    .getSubsystem<Dispatcher>()
+                    .unbind(self->subscriber->get());
+        }
+        catch (Poco::Exception& e)
+        {
+            poco_error(Poco::Util::Application::instance().logger(),
+                    "Subscription deallocation: " + e.displayText());
+        }
+    }
+
+    delete self->subscriber;
+
+    self->ob_type->tp_free((PyObject*) self); // free the object’s memory
+}
+
+extern "C" PyObject* pySubscriptionNew(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    SubscriptionMembers* self;
+
+    self = (SubscriptionMembers*) type->tp_alloc(type, 0);
+    if (self != NULL)
+        self->subscriber = new AutoPtr<DataSubscriber>;
+
+    return (PyObject *) self;
+}
+
+extern "C" int pySubscriptionInit(SubscriptionMembers* self, PyObject *args, PyObject *kwds)
+{
+    PyErr_SetString(PyExc_NotImplementedError,
+            "__init__ is not implemented. Use OutPort.subscribe()");
+    return -1;
+}
+
+PyObject* newSubscription(DataSource* source, size_t maxQueue)
+{
+    if (PyType_Ready(&PythonSubscription) < 0)
+    {
+        PyErr_SetString(PyExc_ImportError,
+                "Not able to create the Subscription Type");
+        return NULL;
+    }
+
+    SubscriptionMembers* pySub = reinterpret_cast<SubscriptionMembers*>(
+            pySubscriptionNew(&PythonSubscription, NULL, NULL) );
+
+    if (pySub == NULL)
+        return NULL;
+
+    *pySub->subscriber = new DataSubscriber(maxQueue);
+
+    try
+    {
+        Poco::Util::Application::instance()
+                                .getSubsystem<Dispatcher>()
+                                .bind(source, pySub->subscriber->get());
+    }
+    catch (Poco::Exception& e)
+    {
+        // not bound: do not unbind in the deallocator
+        *pySub->subscriber = NULL;
+        Py_DECREF(pySub);
+        PyErr_SetString(PyExc_RuntimeError,
+                e.displayText().c_str());
+        return NULL;
+    }
+
+    return reinterpret_cast<PyObject*>(pySub);
+}
+
+/// python value of a scalar
+///@{
+static PyObject* subscriptionValue(Poco::Int32 value)
+    { return PyInt_FromLong(value); }
+static PyObject* subscriptionValue(Poco::UInt32 value)
+    { return PyInt_FromSize_t(value); }
+static PyObject* subscriptionValue(Poco::Int64 value)
+    { return PyInt_FromLong(static_cast<long>(value)); }
+static PyObject* subscriptionValue(Poco::UInt64 value)
+    { return PyInt_FromSize_t(static_cast<size_t>(value)); }
+static PyObject* subscriptionValue(float value)
+    { return PyFloat_FromDouble(value); }
+static PyObject* subscriptionValue(double value)
+    { return PyFloat_FromDouble(value); }
+static PyObject* subscriptionValue(const std::string& value)
+    { return PyString_FromStringAndSize(value.data(), value.size()); }
+#ifdef HAVE_OPENCV
+static PyObject* subscriptionValue(const cv::Mat& value)
+    { return dataArrayFromImage(value, true); } // private copy of the subscriber
+#endif
+///@}
+
+/// python value of a queued data item, scalar or vector of T
+template <typename T>
+static PyObject* subscriptionValue(DataItem* item)
+{
+    if (!DataItem::isVector(item->dataType()))
+        return subscriptionValue(*item->getData<T>());
+
+    std::vector<T>* pData = item->getData< std::vector<T> >();
+
+    PyObject* list = PyList_New(pData->size());
+    if (list == NULL)
+        return NULL;
+
+    for (size_t index = 0; index < pData->size(); index++)
+    {
+        PyObject* value = subscriptionValue(pData->at(index));
+        if (value == NULL)
+        {
+            Py_DECREF(list);
+            return NULL;
+        }
+
+        PyList_SET_ITEM(list, index, value); // steals the reference
+    }
+
+    return list;
+}
+
+/**
+ * Convert a queued data item into a python object
+ *
+ * The queued items are copies owned by the subscription:
+ * no lock is needed.
+ */
+static PyObject* subscriptionItemValue(DataItem* item)
+{
+    switch (DataItem::noContainerDataType(item->dataType()))
+    {
+    case DataItem::typeInt32:
+        return subscriptionValue<Poco::Int32>(item);
+    case DataItem::typeUInt32:
+        return subscriptionValue<Poco::UInt32>(item);
+    case DataItem::typeInt64:
+        return subscriptionValue<Poco::Int64>(item);
+    case DataItem::typeUInt64:
+        return subscriptionValue<Poco::UInt64>(item);
+    case DataItem::typeFloat:
+        return subscriptionValue<float>(item);
+    case DataItem::typeDblFloat:
+        return subscriptionValue<double>(item);
+    case DataItem::typeString:
+        return subscriptionValue<std::string>(item);
+#ifdef HAVE_OPENCV
+    case DataItem::typeCvMat:
+        return subscriptionValue<cv::Mat>(item);
+#endif
+    default:
+        PyErr_SetString(PyExc_NotImplementedError,
+                "the subscription is not implemented for this dataType");
+        return NULL;
+    }
+}
+
+/**
+ * Pop at most maxCount items, releasing the GIL while waiting
+ *
+ * @param timeout in seconds. Negative: no timeout
+ */
+static void subscriptionPop(SubscriptionMembers* self,
+        std::vector< SharedPtr<DataItem> >& items,
+        size_t maxCount, double timeout)
+{
+    if (self->subscriber->isNull())
+        return;
+
+    // keep a reference: the python object could be closed by another thread
+    AutoPtr<DataSubscriber> subscriber(*self->subscriber);
+
+    long timeoutMs = (timeout < 0) ? -1 : static_cast<long>(timeout * 1000);
+
+    Py_BEGIN_ALLOW_THREADS
+    subscriber->pop(items, maxCount, timeoutMs);
+    Py_END_ALLOW_THREADS
+}
+
+/// parse the optional timeout argument (None or seconds)
+static bool subscriptionTimeout(PyObject* pyTimeout, double& timeout)
+{
+    timeout = -1;
+
+    if (pyTimeout == NULL || pyTimeout == Py_None)
+        return true;
+
+    timeout = PyFloat_AsDouble(pyTimeout);
+    if (timeout == -1 && PyErr_Occurred())
+        return false;
+
+    if (timeout < 0)
+        timeout = 0;
+
+    return true;
+}
+
+PyObject* pySubscriptionGet(SubscriptionMembers *self, PyObject* args, PyObject* kwds)
+{
+    static const char* kwlist[] = { "timeout", NULL };
+    PyObject* pyTimeout = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O:get",
+            const_cast<char**>(kwlist), &pyTimeout))
+        return NULL;
+
+    double timeout;
+    if (!subscriptionTimeout(pyTimeout, timeout))
+        return NULL;
+
+    std::vector< SharedPtr<DataItem> > items;
+    subscriptionPop(self, items, 1, timeout);
+
+    if (items.empty())
+        Py_RETURN_NONE;
+
+    return subscriptionItemValue(items.front().get());
+}
+
+PyObject* pySubscriptionGetBatch(SubscriptionMembers *self, PyObject* args, PyObject* kwds)
+{
+    static const char* kwlist[] = { "k", "timeout", NULL };
+    Py_ssize_t maxCount;
+    PyObject* pyTimeout = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|O:getBatch",
+            const_cast<char**>(kwlist), &maxCount, &pyTimeout))
+        return NULL;
+
+    if (maxCount < 1)
+    {
+        PyErr_SetString(PyExc_ValueError,
+                "the batch size k shall be positive");
+        return NULL;
+    }
+
+    double timeout;
+    if (!subscriptionTimeout(pyTimeout, timeout))
+        return NULL;
+
+    std::vector< SharedPtr<DataItem> > items;
+    subscriptionPop(self, items, static_cast<size_t>(maxCount), timeout);
+
+    PyObject* list = PyList_New(items.size());
+    if (list == NULL)
+        return NULL;
+
+    for (size_t index = 0; index < items.size(); index++)
+    {
+        PyObject* value = subscriptionItemValue(items[index].get());
+        if (value == NULL)
+        {
+            Py_DECREF(list);
+            return NULL;
+        }
+
+        PyList_SET_ITEM(list, index, value); // steals the reference
+    }
+
+    return list;
+}
+
+PyObject* pySubscriptionPending(SubscriptionMembers *self)
+{
+    if (self->subscriber->isNull())
+        return PyInt_FromLong(0);
+
+    return PyInt_FromSize_t((*self->subscriber)->pending());
+}
+
+PyObject* pySubscriptionDropped(SubscriptionMembers *self)
+{
+    if (self->subscriber->isNull())
+        return PyInt_FromLong(0);
+
+    return PyInt_FromSize_t((*self->subscriber)->dropped());
+}
+
+PyObject* pySubscriptionClose(SubscriptionMembers *self)
+{
+    if (self->subscriber->isNull() || (*self->subscriber)->isClosed())
+        Py_RETURN_NONE;
+
+    (*self->subscriber)->close();
+
+    try
+    {
+        Poco::Util::Application::instance()
+                .getSubsystem<Dispatcher>()
+                .unbind(self->subscriber->get());
+    }
+    catch (Poco::Exception& e)
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+                e.displayText().c_str());
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+PyObject* pySubscriptionIterNext(SubscriptionMembers *self)
+{
+    std::vector< SharedPtr<DataItem> > items;
+    subscriptionPop(self, items, 1, -1);
+
+    // closed and empty: StopIteration
+    if (items.empty())
+        return NULL;
+
+    return subscriptionItemValue(items.front().get());
+}
+
+#endif /* HAVE_PYTHON27 */
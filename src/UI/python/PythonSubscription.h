@@ -0,0 +1,220 @@
+/**
+ * Definition of the Subscription python class
+ * 
+ * @file	src/UI/python/PythonSubscription.h
+ * @date	oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+Copyright (c) 2026 Ph. Renaud-Goud / Opticalp
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#ifndef SRC_PYTHONSUBSCRIPTION_H_
+#define SRC_PYTHONSUBSCRIPTION_H_
+
+#ifdef HAVE_PYTHON27
+
+#include "PythonAPI.h"
+#include "structmember.h"
+
+#include "Poco/AutoPtr.h"
+
+#include "dataLoggers/DataSubscriber.h"
+
+// -----------------------------------------------------------------------
+// Variables
+// -----------------------------------------------------------------------
+
+/**
+ * member variables for the python Subscription class
+ *
+ * A subscription receives every new data item of an output port
+ * through a bounded queue filled on the C++ side (see DataSubscriber).
+ * It is created by OutPort.subscribe().
+ *
+ * The blocking methods release the GIL while waiting.
+ */
+typedef struct
+{
+    PyObject_HEAD ///< a refcount and a pointer to a type object (convenience python/C API macro)
+    Poco::AutoPtr<DataSubscriber>* subscriber; ///< pointer to the C++ internal data subscriber
+} SubscriptionMembers;
+
+// -----------------------------------------------------------------------
+// Methods
+// -----------------------------------------------------------------------
+
+/**
+ * Initializer
+ *
+ * The Subscription can not be created from python.
+ * Use OutPort.subscribe() instead.
+ */
+extern "C" int pySubscriptionInit(SubscriptionMembers* self, PyObject *args, PyObject *kwds);
+
+/// python wrapper to wait for the next data item
+extern "C" PyObject* pySubscriptionGet(SubscriptionMembers *self, PyObject* args, PyObject* kwds);
+
+static PyMethodDef pyMethodSubscriptionGet =
+{
+    "get",
+    (PyCFunction)pySubscriptionGet,
+    METH_VARARGS | METH_KEYWORDS,
+    "get(timeout=None): Wait for the next data item and return its value. "
+    "timeout in seconds. Return None if the timeout expired or if the "
+    "subscription is closed"
+};
+
+/// python wrapper to retrieve several data items at once
+extern "C" PyObject* pySubscriptionGetBatch(SubscriptionMembers *self, PyObject* args, PyObject* kwds);
+
+static PyMethodDef pyMethodSubscriptionGetBatch =
+{
+    "getBatch",
+    (PyCFunction)pySubscriptionGetBatch,
+    METH_VARARGS | METH_KEYWORDS,
+    "getBatch(k, timeout=None): Wait for at least one data item and "
+    "return the list of the values of at most k queued items. "
+    "Return an empty list if the timeout expired or if the "
+    "subscription is closed"
+};
+
+/// python wrapper to get the count of queued items
+extern "C" PyObject* pySubscriptionPending(SubscriptionMembers *self);
+
+static PyMethodDef pyMethodSubscriptionPending =
+{
+    "pending",
+    (PyCFunction)pySubscriptionPending,
+    METH_NOARGS,
+    "Count of the data items waiting to be retrieved"
+};
+
+/// python wrapper to get the count of dropped items
+extern "C" PyObject* pySubscriptionDropped(SubscriptionMembers *self);
+
+static PyMethodDef pyMethodSubscriptionDropped =
+{
+    "dropped",
+    (PyCFunction)pySubscriptionDropped,
+    METH_NOARGS,
+    "Count of the data items dropped because the queue was full"
+};
+
+/// python wrapper to stop the subscription
+extern "C" PyObject* pySubscriptionClose(SubscriptionMembers *self);
+
+static PyMethodDef pyMethodSubscriptionClose =
+{
+    "close",
+    (PyCFunction)pySubscriptionClose,
+    METH_NOARGS,
+    "Unsubscribe from the port. The queued items can still be retrieved"
+};
+
+/// exported methods
+static PyMethodDef pySubscriptionMethods[] = {
+        pyMethodSubscriptionGet,
+        pyMethodSubscriptionGetBatch,
+        pyMethodSubscriptionPending,
+        pyMethodSubscriptionDropped,
+        pyMethodSubscriptionClose,
+
+        {NULL} // sentinel
+};
+
+/// iterator: wait for the next item, stop when closed and empty
+extern "C" PyObject* pySubscriptionIterNext(SubscriptionMembers *self);
+
+// -----------------------------------------------------------------------
+// General
+// -----------------------------------------------------------------------
+
+/**
+ * Deallocator
+ *
+ * Unsubscribe from the port
+ */
+extern "C" void pySubscriptionDealloc(SubscriptionMembers* self);
+
+/**
+ * Allocator
+ */
+extern "C" PyObject* pySubscriptionNew(PyTypeObject* type, PyObject* args, PyObject* kwds);
+
+/**
+ * Create a Subscription to the data of the given source
+ *
+ * @param source data source to subscribe to (e.g. an output port)
+ * @param maxQueue maximum count of queued items
+ * @return NULL with a python exception set if the binding failed
+ */
+PyObject* newSubscription(DataSource* source, size_t maxQueue);
+
+/// Definition of the PyTypeObject
+static PyTypeObject PythonSubscription = {               // SPECIFIC
+    PyObject_HEAD_INIT(NULL)
+    0,                          /*ob_size*/
+    "instru.Subscription",      /*tp_name*/           // SPECIFIC
+    sizeof(SubscriptionMembers),/*tp_basicsize*/      // SPECIFIC
+    0,                          /*tp_itemsize*/
+    (destructor)pySubscriptionDealloc,/*tp_dealloc*/  // SPECIFIC
+    0,                          /*tp_print*/
+    0,                          /*tp_getattr*/
+    0,                          /*tp_setattr*/
+    0,                          /*tp_compare*/
+    0,                          /*tp_repr*/
+    0,                          /*tp_as_number*/
+    0,                          /*tp_as_sequence*/
+    0,                          /*tp_as_mapping*/
+    0,                          /*tp_hash */
+    0,                          /*tp_call*/
+    0,                          /*tp_str*/
+    0,                          /*tp_getattro*/
+    0,                          /*tp_setattro*/
+    0,                          /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT |
+        Py_TPFLAGS_HAVE_ITER,   /*tp_flags*/          // SPECIFIC
+    "Queue of the data items "
+    "of an output port",        /* tp_doc */          // SPECIFIC
+    0,                          /* tp_traverse */
+    0,                          /* tp_clear */
+    0,                          /* tp_richcompare */
+    0,                          /* tp_weaklistoffset */
+    PyObject_SelfIter,          /* tp_iter */         // SPECIFIC
+    (iternextfunc)pySubscriptionIterNext, /* tp_iternext */ // SPECIFIC
+    pySubscriptionMethods,      /* tp_methods */    // SPECIFIC
+    0,                          /* tp_members */
+    0,                          /* tp_getset */
+    0,                          /* tp_base */
+    0,                          /* tp_dict */
+    0,                          /* tp_descr_get */
+    0,                          /* tp_descr_set */
+    0,                          /* tp_dictoffset */
+    (initproc)pySubscriptionInit,  /* tp_init */    // SPECIFIC
+    0,                          /* tp_alloc */
+    pySubscriptionNew,          /* tp_new */        // SPECIFIC
+};
+
+#endif /* HAVE_PYTHON27 */
+#endif /* SRC_PYTHONSUBSCRIPTION_H_ */
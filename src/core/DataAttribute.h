@@ -90,6 +90,18 @@ public:
     void appendSeqTarget(SeqTarget* target)
         { seqTargets.insert(target); }
 
+    /// Read access to the attribute content, e.g. to serialize it
+    ///@{
+    const std::set<size_t>& getIndexes() const
+        { return indexes; }
+    const std::vector<size_t>& getAllSequences() const
+        { return allSequences; }
+    const std::vector<size_t>& getStartingSequences() const
+        { return startingSequences; }
+    const std::vector<size_t>& getEndingSequences() const
+        { return endingSequences; }
+    ///@}
+
 protected:
     /**
      * Swap content with another DataAttribute
@@ -27,6 +27,7 @@
  */
 
 #include "DataLogger.h"
+#include "DataSource.h"
 
 #include "ThreadManager.h"
 
@@ -47,9 +48,48 @@ void DataLogger::run()
 
 	lockSource();
 
+	size_t queueSize;
+	{
+		Poco::FastMutex::ScopedLock lock(snapshotMutex);
+		queueSize = snapshotQueueSize;
+	}
+
+	if (queueSize == 0)
+	{
+		Poco::FastMutex::ScopedLock lock(mutex);
+		currentData = getDataSource();
+
+		try
+		{
+			log();
+		}
+		catch (...)
+		{
+			currentData = NULL;
+			releaseInputData();
+			throw;
+		}
+
+		currentData = NULL;
+		releaseInputData();
+		return;
+	}
+
+	Poco::SharedPtr<DataItem> snapshot;
+
 	try
 	{
-		log();
+		if (!snapshotWanted())
+		{
+			releaseInputData();
+
+			Poco::FastMutex::ScopedLock lock(snapshotMutex);
+			dropped++;
+			return;
+		}
+
+		snapshot = new DataItem(*getDataSource());
+		cloneImages(*snapshot);
 	}
 	catch (...)
 	{
@@ -58,6 +98,126 @@ void DataLogger::run()
 	}
 
 	releaseInputData();
+
+	{
+		Poco::FastMutex::ScopedLock lock(snapshotMutex);
+
+		if (snapshots.size() >= queueSize)
+		{
+			snapshots.pop_front();
+			dropped++;
+		}
+
+		snapshots.push_back(snapshot);
+
+		// the running thread will log this snapshot too
+		if (draining)
+			return;
+
+		draining = true;
+	}
+
+	logSnapshots();
+}
+
+void DataLogger::logSnapshots()
+{
+	// the other queued snapshots are still logged after a failure.
+	// the last error is thrown at the end of the drain, as log()
+	// errors are thrown by run() in the direct mode
+	Poco::SharedPtr<Poco::Exception> error;
+
+	while (true)
+	{
+		Poco::SharedPtr<DataItem> snapshot;
+
+		{
+			Poco::FastMutex::ScopedLock lock(snapshotMutex);
+
+			if (snapshots.empty())
+			{
+				draining = false;
+				break;
+			}
+
+			snapshot = snapshots.front();
+			snapshots.pop_front();
+		}
+
+		Poco::FastMutex::ScopedLock lock(mutex);
+		currentData = snapshot.get();
+
+		try
+		{
+			log();
+		}
+		catch (Poco::Exception& e)
+		{
+			poco_error(logger(), name() + ": " + e.displayText());
+			error = e.clone();
+		}
+		catch (std::exception& e)
+		{
+			poco_error(logger(), name() + ": " + e.what());
+			error = new Poco::Exception(name(), e.what());
+		}
+		catch (...)
+		{
+			poco_error(logger(), name() + ": unknown exception");
+			error = new Poco::UnhandledException(name(), "unknown exception");
+		}
+
+		currentData = NULL;
+	}
+
+	if (!error.isNull())
+		error->rethrow();
+}
+
+void DataLogger::cloneImages(DataItem& item)
+{
+#ifdef HAVE_OPENCV
+	switch (item.dataType())
+	{
+	case DataItem::typeCvMat:
+	{
+		cv::Mat* pMat = item.getData<cv::Mat>();
+		*pMat = pMat->clone();
+		break;
+	}
+	case DataItem::typeCvMat | DataItem::contVector:
+	{
+		std::vector<cv::Mat>* pMats = item.getData< std::vector<cv::Mat> >();
+		for (std::vector<cv::Mat>::iterator it = pMats->begin(),
+				ite = pMats->end(); it != ite; it++)
+			*it = it->clone();
+		break;
+	}
+	default:
+		break;
+	}
+#endif
+}
+
+void DataLogger::setSnapshotQueue(size_t size)
+{
+	Poco::FastMutex::ScopedLock lock(snapshotMutex);
+
+	// the queued snapshots are still logged
+	snapshotQueueSize = size;
+	dropped = 0;
+}
+
+size_t DataLogger::getSnapshotQueue()
+{
+	Poco::FastMutex::ScopedLock lock(snapshotMutex);
+	return snapshotQueueSize;
+}
+
+size_t DataLogger::droppedSnapshots()
+{
+	Poco::FastMutex::ScopedLock lock(snapshotMutex);
+	return dropped;
 }
 
 void DataLogger::setName(size_t refCount)
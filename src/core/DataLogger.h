@@ -30,6 +30,7 @@
 #define SRC_DATALOGGER_H_
 
 #include "DataTarget.h"
+#include "DataItem.h"
 #include "VerboseEntity.h"
 #include "ParameterizedEntity.h"
 #include "UniqueNameEntity.h"
@@ -37,6 +38,9 @@
 #include "Poco/Runnable.h"
 #include "Poco/Mutex.h"
 #include "Poco/RefCountedObject.h"
+#include "Poco/SharedPtr.h"
+
+#include <deque>
 
 using Poco::Mutex;
 
@@ -49,6 +53,12 @@ using Poco::Mutex;
  * The derived classes shall implement a classDescription
  * static method. DataTarget::description can be implemented
  * as linking to this method.
+ *
+ * By default, log() is called while the source data is locked: the
+ * source can not be written again before the end of log(). In the
+ * snapshot mode (see setSnapshotQueue), the data is copied, the source
+ * is released at once, and log() is called on the copy, so that a slow
+ * logger does not slow down the data flow.
  */
 class DataLogger: public DataTarget,
     public ParameterizedEntity,
@@ -66,7 +76,9 @@ public:
     DataLogger(std::string implementationName):
         className(implementationName),
         ParameterizedEntity("dataLogger." + implementationName),
-        VerboseEntity("dataLogger." + implementationName) // startup logger name
+        VerboseEntity("dataLogger." + implementationName), // startup logger name
+        currentData(NULL),
+        snapshotQueueSize(0), draining(false), dropped(0)
         {   }
 
     virtual ~DataLogger() { poco_information(logger(), "deleting " + name()); }
@@ -74,10 +86,31 @@ public:
     /**
      * Lock the input and launch log()
      *
-     * This method release the data after the logging.
+     * This method release the data after the logging, or, in the
+     * snapshot mode, after the copy of the data.
      */
     void run();
 
+    /**
+     * Set the size of the snapshot queue
+     *
+     * @param size 0 to leave the snapshot mode (default).
+     * Else, maximum count of copies waiting to be logged.
+     * When the queue is full, the oldest copy is dropped.
+     *
+     * The images are cloned, so that the source image buffer can be
+     * written again (or recycled) as soon as it is released.
+     *
+     * The log() errors are logged, and the last one is thrown by the
+     * run() call that drains the queue, once it is empty.
+     */
+    void setSnapshotQueue(size_t size);
+
+    size_t getSnapshotQueue();
+
+    /// Count of the copies dropped because the queue was full
+    size_t droppedSnapshots();
+
     /**
      * Get the data logger implementation class name
      *
@@ -108,13 +141,34 @@ protected:
      *
      * The data to log should be accessed using
      *
-     *     T* getDataSource()->getData<T>();
+     *     T* loggedData()->getData<T>();
      *
-     * The input data is already locked.
+     * The input data is already locked (or copied).
      * The data is released by the calling function.
+     *
+     * The calls to log() are serialized.
      */
     virtual void log() = 0;
 
+    /**
+     * Check if a snapshot has to be taken of the incoming data
+     *
+     * Called in the snapshot mode, before the copy. If false is
+     * returned, the source is released without copy and the data is
+     * counted as dropped. Can be overridden to skip the data that would
+     * be replaced anyway, e.g. above a display refresh rate.
+     *
+     * Default: true
+     */
+    virtual bool snapshotWanted() { return true; }
+
+    /**
+     * Data to be logged, valid during log()
+     *
+     * Locked source data or snapshot, with its attribute.
+     */
+    DataItem* loggedData() { return currentData; }
+
     /**
      * Set data logger internal name
      *
@@ -125,6 +179,9 @@ protected:
 
     Poco::Logger& logger() { return VerboseEntity::logger(); }
 
+    /// Replace the images of the given copy by deep copies
+    static void cloneImages(DataItem& item);
+
 private:
     DataLogger();
 
@@ -141,9 +198,23 @@ private:
 	void targetWaitCancelled() { }
 	void targetReset() { }
 
+    /**
+     * Call log() on the queued snapshots until the queue is empty
+     *
+     * @throw the last log() error, after the drain
+     */
+    void logSnapshots();
+
 	std::string className; ///< data logger implementation class name
 
-    Poco::FastMutex mutex; ///< data logger main mutex
+    Poco::FastMutex mutex; ///< data logger main mutex. Serialize log()
+    DataItem* currentData; ///< see loggedData()
+
+    size_t snapshotQueueSize; ///< 0: no snapshot
+    std::deque< Poco::SharedPtr<DataItem> > snapshots;
+    bool draining; ///< a thread is logging the snapshots
+    size_t dropped; ///< dropped snapshot count
+    Poco::FastMutex snapshotMutex; ///< protect the snapshot queue
 };
 
 #endif /* SRC_DATALOGGER_H_ */
@@ -38,6 +38,7 @@
 #ifdef HAVE_OPENCV
 #    include "dataLoggers/ShowImageLogger.h"
 #    include "dataLoggers/SaveImageLogger.h"
+#    include "dataLoggers/RawRecordLogger.h"
 #endif
 
 // proxies
@@ -78,6 +79,8 @@ DataManager::DataManager():
     loggerClasses.insert(classPair("ShowImageLogger", ShowImageLogger::classDescription()));
     loggerFactory.registerClass<SaveImageLogger>("SaveImageLogger");
     loggerClasses.insert(classPair("SaveImageLogger", SaveImageLogger::classDescription()));
+    loggerFactory.registerClass<RawRecordLogger>("RawRecordLogger");
+    loggerClasses.insert(classPair("RawRecordLogger", RawRecordLogger::classDescription()));
 #endif
 
     // Register data proxies in the factory using their C++ class name
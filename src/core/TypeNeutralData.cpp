@@ -82,6 +82,15 @@ TypeNeutralData::TypeNeutralData(const TypeNeutralData& other):
     	dataStore = reinterpret_cast<void*>(tmp);
         break;
 		}
+#ifdef HAVE_OPENCV
+    case (typeCvMat | contScalar):
+		{
+        // the image data is shared, not copied
+        cv::Mat* tmp = new cv::Mat(*reinterpret_cast<cv::Mat*>(other.dataStore));
+    	dataStore = reinterpret_cast<void*>(tmp);
+        break;
+		}
+#endif
 
     // vector containers
     case (typeInt32 | contVector):
@@ -126,6 +135,14 @@ TypeNeutralData::TypeNeutralData(const TypeNeutralData& other):
     	dataStore = reinterpret_cast<void*>(tmp);
         break;
 		}
+#ifdef HAVE_OPENCV
+    case (typeCvMat | contVector):
+		{
+    	std::vector<cv::Mat>* tmp = new std::vector<cv::Mat>(*reinterpret_cast< std::vector<cv::Mat>* >(other.dataStore));
+    	dataStore = reinterpret_cast<void*>(tmp);
+        break;
+		}
+#endif
 
     // others
     case typeUndefined:
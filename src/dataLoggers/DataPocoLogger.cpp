@@ -29,12 +29,16 @@
 #include "DataPocoLogger.h"
 
 #include "Poco/NumberFormatter.h"
+#include "Poco/Thread.h"
 
 size_t DataPocoLogger::refCount = 0;
 
 void DataPocoLogger::log()
 {
-    int datatype = sourceDataType();
+    if (delay > 0)
+        Poco::Thread::sleep(static_cast<long>(delay));
+
+    int datatype = loggedData()->dataType();
 
     if (DataItem::isVector(datatype))
     {
@@ -46,30 +50,30 @@ void DataPocoLogger::log()
         {
         case DataItem::typeInt32:
             poco_information(recLogger(),
-                    Poco::NumberFormatter::format(*(getDataSource()->getData<Poco::Int32>())));
+                    Poco::NumberFormatter::format(*(loggedData()->getData<Poco::Int32>())));
             break;
         case DataItem::typeUInt32:
             poco_information(recLogger(),
-                    Poco::NumberFormatter::format(*(getDataSource()->getData<Poco::UInt32>())));
+                    Poco::NumberFormatter::format(*(loggedData()->getData<Poco::UInt32>())));
             break;
         case DataItem::typeInt64:
             poco_information(recLogger(),
-                    Poco::NumberFormatter::format(*(getDataSource()->getData<Poco::Int64>())));
+                    Poco::NumberFormatter::format(*(loggedData()->getData<Poco::Int64>())));
             break;
         case DataItem::typeUInt64:
             poco_information(recLogger(),
-                    Poco::NumberFormatter::format(*(getDataSource()->getData<Poco::UInt64>())));
+                    Poco::NumberFormatter::format(*(loggedData()->getData<Poco::UInt64>())));
             break;
         case DataItem::typeFloat:
             poco_information(recLogger(),
-                    Poco::NumberFormatter::format(*(getDataSource()->getData<float>())));
+                    Poco::NumberFormatter::format(*(loggedData()->getData<float>())));
             break;
         case DataItem::typeDblFloat:
             poco_information(recLogger(),
-                    Poco::NumberFormatter::format(*(getDataSource()->getData<double>())));
+                    Poco::NumberFormatter::format(*(loggedData()->getData<double>())));
             break;
         case DataItem::typeString:
-            poco_information(recLogger(), *(getDataSource()->getData<std::string>()));
+            poco_information(recLogger(), *(loggedData()->getData<std::string>()));
             break;
         default:
             throw Poco::NotImplementedException("DataPocoLogger",
@@ -110,7 +114,7 @@ void DataPocoLogger::logVectorValue(DataItem::DataTypeEnum dataType)
     case DataItem::typeInt32:
     {
         std::vector<Poco::Int32>* pData;
-        pData = getDataSource()->getData< std::vector<Poco::Int32> >();
+        pData = loggedData()->getData< std::vector<Poco::Int32> >();
 
         for (std::vector<Poco::Int32>::iterator it = pData->begin(),
                 ite = pData->end(); it != ite; it++)
@@ -123,7 +127,7 @@ void DataPocoLogger::logVectorValue(DataItem::DataTypeEnum dataType)
     case DataItem::typeUInt32:
     {
         std::vector<Poco::UInt32>* pData;
-        pData = getDataSource()->getData< std::vector<Poco::UInt32> >();
+        pData = loggedData()->getData< std::vector<Poco::UInt32> >();
 
         for (std::vector<Poco::UInt32>::iterator it = pData->begin(),
                 ite = pData->end(); it != ite; it++)
@@ -136,7 +140,7 @@ void DataPocoLogger::logVectorValue(DataItem::DataTypeEnum dataType)
     case DataItem::typeInt64:
     {
         std::vector<Poco::Int64>* pData;
-        pData = getDataSource()->getData< std::vector<Poco::Int64> >();
+        pData = loggedData()->getData< std::vector<Poco::Int64> >();
 
         for (std::vector<Poco::Int64>::iterator it = pData->begin(),
                 ite = pData->end(); it != ite; it++)
@@ -149,7 +153,7 @@ void DataPocoLogger::logVectorValue(DataItem::DataTypeEnum dataType)
     case DataItem::typeUInt64:
     {
         std::vector<Poco::UInt64>* pData;
-        pData = getDataSource()->getData< std::vector<Poco::UInt64> >();
+        pData = loggedData()->getData< std::vector<Poco::UInt64> >();
 
         for (std::vector<Poco::UInt64>::iterator it = pData->begin(),
                 ite = pData->end(); it != ite; it++)
@@ -162,7 +166,7 @@ void DataPocoLogger::logVectorValue(DataItem::DataTypeEnum dataType)
     case DataItem::typeFloat:
     {
         std::vector<float>* pData;
-        pData = getDataSource()->getData< std::vector<float> >();
+        pData = loggedData()->getData< std::vector<float> >();
 
        for (std::vector<float>::iterator it = pData->begin(),
                 ite = pData->end(); it != ite; it++)
@@ -175,7 +179,7 @@ void DataPocoLogger::logVectorValue(DataItem::DataTypeEnum dataType)
     case DataItem::typeDblFloat:
     {
         std::vector<double>* pData;
-        pData = getDataSource()->getData< std::vector<double> >();
+        pData = loggedData()->getData< std::vector<double> >();
 
         for (std::vector<double>::iterator it = pData->begin(),
                 ite = pData->end(); it != ite; it++)
@@ -188,7 +192,7 @@ void DataPocoLogger::logVectorValue(DataItem::DataTypeEnum dataType)
     case DataItem::typeString:
     {
         std::vector<std::string>* pData;
-        pData = getDataSource()->getData< std::vector<std::string> >();
+        pData = loggedData()->getData< std::vector<std::string> >();
 
         for (std::vector<std::string>::iterator it = pData->begin(),
                 ite = pData->end(); it != ite; it++)
@@ -211,7 +215,7 @@ void DataPocoLogger::logVectorValue(DataItem::DataTypeEnum dataType)
 
 DataPocoLogger::DataPocoLogger():
         DataLogger("DataPocoLogger"),
-        iPar(421), fPar(3.14), sPar("Caramba")
+        iPar(421), fPar(3.14), sPar("Caramba"), delay(0)
 {
 	setName(refCount);
 
@@ -222,6 +226,8 @@ DataPocoLogger::DataPocoLogger():
     addParameter(paramInt, "intParam", "simple integer parameter", ParamItem::typeInteger, "1515");
     addParameter(paramFloat, "floatParam", "simple floating point parameter", ParamItem::typeFloat);
     addParameter(paramStr, "strParam", "simple character string parameter", ParamItem::typeString);
+    addParameter(paramDelay, "delay", "time spent in each log() call, in ms, "
+            "to simulate a slow logger", ParamItem::typeInteger, "0");
 
     refCount++;
 }
@@ -38,7 +38,8 @@
  *
  * Very simple data logger that outputs data into a Poco::Logger
  *
- * Exhibit some dummy parameters for testing purpose.
+ * Exhibit some dummy parameters for testing purpose, and a delay
+ * parameter to simulate a slow logger.
  */
 class DataPocoLogger: public DataLogger
 {
@@ -90,15 +91,20 @@ private:
         paramInt,
         paramFloat,
         paramStr,
+        paramDelay,
         paramCnt
     };
 
     Poco::Int64 iPar; ///< storage for integer parameter
     double fPar; ///< storage for float parameter
     std::string sPar; ///< storage for char string parameter
+    Poco::Int64 delay; ///< time spent in log(), in ms
 
     Poco::Int64 getIntParameterValue(size_t paramIndex)
     {
+        if (paramIndex == paramDelay)
+            return delay;
+
         poco_assert(paramIndex == paramInt);
         return iPar;
     }
@@ -117,6 +123,15 @@ private:
 
     void setIntParameterValue(size_t paramIndex, Poco::Int64 value)
     {
+        if (paramIndex == paramDelay)
+        {
+            if (value < 0)
+                throw Poco::RangeException("setParameterValue",
+                        "delay can not be negative");
+            delay = value;
+            return;
+        }
+
         poco_assert(paramIndex == paramInt);
         iPar = value;
     }
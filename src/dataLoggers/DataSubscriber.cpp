@@ -0,0 +1,149 @@
+/**
+ * @file	src/dataLoggers/DataSubscriber.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "DataSubscriber.h"
+
+#include "Poco/Timestamp.h"
+
+size_t DataSubscriber::refCount = 0;
+
+DataSubscriber::DataSubscriber(size_t maxQueue):
+        DataLogger("DataSubscriber"),
+        queueSize(maxQueue ? maxQueue : 1),
+        droppedCnt(0), closed(false)
+{
+    setName(refCount);
+    refCount++;
+}
+
+void DataSubscriber::log()
+{
+    // copy outside of the queue lock.
+    // the source is locked during log()
+    Poco::SharedPtr<DataItem> item(new DataItem(*loggedData()));
+    cloneImages(*item);
+
+    Poco::Mutex::ScopedLock lock(queueMutex);
+
+    if (closed)
+        return;
+
+    if (queue.size() >= queueSize)
+    {
+        queue.pop_front();
+        droppedCnt++;
+    }
+
+    queue.push_back(item);
+    queueCond.signal();
+}
+
+std::set<int> DataSubscriber::supportedInputDataType()
+{
+    std::set<int> ret;
+
+    ret.insert(DataItem::typeInt32);
+    ret.insert(DataItem::typeUInt32);
+    ret.insert(DataItem::typeInt64);
+    ret.insert(DataItem::typeUInt64);
+    ret.insert(DataItem::typeFloat);
+    ret.insert(DataItem::typeDblFloat);
+    ret.insert(DataItem::typeString);
+
+    ret.insert(DataItem::typeInt32 | DataItem::contVector);
+    ret.insert(DataItem::typeUInt32 | DataItem::contVector);
+    ret.insert(DataItem::typeInt64 | DataItem::contVector);
+    ret.insert(DataItem::typeUInt64 | DataItem::contVector);
+    ret.insert(DataItem::typeFloat | DataItem::contVector);
+    ret.insert(DataItem::typeDblFloat | DataItem::contVector);
+    ret.insert(DataItem::typeString | DataItem::contVector);
+
+#ifdef HAVE_OPENCV
+    ret.insert(DataItem::typeCvMat);
+    ret.insert(DataItem::typeCvMat | DataItem::contVector);
+#endif
+
+    return ret;
+}
+
+size_t DataSubscriber::pop(std::vector< Poco::SharedPtr<DataItem> >& items,
+        size_t maxCount, long timeout)
+{
+    Poco::Mutex::ScopedLock lock(queueMutex);
+
+    Poco::Timestamp start;
+
+    while (queue.empty() && !closed)
+    {
+        if (timeout < 0)
+        {
+            queueCond.wait(queueMutex);
+        }
+        else
+        {
+            long remaining = timeout - static_cast<long>(start.elapsed() / 1000);
+            if (remaining <= 0 || !queueCond.tryWait(queueMutex, remaining))
+                return 0;
+        }
+    }
+
+    size_t count = 0;
+    while (!queue.empty() && count < maxCount)
+    {
+        items.push_back(queue.front());
+        queue.pop_front();
+        count++;
+    }
+
+    return count;
+}
+
+size_t DataSubscriber::pending()
+{
+    Poco::Mutex::ScopedLock lock(queueMutex);
+    return queue.size();
+}
+
+size_t DataSubscriber::dropped()
+{
+    Poco::Mutex::ScopedLock lock(queueMutex);
+    return droppedCnt;
+}
+
+void DataSubscriber::close()
+{
+    Poco::Mutex::ScopedLock lock(queueMutex);
+    closed = true;
+    queueCond.broadcast();
+}
+
+bool DataSubscriber::isClosed()
+{
+    Poco::Mutex::ScopedLock lock(queueMutex);
+    return closed;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file	src/dataLoggers/DataSubscriber.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_DATASUBSCRIBER_H_
+#define SRC_DATASUBSCRIBER_H_
+
+#include "core/DataLogger.h"
+
+#include "Poco/Condition.h"
+
+/**
+ * DataSubscriber
+ *
+ * Data logger storing a copy of each new data item in a bounded queue,
+ * to be consumed by a client thread (e.g. a python script iterating
+ * a subscription) via pop().
+ *
+ * The copy is done when the source port notifies its new data, so that
+ * the source is released at once and no item is missed by a slow
+ * consumer, up to the queue size. When the queue is full, the oldest
+ * item is dropped and counted (see dropped()).
+ *
+ * The images are deeply copied too: the DataItem copy constructor
+ * shares the image data, that the source can overwrite or recycle
+ * (e.g. lent camera buffers) once released.
+ *
+ * This logger is not registered in the DataManager: it is created by
+ * the python OutPort.subscribe() method.
+ */
+class DataSubscriber: public DataLogger
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param maxQueue maximum count of items waiting to be popped
+     */
+    DataSubscriber(size_t maxQueue);
+
+    virtual ~DataSubscriber() { }
+
+    std::string description() { return classDescription(); }
+
+    static std::string classDescription()
+        { return "Queue the data to be retrieved by a client"; }
+
+    /**
+     * Move the queued items into the given vector
+     *
+     * Wait for at least one item, then retrieve at most maxCount items
+     * without waiting any further.
+     *
+     * @param items vector to which the items are appended
+     * @param maxCount maximum count of items to retrieve
+     * @param timeout in milliseconds. Negative value: no timeout.
+     * @return count of retrieved items. 0 if the timeout expired,
+     * or if the subscriber is closed and its queue is empty.
+     */
+    size_t pop(std::vector< Poco::SharedPtr<DataItem> >& items,
+            size_t maxCount, long timeout = -1);
+
+    /// Count of the items waiting to be popped
+    size_t pending();
+
+    /// Count of the items dropped because the queue was full
+    size_t dropped();
+
+    /// Maximum count of items waiting to be popped
+    size_t maxQueue() { return queueSize; }
+
+    /**
+     * Stop queuing the new items and wake up the waiting pop()
+     *
+     * The items already queued can still be popped.
+     */
+    void close();
+
+    bool isClosed();
+
+private:
+    static size_t refCount;
+
+    void log();
+
+    std::set<int> supportedInputDataType();
+
+    size_t queueSize;
+    std::deque< Poco::SharedPtr<DataItem> > queue;
+    size_t droppedCnt;
+    bool closed;
+
+    Poco::Mutex queueMutex; ///< protect the queue and the counters
+    Poco::Condition queueCond; ///< signaled on new item or close
+};
+
+#endif /* SRC_DATASUBSCRIBER_H_ */
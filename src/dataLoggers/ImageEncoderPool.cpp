@@ -0,0 +1,176 @@
+/**
+ * @file	src/dataLoggers/ImageEncoderPool.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+
+#include "ImageEncoderPool.h"
+
+#include "core/ThreadManager.h"
+
+#include "Poco/Util/Application.h"
+
+ImageEncoderPool::ImageEncoderPool(EncodeFunction encode, Poco::Logger& logger):
+        encodeFunc(encode),
+        running(0), capacity(8),
+        workerRunnable(*this, &ImageEncoderPool::workerLoop),
+        workers(0), workerCount(2),
+        log(logger)
+{
+}
+
+ImageEncoderPool::~ImageEncoderPool()
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+
+    while (!jobs.empty() || workers)
+        stateChanged.wait(mutex);
+}
+
+bool ImageEncoderPool::push(const Job& job, bool wait)
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+
+    while (jobs.size() >= capacity)
+    {
+        if (!wait)
+            return false;
+
+        stateChanged.wait(mutex);
+    }
+
+    jobs.push_back(job);
+    startWorkers();
+    stateChanged.broadcast();
+
+    if (workers == 0)
+    {
+        // no thread available: encode in the calling thread
+        workers++;
+        Poco::ScopedUnlock<Poco::Mutex> unlock(mutex);
+        workerLoop();
+    }
+
+    return true;
+}
+
+void ImageEncoderPool::startWorkers()
+{
+    while (workers < workerCount && workers < jobs.size() + running)
+    {
+        try
+        {
+            workers++;
+            Poco::Util::Application::instance()
+                .getSubsystem<ThreadManager>()
+                .startRunnable(workerRunnable);
+        }
+        catch (Poco::NoThreadAvailableException&)
+        {
+            workers--;
+            poco_notice(log, "no thread available for the image encoding");
+            return;
+        }
+    }
+}
+
+void ImageEncoderPool::workerLoop()
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+
+    while (!jobs.empty())
+    {
+        Job job = jobs.front();
+        jobs.pop_front();
+        running++;
+        stateChanged.broadcast(); // free slot
+
+        {
+            Poco::ScopedUnlock<Poco::Mutex> unlock(mutex);
+
+            try
+            {
+                encodeFunc(job);
+            }
+            catch (Poco::Exception& e)
+            {
+                poco_error(log, "saving " + job.path + ": " + e.displayText());
+            }
+            catch (std::exception& e)
+            {
+                poco_error(log, "saving " + job.path + ": " + e.what());
+            }
+        }
+
+        running--;
+    }
+
+    workers--;
+    stateChanged.broadcast();
+}
+
+void ImageEncoderPool::setWorkerCount(size_t count)
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+    workerCount = count;
+}
+
+size_t ImageEncoderPool::getWorkerCount()
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+    return workerCount;
+}
+
+void ImageEncoderPool::setCapacity(size_t count)
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+
+    capacity = count ? count : 1;
+    stateChanged.broadcast();
+}
+
+size_t ImageEncoderPool::getCapacity()
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+    return capacity;
+}
+
+size_t ImageEncoderPool::depth()
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+    return jobs.size() + running;
+}
+
+void ImageEncoderPool::flush()
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+
+    while (!jobs.empty() || running)
+        stateChanged.wait(mutex);
+}
+
+#endif /* HAVE_OPENCV */
@@ -0,0 +1,135 @@
+/**
+ * @file	src/dataLoggers/ImageEncoderPool.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_DATALOGGERS_IMAGEENCODERPOOL_H_
+#define SRC_DATALOGGERS_IMAGEENCODERPOOL_H_
+
+#ifdef HAVE_OPENCV
+
+#include "Poco/Logger.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/RunnableAdapter.h"
+
+#include "opencv2/core/core.hpp"
+
+#include <deque>
+#include <vector>
+#include <string>
+
+/**
+ * ImageEncoderPool
+ *
+ * Bounded queue of images to be encoded and saved to files,
+ * served by workers. Used by SaveImageLogger.
+ *
+ * The workers are run by the ThreadManager while there are queued
+ * jobs, so that ThreadManager::waitAll returns once the images
+ * are saved.
+ *
+ * The queued images are references to the images of the dataflow:
+ * they shall not be modified by their producer once delivered.
+ */
+class ImageEncoderPool
+{
+public:
+    /// Encoding job
+    struct Job
+    {
+        cv::Mat image;
+        std::string path; ///< file path. The extension selects the codec
+        int normalize; ///< normalization method, see SaveImageLogger
+        std::vector<int> params; ///< cv::imwrite parameters
+    };
+
+    /// Function called by the workers to process a job
+    typedef void (*EncodeFunction)(const Job& job);
+
+    /**
+     * Constructor
+     *
+     * The workers are started when jobs are queued
+     *
+     * @param encode function processing the jobs
+     * @param logger logger of the owner
+     */
+    ImageEncoderPool(EncodeFunction encode, Poco::Logger& logger);
+
+    /// Wait for the queued images to be encoded
+    virtual ~ImageEncoderPool();
+
+    /**
+     * Queue a job
+     *
+     * @param wait if the queue is full, wait for a free slot (true)
+     * or drop the job (false)
+     * @return false if the job was dropped
+     */
+    bool push(const Job& job, bool wait);
+
+    /// Set the maximum number of concurrent workers
+    void setWorkerCount(size_t count);
+    size_t getWorkerCount();
+
+    /// Set the maximum number of queued jobs (at least 1)
+    void setCapacity(size_t count);
+    size_t getCapacity();
+
+    /// Number of queued and running jobs
+    size_t depth();
+
+    /// Wait until all the queued jobs are processed
+    void flush();
+
+private:
+    ImageEncoderPool();
+
+    /// Worker main loop: process the jobs until the queue is empty
+    void workerLoop();
+
+    /// Start the missing workers. mutex shall be locked
+    void startWorkers();
+
+    EncodeFunction encodeFunc;
+
+    std::deque<Job> jobs;
+    size_t running; ///< jobs being processed
+    size_t capacity;
+
+    Poco::Mutex mutex; ///< lock all the members
+    Poco::Condition stateChanged; ///< job queued, job done or worker exited
+
+    Poco::RunnableAdapter<ImageEncoderPool> workerRunnable;
+    size_t workers; ///< active workers
+    size_t workerCount; ///< maximum number of workers
+
+    Poco::Logger& log;
+};
+
+#endif /* HAVE_OPENCV */
+#endif /* SRC_DATALOGGERS_IMAGEENCODERPOOL_H_ */
@@ -0,0 +1,278 @@
+/**
+ * @file	src/dataLoggers/RawRecordLogger.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+
+#include "RawRecordLogger.h"
+#include "core/DataItem.h"
+#include "core/DataAttribute.h"
+
+#include "Poco/String.h"
+#include "Poco/Timestamp.h"
+#include "Poco/NumberFormatter.h"
+
+#include "opencv2/opencv.hpp"
+
+size_t RawRecordLogger::refCount = 0;
+
+/// Append a list of attribute values to the metadata words
+template <class Container>
+static void appendMeta(std::vector<Poco::UInt64>& meta, const Container& values)
+{
+    meta.push_back(values.size());
+    meta.insert(meta.end(), values.begin(), values.end());
+}
+
+RawRecordLogger::RawRecordLogger():
+        DataLogger("RawRecordLogger"),
+        chunkSize(16), prealloc(0), directIO(false)
+{
+    setName(refCount);
+
+    setParameterCount(paramCnt);
+    addParameter(paramFile, "file", "Container file path. "
+            "Changing it finalizes the current file. "
+            "The new file is created at the next image",
+            ParamItem::typeString, "");
+    addParameter(paramChunkSize, "chunkSize", "Size of each of the two "
+            "write buffers, in MB. Applied at the file creation",
+            ParamItem::typeInteger, "16");
+    addParameter(paramPreallocate, "preallocate", "Disk space to reserve "
+            "at the file creation, in MB. 0 to disable",
+            ParamItem::typeInteger, "0");
+    addParameter(paramDirectIO, "directIO", "Bypass the system cache "
+            "(ON/OFF), if supported. Applied at the file creation",
+            ParamItem::typeString, "OFF");
+    addParameter(paramFramesRecorded, "framesRecorded", "Count of images "
+            "recorded in the current file (read-only)",
+            ParamItem::typeInteger, "0");
+    addParameter(paramThroughput, "throughput", "Mean write throughput "
+            "to the current file, in MB/s (read-only)",
+            ParamItem::typeFloat, "0");
+    addParameter(paramBacklog, "backlog", "Recorded data not yet written "
+            "to the disk, in bytes (read-only)",
+            ParamItem::typeInteger, "0");
+
+    setStrParameterValue(paramFile, getStrParameterDefaultValue(paramFile));
+    setIntParameterValue(paramChunkSize, getIntParameterDefaultValue(paramChunkSize));
+    setIntParameterValue(paramPreallocate, getIntParameterDefaultValue(paramPreallocate));
+    setStrParameterValue(paramDirectIO, getStrParameterDefaultValue(paramDirectIO));
+
+    refCount++;
+}
+
+RawRecordLogger::~RawRecordLogger()
+{
+    try
+    {
+        closeRecord();
+    }
+    catch (Poco::Exception& e)
+    {
+        poco_error(logger(), "unable to finalize the record file: "
+                + e.displayText());
+    }
+}
+
+void RawRecordLogger::log()
+{
+    cv::Mat img = *(loggedData()->getData<cv::Mat>());
+
+    if (!img.data)
+        throw Poco::RuntimeException(name(),"empty image, nothing to record");
+
+    Poco::FastMutex::ScopedLock lock(writerMutex);
+
+    if (!writer.isOpen())
+    {
+        if (filePath.toString().empty())
+            throw Poco::RuntimeException(name(),
+                    "no container file set, see the \"file\" parameter");
+
+        writer.open(filePath.toString(),
+                static_cast<size_t>(chunkSize) << 20,
+                static_cast<Poco::UInt64>(prealloc) << 20,
+                directIO);
+
+        poco_information(logger(), "recording to " + filePath.toString());
+    }
+
+    DataAttribute attr = loggedData()->getDataAttribute();
+
+    std::vector<Poco::UInt64> meta;
+    appendMeta(meta, attr.getIndexes());
+    appendMeta(meta, attr.getAllSequences());
+    appendMeta(meta, attr.getStartingSequences());
+    appendMeta(meta, attr.getEndingSequences());
+
+    writer.append(img, static_cast<Poco::UInt64>(
+                    Poco::Timestamp().epochMicroseconds()) * 1000,
+            meta);
+}
+
+void RawRecordLogger::closeRecord()
+{
+    Poco::FastMutex::ScopedLock lock(writerMutex);
+    closeWriter();
+}
+
+void RawRecordLogger::closeWriter()
+{
+    if (!writer.isOpen())
+        return;
+
+    Poco::UInt64 frames = writer.framesRecorded();
+    writer.close();
+
+    poco_information(logger(), writer.path() + " closed. "
+            + Poco::NumberFormatter::format(frames) + " images recorded");
+}
+
+std::set<int> RawRecordLogger::supportedInputDataType()
+{
+    std::set<int> ret;
+    ret.insert(DataItem::typeCvMat);
+    return ret;
+}
+
+Poco::Int64 RawRecordLogger::getIntParameterValue(size_t paramIndex)
+{
+    switch (paramIndex)
+    {
+    case paramChunkSize:
+        return chunkSize;
+    case paramPreallocate:
+        return prealloc;
+    case paramFramesRecorded:
+        return static_cast<Poco::Int64>(writer.framesRecorded());
+    case paramBacklog:
+        return static_cast<Poco::Int64>(writer.backlog());
+    default:
+        poco_bugcheck_msg("wrong parameter index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void RawRecordLogger::setIntParameterValue(size_t paramIndex, Poco::Int64 value)
+{
+    // read by log() at the container opening
+    Poco::FastMutex::ScopedLock lock(writerMutex);
+
+    switch (paramIndex)
+    {
+    case paramChunkSize:
+        if (value < 1)
+            throw Poco::RangeException("setParameterValue",
+                    "chunkSize has to be at least 1 MB");
+        chunkSize = value;
+        break;
+    case paramPreallocate:
+        if (value < 0)
+            throw Poco::RangeException("setParameterValue",
+                    "preallocate has to be positive");
+        prealloc = value;
+        break;
+    case paramFramesRecorded:
+    case paramBacklog:
+        throw Poco::InvalidAccessException("setParameterValue",
+                "read-only parameter");
+    default:
+        poco_bugcheck_msg("wrong parameter index");
+        throw Poco::BugcheckException();
+    }
+}
+
+double RawRecordLogger::getFloatParameterValue(size_t paramIndex)
+{
+    if (paramIndex != paramThroughput)
+    {
+        poco_bugcheck_msg("wrong parameter index");
+        throw Poco::BugcheckException();
+    }
+
+    return writer.throughput();
+}
+
+void RawRecordLogger::setFloatParameterValue(size_t paramIndex, double value)
+{
+    if (paramIndex != paramThroughput)
+    {
+        poco_bugcheck_msg("wrong parameter index");
+        throw Poco::BugcheckException();
+    }
+
+    throw Poco::InvalidAccessException("setParameterValue",
+            "read-only parameter");
+}
+
+std::string RawRecordLogger::getStrParameterValue(size_t paramIndex)
+{
+    Poco::FastMutex::ScopedLock lock(writerMutex);
+
+    switch (paramIndex)
+    {
+    case paramFile:
+        return filePath.toString();
+    case paramDirectIO:
+        return directIO ? "ON" : "OFF";
+    default:
+        poco_bugcheck_msg("wrong parameter index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void RawRecordLogger::setStrParameterValue(size_t paramIndex, std::string value)
+{
+    // a log() call could open the previous file in between
+    // if the lock was released after the closing
+    Poco::FastMutex::ScopedLock lock(writerMutex);
+
+    switch (paramIndex)
+    {
+    case paramFile:
+        closeWriter();
+        filePath = value;
+        if (!value.empty())
+            filePath.makeAbsolute();
+        break;
+    case paramDirectIO:
+        if (Poco::icompare(value, "ON") == 0)
+            directIO = true;
+        else if (Poco::icompare(value, "OFF") == 0)
+            directIO = false;
+        else
+            throw Poco::InvalidArgumentException("setParameterValue",
+                    "directIO has to be ON or OFF");
+        break;
+    default:
+        poco_bugcheck_msg("wrong parameter index");
+        throw Poco::BugcheckException();
+    }
+}
+
+#endif /* HAVE_OPENCV */
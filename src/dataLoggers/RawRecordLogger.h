@@ -0,0 +1,112 @@
+/**
+ * @file	src/dataLoggers/RawRecordLogger.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_DATALOGGERS_RAWRECORDLOGGER_H_
+#define SRC_DATALOGGERS_RAWRECORDLOGGER_H_
+
+#ifdef HAVE_OPENCV
+
+#include "core/DataLogger.h"
+#include "tools/rawRecord/RawRecordWriter.h"
+
+#include "Poco/Path.h"
+
+/**
+ * RawRecordLogger
+ *
+ * DataLogger to record the raw images and their data attributes
+ * into a single container file, without encoding.
+ * @see tools/rawRecord/RawRecordFormat.h for the file format
+ *
+ * The image is copied into a write buffer, and log() returns without
+ * waiting for the disk: the buffers are written by a background thread.
+ * The source is held until log() returns, unless the snapshot mode of
+ * the DataLogger is enabled (see DataLogger::setSnapshotQueue).
+ *
+ * The container file is created at the first logged image. It is
+ * finalized (index written) when the "file" parameter is changed
+ * or when the logger is deleted.
+ */
+class RawRecordLogger: public DataLogger
+{
+public:
+    RawRecordLogger();
+    virtual ~RawRecordLogger();
+
+    std::string description() { return classDescription(); }
+
+    static std::string classDescription()
+        { return "Record the raw images and their attributes "
+                "in a single container file. "
+                "See parameters description"; }
+
+    void log();
+
+private:
+    static size_t refCount;
+
+    std::set<int> supportedInputDataType();
+
+    enum params
+    {
+        paramFile,
+        paramChunkSize,
+        paramPreallocate,
+        paramDirectIO,
+        paramFramesRecorded,
+        paramThroughput,
+        paramBacklog,
+        paramCnt
+    };
+
+    Poco::Path filePath; ///< container file path
+    Poco::Int64 chunkSize; ///< write buffer size, in MB
+    Poco::Int64 prealloc; ///< disk space to reserve, in MB
+    bool directIO;
+
+    RawRecordWriter writer;
+    Poco::FastMutex writerMutex; ///< lock the writer during log and open/close, and the settings
+
+    /// Finalize the container file, if opened
+    void closeRecord();
+
+    /// closeRecord() logic. writerMutex shall be locked
+    void closeWriter();
+
+    Poco::Int64 getIntParameterValue(size_t paramIndex);
+    void setIntParameterValue(size_t paramIndex, Poco::Int64 value);
+
+    double getFloatParameterValue(size_t paramIndex);
+    void setFloatParameterValue(size_t paramIndex, double value);
+
+    void setStrParameterValue(size_t paramIndex, std::string value);
+    std::string getStrParameterValue(size_t paramIndex);
+};
+
+#endif /* HAVE_OPENCV */
+#endif /* SRC_DATALOGGERS_RAWRECORDLOGGER_H_ */
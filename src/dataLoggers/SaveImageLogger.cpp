@@ -41,10 +41,13 @@ size_t SaveImageLogger::refCount = 0;
 SaveImageLogger::SaveImageLogger():
         DataLogger("SaveImageLogger"),
         nextIndex(1), extension(".png"),
-        prefix("img_"), digits(2), normalize(normDef)
+        prefix("img_"), digits(2), normalize(normDef),
+        compression(-1), dropOnOverflow(false), dropped(0)
 {
     setName(refCount);
 
+    encoders = new ImageEncoderPool(&SaveImageLogger::saveImage, logger());
+
     setParameterCount(paramCnt);
     addParameter(paramDirectory, "directory", "Directory in which to store the images",
             ParamItem::typeString, "");
@@ -60,6 +63,24 @@ SaveImageLogger::SaveImageLogger():
 			"available methods are \"min\", \"max\", \"none\", \"default\". \n"
 			"default is max for float image, none for uchar8 image. ",
 		ParamItem::typeString, "default");
+    addParameter(paramCompression, "compression", "Compression level "
+            "(png: 0 to 9) or quality (jpg, webp: 0 to 100) of the codec. "
+            "The codec is selected by the extension. -1 for the codec default",
+            ParamItem::typeInteger, "-1");
+    addParameter(paramWorkers, "workers", "Count of image encoding threads. "
+            "0 to encode in the logger thread, holding the source",
+            ParamItem::typeInteger, "2");
+    addParameter(paramQueueSize, "queueSize", "Maximum count of images "
+            "waiting to be encoded", ParamItem::typeInteger, "8");
+    addParameter(paramOverflow, "overflow", "Policy when the queue is full: "
+            "\"block\" (wait, holding the source) or \"drop\" (skip the image)",
+            ParamItem::typeString, "block");
+    addParameter(paramQueueDepth, "queueDepth", "Count of images being "
+            "encoded or waiting to be (read-only)",
+            ParamItem::typeInteger, "0");
+    addParameter(paramDropped, "dropped", "Count of images dropped "
+            "because the queue was full (read-only)",
+            ParamItem::typeInteger, "0");
 
 
     setStrParameterValue(paramDirectory, getStrParameterDefaultValue(paramDirectory));
@@ -68,83 +89,128 @@ SaveImageLogger::SaveImageLogger():
     setStrParameterValue(paramExtension, getStrParameterDefaultValue(paramExtension));
     setIntParameterValue(paramNextIndex, getIntParameterDefaultValue(paramNextIndex));
 	setStrParameterValue(paramNormalize, getStrParameterDefaultValue(paramNormalize));
+    setIntParameterValue(paramCompression, getIntParameterDefaultValue(paramCompression));
+    setIntParameterValue(paramWorkers, getIntParameterDefaultValue(paramWorkers));
+    setIntParameterValue(paramQueueSize, getIntParameterDefaultValue(paramQueueSize));
+    setStrParameterValue(paramOverflow, getStrParameterDefaultValue(paramOverflow));
 
     refCount++;
 }
 
 void SaveImageLogger::log()
 {
-    cv::Mat img = *(getDataSource()->getData<cv::Mat>());
+    // reference to the image data, no copy
+    cv::Mat img = *(loggedData()->getData<cv::Mat>());
+
+    if (!img.data)
+        throw Poco::RuntimeException(name(),"empty image, nothing to save");
+
+    Poco::Path imgPath(directory);
 
-    if (img.data)
+    if (digits)
+    {
+        std::string fullIndex = Poco::NumberFormatter::format0(nextIndex, digits);
+        std::string index(fullIndex.end()-digits, fullIndex.end()); // cheap modulo
+        imgPath.append(prefix + index + extension);
+    }
+    else
     {
-        Poco::Path imgPath(directory);
+        imgPath.append(prefix + extension);
+    }
 
-        if (digits)
-        {
-            std::string fullIndex = Poco::NumberFormatter::format0(nextIndex, digits);
-            std::string index(fullIndex.end()-digits, fullIndex.end()); // cheap modulo
-            imgPath.append(prefix + index + extension);
-        }
-        else
-        {
-            imgPath.append(prefix + extension);
-        }
+    // increment parameters
+    nextIndex++;
 
-        if (img.type() == CV_8U && (normalize == normDef || normalize == normNone))
-    		cv::imwrite(imgPath.toString(), img);
-        else
-        {
-			double offset = 0, scaleFactor;
-			cv::Mat tmpImg; // temporary image
-
-			if (img.type() == CV_16U)
-				scaleFactor = 1./255;
-			else
-				scaleFactor = 255;
-
-			if (normalize != normNone)
-			{
-				int norm;
-				if (normalize == normDef)
-					norm = normMax;
-				else
-					norm = normalize;
-
-				double min,max;
-				cv::minMaxLoc(img,&min,&max);
-
-				if ((norm & normMin) == 0)
-					min = 0;
-
-				if (norm & normMax)
-				{
-					if (max-min)
-						scaleFactor = 255.0 / (max-min);
-					else if (max)
-						scaleFactor = 255.0 / max;
-				}
-
-				offset = -min * scaleFactor;
-			}
-
-			img.convertTo(
-					tmpImg,      // output image
-					CV_8U,       // depth
-					scaleFactor, // scale factor
-					offset); // offset (after scaling)
-
-			// save image
-			cv::imwrite(imgPath.toString(), tmpImg);
-        }
+    ImageEncoderPool::Job job;
+    job.image = img;
+    job.path = imgPath.toString();
+    job.normalize = normalize;
+    job.params = writeParams();
 
-        // increment parameters
-        nextIndex++;
+    if (encoders->getWorkerCount() == 0)
+        saveImage(job);
+    else if (!encoders->push(job, !dropOnOverflow))
+    {
+        dropped++;
+        poco_warning(logger(), "encoding queue full, "
+                + job.path + " dropped");
     }
+}
+
+std::vector<int> SaveImageLogger::writeParams()
+{
+    std::vector<int> params;
+
+    if (compression < 0)
+        return params;
+
+    std::string ext = Poco::toLower(extension);
+
+    if (ext == ".png")
+        params.push_back(cv::IMWRITE_PNG_COMPRESSION);
+    else if (ext == ".jpg" || ext == ".jpeg")
+        params.push_back(cv::IMWRITE_JPEG_QUALITY);
+    else if (ext == ".webp")
+        params.push_back(cv::IMWRITE_WEBP_QUALITY);
     else
+        return params;
+
+    params.push_back(static_cast<int>(compression));
+    return params;
+}
+
+void SaveImageLogger::saveImage(const ImageEncoderPool::Job& job)
+{
+    const cv::Mat& img = job.image;
+    int normalize = job.normalize;
+
+    if (img.type() == CV_8U && (normalize == normDef || normalize == normNone))
     {
-        throw Poco::RuntimeException(name(),"empty image, nothing to save");
+        cv::imwrite(job.path, img, job.params);
+        return;
+    }
+
+    double offset = 0, scaleFactor;
+    cv::Mat tmpImg; // temporary image
+
+    if (img.type() == CV_16U)
+        scaleFactor = 1./255;
+    else
+        scaleFactor = 255;
+
+    if (normalize != normNone)
+    {
+        int norm;
+        if (normalize == normDef)
+            norm = normMax;
+        else
+            norm = normalize;
+
+        double min,max;
+        cv::minMaxLoc(img,&min,&max);
+
+        if ((norm & normMin) == 0)
+            min = 0;
+
+        if (norm & normMax)
+        {
+            if (max-min)
+                scaleFactor = 255.0 / (max-min);
+            else if (max)
+                scaleFactor = 255.0 / max;
+        }
+
+        offset = -min * scaleFactor;
     }
+
+    img.convertTo(
+            tmpImg,      // output image
+            CV_8U,       // depth
+            scaleFactor, // scale factor
+            offset); // offset (after scaling)
+
+    // save image
+    cv::imwrite(job.path, tmpImg, job.params);
 }
 
 std::set<int> SaveImageLogger::supportedInputDataType()
@@ -162,6 +228,16 @@ Poco::Int64 SaveImageLogger::getIntParameterValue(size_t paramIndex)
         return digits;
     case paramNextIndex:
         return nextIndex;
+    case paramCompression:
+        return compression;
+    case paramWorkers:
+        return static_cast<Poco::Int64>(encoders->getWorkerCount());
+    case paramQueueSize:
+        return static_cast<Poco::Int64>(encoders->getCapacity());
+    case paramQueueDepth:
+        return static_cast<Poco::Int64>(encoders->depth());
+    case paramDropped:
+        return dropped;
     default:
         poco_bugcheck_msg("wrong parameter index");
         throw Poco::BugcheckException();
@@ -181,6 +257,28 @@ void SaveImageLogger::setIntParameterValue(size_t paramIndex, Poco::Int64 value)
     case paramNextIndex:
         nextIndex = value;
         break;
+    case paramCompression:
+        if (value < -1 || value > 100)
+            throw Poco::RangeException("setParameterValue",
+                    "compression has to be -1 (default) or between 0 and 100");
+        compression = value;
+        break;
+    case paramWorkers:
+        if (value < 0)
+            throw Poco::RangeException("setParameterValue",
+                    "parameter workers has to be positive");
+        encoders->setWorkerCount(static_cast<size_t>(value));
+        break;
+    case paramQueueSize:
+        if (value < 1)
+            throw Poco::RangeException("setParameterValue",
+                    "parameter queueSize has to be at least 1");
+        encoders->setCapacity(static_cast<size_t>(value));
+        break;
+    case paramQueueDepth:
+    case paramDropped:
+        throw Poco::InvalidAccessException("setParameterValue",
+                "read-only parameter");
     default:
         poco_bugcheck_msg("wrong parameter index");
         throw Poco::BugcheckException();
@@ -214,6 +312,8 @@ std::string SaveImageLogger::getStrParameterValue(size_t paramIndex)
 			return ret;
 		}
 		}
+    case paramOverflow:
+        return dropOnOverflow ? "drop" : "block";
     default:
         poco_bugcheck_msg("wrong parameter index");
         throw Poco::BugcheckException();
@@ -253,6 +353,15 @@ void SaveImageLogger::setStrParameterValue(size_t paramIndex, std::string value)
 		throw Poco::InvalidArgumentException("setParameterValue",
 				"normalize has to be \"min\" , \"max\", \"none\" or \"default\". ");
 	}
+    case paramOverflow:
+        if (Poco::icompare(value, "block") == 0)
+            dropOnOverflow = false;
+        else if (Poco::icompare(value, "drop") == 0)
+            dropOnOverflow = true;
+        else
+            throw Poco::InvalidArgumentException("setParameterValue",
+                    "overflow has to be \"block\" or \"drop\"");
+        break;
     default:
         poco_bugcheck_msg("wrong parameter index");
         throw Poco::BugcheckException();
@@ -33,12 +33,23 @@
 
 #include "core/DataLogger.h"
 
+#include "ImageEncoderPool.h"
+
+#include "Poco/SharedPtr.h"
+
 /**
  * SaveImageLogger
  * 
  * DataLogger to save images when hit.
  * The file name increments after each image.
  * @see parameters description
+ *
+ * The images are encoded by a pool of worker threads (workers
+ * parameter), so that the source is released as soon as the image is
+ * queued. The file index is attributed at the queuing: the file names
+ * follow the image order. If the queue is full, log() waits for a free
+ * slot (backpressure on the source) or drops the image (the file
+ * index is skipped), depending on the overflow parameter.
  */
 class SaveImageLogger: public DataLogger
 {
@@ -67,6 +78,12 @@ private:
         paramExtension,
         paramNextIndex,
 		paramNormalize,
+        paramCompression,
+        paramWorkers,
+        paramQueueSize,
+        paramOverflow,
+        paramQueueDepth,
+        paramDropped,
         paramCnt
     };
 
@@ -86,6 +103,18 @@ private:
 
 	int normalize; ///< image normalization method
 
+    Poco::Int64 compression; ///< codec compression level or quality. -1: codec default
+    bool dropOnOverflow; ///< drop the images if the queue is full
+    Poco::Int64 dropped; ///< count of dropped images
+
+    Poco::SharedPtr<ImageEncoderPool> encoders;
+
+    /// cv::imwrite parameters corresponding to the extension and compression
+    std::vector<int> writeParams();
+
+    /// Normalize (see normalization parameter) and save the image
+    static void saveImage(const ImageEncoderPool::Job& job);
+
     Poco::Int64 getIntParameterValue(size_t paramIndex);
     void setIntParameterValue(size_t paramIndex, Poco::Int64 value);
 
@@ -35,7 +35,6 @@
 #include "UI/GuiManager.h"
 #include "UI/GUI/GuiProcessingUnit.h"
 
-#include "Poco/NumberFormatter.h"
 
 #include "opencv2/opencv.hpp"
 
@@ -44,11 +43,13 @@
 #endif
 
 
+#define DEFAULT_DISPLAY_RATE 60 ///< Hz, without GUI
+
 size_t ShowImageLogger::refCount = 0;
-size_t ShowImageLogger::winCount = 0;
 
 ShowImageLogger::ShowImageLogger():
         DataLogger("ShowImageLogger"),
+        lastSnapshot(0),
 		imagePanelIndex(0)
 {
     setName(refCount);
@@ -60,12 +61,16 @@ ShowImageLogger::ShowImageLogger():
 
     setIntParameterValue(paramImagePanel, getIntParameterDefaultValue(paramImagePanel));
 
+    // latest frame wins: the source is released at once, and the
+    // frames arriving while an image is being shown are skipped
+    setSnapshotQueue(1);
+
     refCount++;
 }
 
 void ShowImageLogger::log()
 {
-    cv::Mat img = *(getDataSource()->getData<cv::Mat>());
+    cv::Mat img = *(loggedData()->getData<cv::Mat>());
 
     if (img.data)
     {
@@ -82,14 +87,13 @@ void ShowImageLogger::log()
         else
 #endif /* HAVE_WXWIDGETS */
         {
-            std::string winName = name() + Poco::NumberFormatter::format(winCount++);
-            // create a window for display.
-            cv::namedWindow( winName, cv::WINDOW_AUTOSIZE );
+            // one window per logger, reused for each new image
+            cv::namedWindow( name(), cv::WINDOW_AUTOSIZE );
             // Show our image inside it.
-            cv::imshow( winName, img );
+            cv::imshow( name(), img );
 
-            // take time to effectively display the image
-            cv::waitKey(100);
+            // process the window events to effectively display the image
+            cv::waitKey(1);
         }
     }
     else
@@ -98,6 +102,39 @@ void ShowImageLogger::log()
     }
 }
 
+bool ShowImageLogger::snapshotWanted()
+{
+    double rate = displayRate();
+    if (rate <= 0)
+        return true;
+
+    Poco::Timestamp::TimeDiff period =
+            static_cast<Poco::Timestamp::TimeDiff>(1000000 / rate);
+
+    Poco::FastMutex::ScopedLock lock(snapshotGateMutex);
+
+    // this image would be replaced before being displayed
+    if (lastSnapshot.elapsed() < period)
+        return false;
+
+    lastSnapshot.update();
+    return true;
+}
+
+double ShowImageLogger::displayRate()
+{
+#ifdef HAVE_WXWIDGETS
+    GuiProcessingUnit* guiProc =
+            Poco::Util::Application::instance()
+                .getSubsystem<GuiManager>()
+                .getGuiProcUnit();
+    if (guiProc != NULL)
+        return guiProc->imageRefreshRate(static_cast<int>(imagePanelIndex));
+#endif /* HAVE_WXWIDGETS */
+
+    return DEFAULT_DISPLAY_RATE;
+}
+
 std::set<int> ShowImageLogger::supportedInputDataType()
 {
     std::set<int> ret;
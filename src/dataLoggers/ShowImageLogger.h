@@ -33,10 +33,18 @@
 
 #include "core/DataLogger.h"
 
+#include "Poco/Timestamp.h"
+#include "Poco/Mutex.h"
+
 /**
  * ShowImageLogger
  *
  * Data logger that displays an image
+ *
+ * Works in the snapshot mode with a queue of 1 image:
+ * only the latest image is displayed. The images arriving faster
+ * than the refresh rate of the image panel (or 60Hz without GUI) are
+ * released without being copied.
  */
 class ShowImageLogger: public DataLogger
 {
@@ -52,8 +60,16 @@ public:
     void log();
 
 private:
+    /// false if the previous snapshot is less than a refresh period old
+    bool snapshotWanted();
+
+    /// refresh rate of the display, in Hz
+    double displayRate();
+
+    Poco::Timestamp lastSnapshot;
+    Poco::FastMutex snapshotGateMutex; ///< lock lastSnapshot
+
     static size_t refCount;
-	static size_t winCount;
 
     std::set<int> supportedInputDataType();
 
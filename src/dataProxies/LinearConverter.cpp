@@ -29,11 +29,13 @@
 #include "LinearConverter.h"
 
 #include "Poco/NumberFormatter.h"
+#include "Poco/String.h"
 
 size_t LinearConverter::refCount = 0;
 
 LinearConverter::LinearConverter():
-		DataProxy("LinearConverter")
+		DataProxy("LinearConverter"),
+		alter(false)
 {
 	setName(refCount);
     refCount++;
@@ -41,8 +43,13 @@ LinearConverter::LinearConverter():
 	setParameterCount(paramCnt);
 	addParameter(paramScale, "scale", "scale factor (applied before offset)", ParamItem::typeFloat, "1.0");
 	addParameter(paramOffset, "offset", "offset applied after scaling. ", ParamItem::typeFloat, "0.0");
+	addParameter(paramAlter, "alter", "convert in the input vector (\"yes\"), handed over to the output, "
+			"if the input and output types are the same and this proxy "
+			"is the only consumer of the input, "
+			"or write a separate output vector (\"no\")", ParamItem::typeString, "no");
 	setFloatParameterValue(paramScale, getFloatParameterDefaultValue(paramScale));
 	setFloatParameterValue(paramOffset, getFloatParameterDefaultValue(paramOffset));
+	setStrParameterValue(paramAlter, getStrParameterDefaultValue(paramAlter));
 }
 
 std::set<int> LinearConverter::supportedInputDataType()
@@ -124,161 +131,23 @@ void LinearConverter::convert()
 		switch (noContainerDataType(dataType()))
 		{
 	    case (typeInt32):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorInt32<Poco::Int32>(getData< std::vector<Poco::Int32> >());
-				break;
-			case (typeUInt32):
-				assignVectorInt32<Poco::UInt32>(getData< std::vector<Poco::Int32> >());
-				break;
-			case (typeInt64 ):
-				assignVectorInt32<Poco::Int64>(getData< std::vector<Poco::Int32> >());
-				break;
-			case (typeUInt64):
-				assignVectorInt32<Poco::UInt64>(getData< std::vector<Poco::Int32> >());
-				break;
-			case (typeFloat ):
-				assignVectorInt32<float>(getData< std::vector<Poco::Int32> >());
-				break;
-			case (typeDblFloat):
-				assignVectorInt32<double>(getData< std::vector<Poco::Int32> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<Poco::Int32>();
+	    	break;
 	    case (typeUInt32):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorUInt32<Poco::Int32>(getData< std::vector<Poco::UInt32> >());
-				break;
-			case (typeUInt32):
-				assignVectorUInt32<Poco::UInt32>(getData< std::vector<Poco::UInt32> >());
-				break;
-			case (typeInt64 ):
-				assignVectorUInt32<Poco::Int64>(getData< std::vector<Poco::UInt32> >());
-				break;
-			case (typeUInt64):
-				assignVectorUInt32<Poco::UInt64>(getData< std::vector<Poco::UInt32> >());
-				break;
-			case (typeFloat ):
-				assignVectorUInt32<float>(getData< std::vector<Poco::UInt32> >());
-				break;
-			case (typeDblFloat):
-				assignVectorUInt32<double>(getData< std::vector<Poco::UInt32> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<Poco::UInt32>();
+	    	break;
 	    case (typeInt64):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorInt64<Poco::Int32>(getData< std::vector<Poco::Int64> >());
-				break;
-			case (typeUInt32):
-				assignVectorInt64<Poco::UInt32>(getData< std::vector<Poco::Int64> >());
-				break;
-			case (typeInt64 ):
-				assignVectorInt64<Poco::Int64>(getData< std::vector<Poco::Int64> >());
-				break;
-			case (typeUInt64):
-				assignVectorInt64<Poco::UInt64>(getData< std::vector<Poco::Int64> >());
-				break;
-			case (typeFloat ):
-				assignVectorInt64<float>(getData< std::vector<Poco::Int64> >());
-				break;
-			case (typeDblFloat):
-				assignVectorInt64<double>(getData< std::vector<Poco::Int64> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<Poco::Int64>();
+	    	break;
 	    case (typeUInt64):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorUInt64<Poco::Int32>(getData< std::vector<Poco::UInt64> >());
-				break;
-			case (typeUInt32):
-				assignVectorUInt64<Poco::UInt32>(getData< std::vector<Poco::UInt64> >());
-				break;
-			case (typeInt64 ):
-				assignVectorUInt64<Poco::Int64>(getData< std::vector<Poco::UInt64> >());
-				break;
-			case (typeUInt64):
-				assignVectorUInt64<Poco::UInt64>(getData< std::vector<Poco::UInt64> >());
-				break;
-			case (typeFloat ):
-				assignVectorUInt64<float>(getData< std::vector<Poco::UInt64> >());
-				break;
-			case (typeDblFloat):
-				assignVectorUInt64<double>(getData< std::vector<Poco::UInt64> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<Poco::UInt64>();
+	    	break;
 	    case (typeFloat):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorFloat<Poco::Int32>(getData< std::vector<float> >());
-				break;
-			case (typeUInt32):
-				assignVectorFloat<Poco::UInt32>(getData< std::vector<float> >());
-				break;
-			case (typeInt64 ):
-				assignVectorFloat<Poco::Int64>(getData< std::vector<float> >());
-				break;
-			case (typeUInt64):
-				assignVectorFloat<Poco::UInt64>(getData< std::vector<float> >());
-				break;
-			case (typeFloat ):
-				assignVectorFloat<float>(getData< std::vector<float> >());
-				break;
-			case (typeDblFloat):
-				assignVectorFloat<double>(getData< std::vector<float> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<float>();
+	    	break;
 	    case (typeDblFloat):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorDblFloat<Poco::Int32>(getData< std::vector<double> >());
-				break;
-			case (typeUInt32):
-				assignVectorDblFloat<Poco::UInt32>(getData< std::vector<double> >());
-				break;
-			case (typeInt64 ):
-				assignVectorDblFloat<Poco::Int64>(getData< std::vector<double> >());
-				break;
-			case (typeUInt64):
-				assignVectorDblFloat<Poco::UInt64>(getData< std::vector<double> >());
-				break;
-			case (typeFloat ):
-				assignVectorDblFloat<float>(getData< std::vector<double> >());
-				break;
-			case (typeDblFloat):
-				assignVectorDblFloat<double>(getData< std::vector<double> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<double>();
+	    	break;
 		default:
 			poco_bugcheck_msg("incorrect output data type");
 			throw Poco::BugcheckException();
@@ -480,3 +349,26 @@ void LinearConverter::setFloatParameterValue(size_t paramIndex, double value)
 		throw Poco::BugcheckException();
 	}
 }
+
+std::string LinearConverter::getStrParameterValue(size_t paramIndex)
+{
+	poco_assert(paramIndex == paramAlter);
+
+	if (alter)
+		return "yes";
+	else
+		return "no";
+}
+
+void LinearConverter::setStrParameterValue(size_t paramIndex, std::string value)
+{
+	poco_assert(paramIndex == paramAlter);
+
+	if (Poco::icompare(value, "yes") == 0)
+		alter = true;
+	else if (Poco::icompare(value, "no") == 0)
+		alter = false;
+	else
+		throw Poco::InvalidArgumentException(name() + "::setParameterValue",
+				"\"alter\" parameter value has to be: \"yes\" or \"no\"");
+}
@@ -81,24 +81,46 @@ private:
     template <typename T> float getFloat(const T& data);
     template <typename T> double getDblFloat(const T& data);
 
-    template <typename T> void assignVectorInt32(std::vector<Poco::Int32>* destination);
-    template <typename T> void assignVectorUInt32(std::vector<Poco::UInt32>* destination);
-    template <typename T> void assignVectorInt64(std::vector<Poco::Int64>* destination);
-    template <typename T> void assignVectorUInt64(std::vector<Poco::UInt64>* destination);
-    template <typename T> void assignVectorFloat(std::vector<float>* destination);
-    template <typename T> void assignVectorDblFloat(std::vector<double>* destination);
+    /// Element-wise conversion selected by the output type (tag dispatch)
+    ///@{
+    template <typename T> Poco::Int32 getValue(const T& data, Poco::Int32*);
+    template <typename T> Poco::UInt32 getValue(const T& data, Poco::UInt32*);
+    template <typename T> Poco::Int64 getValue(const T& data, Poco::Int64*);
+    template <typename T> Poco::UInt64 getValue(const T& data, Poco::UInt64*);
+    template <typename T> float getValue(const T& data, float*);
+    template <typename T> double getValue(const T& data, double*);
+    ///@}
+
+    /**
+     * Convert the input vector into the output vector
+     *
+     * The common type pairs are converted by blocks with
+     * linearConvertKernel, the other elements with getValue.
+     *
+     * If alter is set and the types are the same, the input vector
+     * is handed over to the output by swap and converted in place,
+     * provided that this proxy is its only consumer.
+     */
+    template <typename In, typename Out> void convertVector();
+
+    /// Dispatch convertVector on the input data type
+    template <typename Out> void convertVectorTo();
 
 	enum params
 	{
 		paramScale,
 		paramOffset,
+		paramAlter,
 		paramCnt
 	};
 
 	double scale, offset;
+	bool alter; ///< convert in the input vector when possible
 
 	double getFloatParameterValue(size_t paramIndex);
 	void setFloatParameterValue(size_t paramIndex, double value);
+	std::string getStrParameterValue(size_t paramIndex);
+	void setStrParameterValue(size_t paramIndex, std::string value);
 };
 
 #include "LinearConverter.ipp"
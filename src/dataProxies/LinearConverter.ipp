@@ -32,11 +32,25 @@
 #include <limits>
 
 #include "tools/customRound.h"
+#include "tools/linearConvert.h"
 
 //------------//
 //  getInt32  //
 //------------//
 
+template <> inline
+Poco::Int32 LinearConverter::getInt32(const Poco::Int32& data)
+{
+	double ret = data * scale + offset;
+
+	if (ret > std::numeric_limits<Poco::Int32>::max())
+		return std::numeric_limits<Poco::Int32>::max();
+	else if (ret < std::numeric_limits<Poco::Int32>::min())
+		return std::numeric_limits<Poco::Int32>::min();
+	else
+		return static_cast<Poco::Int32>(round(ret));
+}
+
 template <> inline
 Poco::Int32 LinearConverter::getInt32(const Poco::UInt32& data)
 {
@@ -292,27 +306,20 @@ inline Poco::UInt64 LinearConverter::getUInt64(const T& data)
 //  getFloat   //
 //-------------//
 
-template <> inline
-float LinearConverter::getFloat(const double& data)
+template<typename T>
+inline float LinearConverter::getFloat(const T& data)
 {
 	double ret = data * scale + offset;
 
+	// saturated as in linearConvertKernel, whatever the source type
 	if (ret > std::numeric_limits<float>::max())
 		return std::numeric_limits<float>::max();
-	else if (ret < std::numeric_limits<float>::min())
-		return std::numeric_limits<float>::min();
+	else if (ret < -std::numeric_limits<float>::max())
+		return -std::numeric_limits<float>::max();
 	else
 		return static_cast<float>(ret);
 }
 
-template<typename T>
-inline float LinearConverter::getFloat(const T& data)
-{
-	double ret = data * scale + offset;
-
-	return static_cast<float>(ret);
-}
-
 //----------------//
 //  getDblFloat   //
 //----------------//
@@ -325,79 +332,113 @@ inline double LinearConverter::getDblFloat(const T& data)
 	return static_cast<double>(ret);
 }
 
-//-----------------//
-//  assignVector   //
-//-----------------//
+//-------------//
+//  getValue   //
+//-------------//
 
 template<typename T>
-inline void LinearConverter::assignVectorInt32(
-		std::vector<Poco::Int32>* destination)
+inline Poco::Int32 LinearConverter::getValue(const T& data, Poco::Int32*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
-	size_t length = dataIn->size();
-	destination->resize(length);
-
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getInt32<T>((*dataIn)[index]);
+	return getInt32<T>(data);
 }
 
 template<typename T>
-inline void LinearConverter::assignVectorUInt32(
-		std::vector<Poco::UInt32>* destination)
+inline Poco::UInt32 LinearConverter::getValue(const T& data, Poco::UInt32*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
-	size_t length = dataIn->size();
-	destination->resize(length);
-
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getUInt32<T>((*dataIn)[index]);
+	return getUInt32<T>(data);
 }
 
 template<typename T>
-inline void LinearConverter::assignVectorInt64(
-		std::vector<Poco::Int64>* destination)
+inline Poco::Int64 LinearConverter::getValue(const T& data, Poco::Int64*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
-	size_t length = dataIn->size();
-	destination->resize(length);
-
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getInt64<T>((*dataIn)[index]);
+	return getInt64<T>(data);
 }
 
 template<typename T>
-inline void LinearConverter::assignVectorUInt64(
-		std::vector<Poco::UInt64>* destination)
+inline Poco::UInt64 LinearConverter::getValue(const T& data, Poco::UInt64*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
-	size_t length = dataIn->size();
-	destination->resize(length);
-
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getUInt64<T>((*dataIn)[index]);
+	return getUInt64<T>(data);
 }
 
 template<typename T>
-inline void LinearConverter::assignVectorFloat(
-		std::vector<float>* destination)
+inline float LinearConverter::getValue(const T& data, float*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
-	size_t length = dataIn->size();
-	destination->resize(length);
-
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getFloat<T>((*dataIn)[index]);
+	return getFloat<T>(data);
 }
 
 template<typename T>
-inline void LinearConverter::assignVectorDblFloat(
-		std::vector<double>* destination)
+inline double LinearConverter::getValue(const T& data, double*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
+	return getDblFloat<T>(data);
+}
+
+//-----------------//
+//  convertVector  //
+//-----------------//
+
+template<typename In, typename Out>
+inline void LinearConverter::convertVector()
+{
+	std::vector<In>* dataIn = getDataSource()->getData< std::vector<In> >();
+	std::vector<Out>* destination = getData< std::vector<Out> >();
+
 	size_t length = dataIn->size();
-	destination->resize(length);
+	const In* src;
+
+	if (alter && getDataSource()->getDataTargets().size() == 1
+			&& linearConvertSwap(*dataIn, *destination))
+	{
+		// the output holds the input data, converted in place.
+		// The source gets the previous output buffer
+		if (length == 0)
+			return;
+
+		src = reinterpret_cast<const In*>(&(*destination)[0]); // In is Out
+	}
+	else
+	{
+		// no reallocation if the previous output was not smaller
+		destination->resize(length);
 
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getDblFloat<T>((*dataIn)[index]);
+		if (length == 0)
+			return;
+
+		src = &(*dataIn)[0];
+	}
+
+	Out* dst = &(*destination)[0];
+
+	size_t index = linearConvertKernel<In, Out>(src, dst, length, scale, offset);
+
+	for ( ; index < length; index++)
+		dst[index] = getValue<In>(src[index], static_cast<Out*>(NULL));
 }
 
+template<typename Out>
+inline void LinearConverter::convertVectorTo()
+{
+	switch (noContainerDataType(getDataSource()->dataType())) // input ?
+	{
+	case (typeInt32 ):
+		convertVector<Poco::Int32, Out>();
+		break;
+	case (typeUInt32):
+		convertVector<Poco::UInt32, Out>();
+		break;
+	case (typeInt64 ):
+		convertVector<Poco::Int64, Out>();
+		break;
+	case (typeUInt64):
+		convertVector<Poco::UInt64, Out>();
+		break;
+	case (typeFloat ):
+		convertVector<float, Out>();
+		break;
+	case (typeDblFloat):
+		convertVector<double, Out>();
+		break;
+	default:
+		poco_bugcheck_msg("incorrect input data type");
+		throw Poco::BugcheckException();
+	}
+}
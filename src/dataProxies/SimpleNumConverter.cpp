@@ -29,14 +29,23 @@
 #include "SimpleNumConverter.h"
 
 #include "Poco/NumberFormatter.h"
+#include "Poco/String.h"
 
 size_t SimpleNumConverter::refCount = 0;
 
 SimpleNumConverter::SimpleNumConverter():
-		DataProxy("SimpleNumConverter")
+		DataProxy("SimpleNumConverter"),
+		alter(false)
 {
 	setName(refCount);
     refCount++;
+
+	setParameterCount(paramCnt);
+	addParameter(paramAlter, "alter", "hand the input vector over to the output (\"yes\") "
+			"if the input and output types are the same and this proxy "
+			"is the only consumer of the input, "
+			"or write a separate output vector (\"no\")", ParamItem::typeString, "no");
+	setStrParameterValue(paramAlter, getStrParameterDefaultValue(paramAlter));
 }
 
 std::set<int> SimpleNumConverter::supportedInputDataType()
@@ -118,161 +127,23 @@ void SimpleNumConverter::convert()
 		switch (noContainerDataType(dataType()))
 		{
 	    case (typeInt32):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorInt32<Poco::Int32>(getData< std::vector<Poco::Int32> >());
-				break;
-			case (typeUInt32):
-				assignVectorInt32<Poco::UInt32>(getData< std::vector<Poco::Int32> >());
-				break;
-			case (typeInt64 ):
-				assignVectorInt32<Poco::Int64>(getData< std::vector<Poco::Int32> >());
-				break;
-			case (typeUInt64):
-				assignVectorInt32<Poco::UInt64>(getData< std::vector<Poco::Int32> >());
-				break;
-			case (typeFloat ):
-				assignVectorInt32<float>(getData< std::vector<Poco::Int32> >());
-				break;
-			case (typeDblFloat):
-				assignVectorInt32<double>(getData< std::vector<Poco::Int32> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<Poco::Int32>();
+	    	break;
 	    case (typeUInt32):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorUInt32<Poco::Int32>(getData< std::vector<Poco::UInt32> >());
-				break;
-			case (typeUInt32):
-				assignVectorUInt32<Poco::UInt32>(getData< std::vector<Poco::UInt32> >());
-				break;
-			case (typeInt64 ):
-				assignVectorUInt32<Poco::Int64>(getData< std::vector<Poco::UInt32> >());
-				break;
-			case (typeUInt64):
-				assignVectorUInt32<Poco::UInt64>(getData< std::vector<Poco::UInt32> >());
-				break;
-			case (typeFloat ):
-				assignVectorUInt32<float>(getData< std::vector<Poco::UInt32> >());
-				break;
-			case (typeDblFloat):
-				assignVectorUInt32<double>(getData< std::vector<Poco::UInt32> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<Poco::UInt32>();
+	    	break;
 	    case (typeInt64):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorInt64<Poco::Int32>(getData< std::vector<Poco::Int64> >());
-				break;
-			case (typeUInt32):
-				assignVectorInt64<Poco::UInt32>(getData< std::vector<Poco::Int64> >());
-				break;
-			case (typeInt64 ):
-				assignVectorInt64<Poco::Int64>(getData< std::vector<Poco::Int64> >());
-				break;
-			case (typeUInt64):
-				assignVectorInt64<Poco::UInt64>(getData< std::vector<Poco::Int64> >());
-				break;
-			case (typeFloat ):
-				assignVectorInt64<float>(getData< std::vector<Poco::Int64> >());
-				break;
-			case (typeDblFloat):
-				assignVectorInt64<double>(getData< std::vector<Poco::Int64> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<Poco::Int64>();
+	    	break;
 	    case (typeUInt64):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorUInt64<Poco::Int32>(getData< std::vector<Poco::UInt64> >());
-				break;
-			case (typeUInt32):
-				assignVectorUInt64<Poco::UInt32>(getData< std::vector<Poco::UInt64> >());
-				break;
-			case (typeInt64 ):
-				assignVectorUInt64<Poco::Int64>(getData< std::vector<Poco::UInt64> >());
-				break;
-			case (typeUInt64):
-				assignVectorUInt64<Poco::UInt64>(getData< std::vector<Poco::UInt64> >());
-				break;
-			case (typeFloat ):
-				assignVectorUInt64<float>(getData< std::vector<Poco::UInt64> >());
-				break;
-			case (typeDblFloat):
-				assignVectorUInt64<double>(getData< std::vector<Poco::UInt64> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<Poco::UInt64>();
+	    	break;
 	    case (typeFloat):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorFloat<Poco::Int32>(getData< std::vector<float> >());
-				break;
-			case (typeUInt32):
-				assignVectorFloat<Poco::UInt32>(getData< std::vector<float> >());
-				break;
-			case (typeInt64 ):
-				assignVectorFloat<Poco::Int64>(getData< std::vector<float> >());
-				break;
-			case (typeUInt64):
-				assignVectorFloat<Poco::UInt64>(getData< std::vector<float> >());
-				break;
-			case (typeFloat ):
-				assignVectorFloat<float>(getData< std::vector<float> >());
-				break;
-			case (typeDblFloat):
-				assignVectorFloat<double>(getData< std::vector<float> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<float>();
+	    	break;
 	    case (typeDblFloat):
-			switch (noContainerDataType(getDataSource()->dataType())) // input ?
-			{
-			case (typeInt32 ):
-				assignVectorDblFloat<Poco::Int32>(getData< std::vector<double> >());
-				break;
-			case (typeUInt32):
-				assignVectorDblFloat<Poco::UInt32>(getData< std::vector<double> >());
-				break;
-			case (typeInt64 ):
-				assignVectorDblFloat<Poco::Int64>(getData< std::vector<double> >());
-				break;
-			case (typeUInt64):
-				assignVectorDblFloat<Poco::UInt64>(getData< std::vector<double> >());
-				break;
-			case (typeFloat ):
-				assignVectorDblFloat<float>(getData< std::vector<double> >());
-				break;
-			case (typeDblFloat):
-				assignVectorDblFloat<double>(getData< std::vector<double> >());
-				break;
-			default:
-				poco_bugcheck_msg("incorrect input data type");
-				throw Poco::BugcheckException();
-			}
-			break;
+	    	convertVectorTo<double>();
+	    	break;
 		default:
 			poco_bugcheck_msg("incorrect output data type");
 			throw Poco::BugcheckException();
@@ -444,3 +315,26 @@ void SimpleNumConverter::convert()
 		}
 	}
 }
+
+std::string SimpleNumConverter::getStrParameterValue(size_t paramIndex)
+{
+	poco_assert(paramIndex == paramAlter);
+
+	if (alter)
+		return "yes";
+	else
+		return "no";
+}
+
+void SimpleNumConverter::setStrParameterValue(size_t paramIndex, std::string value)
+{
+	poco_assert(paramIndex == paramAlter);
+
+	if (Poco::icompare(value, "yes") == 0)
+		alter = true;
+	else if (Poco::icompare(value, "no") == 0)
+		alter = false;
+	else
+		throw Poco::InvalidArgumentException(name() + "::setParameterValue",
+				"\"alter\" parameter value has to be: \"yes\" or \"no\"");
+}
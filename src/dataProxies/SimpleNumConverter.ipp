@@ -31,6 +31,7 @@
 #include <limits>
 
 #include "tools/customRound.h"
+#include "tools/linearConvert.h"
 
 //------------//
 //  getInt32  //
@@ -249,21 +250,18 @@ inline Poco::UInt64 SimpleNumConverter::getUInt64(const T& data)
 //  getFloat   //
 //-------------//
 
-template <> inline
-float SimpleNumConverter::getFloat(const double& data)
-{
-	if (data > std::numeric_limits<float>::max())
-		return std::numeric_limits<float>::max();
-	else if (data < std::numeric_limits<float>::min())
-		return std::numeric_limits<float>::min();
-	else
-		return static_cast<float>(data);
-}
-
 template<typename T>
 inline float SimpleNumConverter::getFloat(const T& data)
 {
-	return static_cast<float>(data);
+	double ret = static_cast<double>(data);
+
+	// saturated as in linearConvertKernel, whatever the source type
+	if (ret > std::numeric_limits<float>::max())
+		return std::numeric_limits<float>::max();
+	else if (ret < -std::numeric_limits<float>::max())
+		return -std::numeric_limits<float>::max();
+	else
+		return static_cast<float>(ret);
 }
 
 //----------------//
@@ -276,79 +274,105 @@ inline double SimpleNumConverter::getDblFloat(const T& data)
 	return static_cast<double>(data);
 }
 
-//-----------------//
-//  assignVector   //
-//-----------------//
+//-------------//
+//  getValue   //
+//-------------//
 
 template<typename T>
-inline void SimpleNumConverter::assignVectorInt32(
-		std::vector<Poco::Int32>* destination)
+inline Poco::Int32 SimpleNumConverter::getValue(const T& data, Poco::Int32*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
-	size_t length = dataIn->size();
-	destination->resize(length);
-
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getInt32<T>((*dataIn)[index]);
+	return getInt32<T>(data);
 }
 
 template<typename T>
-inline void SimpleNumConverter::assignVectorUInt32(
-		std::vector<Poco::UInt32>* destination)
+inline Poco::UInt32 SimpleNumConverter::getValue(const T& data, Poco::UInt32*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
-	size_t length = dataIn->size();
-	destination->resize(length);
-
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getUInt32<T>((*dataIn)[index]);
+	return getUInt32<T>(data);
 }
 
 template<typename T>
-inline void SimpleNumConverter::assignVectorInt64(
-		std::vector<Poco::Int64>* destination)
+inline Poco::Int64 SimpleNumConverter::getValue(const T& data, Poco::Int64*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
-	size_t length = dataIn->size();
-	destination->resize(length);
-
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getInt64<T>((*dataIn)[index]);
+	return getInt64<T>(data);
 }
 
 template<typename T>
-inline void SimpleNumConverter::assignVectorUInt64(
-		std::vector<Poco::UInt64>* destination)
+inline Poco::UInt64 SimpleNumConverter::getValue(const T& data, Poco::UInt64*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
-	size_t length = dataIn->size();
-	destination->resize(length);
-
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getUInt64<T>((*dataIn)[index]);
+	return getUInt64<T>(data);
 }
 
 template<typename T>
-inline void SimpleNumConverter::assignVectorFloat(
-		std::vector<float>* destination)
+inline float SimpleNumConverter::getValue(const T& data, float*)
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
-	size_t length = dataIn->size();
-	destination->resize(length);
-
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getFloat<T>((*dataIn)[index]);
+	return getFloat<T>(data);
 }
 
 template<typename T>
-inline void SimpleNumConverter::assignVectorDblFloat(
-		std::vector<double>* destination)
+inline double SimpleNumConverter::getValue(const T& data, double*)
+{
+	return getDblFloat<T>(data);
+}
+
+//-----------------//
+//  convertVector  //
+//-----------------//
+
+template<typename In, typename Out>
+inline void SimpleNumConverter::convertVector()
 {
-	std::vector<T>* dataIn = getDataSource()->getData< std::vector<T> >();
+	std::vector<In>* dataIn = getDataSource()->getData< std::vector<In> >();
+	std::vector<Out>* destination = getData< std::vector<Out> >();
+
+	// same type: the input data are handed over, nothing to convert.
+	// The source gets the previous output buffer
+	if (alter && getDataSource()->getDataTargets().size() == 1
+			&& linearConvertSwap(*dataIn, *destination))
+		return;
+
+	// no reallocation if the previous output was not smaller
 	size_t length = dataIn->size();
 	destination->resize(length);
 
-	for (size_t index = 0; index < length; index++)
-		(*destination)[index] = getDblFloat<T>((*dataIn)[index]);
+	if (length == 0)
+		return;
+
+	const In* src = &(*dataIn)[0];
+	Out* dst = &(*destination)[0];
+
+	// x * 1.0 + (-0.0) is exactly x, even for -0.0: plain cast
+	// for the pairs supported by the kernel (exact through double)
+	size_t index = linearConvertKernel<In, Out>(src, dst, length, 1.0, -0.0);
+
+	for ( ; index < length; index++)
+		dst[index] = getValue<In>(src[index], static_cast<Out*>(NULL));
 }
 
+template<typename Out>
+inline void SimpleNumConverter::convertVectorTo()
+{
+	switch (noContainerDataType(getDataSource()->dataType())) // input ?
+	{
+	case (typeInt32 ):
+		convertVector<Poco::Int32, Out>();
+		break;
+	case (typeUInt32):
+		convertVector<Poco::UInt32, Out>();
+		break;
+	case (typeInt64 ):
+		convertVector<Poco::Int64, Out>();
+		break;
+	case (typeUInt64):
+		convertVector<Poco::UInt64, Out>();
+		break;
+	case (typeFloat ):
+		convertVector<float, Out>();
+		break;
+	case (typeDblFloat):
+		convertVector<double, Out>();
+		break;
+	default:
+		poco_bugcheck_msg("incorrect input data type");
+		throw Poco::BugcheckException();
+	}
+}
@@ -30,12 +30,14 @@
 
 #include "UnstackArrayFactory.h"
 #include "SeqAccumulatorFactory.h"
+#include "SeqReducerFactory.h"
 
 std::vector<std::string> DataShapingFactory::selectValueList()
 {
 	std::vector<std::string> list;
 	list.push_back("unstack");
 	list.push_back("accu");
+	list.push_back("reduce");
 	return list;
 }
 
@@ -45,6 +47,8 @@ ModuleFactoryBranch* DataShapingFactory::newChildFactory(std::string selector)
         return new UnstackArrayFactory(this, selector);
     if (selector.compare("accu") == 0)
         return new SeqAccumulatorFactory(this, selector);
+    if (selector.compare("reduce") == 0)
+        return new SeqReducerFactory(this, selector);
     else
         return NULL;
 }
@@ -0,0 +1,119 @@
+/**
+ * @file	src/modules/control/ImageSpillFile.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+
+#include "ImageSpillFile.h"
+
+#include "Poco/Exception.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+#include <linux/magic.h>
+#endif
+
+ImageSpillFile::ImageSpillFile(std::string directory, size_t capacity,
+        int rows, int cols, int type):
+    file(directory), // system temporary directory if empty
+    frameCount(capacity),
+    frameRows(rows), frameCols(cols), frameType(type),
+    frameSize(static_cast<size_t>(rows) * cols * CV_ELEM_SIZE(type))
+{
+    if (frameCount == 0 || frameSize == 0)
+        throw Poco::InvalidArgumentException("ImageSpillFile",
+                "empty image stack");
+
+    file.createFile();
+    file.setSize(static_cast<Poco::File::FileSize>(frameCount) * frameSize);
+
+    mapping = Poco::SharedMemory(file, Poco::SharedMemory::AM_WRITE);
+
+    if (static_cast<size_t>(mapping.end() - mapping.begin()) < frameCount * frameSize)
+        throw Poco::FileException(file.path(), "unable to map "
+                + Poco::NumberFormatter::format(frameCount * frameSize) + " bytes");
+}
+
+void ImageSpillFile::store(size_t index, const cv::Mat& image, cv::Mat& stored)
+{
+    if (index >= frameCount)
+        throw Poco::RangeException("ImageSpillFile", "image index out of range");
+
+    if (image.rows != frameRows || image.cols != frameCols
+            || image.type() != frameType)
+        throw Poco::InvalidArgumentException("ImageSpillFile",
+                "the image format differs from the stack format");
+
+    char* pixels = mapping.begin() + index * frameSize;
+
+    cv::Mat frame(frameRows, frameCols, frameType, pixels);
+    image.copyTo(frame);
+
+#ifdef __linux__
+    // drop the pages from the process. They stay in the page cache,
+    // to be written back and reclaimed by the system
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t begin = (reinterpret_cast<size_t>(pixels) + page - 1) / page * page;
+    size_t end = (reinterpret_cast<size_t>(pixels) + frameSize) / page * page;
+    if (end > begin)
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+#endif
+
+    lend(pixels, frameSize, frameRows, frameCols, frameType, stored);
+}
+
+std::string ImageSpillFile::defaultDirectory()
+{
+#ifdef __linux__
+    Poco::File varTmp("/var/tmp/");
+    if (varTmp.exists() && varTmp.isDirectory() && varTmp.canWrite()
+            && !onRamFileSystem(varTmp.path()))
+        return varTmp.path();
+#endif
+
+    return Poco::Path::temp();
+}
+
+bool ImageSpillFile::onRamFileSystem(const std::string& directory)
+{
+#ifdef __linux__
+    struct statfs info;
+    std::string path(directory.empty() ? Poco::Path::temp() : directory);
+
+    if (statfs(path.c_str(), &info) == 0)
+        return info.f_type == TMPFS_MAGIC || info.f_type == RAMFS_MAGIC;
+#endif
+
+    return false;
+}
+
+#endif /* HAVE_OPENCV */
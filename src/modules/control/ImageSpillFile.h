@@ -0,0 +1,114 @@
+/**
+ * @file	src/modules/control/ImageSpillFile.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_MODULES_CONTROL_IMAGESPILLFILE_H_
+#define SRC_MODULES_CONTROL_IMAGESPILLFILE_H_
+
+#ifdef HAVE_OPENCV
+
+#include "tools/LentMatAllocator.h"
+
+#include "Poco/SharedMemory.h"
+#include "Poco/TemporaryFile.h"
+
+#include "opencv2/core/core.hpp"
+
+/**
+ * ImageSpillFile
+ *
+ * Stack of images of the same size and type, stored in a temporary
+ * file mapped in memory. Used by the SeqAccumulator beyond its memory
+ * budget.
+ *
+ * The stored images are lent as cv::Mat headers pointing into the
+ * mapping: they are read back from the file when accessed, and their
+ * pages can be reclaimed by the system at any time. Each lent cv::Mat
+ * holds a reference to the spill file (see LentMatAllocator), so that
+ * the file is removed when the last image is released.
+ *
+ * On linux, the pages of a stored image are unmapped from the process
+ * right after the copy, so that the resident memory does not grow
+ * with the stack.
+ */
+class ImageSpillFile: public LentMatAllocator
+{
+public:
+    /**
+     * Create and map the temporary file
+     *
+     * @param directory directory of the temporary file.
+     * If empty, the system temporary directory is used.
+     * @param capacity count of images of the stack
+     * @param rows, cols, type image format
+     * @throw Poco::FileException if the file can not be created or mapped
+     */
+    ImageSpillFile(std::string directory, size_t capacity,
+            int rows, int cols, int type);
+
+    size_t capacity() { return frameCount; }
+
+    /**
+     * Default directory of the spill files
+     *
+     * /var/tmp on linux, if it is not on a RAM file system:
+     * the system temporary directory is often a tmpfs.
+     * Else, the system temporary directory.
+     */
+    static std::string defaultDirectory();
+
+    /**
+     * Check if the directory is on a RAM file system
+     *
+     * Spilling there does not relieve the memory.
+     * Only detected on linux (tmpfs, ramfs).
+     */
+    static bool onRamFileSystem(const std::string& directory);
+
+    /**
+     * Copy the image into the stack and lend its stored copy
+     *
+     * @param index image index in the stack
+     * @param image image to copy. Its format shall be the stack format.
+     * @param stored header on the stored copy
+     */
+    void store(size_t index, const cv::Mat& image, cv::Mat& stored);
+
+protected:
+    ~ImageSpillFile() { }
+
+private:
+    Poco::TemporaryFile file; ///< removed when destroyed, after the mapping
+    Poco::SharedMemory mapping;
+
+    size_t frameCount;
+    int frameRows, frameCols, frameType;
+    size_t frameSize; ///< in bytes
+};
+
+#endif /* HAVE_OPENCV */
+#endif /* SRC_MODULES_CONTROL_IMAGESPILLFILE_H_ */
@@ -29,6 +29,16 @@
 #include "SeqAccumulator.h"
 
 #include "Poco/NumberFormatter.h"
+#include "Poco/String.h"
+
+#ifdef HAVE_OPENCV
+#include "Poco/DeflatingStream.h"
+#include "Poco/InflatingStream.h"
+
+#include <sstream>
+#endif
+
+#include <algorithm>
 
 size_t SeqAccumulator::refCount = 0;
 
@@ -36,7 +46,12 @@ SeqAccumulator::SeqAccumulator(ModuleFactory* parent, std::string customName, in
 	Module(parent, customName),
 	mDataType(dataType),
 	dataStore(dataType | DataItem::contVector),
-	seqIndex(0)
+	seqIndex(0),
+#ifdef HAVE_OPENCV
+	frameRows(0), frameCols(0), frameType(0), stackCount(0),
+	memoryFrames(0), spillCount(0), deflatedSize(0),
+#endif
+	capacity(0), lastCount(0), memoryBudget(0), compress(false)
 {
     if (refCount)
         setInternalName("SeqAccumulator" + Poco::NumberFormatter::format(refCount));
@@ -52,6 +67,34 @@ SeqAccumulator::SeqAccumulator(ModuleFactory* parent, std::string customName, in
     setOutPortCount(outPortCnt);
     addOutPort("array", "Output the array of elements of one sequence", mDataType | DataItem::contVector, arrayOutPort);
 
+    // parameters
+    setParameterCount(paramCnt);
+    addParameter(paramCapacity,
+            "capacity",
+            "Expected count of elements of a sequence, to preallocate the array, "
+            "e.g. the seqSize of the sequence generator. "
+            "If 0: the length of the previous sequence is used. ",
+            ParamItem::typeInteger, "0");
+    addParameter(paramMemoryBudget,
+            "memoryBudget",
+            "Maximum size of the images of one sequence kept in memory, in MiB. "
+            "Beyond it, the images are spilled to temporary files mapped in memory. "
+            "If 0: no limit. ",
+            ParamItem::typeInteger, "0");
+    addParameter(paramSpillDirectory,
+            "spillDirectory",
+            "Directory of the temporary spill files. Should be on a disk, "
+            "not on a RAM file system. "
+            "If empty: /var/tmp on linux, else the system temporary directory. ",
+            ParamItem::typeString, "");
+    addParameter(paramCompression,
+            "compression",
+            "Compression of the images beyond half of the memory budget, "
+            "before spilling: \"none\" or \"deflate\" (lossless, zlib) ",
+            ParamItem::typeString, "none");
+
+    setParametersDefaultValue();
+
     notifyCreation();
 
     // if nothing failed
@@ -114,108 +157,292 @@ void SeqAccumulator::process(int startCond)
         writeOutData();
 
         notifyOutPortReady(arrayOutPort, outAttr);
+
+        clearStore();
     }
 }
 
+size_t SeqAccumulator::expectedCount()
+{
+	if (capacity > 0)
+		return static_cast<size_t>(capacity);
+	else
+		return lastCount;
+}
+
 void SeqAccumulator::appendDataToStore()
 {
     switch (DataItem::noContainerDataType(mDataType))
     {
     case DataItem::typeInt32:
-    {
-    	Poco::Int32* pData;
-    	readInPortData<Poco::Int32>(dataInPort, pData);
-    	dataStore.getData< std::vector<Poco::Int32> >()->push_back(*pData);
+    	appendToStore<Poco::Int32>();
     	break;
-    }
     case DataItem::typeUInt32:
-    {
-    	Poco::UInt32* pData;
-    	readInPortData<Poco::UInt32>(dataInPort, pData);
-    	dataStore.getData< std::vector<Poco::UInt32> >()->push_back(*pData);
+    	appendToStore<Poco::UInt32>();
     	break;
-    }
     case DataItem::typeInt64:
-    {
-    	Poco::Int64* pData;
-    	readInPortData<Poco::Int64>(dataInPort, pData);
-    	dataStore.getData< std::vector<Poco::Int64> >()->push_back(*pData);
+    	appendToStore<Poco::Int64>();
     	break;
-    }
     case DataItem::typeUInt64:
-    {
-    	Poco::UInt64* pData;
-    	readInPortData<Poco::UInt64>(dataInPort, pData);
-    	dataStore.getData< std::vector<Poco::UInt64> >()->push_back(*pData);
+    	appendToStore<Poco::UInt64>();
     	break;
-    }
 
 #ifdef HAVE_OPENCV
     case DataItem::typeCvMat:
     {
     	cv::Mat* pData;
     	readInPortData<cv::Mat>(dataInPort, pData);
-    	dataStore.getData< std::vector<cv::Mat> >()->push_back(*pData);
+    	appendImageToStore(*pData);
     	break;
     }
 #endif
     case DataItem::typeFloat:
-    {
-    	float* pData;
-    	readInPortData<float>(dataInPort, pData);
-    	dataStore.getData< std::vector<float> >()->push_back(*pData);
+    	appendToStore<float>();
     	break;
-    }
     case DataItem::typeDblFloat:
-    {
-    	double* pData;
-    	readInPortData<double>(dataInPort, pData);
-    	dataStore.getData< std::vector<double> >()->push_back(*pData);
+    	appendToStore<double>();
     	break;
-    }
     case DataItem::typeString:
-    {
-    	std::string* pData;
-    	readInPortData<std::string>(dataInPort, pData);
-    	dataStore.getData< std::vector<std::string> >()->push_back(*pData);
+    	appendToStore<std::string>();
     	break;
-    }
     default:
     	throw Poco::NotImplementedException("SeqAccumulator",
     			"data type not supported");
     }
 }
 
+#ifdef HAVE_OPENCV
+void SeqAccumulator::appendImageToStore(cv::Mat& image)
+{
+	std::vector<cv::Mat>* pStore = dataStore.getData< std::vector<cv::Mat> >();
+
+	if (image.empty() || image.dims > 2)
+	{
+		pStore->push_back(image.clone());
+		return;
+	}
+
+	if (imageStack.empty() && spill.isNull() && deflated.empty())
+	{
+		frameRows = image.rows;
+		frameCols = image.cols;
+		frameType = image.type();
+
+		allocateStack(std::max<size_t>(expectedCount(), 1));
+	}
+
+	if (image.rows != frameRows || image.cols != frameCols
+			|| image.type() != frameType)
+	{
+		poco_warning(logger(), name() + ": image size or type change "
+				"in the sequence. The image is not stacked. ");
+		pStore->push_back(image.clone());
+		return;
+	}
+
+	if (compress && spill.isNull() && stackCount == stackCapacity()
+			&& memoryFrames >= frameBudget()
+			&& deflatedSize < static_cast<size_t>(memoryBudget) * 1024 * 1024 / 2)
+	{
+		deflateImage(image);
+		return;
+	}
+
+	if (stackCount == stackCapacity()
+			&& (spill.isNull() || spillCount == spill->capacity()))
+		growStack();
+
+	cv::Mat stored;
+
+	if (stackCount < stackCapacity())
+	{
+		stored = stackFrame(stackCount++);
+		image.copyTo(stored);
+	}
+	else
+	{
+		spill->store(spillCount++, image, stored);
+	}
+
+	pStore->push_back(stored);
+}
+
+size_t SeqAccumulator::frameBudget()
+{
+	if (memoryBudget == 0)
+		return static_cast<size_t>(-1);
+
+	size_t frameSize = static_cast<size_t>(frameRows) * frameCols
+			* CV_ELEM_SIZE(frameType);
+
+	size_t budget = static_cast<size_t>(memoryBudget) * 1024 * 1024;
+	if (compress)
+		budget /= 2; // the other half is for the deflated images
+
+	return budget / frameSize;
+}
+
+void SeqAccumulator::deflateImage(const cv::Mat& image)
+{
+	std::ostringstream buffer;
+
+	{
+		// fastest zlib level
+		Poco::DeflatingOutputStream deflater(buffer,
+				Poco::DeflatingStreamBuf::STREAM_ZLIB, 1);
+
+		size_t rowSize = static_cast<size_t>(frameCols) * CV_ELEM_SIZE(frameType);
+		for (int row = 0; row < frameRows; row++)
+			deflater.write(reinterpret_cast<const char*>(image.ptr(row)),
+					static_cast<std::streamsize>(rowSize));
+
+		deflater.close();
+	}
+
+	std::vector<cv::Mat>* pStore = dataStore.getData< std::vector<cv::Mat> >();
+
+	deflated.push_back(buffer.str());
+	deflatedIndex.push_back(pStore->size());
+	deflatedSize += deflated.back().size();
+
+	// placeholder
+	pStore->push_back(cv::Mat());
+}
+
+void SeqAccumulator::inflateImages()
+{
+	if (deflated.empty())
+		return;
+
+	std::vector<cv::Mat>* pStore = dataStore.getData< std::vector<cv::Mat> >();
+
+	Poco::AutoPtr<ImageSpillFile> target = newSpillFile(deflated.size());
+
+	cv::Mat frame(frameRows, frameCols, frameType);
+	std::streamsize frameSize = static_cast<std::streamsize>(frame.total() * frame.elemSize());
+
+	for (size_t index = 0; index < deflated.size(); index++)
+	{
+		std::istringstream buffer(deflated[index]);
+		Poco::InflatingInputStream inflater(buffer,
+				Poco::InflatingStreamBuf::STREAM_ZLIB);
+
+		inflater.read(reinterpret_cast<char*>(frame.data), frameSize);
+		if (inflater.gcount() != frameSize)
+			throw Poco::DataFormatException(name(),
+					"unable to inflate a stored image");
+
+		// release the memory as soon as possible
+		std::string().swap(deflated[index]);
+
+		target->store(index, frame, pStore->at(deflatedIndex[index]));
+	}
+
+	deflated.clear();
+	deflatedIndex.clear();
+	deflatedSize = 0;
+}
+
+Poco::AutoPtr<ImageSpillFile> SeqAccumulator::newSpillFile(size_t count)
+{
+	return new ImageSpillFile(spillPath, count,
+			frameRows, frameCols, frameType);
+}
+
+void SeqAccumulator::allocateStack(size_t count)
+{
+	stackCount = 0;
+	spill = Poco::AutoPtr<ImageSpillFile>();
+	spillCount = 0;
+
+	size_t inMemory = std::min(count, frameBudget());
+	memoryFrames = inMemory;
+
+	if (inMemory)
+		imageStack.create(static_cast<int>(inMemory) * frameRows,
+				frameCols, frameType);
+
+	// with compression, the spill file is only created
+	// once the deflated images reach their budget
+	if (count > inMemory && !compress)
+	{
+		poco_information(logger(), name() + ": memory budget reached, "
+				"spilling the images to a temporary file");
+		spill = newSpillFile(count - inMemory);
+	}
+}
+
+void SeqAccumulator::growStack()
+{
+	std::vector<cv::Mat>* pStore = dataStore.getData< std::vector<cv::Mat> >();
+
+	// double the capacity
+	size_t more = std::max<size_t>(pStore->size(), 1);
+	size_t room = frameBudget() - memoryFrames;
+
+	if (spill.isNull() && room)
+	{
+		// new in-memory segment. The previous segments are kept
+		// by the headers of the stored images: nothing is copied
+		imageStack = cv::Mat(static_cast<int>(std::min(more, room)) * frameRows,
+				frameCols, frameType);
+		memoryFrames += stackCapacity();
+		stackCount = 0;
+	}
+	else
+	{
+		// the in-memory segments and the previous spill files are kept
+		// by the stored headers
+		poco_information(logger(), name() + ": memory budget reached, "
+				"spilling the next images to a new temporary file");
+		spill = newSpillFile(more);
+		spillCount = 0;
+	}
+}
+#endif
+
 void SeqAccumulator::clearStore()
 {
+	size_t expected = expectedCount();
+
     switch (DataItem::noContainerDataType(mDataType))
     {
     case DataItem::typeInt32:
-    	dataStore.getData< std::vector<Poco::Int32> >()->clear();
+    	clearStore<Poco::Int32>(expected);
     	break;
     case DataItem::typeUInt32:
-    	dataStore.getData< std::vector<Poco::UInt32> >()->clear();
+    	clearStore<Poco::UInt32>(expected);
     	break;
     case DataItem::typeInt64:
-    	dataStore.getData< std::vector<Poco::Int64> >()->clear();
+    	clearStore<Poco::Int64>(expected);
     	break;
     case DataItem::typeUInt64:
-    	dataStore.getData< std::vector<Poco::UInt64> >()->clear();
+    	clearStore<Poco::UInt64>(expected);
     	break;
 
 #ifdef HAVE_OPENCV
     case DataItem::typeCvMat:
-    	dataStore.getData< std::vector<cv::Mat> >()->clear();
+    	clearStore<cv::Mat>(expected);
+    	// the sent images keep the previous stack alive,
+    	// a new one is allocated on the next image
+    	imageStack.release();
+    	stackCount = 0;
+    	memoryFrames = 0;
+    	spill = Poco::AutoPtr<ImageSpillFile>();
+    	spillCount = 0;
+    	deflated.clear();
+    	deflatedIndex.clear();
+    	deflatedSize = 0;
     	break;
 #endif
     case DataItem::typeFloat:
-    	dataStore.getData< std::vector<float> >()->clear();
+    	clearStore<float>(expected);
     	break;
     case DataItem::typeDblFloat:
-    	dataStore.getData< std::vector<double> >()->clear();
+    	clearStore<double>(expected);
     	break;
     case DataItem::typeString:
-    	dataStore.getData< std::vector<std::string> >()->clear();
+    	clearStore<std::string>(expected);
     	break;
     default:
     	throw Poco::NotImplementedException("SeqAccumulator",
@@ -228,64 +455,41 @@ void SeqAccumulator::writeOutData()
     switch (DataItem::noContainerDataType(mDataType))
     {
     case DataItem::typeInt32:
-    {
-    	std::vector<Poco::Int32>* pData;
-    	getDataToWrite< std::vector<Poco::Int32> >(arrayOutPort, pData);
-    	*pData = std::vector<Poco::Int32>(*dataStore.getData< std::vector<Poco::Int32> >());
+    	lastCount = dataStore.getData< std::vector<Poco::Int32> >()->size();
+    	swapStoreToOut<Poco::Int32>();
     	break;
-    }
     case DataItem::typeUInt32:
-    {
-    	std::vector<Poco::UInt32>* pData;
-    	getDataToWrite< std::vector<Poco::UInt32> >(arrayOutPort, pData);
-    	*pData = std::vector<Poco::UInt32>(*dataStore.getData< std::vector<Poco::UInt32> >());
+    	lastCount = dataStore.getData< std::vector<Poco::UInt32> >()->size();
+    	swapStoreToOut<Poco::UInt32>();
     	break;
-    }
     case DataItem::typeInt64:
-    {
-    	std::vector<Poco::Int64>* pData;
-    	getDataToWrite< std::vector<Poco::Int64> >(arrayOutPort, pData);
-    	*pData = std::vector<Poco::Int64>(*dataStore.getData< std::vector<Poco::Int64> >());
+    	lastCount = dataStore.getData< std::vector<Poco::Int64> >()->size();
+    	swapStoreToOut<Poco::Int64>();
     	break;
-    }
     case DataItem::typeUInt64:
-    {
-    	std::vector<Poco::UInt64>* pData;
-    	getDataToWrite< std::vector<Poco::UInt64> >(arrayOutPort, pData);
-    	*pData = std::vector<Poco::UInt64>(*dataStore.getData< std::vector<Poco::UInt64> >());
+    	lastCount = dataStore.getData< std::vector<Poco::UInt64> >()->size();
+    	swapStoreToOut<Poco::UInt64>();
     	break;
-    }
 
 #ifdef HAVE_OPENCV
     case DataItem::typeCvMat:
-    {
-    	std::vector<cv::Mat>* pData;
-    	getDataToWrite< std::vector<cv::Mat> >(arrayOutPort, pData);
-    	*pData = std::vector<cv::Mat>(*dataStore.getData< std::vector<cv::Mat> >());
+    	inflateImages();
+    	lastCount = dataStore.getData< std::vector<cv::Mat> >()->size();
+    	swapStoreToOut<cv::Mat>();
     	break;
-    }
 #endif
     case DataItem::typeFloat:
-    {
-    	std::vector<float>* pData;
-    	getDataToWrite< std::vector<float> >(arrayOutPort, pData);
-    	*pData = std::vector<float>(*dataStore.getData< std::vector<float> >());
+    	lastCount = dataStore.getData< std::vector<float> >()->size();
+    	swapStoreToOut<float>();
     	break;
-    }
     case DataItem::typeDblFloat:
-    {
-    	std::vector<double>* pData;
-    	getDataToWrite< std::vector<double> >(arrayOutPort, pData);
-    	*pData = std::vector<double>(*dataStore.getData< std::vector<double> >());
+    	lastCount = dataStore.getData< std::vector<double> >()->size();
+    	swapStoreToOut<double>();
     	break;
-    }
     case DataItem::typeString:
-    {
-    	std::vector<std::string>* pData;
-    	getDataToWrite< std::vector<std::string> >(arrayOutPort, pData);
-    	*pData = std::vector<std::string>(*dataStore.getData< std::vector<std::string> >());
+    	lastCount = dataStore.getData< std::vector<std::string> >()->size();
+    	swapStoreToOut<std::string>();
     	break;
-    }
     default:
     	throw Poco::NotImplementedException("SeqAccumulator",
     			"data type not supported");
@@ -297,3 +501,82 @@ void SeqAccumulator::reset()
 	clearStore();
 	seqIndex = 0;
 }
+
+Poco::Int64 SeqAccumulator::getIntParameterValue(size_t paramIndex)
+{
+    switch(paramIndex)
+    {
+    case paramCapacity:
+        return capacity;
+    case paramMemoryBudget:
+        return memoryBudget;
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void SeqAccumulator::setIntParameterValue(size_t paramIndex, Poco::Int64 value)
+{
+    switch(paramIndex)
+    {
+    case paramCapacity:
+        if (value<0)
+            throw Poco::RangeException("setParameterValue",
+                    "capacity has to be positive or null");
+        capacity = value;
+        break;
+    case paramMemoryBudget:
+        if (value<0)
+            throw Poco::RangeException("setParameterValue",
+                    "memoryBudget has to be positive or null");
+        memoryBudget = value;
+        break;
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
+
+std::string SeqAccumulator::getStrParameterValue(size_t paramIndex)
+{
+    switch(paramIndex)
+    {
+    case paramSpillDirectory:
+        return spillDirectory;
+    case paramCompression:
+        return compress ? "deflate" : "none";
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void SeqAccumulator::setStrParameterValue(size_t paramIndex, std::string value)
+{
+    switch(paramIndex)
+    {
+    case paramSpillDirectory:
+#ifdef HAVE_OPENCV
+        spillPath = value.empty() ? ImageSpillFile::defaultDirectory() : value;
+        if (ImageSpillFile::onRamFileSystem(spillPath))
+            poco_warning(logger(), name() + ": the spill directory " + spillPath
+                    + " is on a RAM file system. "
+                    "Spilling there does not relieve the memory. ");
+#endif
+        spillDirectory = value;
+        break;
+    case paramCompression:
+        if (Poco::icompare(value, "none") == 0)
+            compress = false;
+        else if (Poco::icompare(value, "deflate") == 0)
+            compress = true;
+        else
+            throw Poco::InvalidArgumentException("setParameterValue",
+                    "compression shall be \"none\" or \"deflate\"");
+        break;
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
@@ -33,10 +33,33 @@
 
 #include "core/TypeNeutralData.h"
 
+#ifdef HAVE_OPENCV
+#include "ImageSpillFile.h"
+
+#include "Poco/AutoPtr.h"
+#endif
+
 /**
  * SeqAccumulator
  *
  * Transform a data sequence into an array.
+ *
+ * The store is preallocated with the expected element count (capacity
+ * parameter, or length of the previous sequence), and handed over to
+ * the output port by swap at the end of the sequence.
+ *
+ * The images are copied into a preallocated stack: one contiguous
+ * segment when the expected count is right, more segments else. The
+ * output array elements share the stack data.
+ *
+ * Beyond the memory budget, the images are spilled to temporary files
+ * mapped in memory (see ImageSpillFile): the output elements are then
+ * read back from the disk when accessed.
+ *
+ * With compression, the raw images only get half of the budget. The
+ * next images are deflated in memory, in the other half, before
+ * spilling. They are inflated into a spill file at the end of the
+ * sequence, so that the output array stays a lazily read stack.
  */
 class SeqAccumulator: public Module
 {
@@ -60,16 +83,106 @@ private:
      */
     void appendDataToStore();
 
+    /// Append the input port data to the store vector of T
+    template <typename T>
+    void appendToStore();
+
     /**
      * Clear the vector contained in dataStore
+     *
+     * and reserve the expected element count
      */
     void clearStore();
 
+    /// Clear the store vector of T and reserve the expected count
+    template <typename T>
+    void clearStore(size_t expected);
+
     /**
      * Send data array to the outPort
+     *
+     * The store content is swapped with the previous output array.
      */
     void writeOutData();
 
+    /// Swap the store vector of T with the output port data
+    template <typename T>
+    void swapStoreToOut();
+
+    /// Expected element count of the current sequence
+    size_t expectedCount();
+
+#ifdef HAVE_OPENCV
+    /**
+     * Copy the image into the stack and append a header on its copy
+     * to the store
+     *
+     * The stack is allocated on the first image of the sequence,
+     * and extended by a new segment when full.
+     * An image which size or type differs from the first image
+     * of the sequence is cloned out of the stack.
+     */
+    void appendImageToStore(cv::Mat& image);
+
+    /**
+     * Allocate the stack for the given count of images
+     *
+     * in memory up to the memory budget, then in a spill file
+     */
+    void allocateStack(size_t count);
+
+    /**
+     * Extend the full stack
+     *
+     * A new in-memory segment, doubling the capacity, is allocated
+     * within the memory budget. Else, a new spill file is created for
+     * the next images. The stored images are never moved.
+     */
+    void growStack();
+
+    /// Count of raw images of the stack format that fit in the memory budget
+    size_t frameBudget();
+
+    /**
+     * Deflate the image in memory and append a placeholder to the store
+     *
+     * The placeholder is replaced by inflateImages()
+     */
+    void deflateImage(const cv::Mat& image);
+
+    /**
+     * Inflate the deflated images into a spill file
+     *
+     * and replace their placeholders in the store by headers on the
+     * spill file. Called at the end of the sequence.
+     */
+    void inflateImages();
+
+    /// Create a spill file for the given count of images of the stack format
+    Poco::AutoPtr<ImageSpillFile> newSpillFile(size_t count);
+
+    /// Count of images that the current in-memory segment can hold
+    size_t stackCapacity()
+    	{ return frameRows ? static_cast<size_t>(imageStack.rows / frameRows) : 0; }
+
+    /// Header on the image of the given index in the current segment
+    cv::Mat stackFrame(size_t index)
+    	{ return imageStack.rowRange(static_cast<int>(index) * frameRows,
+    			static_cast<int>(index + 1) * frameRows); }
+
+    cv::Mat imageStack; ///< current in-memory segment of the stack
+    int frameRows, frameCols, frameType; ///< format of the stacked images
+    size_t stackCount; ///< count of images stored in imageStack
+    size_t memoryFrames; ///< count of images allocated in memory for the sequence
+
+    Poco::AutoPtr<ImageSpillFile> spill; ///< current spill file, if any
+    size_t spillCount; ///< count of images stored in the current spill file
+
+    std::vector<std::string> deflated; ///< deflated images of the sequence
+    std::vector<size_t> deflatedIndex; ///< index of the deflated images in the store
+    size_t deflatedSize; ///< total size of the deflated images, in bytes
+#endif
+
     bool seqRunning()
     {
     	poco_information(logger(), name() + " seqRunning request");
@@ -92,10 +205,34 @@ private:
         outPortCnt
     };
 
+    enum params
+    {
+        paramCapacity,
+        paramMemoryBudget,
+        paramSpillDirectory,
+        paramCompression,
+        paramCnt
+    };
+
+    Poco::Int64 getIntParameterValue(size_t paramIndex);
+    void setIntParameterValue(size_t paramIndex, Poco::Int64 value);
+    std::string getStrParameterValue(size_t paramIndex);
+    void setStrParameterValue(size_t paramIndex, std::string value);
+
     size_t seqIndex;
     TypeNeutralData dataStore; ///< array to accumulate the seq data
 
     int mDataType;
+
+    Poco::Int64 capacity; ///< expected count of elements. 0: use lastCount
+    size_t lastCount; ///< element count of the previous sequence
+
+    Poco::Int64 memoryBudget; ///< in MiB. 0: no limit
+    std::string spillDirectory; ///< empty: ImageSpillFile::defaultDirectory
+    std::string spillPath; ///< resolved spill directory
+    bool compress; ///< deflate the images beyond half of the memory budget
 };
 
+#include "SeqAccumulator.ipp"
+
 #endif /* SRC_MODULES_CONTROL_SEQACCUMULATOR_H_ */
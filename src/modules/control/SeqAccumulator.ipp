@@ -0,0 +1,58 @@
+/**
+ * @file	src/modules/control/SeqAccumulator.ipp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "SeqAccumulator.h"
+
+template <typename T>
+void SeqAccumulator::appendToStore()
+{
+	T* pData;
+	readInPortData<T>(dataInPort, pData);
+	dataStore.getData< std::vector<T> >()->push_back(*pData);
+}
+
+template <typename T>
+void SeqAccumulator::clearStore(size_t expected)
+{
+	std::vector<T>* pStore = dataStore.getData< std::vector<T> >();
+
+	// clear() keeps the capacity
+	pStore->clear();
+	pStore->reserve(expected);
+}
+
+template <typename T>
+void SeqAccumulator::swapStoreToOut()
+{
+	std::vector<T>* pData;
+	getDataToWrite< std::vector<T> >(arrayOutPort, pData);
+
+	// the store gets the previous output array,
+	// that is cleared right after the notification (see process)
+	pData->swap(*dataStore.getData< std::vector<T> >());
+}
@@ -0,0 +1,414 @@
+/**
+ * @file	src/modules/control/SeqReducer.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "SeqReducer.h"
+
+#include "Poco/NumberFormatter.h"
+
+size_t SeqReducer::refCount = 0;
+
+SeqReducer::SeqReducer(ModuleFactory* parent, std::string customName,
+		Operation operation, int dataType):
+	Module(parent, customName),
+	mOperation(operation),
+	mDataType(dataType),
+	extremum(dataType),
+	seqIndex(0),
+	count(0), argIndex(0),
+	mean(0), m2(0), sum(0)
+{
+    if (refCount)
+        setInternalName("SeqReducer" + Poco::NumberFormatter::format(refCount));
+    else
+        setInternalName("SeqReducer");
+
+    setCustomName(customName);
+    setLogger("module." + name());
+
+    setInPortCount(inPortCnt);
+    addInPort("elements", "seq data to be reduced", mDataType, dataInPort);
+
+    setOutPortCount(outPortCnt);
+    addOutPort("result", "Output the " + operationName(mOperation)
+    		+ " of the elements of one sequence",
+    		outputDataType(mOperation, mDataType), resultOutPort);
+
+    notifyCreation();
+
+    // if nothing failed
+    refCount++;
+}
+
+std::string SeqReducer::description()
+{
+	std::string descr = DataItem::dataTypeStr(mDataType);
+	descr += " data sequence reducer Module. \n"
+			"The " + operationDescription(mOperation) + " \n"
+			"of the elements of the input sequence is computed \n"
+			"on the fly and sent to the output at the sequence end. ";
+	return descr;
+}
+
+std::string SeqReducer::operationName(Operation operation)
+{
+	switch (operation)
+	{
+	case opMin:
+		return "min";
+	case opMax:
+		return "max";
+	case opArgMin:
+		return "argmin";
+	case opArgMax:
+		return "argmax";
+	case opSum:
+		return "sum";
+	case opMean:
+		return "mean";
+	case opStd:
+		return "std";
+	default:
+		poco_bugcheck_msg("SeqReducer: unknown operation");
+		throw Poco::BugcheckException();
+	}
+}
+
+std::string SeqReducer::operationDescription(Operation operation)
+{
+	switch (operation)
+	{
+	case opMin:
+		return "minimum";
+	case opMax:
+		return "maximum";
+	case opArgMin:
+		return "index of the minimum";
+	case opArgMax:
+		return "index of the maximum";
+	case opSum:
+		return "sum";
+	case opMean:
+		return "mean";
+	case opStd:
+		return "standard deviation";
+	default:
+		poco_bugcheck_msg("SeqReducer: unknown operation");
+		throw Poco::BugcheckException();
+	}
+}
+
+int SeqReducer::outputDataType(Operation operation, int dataType)
+{
+#ifdef HAVE_OPENCV
+	if (dataType == DataItem::typeCvMat)
+		return DataItem::typeCvMat;
+#endif
+
+	switch (operation)
+	{
+	case opMin:
+	case opMax:
+		return dataType;
+	case opArgMin:
+	case opArgMax:
+		return DataItem::typeInt64;
+	default:
+		return DataItem::typeDblFloat;
+	}
+}
+
+void SeqReducer::process(int startCond)
+{
+    if (startCond == noDataStartState)
+    {
+        poco_information(logger(), name() + ": no input data. Exiting. ");
+        return;
+    }
+
+    DataAttributeIn attr;
+    readLockInPort(dataInPort);
+    readInPortDataAttribute(dataInPort, &attr);
+
+    bool end = false;
+
+    if (attr.isStartSequence(seqIndex))
+    {
+        poco_information(logger(), name() + ": sequence starting");
+        count = 0;
+    }
+
+    if (attr.isInSequence(seqIndex))
+    {
+        if (attr.isEndSequence(seqIndex))
+        {
+        	poco_information(logger(), name() + ": sequence ending");
+        	end = true;
+        }
+    }
+    else
+    {
+        end = true; // reduce 1 element
+        count = 0;
+    }
+
+    updateState();
+
+    releaseInPort(dataInPort);
+
+    if (end)
+    {
+        DataAttributeOut outAttr = attr;
+
+        reserveOutPort(resultOutPort);
+        writeOutData();
+
+        notifyOutPortReady(resultOutPort, outAttr);
+
+        count = 0;
+    }
+}
+
+void SeqReducer::updateState()
+{
+	if (count == 0)
+	{
+		argIndex = 0;
+		mean = 0;
+		m2 = 0;
+		sum = 0;
+	}
+
+    switch (mDataType)
+    {
+    case DataItem::typeInt32:
+    	updateScalar<Poco::Int32>();
+    	break;
+    case DataItem::typeUInt32:
+    	updateScalar<Poco::UInt32>();
+    	break;
+    case DataItem::typeInt64:
+    	updateScalar<Poco::Int64>();
+    	break;
+    case DataItem::typeUInt64:
+    	updateScalar<Poco::UInt64>();
+    	break;
+    case DataItem::typeFloat:
+    	updateScalar<float>();
+    	break;
+    case DataItem::typeDblFloat:
+    	updateScalar<double>();
+    	break;
+
+#ifdef HAVE_OPENCV
+    case DataItem::typeCvMat:
+    {
+    	cv::Mat* pData;
+    	readInPortData<cv::Mat>(dataInPort, pData);
+    	updateImage(*pData);
+    	break;
+    }
+#endif
+    default:
+    	throw Poco::NotImplementedException("SeqReducer",
+    			"data type not supported");
+    }
+}
+
+#ifdef HAVE_OPENCV
+void SeqReducer::updateImage(cv::Mat& image)
+{
+	if (count && (image.size() != stateImage.size()
+			|| image.channels() != stateImage.channels()))
+		throw Poco::DataFormatException("SeqReducer",
+				"the image size changed in the sequence");
+
+	switch (mOperation)
+	{
+	case opMin:
+	case opMax:
+		if (count == 0)
+			image.copyTo(stateImage);
+		else if (image.type() != stateImage.type())
+			throw Poco::DataFormatException("SeqReducer",
+					"the image type changed in the sequence");
+		else if (mOperation == opMin)
+			cv::min(stateImage, image, stateImage);
+		else
+			cv::max(stateImage, image, stateImage);
+		break;
+
+	case opArgMin:
+	case opArgMax:
+		if (image.channels() != 1)
+			throw Poco::NotImplementedException("SeqReducer",
+					"argmin and argmax need single channel images");
+
+		if (count == 0)
+		{
+			image.copyTo(stateImage);
+			indexImage.create(image.size(), CV_32S);
+			indexImage.setTo(cv::Scalar(0));
+		}
+		else
+		{
+			if (image.type() != stateImage.type())
+				throw Poco::DataFormatException("SeqReducer",
+						"the image type changed in the sequence");
+
+			cv::compare(image, stateImage, mask,
+					(mOperation == opArgMin) ? cv::CMP_LT : cv::CMP_GT);
+			image.copyTo(stateImage, mask);
+			indexImage.setTo(cv::Scalar(static_cast<double>(count)), mask);
+		}
+		break;
+
+	case opSum:
+	case opMean:
+	case opStd:
+		if (count == 0)
+		{
+			stateImage.create(image.size(), CV_MAKETYPE(CV_64F, image.channels()));
+			stateImage.setTo(cv::Scalar::all(0));
+			if (mOperation == opStd)
+			{
+				stateSqImage.create(image.size(), stateImage.type());
+				stateSqImage.setTo(cv::Scalar::all(0));
+			}
+		}
+
+		// in place accumulation
+		if (image.depth() == CV_8U || image.depth() == CV_16U
+				|| image.depth() == CV_32F || image.depth() == CV_64F)
+		{
+			cv::accumulate(image, stateImage);
+			if (mOperation == opStd)
+				cv::accumulateSquare(image, stateSqImage);
+		}
+		else
+		{
+			cv::Mat converted;
+			image.convertTo(converted, CV_64F);
+			cv::accumulate(converted, stateImage);
+			if (mOperation == opStd)
+				cv::accumulateSquare(converted, stateSqImage);
+		}
+		break;
+
+	default:
+		poco_bugcheck_msg("SeqReducer: unknown operation");
+		throw Poco::BugcheckException();
+	}
+
+	count++;
+}
+
+void SeqReducer::writeImage()
+{
+	cv::Mat* pData;
+	getDataToWrite<cv::Mat>(resultOutPort, pData);
+
+	switch (mOperation)
+	{
+	case opMin:
+	case opMax:
+	case opSum:
+		// the state is reallocated at the next sequence start
+		*pData = stateImage;
+		stateImage = cv::Mat();
+		break;
+	case opArgMin:
+	case opArgMax:
+		*pData = indexImage;
+		indexImage = cv::Mat();
+		break;
+	case opMean:
+	{
+		// new image: the previous result may still be shared
+		cv::Mat meanImage;
+		stateImage.convertTo(meanImage, CV_64F, 1.0 / static_cast<double>(count));
+		*pData = meanImage;
+		break;
+	}
+	case opStd:
+	{
+		// var = E[x^2] - E[x]^2
+		cv::Mat meanImage, stdImage;
+		stateImage.convertTo(meanImage, CV_64F, 1.0 / static_cast<double>(count));
+		stateSqImage.convertTo(stdImage, CV_64F, 1.0 / static_cast<double>(count));
+		stdImage -= meanImage.mul(meanImage);
+		stdImage = cv::max(stdImage, 0.0); // rounding errors
+		cv::sqrt(stdImage, stdImage);
+		*pData = stdImage;
+		break;
+	}
+	default:
+		poco_bugcheck_msg("SeqReducer: unknown operation");
+		throw Poco::BugcheckException();
+	}
+}
+#endif
+
+void SeqReducer::writeOutData()
+{
+    switch (mDataType)
+    {
+    case DataItem::typeInt32:
+    	writeScalar<Poco::Int32>();
+    	break;
+    case DataItem::typeUInt32:
+    	writeScalar<Poco::UInt32>();
+    	break;
+    case DataItem::typeInt64:
+    	writeScalar<Poco::Int64>();
+    	break;
+    case DataItem::typeUInt64:
+    	writeScalar<Poco::UInt64>();
+    	break;
+    case DataItem::typeFloat:
+    	writeScalar<float>();
+    	break;
+    case DataItem::typeDblFloat:
+    	writeScalar<double>();
+    	break;
+
+#ifdef HAVE_OPENCV
+    case DataItem::typeCvMat:
+    	writeImage();
+    	break;
+#endif
+    default:
+    	throw Poco::NotImplementedException("SeqReducer",
+    			"data type not supported");
+    }
+}
+
+void SeqReducer::reset()
+{
+	count = 0;
+	seqIndex = 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file	src/modules/control/SeqReducer.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_MODULES_CONTROL_SEQREDUCER_H_
+#define SRC_MODULES_CONTROL_SEQREDUCER_H_
+
+#include "core/Module.h"
+
+#include "core/TypeNeutralData.h"
+
+/**
+ * SeqReducer
+ *
+ * Reduce a data sequence to one element (min, max, argmin, argmax,
+ * sum, mean, standard deviation), without storing the sequence.
+ *
+ * The reduction state is updated with each element, and the result is
+ * sent when the sequence ends. An element out of a sequence is reduced
+ * alone.
+ *
+ * The images are reduced pixel-wise:
+ *  - min, max: image of the input type
+ *  - argmin, argmax: CV_32S image of the sequence indexes
+ *    (single channel images only)
+ *  - sum, mean, std: CV_64F image
+ *
+ * The scalar results are:
+ *  - min, max: input type
+ *  - argmin, argmax: 64-bit integer index in the sequence
+ *  - sum, mean, std: double float
+ *
+ * std is the population standard deviation.
+ */
+class SeqReducer: public Module
+{
+public:
+    /// Reduction operations
+    enum Operation
+    {
+        opMin,
+        opMax,
+        opArgMin,
+        opArgMax,
+        opSum,
+        opMean,
+        opStd,
+        opCnt
+    };
+
+	SeqReducer(ModuleFactory* parent, std::string customName,
+			Operation operation, int dataType);
+
+    std::string description();
+
+    /// Selector of the operation, e.g. "argmax"
+    static std::string operationName(Operation operation);
+
+    /// Description of the operation
+    static std::string operationDescription(Operation operation);
+
+    /**
+     * Output data type given the operation and the input data type
+     */
+    static int outputDataType(Operation operation, int dataType);
+
+private:
+    static size_t refCount; ///< reference counter to generate a unique internal name
+
+    /**
+     * Main logic
+     */
+    void process(int startCond);
+
+    /**
+     * Update the reduction state with the input element
+     *
+     * use the reserved input port
+     */
+    void updateState();
+
+    /// Update the reduction state with a scalar of type T
+    template <typename T>
+    void updateScalar();
+
+    /// Send the result of a scalar reduction of type T
+    template <typename T>
+    void writeScalar();
+
+    /// Send the result of the reduction to the outPort
+    void writeOutData();
+
+#ifdef HAVE_OPENCV
+    /// Update the pixel-wise reduction state with the input image
+    void updateImage(cv::Mat& image);
+
+    /// Send the result of a pixel-wise reduction
+    void writeImage();
+
+    cv::Mat stateImage; ///< extremum or sum image
+    cv::Mat stateSqImage; ///< sum of the squares (std)
+    cv::Mat indexImage; ///< argmin/argmax indexes
+    cv::Mat mask; ///< pixels to update (argmin/argmax)
+#endif
+
+    bool seqRunning()
+    {
+    	poco_information(logger(), name() + " seqRunning request");
+    	return seqIndex != 0;
+    }
+
+    void reset();
+
+    /// Indexes of the input ports
+    enum inPorts
+    {
+        dataInPort,
+        inPortCnt
+    };
+
+    /// Indexes of the output ports
+    enum outPorts
+    {
+        resultOutPort,
+        outPortCnt
+    };
+
+    size_t seqIndex;
+
+    Operation mOperation;
+    int mDataType;
+
+    Poco::Int64 count; ///< count of reduced elements
+    Poco::Int64 argIndex; ///< index of the extremum (argmin, argmax)
+    TypeNeutralData extremum; ///< min or max scalar, of the input type
+    double mean; ///< running mean (Welford)
+    double m2; ///< running sum of the squared deviations (Welford)
+    double sum;
+};
+
+#include "SeqReducer.ipp"
+
+#endif /* SRC_MODULES_CONTROL_SEQREDUCER_H_ */
@@ -0,0 +1,120 @@
+/**
+ * @file	src/modules/control/SeqReducer.ipp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "SeqReducer.h"
+
+#include <cmath>
+
+template <typename T>
+void SeqReducer::updateScalar()
+{
+	T* pData;
+	readInPortData<T>(dataInPort, pData);
+
+	T* pExtremum = extremum.getData<T>();
+
+	switch (mOperation)
+	{
+	case opMin:
+	case opArgMin:
+		if (count == 0 || *pData < *pExtremum)
+		{
+			*pExtremum = *pData;
+			argIndex = count;
+		}
+		break;
+	case opMax:
+	case opArgMax:
+		if (count == 0 || *pData > *pExtremum)
+		{
+			*pExtremum = *pData;
+			argIndex = count;
+		}
+		break;
+	default:
+	{
+		double value = static_cast<double>(*pData);
+		double delta = value - mean;
+
+		sum += value;
+		mean += delta / static_cast<double>(count + 1);
+		m2 += delta * (value - mean);
+		break;
+	}
+	}
+
+	count++;
+}
+
+template <typename T>
+void SeqReducer::writeScalar()
+{
+	switch (mOperation)
+	{
+	case opMin:
+	case opMax:
+	{
+		T* pData;
+		getDataToWrite<T>(resultOutPort, pData);
+		*pData = *extremum.getData<T>();
+		break;
+	}
+	case opArgMin:
+	case opArgMax:
+	{
+		Poco::Int64* pData;
+		getDataToWrite<Poco::Int64>(resultOutPort, pData);
+		*pData = argIndex;
+		break;
+	}
+	case opSum:
+	{
+		double* pData;
+		getDataToWrite<double>(resultOutPort, pData);
+		*pData = sum;
+		break;
+	}
+	case opMean:
+	{
+		double* pData;
+		getDataToWrite<double>(resultOutPort, pData);
+		*pData = mean;
+		break;
+	}
+	case opStd:
+	{
+		double* pData;
+		getDataToWrite<double>(resultOutPort, pData);
+		*pData = count ? sqrt(m2 / static_cast<double>(count)) : 0;
+		break;
+	}
+	default:
+		poco_bugcheck_msg("SeqReducer: unknown operation");
+		throw Poco::BugcheckException();
+	}
+}
@@ -34,7 +34,8 @@ size_t UnstackArray::refCount = 0;
 
 UnstackArray::UnstackArray(ModuleFactory* parent, std::string customName, int dataType):
 	Module(parent, customName),
-	mDataType(dataType)
+	mDataType(dataType),
+	chunkSize(0)
 {
     if (refCount)
         setInternalName("UnstackArray" + Poco::NumberFormatter::format(refCount));
@@ -49,6 +50,18 @@ UnstackArray::UnstackArray(ModuleFactory* parent, std::string customName, int da
 
     setOutPortCount(outPortCnt);
     addOutPort("elements", "Output the array elements in a sequence", mDataType, dataOutPort);
+    addOutPort("chunks", "Output the array by chunks of chunkSize elements, "
+    		"in a sequence", mDataType | DataItem::contVector, chunkOutPort);
+
+    // parameters
+    setParameterCount(paramCnt);
+    addParameter(paramChunkSize,
+            "chunkSize",
+            "Count of elements of the sub-arrays sent to the chunks port. "
+            "If 0 or 1: the elements are sent one by one to the elements port. ",
+            ParamItem::typeInteger, "0");
+
+    setParametersDefaultValue();
 
     notifyCreation();
 
@@ -61,7 +74,9 @@ std::string UnstackArray::description()
 	std::string descr = DataItem::dataTypeStr(mDataType);
 	descr += " array unstacking Module. \n"
 			"The lements of the input array are unstacked \n"
-			"and sent as a sequence to the output. ";
+			"and sent as a sequence to the output. \n"
+			"With chunkSize > 1, they are sent as a sequence \n"
+			"of sub-arrays to the chunks output instead. ";
 	return descr;
 }
 
@@ -80,66 +95,62 @@ void UnstackArray::process(int startCond)
     switch (DataItem::noContainerDataType(mDataType))
     {
     case DataItem::typeInt32:
-    {
-    	std::vector<Poco::Int32>* pData;
-    	readInPortData< std::vector<Poco::Int32> >(arrayInPort, pData);
-    	sendData<Poco::Int32>(*pData, attr);
+    	unstack<Poco::Int32>(attr);
     	break;
-    }
     case DataItem::typeUInt32:
-    {
-    	std::vector<Poco::UInt32>* pData;
-    	readInPortData< std::vector<Poco::UInt32> >(arrayInPort, pData);
-    	sendData<Poco::UInt32>(*pData, attr);
+    	unstack<Poco::UInt32>(attr);
     	break;
-    }
     case DataItem::typeInt64:
-    {
-    	std::vector<Poco::Int64>* pData;
-    	readInPortData< std::vector<Poco::Int64> >(arrayInPort, pData);
-    	sendData<Poco::Int64>(*pData, attr);
+    	unstack<Poco::Int64>(attr);
     	break;
-    }
     case DataItem::typeUInt64:
-    {
-    	std::vector<Poco::UInt64>* pData;
-    	readInPortData< std::vector<Poco::UInt64> >(arrayInPort, pData);
-    	sendData<Poco::UInt64>(*pData, attr);
+    	unstack<Poco::UInt64>(attr);
     	break;
-    }
 
 #ifdef HAVE_OPENCV
     case DataItem::typeCvMat:
-    {
-    	std::vector<cv::Mat>* pData;
-    	readInPortData< std::vector<cv::Mat> >(arrayInPort, pData);
-    	sendData<cv::Mat>(*pData, attr);
+    	unstack<cv::Mat>(attr);
     	break;
-    }
 #endif
     case DataItem::typeFloat:
-    {
-    	std::vector<float>* pData;
-    	readInPortData< std::vector<float> >(arrayInPort, pData);
-    	sendData<float>(*pData, attr);
+    	unstack<float>(attr);
     	break;
-    }
     case DataItem::typeDblFloat:
-    {
-    	std::vector<double>* pData;
-    	readInPortData< std::vector<double> >(arrayInPort, pData);
-    	sendData<double>(*pData, attr);
+    	unstack<double>(attr);
     	break;
-    }
     case DataItem::typeString:
-    {
-    	std::vector<std::string>* pData;
-    	readInPortData< std::vector<std::string> >(arrayInPort, pData);
-    	sendData<std::string>(*pData, attr);
+    	unstack<std::string>(attr);
     	break;
-    }
     default:
     	throw Poco::NotImplementedException("UnstackArray",
     			"data type not supported");
     }
 }
+
+Poco::Int64 UnstackArray::getIntParameterValue(size_t paramIndex)
+{
+    switch(paramIndex)
+    {
+    case paramChunkSize:
+        return chunkSize;
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void UnstackArray::setIntParameterValue(size_t paramIndex, Poco::Int64 value)
+{
+    switch(paramIndex)
+    {
+    case paramChunkSize:
+        if (value<0)
+            throw Poco::RangeException("setParameterValue",
+                    "chunkSize has to be positive or null");
+        chunkSize = value;
+        break;
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
@@ -35,6 +35,15 @@
  * UnstackArray
  *
  * Transform an array into a data sequence. This module is a sequence source.
+ *
+ * The input array is copied (the images are shared) and the input port
+ * is released before the emission, so that the source can prepare its
+ * next array meanwhile.
+ *
+ * With the chunkSize parameter > 1, the array is sent as a sequence of
+ * sub-arrays to the chunks output port, instead of one element at a
+ * time to the elements port: the handshake with the downstream modules
+ * happens once per chunk.
  */
 class UnstackArray: public Module
 {
@@ -62,6 +71,7 @@ private:
     enum outPorts
     {
         dataOutPort,
+        chunkOutPort,
         outPortCnt
     };
 
@@ -74,7 +84,34 @@ private:
     template <typename T>
     void sendData(std::vector<T>& input, DataAttributeIn attr);
 
+    /**
+     * Send the input array by chunks
+     *
+     * Same as sendData, with sub-arrays of the given size,
+     * sent to the chunks port.
+     */
+    template <typename T>
+    void sendChunks(std::vector<T>& input, DataAttributeIn attr, size_t chunk);
+
+    /**
+     * Copy the input array, release the input port,
+     * then send the copy with sendData or sendChunks
+     */
+    template <typename T>
+    void unstack(DataAttributeIn& attr);
+
+    enum params
+    {
+        paramChunkSize,
+        paramCnt
+    };
+
+    Poco::Int64 getIntParameterValue(size_t paramIndex);
+    void setIntParameterValue(size_t paramIndex, Poco::Int64 value);
+
     int mDataType;
+
+    Poco::Int64 chunkSize;
 };
 
 #include "UnstackArray.ipp"
@@ -28,6 +28,8 @@
 
 #include "UnstackArray.h"
 
+#include <algorithm>
+
 template <typename T>
 void UnstackArray::sendData(std::vector<T>& input, DataAttributeIn attr)
 {
@@ -69,3 +71,65 @@ void UnstackArray::sendData(std::vector<T>& input, DataAttributeIn attr)
 	attrOut.endSequence();
 	notifyOutPortReady(dataOutPort, attrOut);
 }
+
+template <typename T>
+void UnstackArray::sendChunks(std::vector<T>& input, DataAttributeIn attr, size_t chunk)
+{
+	DataAttributeOut attrOut(attr);
+
+	size_t inSize = input.size();
+
+	if (inSize == 0)
+	{
+		poco_warning(logger(), "The input array is empty. "
+				"Can not send empty data");
+		return;
+	}
+
+	size_t chunkCnt = (inSize + chunk - 1) / chunk;
+
+    reserveOutPort(chunkOutPort);
+    poco_information(logger(),"out port reserved");
+
+    std::vector<T>* pData;
+    getDataToWrite< std::vector<T> >(chunkOutPort, pData);
+	pData->assign(input.begin(), input.begin() + std::min(chunk, inSize));
+
+    if (chunkCnt == 1)
+    {
+    	poco_information(logger(), "only one chunk to be sent. No sequence then. ");
+    	notifyOutPortReady(chunkOutPort, attrOut);
+    	return;
+    }
+
+	attrOut.startSequence();
+	for (size_t ind = 1; ind < chunkCnt; ind++)
+	{
+    	notifyOutPortReady(chunkOutPort, attrOut);
+    	attrOut++;
+        reserveOutPort(chunkOutPort);
+        getDataToWrite< std::vector<T> >(chunkOutPort, pData);
+    	pData->assign(input.begin() + ind * chunk,
+    			input.begin() + std::min((ind + 1) * chunk, inSize));
+	}
+
+	attrOut.endSequence();
+	notifyOutPortReady(chunkOutPort, attrOut);
+}
+
+template <typename T>
+void UnstackArray::unstack(DataAttributeIn& attr)
+{
+	size_t chunk = static_cast<size_t>(chunkSize);
+
+	std::vector<T>* pData;
+	readInPortData< std::vector<T> >(arrayInPort, pData);
+	std::vector<T> input(*pData);
+
+	releaseInPort(arrayInPort);
+
+	if (chunk > 1)
+		sendChunks<T>(input, attr, chunk);
+	else
+		sendData<T>(input, attr);
+}
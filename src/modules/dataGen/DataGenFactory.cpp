@@ -31,6 +31,7 @@
 #include "TypedDataGenFactory.h"
 #include "modules/GenericLeafFactory.h"
 #include "SeqGen.h"
+#include "LoadGen.h"
 
 #include "core/DataItem.h"
 
@@ -45,17 +46,23 @@ std::vector<std::string> DataGenFactory::selectValueList()
     }
 
     list.push_back("seq");
+    list.push_back("load");
 
     return list;
 }
 
 ModuleFactoryBranch* DataGenFactory::newChildFactory(std::string selector)
 {
-    if (selector.compare("seq"))
-        return new TypedDataGenFactory(this, selector);
-    else
+    if (selector.compare("seq") == 0)
         return new GenericLeafFactory<SeqGen>(
                 "SeqGenFactory",
                 "Build a sequence generator with possible endless sequence. ",
                 this, selector);
+    else if (selector.compare("load") == 0)
+        return new GenericLeafFactory<LoadGen>(
+                "LoadGenFactory",
+                "Build a rate-controlled synthetic load generator. ",
+                this, selector);
+    else
+        return new TypedDataGenFactory(this, selector);
 }
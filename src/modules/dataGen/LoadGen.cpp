@@ -0,0 +1,640 @@
+/**
+ * @file	src/modules/dataGen/LoadGen.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "LoadGen.h"
+
+#include "core/DataAttributeOut.h"
+
+#include "Poco/NumberFormatter.h"
+#include "Poco/Random.h"
+#include "Poco/Thread.h"
+
+#include <algorithm>
+#include <cmath>
+
+size_t LoadGen::refCount = 0;
+
+LoadGen::LoadGen(ModuleFactory* parent, std::string customName):
+    Module(parent, customName),
+    payload(payloadScalar),
+    rate(0), count(0), burstSize(1), jitter(0), spinTime(0),
+    vectorSize(0), imageWidth(0), imageHeight(0),
+    spotCount(0), spotSigma(1),
+    achievedRate(0), lateCount(0)
+{
+    if (refCount)
+        setInternalName("LoadGen"
+                        + Poco::NumberFormatter::format(refCount));
+    else
+        setInternalName("LoadGen");
+
+    setCustomName(customName);
+    setLogger("module." + name());
+
+    setInPortCount(inPortCnt);
+    addTrigPort("trig", "Launch the data generation", trigPort);
+
+    setOutPortCount(outPortCnt);
+    addOutPort("scalar", "Emission index, if payload is \"scalar\"",
+            DataItem::typeDblFloat, outPortScalar);
+    addOutPort("vector", "Vector filled with the emission index, "
+            "if payload is \"vector\"",
+            DataItem::typeDblFloat | DataItem::contVector, outPortVector);
+#ifdef HAVE_OPENCV
+    addOutPort("image", "Synthetic image, if payload is \"image\"",
+            DataItem::typeCvMat, outPortImage);
+#endif
+
+    // parameters
+    setParameterCount(paramCnt);
+    addParameter(paramPayload, "payload",
+            "Generated data: \"scalar\", \"vector\" or \"image\"",
+            ParamItem::typeString, "scalar");
+    addParameter(paramRate, "rate",
+            "Target emission rate, in Hz. "
+            "If 0: the data are emitted as fast as possible",
+            ParamItem::typeFloat, "0");
+    addParameter(paramCount, "count",
+            "Count of data to be emitted. "
+            "If 0: endless sequence, until abortion. "
+            "If 1: only one data is emitted, without sequence. ",
+            ParamItem::typeInteger, "100");
+    addParameter(paramBurstSize, "burstSize",
+            "Count of data emitted back-to-back at each burst. "
+            "The bursts are spaced to keep the mean target rate",
+            ParamItem::typeInteger, "1");
+    addParameter(paramJitter, "jitter",
+            "Maximal random shift of the burst times, "
+            "in fraction of the burst period (0 to 1)",
+            ParamItem::typeFloat, "0");
+    addParameter(paramSpinTime, "spinTime",
+            "Maximal busy wait before each emission deadline, in microseconds. "
+            "Larger values give a more accurate rate at the cost of CPU time. "
+            "If 0: sleep only",
+            ParamItem::typeInteger, "200");
+    addParameter(paramVectorSize, "vectorSize",
+            "Size of the generated vectors",
+            ParamItem::typeInteger, "1000");
+    addParameter(paramImageWidth, "imageWidth",
+            "Width of the generated images",
+            ParamItem::typeInteger, "640");
+    addParameter(paramImageHeight, "imageHeight",
+            "Height of the generated images",
+            ParamItem::typeInteger, "480");
+    addParameter(paramImageType, "imageType",
+            "Pixel type of the generated images: \"8U\", \"16U\" or \"32F\"",
+            ParamItem::typeString, "8U");
+    addParameter(paramSpotCount, "spotCount",
+            "Count of gaussian spots in the generated images. "
+            "They are centered in the cells of a regular grid",
+            ParamItem::typeInteger, "1");
+    addParameter(paramSpotSigma, "spotSigma",
+            "Standard deviation of the gaussian spots, in pixels",
+            ParamItem::typeFloat, "5");
+    addParameter(paramAchievedRate, "achievedRate",
+            "Emission rate achieved during the last run, in Hz, "
+            "measured at the burst starts (read-only)",
+            ParamItem::typeFloat, "0");
+    addParameter(paramLateCount, "lateCount",
+            "Count of clock restarts during the last run, "
+            "because of an emission late by more than one burst (read-only)",
+            ParamItem::typeInteger, "0");
+
+    setStrParameterValue(paramPayload, getStrParameterDefaultValue(paramPayload));
+    setFloatParameterValue(paramRate, getFloatParameterDefaultValue(paramRate));
+    setIntParameterValue(paramCount, getIntParameterDefaultValue(paramCount));
+    setIntParameterValue(paramBurstSize, getIntParameterDefaultValue(paramBurstSize));
+    setFloatParameterValue(paramJitter, getFloatParameterDefaultValue(paramJitter));
+    setIntParameterValue(paramSpinTime, getIntParameterDefaultValue(paramSpinTime));
+    setIntParameterValue(paramVectorSize, getIntParameterDefaultValue(paramVectorSize));
+    setIntParameterValue(paramImageWidth, getIntParameterDefaultValue(paramImageWidth));
+    setIntParameterValue(paramImageHeight, getIntParameterDefaultValue(paramImageHeight));
+    setStrParameterValue(paramImageType, getStrParameterDefaultValue(paramImageType));
+    setIntParameterValue(paramSpotCount, getIntParameterDefaultValue(paramSpotCount));
+    setFloatParameterValue(paramSpotSigma, getFloatParameterDefaultValue(paramSpotSigma));
+
+    notifyCreation();
+
+    // if nothing failed
+    refCount++;
+}
+
+void LoadGen::process(int startCond)
+{
+    bool trigged;
+
+    switch (startCond)
+    {
+    case noDataStartState:
+        trigged = false;
+        break;
+    case allDataStartState:
+        trigged = true;
+        break;
+    default:
+        poco_bugcheck_msg("impossible start condition");
+        throw Poco::BugcheckException();
+    }
+
+    DataAttributeOut outAttr;
+
+    if (trigged)
+    {
+        DataAttributeIn inAttr;
+
+        readLockInPort(trigPort);
+        readInPortDataAttribute(trigPort, &inAttr);
+        releaseInPort(trigPort);
+
+        outAttr = inAttr;
+    }
+
+    int curPayload;
+    double curRate, curJitter;
+    Poco::Int64 curCount, burst;
+    Poco::Timestamp::TimeDiff spin;
+    size_t vectSize;
+
+    {
+        Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+        curPayload = payload;
+        curRate = rate;
+        curJitter = jitter;
+        curCount = count;
+        burst = burstSize;
+        spin = spinTime;
+        vectSize = static_cast<size_t>(vectorSize);
+
+#ifdef HAVE_OPENCV
+        if (payload == payloadImage)
+        {
+            int cvType = CV_8U;
+            if (imageType == "16U")
+                cvType = CV_16U;
+            else if (imageType == "32F")
+                cvType = CV_32F;
+
+            image = generateImage(static_cast<int>(imageWidth),
+                    static_cast<int>(imageHeight), cvType,
+                    static_cast<size_t>(spotCount), spotSigma);
+        }
+#endif
+
+        achievedRate = 0;
+        lateCount = 0;
+    }
+
+    // burst period, in microseconds. 0: no timing
+    Poco::Timestamp::TimeDiff burstPeriod = 0;
+    if (curRate > 0)
+    {
+        burstPeriod = static_cast<Poco::Timestamp::TimeDiff>(
+                1000000.0 * static_cast<double>(burst) / curRate);
+    }
+    else
+    {
+        burst = 1;
+    }
+
+    Poco::Random random;
+    random.seed();
+
+    Poco::Timestamp start;
+    Poco::Timestamp clockStart;
+    Poco::Int64 burstInd = 0;
+    Poco::Int64 nextInd = 0;
+
+    if (curCount != 1)
+        outAttr.startSequence();
+
+    while ((curCount == 0) || (nextInd < curCount))
+    {
+        size_t outPort = outPortScalar;
+        switch (curPayload)
+        {
+        case payloadVector:
+            outPort = outPortVector;
+            break;
+#ifdef HAVE_OPENCV
+        case payloadImage:
+            outPort = outPortImage;
+            break;
+#endif
+        default:
+            break;
+        }
+
+        reserveOutPort(outPort);
+        writePayload(curPayload, nextInd, vectSize);
+
+        if (nextInd % burst == 0)
+        {
+            if (burstPeriod && nextInd)
+            {
+                Poco::Timestamp deadline = clockStart + burstInd * burstPeriod;
+
+                if (deadline + burstPeriod < Poco::Timestamp())
+                {
+                    // late by more than one burst: restart the clock
+                    clockStart.update();
+                    burstInd = 0;
+                    deadline = clockStart;
+
+                    Poco::RWLock::ScopedWriteLock lock(dataLock);
+                    lateCount++;
+                }
+                else if (curJitter > 0)
+                {
+                    deadline += static_cast<Poco::Timestamp::TimeDiff>(
+                            (2 * random.nextDouble() - 1) * curJitter
+                            * static_cast<double>(burstPeriod));
+                }
+
+                if (!waitUntil(deadline, spin))
+                    throw ExecutionAbortedException(name(), "Cancelled upon user request" );
+            }
+
+            if (nextInd == 0)
+            {
+                start.update();
+                clockStart = start;
+            }
+            else
+            {
+                updateAchievedRate(nextInd, start);
+            }
+
+            burstInd++;
+        }
+
+        if (curCount > 1 && nextInd == curCount-1)
+            outAttr.endSequence();
+
+        notifyOutPortReady(outPort, outAttr++);
+        nextInd++;
+
+        if (curCount)
+            setProgress(static_cast<float>(nextInd) / static_cast<float>(curCount));
+
+        if (yield())
+            throw ExecutionAbortedException(name(), "Cancelled upon user request" );
+    }
+
+    poco_information(logger(), Poco::NumberFormatter::format(nextInd)
+            + " data emitted at "
+            + Poco::NumberFormatter::format(getFloatParameterValue(paramAchievedRate))
+            + " Hz (target: " + Poco::NumberFormatter::format(curRate) + " Hz)");
+}
+
+bool LoadGen::waitUntil(const Poco::Timestamp& deadline,
+        Poco::Timestamp::TimeDiff spin)
+{
+    // sleep by steps of at least one millisecond (the sleep resolution),
+    // until the remaining time fits in the busy wait
+    while (true)
+    {
+        Poco::Timestamp::TimeDiff remaining = deadline - Poco::Timestamp();
+
+        if (remaining <= 0)
+            return true;
+
+        if (remaining <= spin)
+            break;
+
+        long ms = static_cast<long>((remaining - spin) / 1000);
+        if (sleep(ms > 0 ? ms : 1))
+            return false;
+    }
+
+    while (Poco::Timestamp() < deadline)
+    {
+        if (yield())
+            return false;
+    }
+
+    return true;
+}
+
+void LoadGen::writePayload(int curPayload, Poco::Int64 index, size_t vectSize)
+{
+    switch (curPayload)
+    {
+    case payloadScalar:
+    {
+        double* pData;
+        getDataToWrite<double>(outPortScalar, pData);
+        *pData = static_cast<double>(index);
+        break;
+    }
+    case payloadVector:
+    {
+        std::vector<double>* pData;
+        getDataToWrite< std::vector<double> >(outPortVector, pData);
+        pData->assign(vectSize, static_cast<double>(index));
+        break;
+    }
+#ifdef HAVE_OPENCV
+    case payloadImage:
+    {
+        cv::Mat* pData;
+        getDataToWrite<cv::Mat>(outPortImage, pData);
+        // copy: the previous emission could still be in use downstream
+        *pData = image.clone();
+        break;
+    }
+#endif
+    default:
+        poco_bugcheck_msg("unknown payload");
+        throw Poco::BugcheckException();
+    }
+}
+
+void LoadGen::updateAchievedRate(Poco::Int64 emitted, const Poco::Timestamp& start)
+{
+    Poco::Timestamp::TimeDiff elapsed = start.elapsed();
+
+    if (elapsed <= 0)
+        return;
+
+    Poco::RWLock::ScopedWriteLock lock(dataLock);
+    achievedRate = 1000000.0 * static_cast<double>(emitted)
+            / static_cast<double>(elapsed);
+}
+
+#ifdef HAVE_OPENCV
+cv::Mat LoadGen::generateImage(int width, int height, int cvType,
+        size_t spots, double sigma)
+{
+    cv::Mat acc = cv::Mat::zeros(height, width, CV_64F);
+
+    if (spots)
+    {
+        size_t cols = static_cast<size_t>(
+                std::ceil(std::sqrt(static_cast<double>(spots))));
+        size_t rows = (spots + cols - 1) / cols;
+        int radius = static_cast<int>(std::ceil(4 * sigma));
+
+        for (size_t ind = 0; ind < spots; ind++)
+        {
+            // center of the grid cell, in pixel coordinates
+            double cx = (static_cast<double>(ind % cols) + 0.5) * width / cols - 0.5;
+            double cy = (static_cast<double>(ind / cols) + 0.5) * height / rows - 0.5;
+
+            int xMin = std::max(0, static_cast<int>(cx) - radius);
+            int xMax = std::min(width - 1, static_cast<int>(cx) + radius + 1);
+            int yMin = std::max(0, static_cast<int>(cy) - radius);
+            int yMax = std::min(height - 1, static_cast<int>(cy) + radius + 1);
+
+            for (int y = yMin; y <= yMax; y++)
+            {
+                double* row = acc.ptr<double>(y);
+                for (int x = xMin; x <= xMax; x++)
+                {
+                    double dx = x - cx;
+                    double dy = y - cy;
+                    row[x] += std::exp(-(dx*dx + dy*dy) / (2 * sigma * sigma));
+                }
+            }
+        }
+    }
+
+    double scale = 1;
+    switch (cvType)
+    {
+    case CV_8U:
+        scale = 0.8 * 255;
+        break;
+    case CV_16U:
+        scale = 0.8 * 65535;
+        break;
+    default:
+        break;
+    }
+
+    cv::Mat img;
+    acc.convertTo(img, cvType, scale);
+    return img;
+}
+#endif
+
+Poco::Int64 LoadGen::getIntParameterValue(size_t paramIndex)
+{
+    Poco::RWLock::ScopedReadLock lock(dataLock);
+
+    switch(paramIndex)
+    {
+    case paramCount:
+        return count;
+    case paramBurstSize:
+        return burstSize;
+    case paramVectorSize:
+        return vectorSize;
+    case paramImageWidth:
+        return imageWidth;
+    case paramImageHeight:
+        return imageHeight;
+    case paramSpinTime:
+        return spinTime;
+    case paramSpotCount:
+        return spotCount;
+    case paramLateCount:
+        return lateCount;
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void LoadGen::setIntParameterValue(size_t paramIndex, Poco::Int64 value)
+{
+    Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+    switch(paramIndex)
+    {
+    case paramCount:
+        if (value<0)
+            throw Poco::RangeException("setParameterValue",
+                    "count has to be positive or null");
+        count = value;
+        break;
+    case paramBurstSize:
+        if (value<1)
+            throw Poco::RangeException("setParameterValue",
+                    "burstSize has to be strictly positive");
+        burstSize = value;
+        break;
+    case paramSpinTime:
+        if (value<0)
+            throw Poco::RangeException("setParameterValue",
+                    "spinTime has to be positive or null");
+        spinTime = value;
+        break;
+    case paramVectorSize:
+        if (value<0)
+            throw Poco::RangeException("setParameterValue",
+                    "vectorSize has to be positive or null");
+        vectorSize = value;
+        break;
+    case paramImageWidth:
+        if (value<1)
+            throw Poco::RangeException("setParameterValue",
+                    "imageWidth has to be strictly positive");
+        imageWidth = value;
+        break;
+    case paramImageHeight:
+        if (value<1)
+            throw Poco::RangeException("setParameterValue",
+                    "imageHeight has to be strictly positive");
+        imageHeight = value;
+        break;
+    case paramSpotCount:
+        if (value<0)
+            throw Poco::RangeException("setParameterValue",
+                    "spotCount has to be positive or null");
+        spotCount = value;
+        break;
+    case paramLateCount:
+        throw Poco::InvalidAccessException("setParameterValue",
+                "lateCount is read-only");
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
+
+double LoadGen::getFloatParameterValue(size_t paramIndex)
+{
+    Poco::RWLock::ScopedReadLock lock(dataLock);
+
+    switch(paramIndex)
+    {
+    case paramRate:
+        return rate;
+    case paramJitter:
+        return jitter;
+    case paramSpotSigma:
+        return spotSigma;
+    case paramAchievedRate:
+        return achievedRate;
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void LoadGen::setFloatParameterValue(size_t paramIndex, double value)
+{
+    Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+    switch(paramIndex)
+    {
+    case paramRate:
+        if (value<0)
+            throw Poco::RangeException("setParameterValue",
+                    "rate has to be positive or null");
+        rate = value;
+        break;
+    case paramJitter:
+        if (value<0 || value>1)
+            throw Poco::RangeException("setParameterValue",
+                    "jitter has to be between 0 and 1");
+        jitter = value;
+        break;
+    case paramSpotSigma:
+        if (value<=0)
+            throw Poco::RangeException("setParameterValue",
+                    "spotSigma has to be strictly positive");
+        spotSigma = value;
+        break;
+    case paramAchievedRate:
+        throw Poco::InvalidAccessException("setParameterValue",
+                "achievedRate is read-only");
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
+
+std::string LoadGen::getStrParameterValue(size_t paramIndex)
+{
+    Poco::RWLock::ScopedReadLock lock(dataLock);
+
+    switch(paramIndex)
+    {
+    case paramPayload:
+        switch (payload)
+        {
+        case payloadVector:
+            return "vector";
+        case payloadImage:
+            return "image";
+        default:
+            return "scalar";
+        }
+    case paramImageType:
+        return imageType;
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void LoadGen::setStrParameterValue(size_t paramIndex, std::string value)
+{
+    Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+    switch(paramIndex)
+    {
+    case paramPayload:
+        if (value == "scalar")
+            payload = payloadScalar;
+        else if (value == "vector")
+            payload = payloadVector;
+        else if (value == "image")
+#ifdef HAVE_OPENCV
+            payload = payloadImage;
+#else
+            throw Poco::NotImplementedException("setParameterValue",
+                    "image payload needs OpenCV");
+#endif
+        else
+            throw Poco::InvalidArgumentException("setParameterValue",
+                    "payload: unknown value: " + value);
+        break;
+    case paramImageType:
+        if (value != "8U" && value != "16U" && value != "32F")
+            throw Poco::InvalidArgumentException("setParameterValue",
+                    "imageType: unknown value: " + value);
+        imageType = value;
+        break;
+    default:
+        poco_bugcheck_msg("incorrect param index");
+        throw Poco::BugcheckException();
+    }
+}
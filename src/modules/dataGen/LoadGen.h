@@ -0,0 +1,188 @@
+/**
+ * @file	src/modules/dataGen/LoadGen.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_MODULES_DATAGEN_LOADGEN_H_
+#define SRC_MODULES_DATAGEN_LOADGEN_H_
+
+#include "core/Module.h"
+#include "core/DataItem.h"
+
+#include "Poco/RWLock.h"
+#include "Poco/Timestamp.h"
+
+/**
+ * Synthetic load generator
+ *
+ * Emit synthetic data at a target rate, to load-test a recipe without
+ * any camera. The payload is selected by the "payload" parameter:
+ *  - scalar: the emission index, as a double float
+ *  - vector: vectorSize double floats set to the emission index
+ *  - image: imageWidth x imageHeight image of the given type, with
+ *  spotCount gaussian spots centered in the cells of a regular grid
+ *  (e.g. to check a centroid computation). The image is generated once
+ *  per run, and each emission is a copy of it.
+ *
+ * The emission times are scheduled from a clock started at the
+ * beginning of the run (absolute deadlines): the sleep inaccuracies do
+ * not accumulate. The last spinTime microseconds before a deadline are
+ * waited by yielding instead of sleeping: a larger spinTime gives a
+ * more accurate rate, at the cost of CPU time.
+ *
+ * The data are emitted by bursts of burstSize back-to-back items, the
+ * bursts being spaced so that the mean rate is the target rate. Each
+ * burst deadline can be shifted randomly by up to +/- jitter period.
+ * If the emission is late by more than one burst, the clock is
+ * restarted (no catch-up burst) and the late count is incremented.
+ *
+ * The achieved rate of the last (or current) run is available in the
+ * achievedRate read-only parameter.
+ *
+ * As for SeqGen, the data are emitted as a sequence, unless count is 1.
+ * If count is 0, the sequence is endless and has to be ended by the
+ * module cancellation.
+ */
+class LoadGen: public Module
+{
+public:
+    LoadGen(ModuleFactory* parent, std::string customName);
+
+    std::string description()
+    {
+        return "Synthetic load generator module: "
+                "scalars, vectors or images at a target rate. ";
+    }
+
+private:
+    LoadGen();
+
+    static size_t refCount; ///< reference counter to generate a unique internal name
+
+    void process(int startCond);
+
+    /// Indexes of the input ports
+    enum inPorts
+    {
+        trigPort,
+        inPortCnt
+    };
+
+    /// Indexes of the output ports
+    enum outPorts
+    {
+        outPortScalar,
+        outPortVector,
+#ifdef HAVE_OPENCV
+        outPortImage,
+#endif
+        outPortCnt
+    };
+
+    enum params
+    {
+        paramPayload,
+        paramRate,
+        paramCount,
+        paramBurstSize,
+        paramJitter,
+        paramSpinTime,
+        paramVectorSize,
+        paramImageWidth,
+        paramImageHeight,
+        paramImageType,
+        paramSpotCount,
+        paramSpotSigma,
+        paramAchievedRate,
+        paramLateCount,
+        paramCnt
+    };
+
+    enum payloads
+    {
+        payloadScalar,
+        payloadVector,
+        payloadImage
+    };
+
+    Poco::Int64 getIntParameterValue(size_t paramIndex);
+    void setIntParameterValue(size_t paramIndex, Poco::Int64 value);
+    double getFloatParameterValue(size_t paramIndex);
+    void setFloatParameterValue(size_t paramIndex, double value);
+    std::string getStrParameterValue(size_t paramIndex);
+    void setStrParameterValue(size_t paramIndex, std::string value);
+
+    /**
+     * Wait until the given time
+     *
+     * Sleep, then yield during the last spin microseconds.
+     * @return false if the module was cancelled during the wait
+     */
+    bool waitUntil(const Poco::Timestamp& deadline,
+            Poco::Timestamp::TimeDiff spin);
+
+    /**
+     * Write the payload of the given emission index to its output port
+     *
+     * The output port is reserved by this method
+     */
+    void writePayload(int curPayload, Poco::Int64 index, size_t vectSize);
+
+    /// Update the achieved rate from the emission count since start
+    void updateAchievedRate(Poco::Int64 emitted, const Poco::Timestamp& start);
+
+#ifdef HAVE_OPENCV
+    /**
+     * Generate the synthetic image
+     *
+     * Gaussian spots on a null background, the spots amplitude being
+     * 80% of the full scale for the integer types, 1 for float.
+     */
+    cv::Mat generateImage(int width, int height, int cvType,
+            size_t spots, double sigma);
+
+    cv::Mat image; ///< image copied at each emission of the current run
+#endif
+
+    Poco::RWLock dataLock; ///< lock the parameters
+
+    int payload;
+    double rate; ///< target rate, in Hz. 0: as fast as possible
+    Poco::Int64 count;
+    Poco::Int64 burstSize;
+    double jitter; ///< in fraction of the burst period
+    Poco::Int64 spinTime; ///< in microseconds
+    Poco::Int64 vectorSize;
+    Poco::Int64 imageWidth;
+    Poco::Int64 imageHeight;
+    std::string imageType;
+    Poco::Int64 spotCount;
+    double spotSigma;
+    double achievedRate;
+    Poco::Int64 lateCount;
+};
+
+#endif /* SRC_MODULES_DATAGEN_LOADGEN_H_ */
@@ -31,6 +31,7 @@
 #include "modules/devices/GenicamRootFactory.h"
 #include "modules/GenericLeafFactory.h"
 #include "modules/devices/CameraFromFiles.h"
+#include "modules/devices/CameraFromRecord.h"
 
 std::vector<std::string> CameraFactory::selectValueList()
 {
@@ -38,6 +39,7 @@ std::vector<std::string> CameraFactory::selectValueList()
 
 #ifdef HAVE_OPENCV
     list.push_back("fromFiles");
+    list.push_back("fromRecord");
 #endif
 
     list.push_back("genicam");
@@ -54,6 +56,12 @@ ModuleFactoryBranch* CameraFactory::newChildFactory(std::string selector)
                 "Module factory to construct a fake camera "
                 "generating images from files",
                 this, selector);
+    else if (selector.compare("fromRecord") == 0)
+        return new GenericLeafFactory<CameraFromRecord>(
+                "CameraFromRecordFactory",
+                "Module factory to construct a fake camera "
+                "replaying a raw record file",
+                this, selector);
     else
 #endif
     if  (selector.compare("genicam") == 0)
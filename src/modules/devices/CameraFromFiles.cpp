@@ -40,6 +40,8 @@
 #include "Poco/String.h"
 #include "Poco/StringTokenizer.h"
 
+#include "core/ExecutionAbortedException.h"
+
 //#include "opencv2/opencv.hpp"
 #include "opencv2/core/core.hpp"
 
@@ -47,7 +49,9 @@ size_t CameraFromFiles::refCount = 0;
 
 CameraFromFiles::CameraFromFiles(ModuleFactory* parent, std::string customName):
             Module(parent, customName),
-            forceGrayscale(true)
+            forceGrayscale(true),
+            readAhead(0),
+            replayRate(0), replayClockStarted(false)
 {
     if (refCount)
         setInternalName("CameraFromFiles" + Poco::NumberFormatter::format(refCount));
@@ -57,6 +61,8 @@ CameraFromFiles::CameraFromFiles(ModuleFactory* parent, std::string customName):
     setCustomName(customName);
     setLogger("module." + name());
 
+    imgCache = new ImageFileCache(logger());
+
     // parameters
     setParameterCount(paramCnt);
     addParameter(paramDirectory, "directory",
@@ -68,6 +74,17 @@ CameraFromFiles::CameraFromFiles(ModuleFactory* parent, std::string customName):
     currentImgPath = imgPaths.begin();
     addParameter(paramForceGrayscale, "forceGrayscale", "force a color image to be grayscale (ON). "
             "Leave as is elsewhere (OFF)", ParamItem::typeString, "ON");
+    addParameter(paramReadAhead, "readAhead",
+            "Number of the next files to be decoded in background threads. "
+            "0 to disable the read-ahead", ParamItem::typeInteger, "4");
+    addParameter(paramCacheSize, "cacheSize",
+            "Memory budget (in MB) of the cache of the decoded images, "
+            "used when looping over the files. 0 to disable the cache",
+            ParamItem::typeInteger, "256");
+    addParameter(paramReplayRate, "replayRate",
+            "Image delivery rate (in images per second), "
+            "e.g. to replay a recorded dataset in real time. "
+            "0 to deliver the images as soon as trigged", ParamItem::typeFloat, "0");
 
     setParametersDefaultValue();
 
@@ -126,15 +143,20 @@ void CameraFromFiles::process(int startCond)
     {
         poco_warning(logger(), "No image path in the stack. "
                 "Please fill the \"files\" parameter");
+        dataLock.unlock();
         return;
     }
 
     Poco::Path fullImagePath = imgDir;
     fullImagePath.append(*currentImgPath++);
+    int flags = readFlags();
 
     poco_information(logger(), name() + " tries to open: "
             + fullImagePath.toString());
 
+    // decode the next files while this one is delivered
+    prefetchNext();
+
     dataLock.unlock();
 
     processingTerminated();
@@ -148,31 +170,85 @@ void CameraFromFiles::process(int startCond)
 
     poco_information(logger(),"acq ready output port set");
 
+    // Read the image file (empty Mat if any error occurs)
+    // before reserving the output port
+    cv::Mat img = imgCache->get(fullImagePath.toString(), flags);
+
+    if (!img.data)
+        poco_warning(logger(), "Empty image. Check the given file name. ");
+
+    if (!waitReplayTime())
+        throw ExecutionAbortedException(name(), "Cancelled upon user request");
+
     reserveOutPort(imgOutPort);
 
     cv::Mat* pMat;
     getDataToWrite<cv::Mat>(imgOutPort, pMat);
+    *pMat = img;
 
-    // Read the image file (returns empty Mat if any error occurs)
-    if (forceGrayscale)
+    notifyOutPortReady(imgOutPort, attr);
+}
+
+void CameraFromFiles::prefetchNext()
+{
+    if (imgPaths.empty())
+        return;
+
+    std::vector< std::string >::iterator it = currentImgPath;
+    int flags = readFlags();
+
+    for (Poco::Int64 ind = 0; ind < readAhead
+            && ind < static_cast<Poco::Int64>(imgPaths.size()); ind++)
     {
-        poco_information(logger(),
-            "Retrieving the image in gray scale format");
-        *pMat = cv::imread(fullImagePath.toString().c_str(),
-                cv::IMREAD_GRAYSCALE);
+        if (it == imgPaths.end())
+            it = imgPaths.begin();
+
+        Poco::Path path = imgDir;
+        path.append(*it++);
+        imgCache->prefetch(path.toString(), flags);
     }
+}
+
+int CameraFromFiles::readFlags()
+{
+    if (forceGrayscale)
+        return cv::IMREAD_GRAYSCALE;
     else
+        return cv::IMREAD_UNCHANGED;
+}
+
+bool CameraFromFiles::waitReplayTime()
+{
+    Poco::Timestamp::TimeDiff remaining;
+
     {
-        poco_information(logger(),
-            "Retrieving the image in original color format");
-        *pMat = cv::imread(fullImagePath.toString().c_str(),
-                cv::IMREAD_UNCHANGED);
+        // the clock is shared with the next process() call, which
+        // can already run since processingTerminated() was called
+        Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+        if (replayRate <= 0)
+            return true;
+
+        Poco::Timestamp::TimeDiff period =
+                static_cast<Poco::Timestamp::TimeDiff>(1000000.0 / replayRate);
+
+        Poco::Timestamp now;
+
+        // first image, or late by more than one period: restart the clock
+        if (!replayClockStarted || (nextReplayTime + period < now))
+        {
+            replayClockStarted = true;
+            nextReplayTime = now;
+        }
+
+        remaining = nextReplayTime - now;
+        nextReplayTime += period;
     }
 
-    if (!pMat->data)
-        poco_warning(logger(), "Empty image. Check the given file name. ");
+    if (remaining > 0 && sleep(static_cast<long>(remaining / 1000)))
+        return false;
 
-    notifyOutPortReady(imgOutPort, attr);
+    return true;
 }
 
 std::string CameraFromFiles::getStrParameterValue(size_t paramIndex)
@@ -204,6 +280,7 @@ void CameraFromFiles::setStrParameterValue(size_t paramIndex, std::string value)
     case paramDirectory:
         imgDir = value;
         imgDir.makeAbsolute();
+        imgCache->cancelPrefetch();
         break;
     case paramFiles:
     {
@@ -211,6 +288,7 @@ void CameraFromFiles::setStrParameterValue(size_t paramIndex, std::string value)
                 Poco::StringTokenizer::TOK_IGNORE_EMPTY | Poco::StringTokenizer::TOK_TRIM);
         imgPaths.assign(tok.begin(), tok.end());
         currentImgPath = imgPaths.begin();
+        imgCache->cancelPrefetch();
         break;
     }
     case paramForceGrayscale:
@@ -221,6 +299,7 @@ void CameraFromFiles::setStrParameterValue(size_t paramIndex, std::string value)
         else
             throw Poco::DataFormatException("setParameterValue",
                     value + ": forceGrayscale can only be set to ON or OFF");
+        imgCache->cancelPrefetch();
         break;
     default:
         poco_bugcheck_msg("setStrParameterValue: wrong index");
@@ -228,4 +307,70 @@ void CameraFromFiles::setStrParameterValue(size_t paramIndex, std::string value)
     }
 }
 
+Poco::Int64 CameraFromFiles::getIntParameterValue(size_t paramIndex)
+{
+    Poco::RWLock::ScopedReadLock lock(dataLock);
+
+    switch (paramIndex)
+    {
+    case paramReadAhead:
+        return readAhead;
+    case paramCacheSize:
+        return static_cast<Poco::Int64>(imgCache->getBudget() >> 20);
+    default:
+        poco_bugcheck_msg("getIntParameterValue: wrong index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void CameraFromFiles::setIntParameterValue(size_t paramIndex, Poco::Int64 value)
+{
+    Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+    if (value < 0)
+        throw Poco::RangeException("setParameterValue",
+                "readAhead and cacheSize can not be negative");
+
+    switch (paramIndex)
+    {
+    case paramReadAhead:
+        readAhead = value;
+        break;
+    case paramCacheSize:
+        imgCache->setBudget(static_cast<size_t>(value) << 20);
+        break;
+    default:
+        poco_bugcheck_msg("setIntParameterValue: wrong index");
+        throw Poco::BugcheckException();
+    }
+}
+
+double CameraFromFiles::getFloatParameterValue(size_t paramIndex)
+{
+    Poco::RWLock::ScopedReadLock lock(dataLock);
+
+    if (paramIndex != paramReplayRate)
+    {
+        poco_bugcheck_msg("getFloatParameterValue: wrong index");
+        throw Poco::BugcheckException();
+    }
+
+    return replayRate;
+}
+
+void CameraFromFiles::setFloatParameterValue(size_t paramIndex, double value)
+{
+    Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+    if (paramIndex != paramReplayRate)
+        poco_bugcheck_msg("setFloatParameterValue: wrong index");
+
+    if (value < 0)
+        throw Poco::RangeException("setParameterValue",
+                "replayRate can not be negative");
+
+    replayRate = value;
+    replayClockStarted = false;
+}
+
 #endif /* HAVE_OPENCV */
@@ -33,12 +33,25 @@
 
 #include "core/Module.h"
 
+#include "ImageFileCache.h"
+
+#include "Poco/Timestamp.h"
+#include "Poco/SharedPtr.h"
+
 /**
  * Fake camera device to load images from files.
  * 
  * A camera device is defined as follows:
  *  - generate image on direct runModule
  *  - generate image on input port trig
+ *
+ * The next files are decoded in background threads (readAhead
+ * parameter) and the decoded images are kept in a cache
+ * (cacheSize parameter), so that looping over the files
+ * does not decode them again.
+ *
+ * If replayRate is set, the images are delivered at this fixed rate,
+ * e.g. to replay a recorded dataset in real time.
  */
 class CameraFromFiles: public Module
 {
@@ -57,7 +70,36 @@ private:
      */
     void process(int startCond);
 
-    void reset() { currentImgPath = imgPaths.begin(); Module::reset(); }
+    void reset()
+    {
+        {
+            Poco::RWLock::ScopedWriteLock lock(dataLock);
+            currentImgPath = imgPaths.begin();
+            replayClockStarted = false;
+        }
+        Module::reset();
+    }
+
+    /**
+     * Queue the decoding of the readAhead files following the
+     * current position, looping at the end of the list
+     *
+     * dataLock shall be locked
+     */
+    void prefetchNext();
+
+    /// cv::imread flags corresponding to forceGrayscale. dataLock shall be locked
+    int readFlags();
+
+    /**
+     * Wait for the next replay time, if replayRate is set
+     *
+     * The replay clock is updated under dataLock, the wait is done
+     * without lock.
+     *
+     * @return false if cancelled
+     */
+    bool waitReplayTime();
 
     static size_t refCount; ///< reference counter to generate a unique internal name
 
@@ -66,18 +108,34 @@ private:
         paramDirectory,
         paramFiles,
         paramForceGrayscale,
+        paramReadAhead,
+        paramCacheSize,
+        paramReplayRate,
         paramCnt
     };
 
     std::string getStrParameterValue(size_t paramIndex);
     void setStrParameterValue(size_t paramIndex, std::string value);
 
+    Poco::Int64 getIntParameterValue(size_t paramIndex);
+    void setIntParameterValue(size_t paramIndex, Poco::Int64 value);
+
+    double getFloatParameterValue(size_t paramIndex);
+    void setFloatParameterValue(size_t paramIndex, double value);
+
     Poco::Path imgDir; ///< image files absolute directory
     std::vector< std::string > imgPaths; ///< paths of the images
     std::vector< std::string >::iterator currentImgPath; ///< position of the next image to be generated from imgPaths.
 
     bool forceGrayscale;
 
+    Poco::SharedPtr<ImageFileCache> imgCache; ///< decoded images
+    Poco::Int64 readAhead; ///< number of files decoded in advance
+
+    double replayRate; ///< replay frame rate. 0: no timing
+    bool replayClockStarted; ///< false before the first replayed image
+    Poco::Timestamp nextReplayTime; ///< delivery time of the next image
+
     /// Indexes of the input ports
     enum inPorts
     {
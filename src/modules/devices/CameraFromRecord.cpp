@@ -0,0 +1,417 @@
+/**
+ * @file	src/modules/devices/CameraFromRecord.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+
+#include "CameraFromRecord.h"
+
+#include "core/DataAttributeIn.h"
+#include "core/DataAttribute.h"
+
+#include "core/InDataPort.h"
+#include "core/OutPort.h"
+
+#include "Poco/NumberFormatter.h"
+#include "Poco/String.h"
+
+#include "core/ExecutionAbortedException.h"
+
+size_t CameraFromRecord::refCount = 0;
+
+/// delay after which the pace clock is restarted instead of catching up
+#define MAX_PACE_DELAY 1000000 // us
+
+CameraFromRecord::CameraFromRecord(ModuleFactory* parent, std::string customName):
+            Module(parent, customName),
+            pacing(paceMax), rate(10), speed(1),
+            position(0), seeked(true),
+            clockStarted(false), clockOrigin(0), pacedFrames(0)
+{
+    if (refCount)
+        setInternalName("CameraFromRecord" + Poco::NumberFormatter::format(refCount));
+    else
+        setInternalName("CameraFromRecord");
+
+    setCustomName(customName);
+    setLogger("module." + name());
+
+    // parameters
+    setParameterCount(paramCnt);
+    addParameter(paramFile, "file",
+            "Raw record file to be replayed (see RawRecordLogger)",
+            ParamItem::typeString, "");
+    addParameter(paramPacing, "pacing",
+            "Replay pace: \"max\" (as fast as possible), "
+            "\"rate\" (fixed rate, see the rate parameter) or "
+            "\"timestamps\" (recorded timestamps, see the speed parameter)",
+            ParamItem::typeString, "max");
+    addParameter(paramRate, "rate",
+            "Replay rate (in images per second) for the \"rate\" pacing",
+            ParamItem::typeFloat, "10");
+    addParameter(paramSpeed, "speed",
+            "Time scale for the \"timestamps\" pacing. "
+            "e.g. 2 to replay twice faster than recorded",
+            ParamItem::typeFloat, "1");
+    addParameter(paramPosition, "position",
+            "Index of the next image to be replayed. Set it to seek",
+            ParamItem::typeInteger, "0");
+    addParameter(paramFrameCount, "frameCount",
+            "Count of images in the record file (read-only)",
+            ParamItem::typeInteger, "0");
+
+    setStrParameterValue(paramFile, getStrParameterDefaultValue(paramFile));
+    setStrParameterValue(paramPacing, getStrParameterDefaultValue(paramPacing));
+    setFloatParameterValue(paramRate, getFloatParameterDefaultValue(paramRate));
+    setFloatParameterValue(paramSpeed, getFloatParameterDefaultValue(paramSpeed));
+
+    // ports
+    setInPortCount(inPortCnt);
+    setOutPortCount(outPortCnt);
+
+    addTrigPort("trig", "Launch the image generation", trigPort);
+
+    addOutPort("acqReady", "acquisition ready trigger", DataItem::typeInt32, acqReadyOutPort);
+    addOutPort("image", "image from the record", DataItem::typeCvMat, imgOutPort);
+    addOutPort("timestamp", "recording time of the image, in ns",
+            DataItem::typeUInt64, timestampOutPort);
+
+    notifyCreation();
+
+    // if nothing failed
+    refCount++;
+}
+
+void CameraFromRecord::reset()
+{
+    {
+        Poco::RWLock::ScopedWriteLock lock(dataLock);
+        position = 0;
+        seeked = true;
+    }
+
+    Module::reset();
+}
+
+void CameraFromRecord::process(int startCond)
+{
+    DataAttributeOut attr;
+
+    switch (startCond)
+    {
+    case noDataStartState:
+        poco_information(logger(), name() + " processing direct launch.");
+        break;
+    case allDataStartState:
+        {
+            DataAttributeIn inAttr;
+            readLockInPort(trigPort);
+            readInPortDataAttribute(trigPort, &inAttr);
+            releaseInPort(trigPort);
+
+            attr = inAttr;
+
+            poco_information(logger(), name() + " processing trigged launch.");
+            break;
+        }
+    default:
+        poco_bugcheck_msg("impossible start condition");
+        throw Poco::BugcheckException();
+    }
+
+    dataLock.writeLock();
+
+    if (record.isNull() || record->frameCount() == 0)
+    {
+        poco_warning(logger(), "No image in the record. "
+                "Please set the \"file\" parameter");
+        dataLock.unlock();
+        return;
+    }
+
+    if (position >= record->frameCount())
+    {
+        poco_notice(logger(), "end of the record reached, "
+                "starting again from the beginning");
+        position = 0;
+        seeked = true;
+    }
+
+    // keep the mapping if the file is changed meanwhile
+    Poco::AutoPtr<RawRecordMap> rec = record;
+    size_t frame = position++;
+    bool restart = seeked;
+    seeked = false;
+
+    dataLock.unlock();
+
+    processingTerminated();
+
+    reserveOutPort(acqReadyOutPort);
+
+    Poco::Int32* pInt32;
+    getDataToWrite<Poco::Int32>(acqReadyOutPort, pInt32);
+    *pInt32 = 1;
+    notifyOutPortReady(acqReadyOutPort, attr);
+
+    cv::Mat img;
+    rec->wrap(frame, img);
+    Poco::UInt64 timestamp = rec->timestamp(frame);
+
+    if (!waitPace(timestamp, restart))
+        throw ExecutionAbortedException(name(), "Cancelled upon user request");
+
+    std::set<size_t> outPorts;
+    outPorts.insert(imgOutPort);
+    outPorts.insert(timestampOutPort);
+    reserveOutPorts(outPorts);
+
+    cv::Mat* pMat;
+    getDataToWrite<cv::Mat>(imgOutPort, pMat);
+    *pMat = img;
+
+    Poco::UInt64* pTimestamp;
+    getDataToWrite<Poco::UInt64>(timestampOutPort, pTimestamp);
+    *pTimestamp = timestamp;
+
+    notifyOutPortReady(imgOutPort, attr);
+    notifyOutPortReady(timestampOutPort, attr);
+}
+
+bool CameraFromRecord::waitPace(Poco::UInt64 frameTimestamp, bool restart)
+{
+    Poco::Timestamp::TimeDiff remaining;
+
+    {
+        // the clock is shared with the next process() call, which
+        // can already run since processingTerminated() was called
+        Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+        if (pacing == paceMax)
+            return true;
+
+        Poco::Timestamp now;
+
+        if (restart || !clockStarted
+                || (pacing == paceTimestamps && frameTimestamp < clockOrigin))
+        {
+            clockStarted = true;
+            clockStart = now;
+            clockOrigin = frameTimestamp;
+            pacedFrames = 1;
+            return true;
+        }
+
+        Poco::Timestamp target = clockStart;
+        if (pacing == paceRate)
+            target += static_cast<Poco::Timestamp::TimeDiff>(
+                    static_cast<double>(pacedFrames) * 1000000.0 / rate);
+        else
+            target += static_cast<Poco::Timestamp::TimeDiff>(
+                    static_cast<double>(frameTimestamp - clockOrigin) / 1000.0 / speed);
+
+        pacedFrames++;
+
+        // too late: restart the clock instead of bursting to catch up
+        if (now - target > MAX_PACE_DELAY)
+        {
+            clockStart = now;
+            clockOrigin = frameTimestamp;
+            pacedFrames = 1;
+            return true;
+        }
+
+        remaining = target - now;
+    }
+
+    if (remaining > 0 && sleep(static_cast<long>(remaining / 1000)))
+        return false;
+
+    return true;
+}
+
+std::string CameraFromRecord::getStrParameterValue(size_t paramIndex)
+{
+    Poco::RWLock::ScopedReadLock lock(dataLock);
+
+    switch (paramIndex)
+    {
+    case paramFile:
+        return filePath.toString();
+    case paramPacing:
+        switch (pacing)
+        {
+        case paceRate:
+            return "rate";
+        case paceTimestamps:
+            return "timestamps";
+        default:
+            return "max";
+        }
+    default:
+        poco_bugcheck_msg("getStrParameterValue: wrong index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void CameraFromRecord::setStrParameterValue(size_t paramIndex, std::string value)
+{
+    Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+    switch (paramIndex)
+    {
+    case paramFile:
+        if (value.empty())
+        {
+            record = NULL;
+            filePath = value;
+        }
+        else
+        {
+            Poco::Path path(value);
+            path.makeAbsolute();
+
+            record = new RawRecordMap(path.toString());
+            filePath = path;
+
+            poco_information(logger(), path.toString() + " mapped: "
+                    + Poco::NumberFormatter::format(record->frameCount())
+                    + " images"
+                    + (record->indexed() ? "" : " (not closed properly, "
+                            "the records were scanned)"));
+        }
+        position = 0;
+        seeked = true;
+        break;
+    case paramPacing:
+        if (Poco::icompare(value, "max") == 0)
+            pacing = paceMax;
+        else if (Poco::icompare(value, "rate") == 0)
+            pacing = paceRate;
+        else if (Poco::icompare(value, "timestamps") == 0)
+            pacing = paceTimestamps;
+        else
+            throw Poco::InvalidArgumentException("setParameterValue",
+                    value + ": pacing can only be set to "
+                    "max, rate or timestamps");
+        seeked = true;
+        break;
+    default:
+        poco_bugcheck_msg("setStrParameterValue: wrong index");
+        throw Poco::BugcheckException();
+    }
+}
+
+Poco::Int64 CameraFromRecord::getIntParameterValue(size_t paramIndex)
+{
+    Poco::RWLock::ScopedReadLock lock(dataLock);
+
+    switch (paramIndex)
+    {
+    case paramPosition:
+        return static_cast<Poco::Int64>(position);
+    case paramFrameCount:
+        if (record.isNull())
+            return 0;
+        return static_cast<Poco::Int64>(record->frameCount());
+    default:
+        poco_bugcheck_msg("getIntParameterValue: wrong index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void CameraFromRecord::setIntParameterValue(size_t paramIndex, Poco::Int64 value)
+{
+    Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+    switch (paramIndex)
+    {
+    case paramPosition:
+    {
+        Poco::Int64 count = 0;
+        if (!record.isNull())
+            count = static_cast<Poco::Int64>(record->frameCount());
+
+        if (value < 0 || (value >= count && value))
+            throw Poco::RangeException("setParameterValue",
+                    "position has to be lower than the frame count: "
+                    + Poco::NumberFormatter::format(count));
+
+        position = static_cast<size_t>(value);
+        seeked = true;
+        break;
+    }
+    case paramFrameCount:
+        throw Poco::InvalidAccessException("setParameterValue",
+                "frameCount is read-only");
+    default:
+        poco_bugcheck_msg("setIntParameterValue: wrong index");
+        throw Poco::BugcheckException();
+    }
+}
+
+double CameraFromRecord::getFloatParameterValue(size_t paramIndex)
+{
+    Poco::RWLock::ScopedReadLock lock(dataLock);
+
+    switch (paramIndex)
+    {
+    case paramRate:
+        return rate;
+    case paramSpeed:
+        return speed;
+    default:
+        poco_bugcheck_msg("getFloatParameterValue: wrong index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void CameraFromRecord::setFloatParameterValue(size_t paramIndex, double value)
+{
+    Poco::RWLock::ScopedWriteLock lock(dataLock);
+
+    if (value <= 0)
+        throw Poco::RangeException("setParameterValue",
+                "rate and speed have to be positive");
+
+    switch (paramIndex)
+    {
+    case paramRate:
+        rate = value;
+        break;
+    case paramSpeed:
+        speed = value;
+        break;
+    default:
+        poco_bugcheck_msg("setFloatParameterValue: wrong index");
+        throw Poco::BugcheckException();
+    }
+
+    seeked = true;
+}
+
+#endif /* HAVE_OPENCV */
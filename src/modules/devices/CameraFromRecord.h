@@ -0,0 +1,152 @@
+/**
+ * @file	src/modules/devices/CameraFromRecord.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_MODULES_DEVICES_CAMERAFROMRECORD_H_
+#define SRC_MODULES_DEVICES_CAMERAFROMRECORD_H_
+
+#ifdef HAVE_OPENCV
+
+#include "core/Module.h"
+
+#include "tools/rawRecord/RawRecordMap.h"
+
+#include "Poco/AutoPtr.h"
+#include "Poco/Path.h"
+#include "Poco/Timestamp.h"
+
+/**
+ * Fake camera device to replay a raw record container file
+ * (as written by RawRecordLogger).
+ *
+ *  - generate image on direct runModule
+ *  - generate image on input port trig
+ *
+ * The file is memory-mapped: the images are delivered without copy
+ * nor decoding, pointing into the mapping. The mapping is
+ * copy-on-write: modifying an image in place never writes the file.
+ *
+ * The replay pace can follow the recorded timestamps (scaled by the
+ * speed parameter), a fixed rate, or be as fast as possible.
+ * The position parameter gives the index of the next image and can
+ * be set to seek in the record.
+ */
+class CameraFromRecord: public Module
+{
+public:
+    CameraFromRecord(ModuleFactory* parent, std::string customName);
+    virtual ~CameraFromRecord() { }
+
+    std::string description()
+    {
+        return "Fake camera replaying images \nfrom a raw record file. ";
+    }
+
+private:
+    /**
+     * Main logic
+     */
+    void process(int startCond);
+
+    void reset();
+
+    /**
+     * Wait for the delivery time of the given frame
+     *
+     * The pace clock is updated under dataLock, the wait is done
+     * without lock.
+     *
+     * @param restart restart the pace clock (first frame, seek, loop)
+     * @return false if cancelled
+     */
+    bool waitPace(Poco::UInt64 frameTimestamp, bool restart);
+
+    static size_t refCount; ///< reference counter to generate a unique internal name
+
+    enum params
+    {
+        paramFile,
+        paramPacing,
+        paramRate,
+        paramSpeed,
+        paramPosition,
+        paramFrameCount,
+        paramCnt
+    };
+
+    std::string getStrParameterValue(size_t paramIndex);
+    void setStrParameterValue(size_t paramIndex, std::string value);
+
+    Poco::Int64 getIntParameterValue(size_t paramIndex);
+    void setIntParameterValue(size_t paramIndex, Poco::Int64 value);
+
+    double getFloatParameterValue(size_t paramIndex);
+    void setFloatParameterValue(size_t paramIndex, double value);
+
+    enum pacingModes
+    {
+        paceMax, ///< as fast as possible
+        paceRate, ///< fixed rate
+        paceTimestamps ///< recorded timestamps
+    };
+
+    Poco::Path filePath; ///< record file absolute path
+    Poco::AutoPtr<RawRecordMap> record; ///< mapped record, NULL if no file
+
+    int pacing;
+    double rate; ///< replay rate for paceRate, in frames per second
+    double speed; ///< time scale for paceTimestamps
+
+    size_t position; ///< index of the next frame
+    bool seeked; ///< position changed since the last frame
+
+    bool clockStarted; ///< false before the first paced frame
+    Poco::Timestamp clockStart; ///< host time of the clock origin
+    Poco::UInt64 clockOrigin; ///< recorded timestamp at the clock origin, in ns
+    Poco::Int64 pacedFrames; ///< frames delivered since the clock origin (paceRate)
+
+    /// Indexes of the input ports
+    enum inPorts
+    {
+        trigPort,
+        inPortCnt
+    };
+
+    /// Indexes of the output ports
+    enum outPorts
+    {
+        imgOutPort,
+        timestampOutPort,
+        acqReadyOutPort,
+        outPortCnt
+    };
+
+    Poco::RWLock dataLock; ///< general lock for any data of this module
+};
+
+#endif /* HAVE_OPENCV */
+#endif /* SRC_MODULES_DEVICES_CAMERAFROMRECORD_H_ */
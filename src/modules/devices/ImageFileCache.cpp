@@ -0,0 +1,332 @@
+/**
+ * @file	src/modules/devices/ImageFileCache.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+
+#include "ImageFileCache.h"
+
+#include "Poco/Environment.h"
+#include "Poco/NumberFormatter.h"
+
+#include "opencv2/imgcodecs/imgcodecs.hpp"
+
+ImageFileCache::ImageFileCache(Poco::Logger& logger):
+        budget(0), cachedBytes(0),
+        workerRunnable(*this, &ImageFileCache::workerLoop),
+        stopping(false),
+        log(logger)
+{
+}
+
+ImageFileCache::~ImageFileCache()
+{
+    {
+        Poco::ScopedLock<Poco::Mutex> lock(mutex);
+        stopping = true;
+        stateChanged.broadcast();
+    }
+
+    for (size_t ind = 0; ind < workers.size(); ind++)
+    {
+        workers[ind]->join();
+        delete workers[ind];
+    }
+}
+
+std::string ImageFileCache::key(const std::string& path, int flags)
+{
+    return Poco::NumberFormatter::format(flags) + ":" + path;
+}
+
+void ImageFileCache::prefetch(const std::string& path, int flags)
+{
+    std::string entryKey = key(path, flags);
+
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+
+    std::map<std::string, Entry>::iterator it = entries.find(entryKey);
+    if (it != entries.end())
+    {
+        touch(it->second);
+        return;
+    }
+
+    Entry& entry = entries[entryKey];
+    entry.path = path;
+    entry.flags = flags;
+    entry.state = stateQueued;
+    entry.delivered = false;
+    entry.cancelled = false;
+    entry.bytes = 0;
+    entry.lruPos = lru.insert(lru.begin(), entryKey);
+
+    requests.push_back(entryKey);
+
+    startWorkers();
+    stateChanged.signal();
+}
+
+cv::Mat ImageFileCache::get(const std::string& path, int flags)
+{
+    std::string entryKey = key(path, flags);
+
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+
+    std::map<std::string, Entry>::iterator it = entries.find(entryKey);
+
+    if (it != entries.end() && it->second.state == stateQueued)
+    {
+        // no worker is on it yet: faster to decode it here
+        for (std::deque<std::string>::iterator req = requests.begin(),
+                reqEnd = requests.end(); req != reqEnd; req++)
+        {
+            if (*req == entryKey)
+            {
+                requests.erase(req);
+                break;
+            }
+        }
+
+        erase(it);
+        it = entries.end();
+    }
+
+    while (it != entries.end() && it->second.state == stateDecoding)
+    {
+        stateChanged.wait(mutex);
+        it = entries.find(entryKey); // could have been cancelled
+    }
+
+    if (it != entries.end())
+    {
+        it->second.delivered = true;
+        touch(it->second);
+        cv::Mat image = it->second.image;
+        evict();
+
+        // the consumers may modify the image: do not share it
+        // with the cache, if it is kept
+        if (entries.count(entryKey))
+        {
+            Poco::ScopedUnlock<Poco::Mutex> unlock(mutex);
+            image = image.clone();
+        }
+
+        return image;
+    }
+
+    poco_debug(log, "image cache miss: " + path);
+
+    cv::Mat image;
+    {
+        Poco::ScopedUnlock<Poco::Mutex> unlock(mutex);
+        image = decode(path, flags);
+    }
+
+    if (budget && image.data && entries.find(entryKey) == entries.end())
+    {
+        Entry& entry = entries[entryKey];
+        entry.path = path;
+        entry.flags = flags;
+        entry.state = stateReady;
+        entry.delivered = true;
+        entry.cancelled = false;
+        entry.image = image;
+        entry.bytes = image.total() * image.elemSize();
+        entry.lruPos = lru.insert(lru.begin(), entryKey);
+
+        cachedBytes += entry.bytes;
+        evict();
+
+        if (entries.count(entryKey))
+        {
+            Poco::ScopedUnlock<Poco::Mutex> unlock(mutex);
+            image = image.clone();
+        }
+    }
+
+    return image;
+}
+
+void ImageFileCache::cancelPrefetch()
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+
+    requests.clear();
+
+    for (std::map<std::string, Entry>::iterator it = entries.begin();
+            it != entries.end(); )
+    {
+        if (it->second.delivered)
+        {
+            it++;
+        }
+        else if (it->second.state == stateDecoding)
+        {
+            // dropped by the worker when decoded
+            it->second.cancelled = true;
+            it++;
+        }
+        else
+        {
+            erase(it++);
+        }
+    }
+
+    stateChanged.broadcast();
+}
+
+void ImageFileCache::setBudget(size_t bytes)
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+
+    budget = bytes;
+    evict();
+}
+
+size_t ImageFileCache::getBudget()
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+    return budget;
+}
+
+cv::Mat ImageFileCache::decode(const std::string& path, int flags)
+{
+    try
+    {
+        return cv::imread(path.c_str(), flags);
+    }
+    catch (cv::Exception& e)
+    {
+        poco_error(log, "decoding " + path + ": " + e.what());
+        return cv::Mat();
+    }
+}
+
+void ImageFileCache::startWorkers()
+{
+    if (!workers.empty())
+        return;
+
+    int count = Poco::Environment::processorCount();
+    if (count > 4)
+        count = 4;
+    if (count < 1)
+        count = 1;
+
+    for (int ind = 0; ind < count; ind++)
+    {
+        workers.push_back(new Poco::Thread);
+        workers.back()->start(workerRunnable);
+    }
+
+    poco_information(log, Poco::NumberFormatter::format(count)
+            + " image decoding threads started");
+}
+
+void ImageFileCache::workerLoop()
+{
+    Poco::ScopedLock<Poco::Mutex> lock(mutex);
+
+    while (true)
+    {
+        while (!stopping && requests.empty())
+            stateChanged.wait(mutex);
+
+        if (stopping)
+            return;
+
+        std::string entryKey = requests.front();
+        requests.pop_front();
+
+        std::map<std::string, Entry>::iterator it = entries.find(entryKey);
+        if (it == entries.end())
+            continue;
+
+        it->second.state = stateDecoding;
+        std::string path = it->second.path;
+        int flags = it->second.flags;
+
+        cv::Mat image;
+        {
+            Poco::ScopedUnlock<Poco::Mutex> unlock(mutex);
+            image = decode(path, flags);
+        }
+
+        it = entries.find(entryKey);
+        if (it != entries.end() && it->second.cancelled)
+        {
+            erase(it);
+        }
+        else if (it != entries.end())
+        {
+            it->second.state = stateReady;
+            it->second.image = image;
+            it->second.bytes = image.total() * image.elemSize();
+            cachedBytes += it->second.bytes;
+
+            evict();
+        }
+
+        stateChanged.broadcast();
+    }
+}
+
+void ImageFileCache::evict()
+{
+    std::list<std::string>::iterator pos = lru.end();
+
+    while (cachedBytes > budget && pos != lru.begin())
+    {
+        pos--;
+
+        std::map<std::string, Entry>::iterator it = entries.find(*pos);
+        poco_assert(it != entries.end());
+
+        // the prefetched images are kept until delivered
+        if (it->second.state != stateReady || !it->second.delivered)
+            continue;
+
+        pos++; // erase invalidates the current position
+        erase(it);
+    }
+}
+
+void ImageFileCache::touch(Entry& entry)
+{
+    lru.splice(lru.begin(), lru, entry.lruPos);
+}
+
+void ImageFileCache::erase(std::map<std::string, Entry>::iterator it)
+{
+    cachedBytes -= it->second.bytes;
+    lru.erase(it->second.lruPos);
+    entries.erase(it);
+}
+
+#endif /* HAVE_OPENCV */
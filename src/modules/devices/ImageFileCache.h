@@ -0,0 +1,181 @@
+/**
+ * @file	src/modules/devices/ImageFileCache.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_MODULES_DEVICES_IMAGEFILECACHE_H_
+#define SRC_MODULES_DEVICES_IMAGEFILECACHE_H_
+
+#ifdef HAVE_OPENCV
+
+#include "Poco/Logger.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+
+#include "opencv2/core/core.hpp"
+
+#include <map>
+#include <list>
+#include <deque>
+#include <vector>
+
+/**
+ * ImageFileCache
+ *
+ * Cache of decoded image files, used by CameraFromFiles.
+ *
+ *  - prefetch() queues a file to be decoded by the worker threads,
+ *  - get() returns the decoded image: from the cache, waiting for
+ *  a pending decoding, or decoding it in the calling thread
+ *  if it was not requested yet,
+ *  - the images that were already delivered by get() are kept in a
+ *  LRU cache, bounded by a memory budget. The prefetched images
+ *  are kept until delivered.
+ *
+ * get() returns a copy of the images that stay in the cache, so that
+ * the consumers can modify them. The images that are not kept (budget
+ * exceeded) are handed over without copy.
+ */
+class ImageFileCache
+{
+public:
+    /**
+     * Constructor
+     *
+     * The worker threads are only started at the first prefetch
+     *
+     * @param logger logger of the owner module
+     */
+    ImageFileCache(Poco::Logger& logger);
+
+    /// Stop and join the worker threads
+    virtual ~ImageFileCache();
+
+    /**
+     * Queue the given file to be decoded in the background
+     *
+     * Nothing is done if the image is cached or already queued.
+     *
+     * @param path image file path
+     * @param flags cv::imread flags
+     */
+    void prefetch(const std::string& path, int flags);
+
+    /**
+     * Get the decoded image
+     *
+     * @return an empty image if the file can not be decoded. The
+     * returned image is not shared with the cache.
+     */
+    cv::Mat get(const std::string& path, int flags);
+
+    /**
+     * Drop the queued requests and the prefetched images not
+     * delivered yet
+     *
+     * To be called when the image list changes
+     */
+    void cancelPrefetch();
+
+    /**
+     * Set the memory budget of the delivered images
+     *
+     * @param bytes 0 to disable the cache
+     */
+    void setBudget(size_t bytes);
+
+    size_t getBudget();
+
+private:
+    ImageFileCache();
+
+    /// Decode the given image file
+    cv::Mat decode(const std::string& path, int flags);
+
+    /// Worker thread main loop
+    void workerLoop();
+
+    /// Start the worker threads if not yet started. mutex shall be locked
+    void startWorkers();
+
+    /**
+     * Remove the least recently used images that were already
+     * delivered, until the memory budget is respected.
+     *
+     * mutex shall be locked
+     */
+    void evict();
+
+    /// State of a cache entry
+    enum States
+    {
+        stateQueued, ///< waiting for a worker
+        stateDecoding, ///< being decoded
+        stateReady ///< decoded
+    };
+
+    struct Entry
+    {
+        std::string path;
+        int flags;
+        int state; ///< see States
+        bool delivered; ///< true if returned by get() at least once
+        bool cancelled; ///< cancelled while being decoded
+        cv::Mat image;
+        size_t bytes;
+        std::list<std::string>::iterator lruPos;
+    };
+
+    /// Entry key
+    static std::string key(const std::string& path, int flags);
+
+    /// Move the given entry at the front of the LRU list. mutex shall be locked
+    void touch(Entry& entry);
+
+    /// Erase the given entry. mutex shall be locked
+    void erase(std::map<std::string, Entry>::iterator it);
+
+    std::map<std::string, Entry> entries;
+    std::list<std::string> lru; ///< entry keys, most recently used first
+    std::deque<std::string> requests; ///< queued entry keys
+
+    size_t budget; ///< memory budget in bytes
+    size_t cachedBytes; ///< memory used by the decoded images
+
+    Poco::Mutex mutex; ///< lock all the members
+    Poco::Condition stateChanged; ///< new request, decoded image or stop request
+
+    Poco::RunnableAdapter<ImageFileCache> workerRunnable;
+    std::vector<Poco::Thread*> workers;
+    bool stopping; ///< stop request for the worker threads
+
+    Poco::Logger& log;
+};
+
+#endif /* HAVE_OPENCV */
+#endif /* SRC_MODULES_DEVICES_IMAGEFILECACHE_H_ */
@@ -0,0 +1,178 @@
+/**
+ * @file	src/modules/devices/genicam/BayerConverter.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+#ifdef HAVE_GENAPI
+
+#include "BayerConverter.h"
+
+#include "Poco/Exception.h"
+
+namespace
+{
+
+/**
+ * Half resolution binning of Bayer rows, in parallel
+ *
+ * (r0, c0): position of the red sample in each 2x2 block,
+ * the blue sample is at (1-r0, 1-c0).
+ */
+template <typename T>
+class BinBayerBody: public cv::ParallelLoopBody
+{
+public:
+    BinBayerBody(const cv::Mat& raw, int r0, int c0, cv::Mat& half):
+        mRaw(raw), mR0(r0), mC0(c0), mHalf(half)
+    {
+    }
+
+    void operator()(const cv::Range& range) const
+    {
+        int cols = mHalf.cols;
+
+        for (int row = range.start; row < range.end; row++)
+        {
+            const T* pRed = mRaw.ptr<T>(2*row + mR0) + mC0;
+            const T* pGreen0 = mRaw.ptr<T>(2*row + mR0) + 1 - mC0;
+            const T* pGreen1 = mRaw.ptr<T>(2*row + 1 - mR0) + mC0;
+            const T* pBlue = mRaw.ptr<T>(2*row + 1 - mR0) + 1 - mC0;
+            T* pOut = mHalf.ptr<T>(row);
+
+            for (int col = 0; col < cols; col++)
+            {
+                pOut[3*col] = pBlue[2*col];
+                pOut[3*col + 1] = static_cast<T>(
+                        (static_cast<unsigned int>(pGreen0[2*col])
+                            + pGreen1[2*col] + 1) >> 1);
+                pOut[3*col + 2] = pRed[2*col];
+            }
+        }
+    }
+
+private:
+    const cv::Mat& mRaw;
+    int mR0, mC0;
+    cv::Mat& mHalf;
+};
+
+}
+
+BayerConverter::Pattern BayerConverter::patternFromName(const std::string& name)
+{
+    if (name.compare(0, 5, "Bayer") != 0 || name.size() < 7)
+        return patternNone;
+
+    std::string pattern(name.substr(5, 2));
+
+    if (pattern == "RG")
+        return patternRG;
+    else if (pattern == "GB")
+        return patternGB;
+    else if (pattern == "GR")
+        return patternGR;
+    else if (pattern == "BG")
+        return patternBG;
+    else
+        throw Poco::NotImplementedException("BayerConverter",
+                "unrecognized Bayer pattern: " + name);
+}
+
+void BayerConverter::demosaic(const cv::Mat& raw, Pattern pattern, cv::Mat& bgr)
+{
+    // OpenCV names the patterns after the second row, second column block
+    int code;
+    switch (pattern)
+    {
+    case patternRG:
+        code = cv::COLOR_BayerBG2BGR;
+        break;
+    case patternGB:
+        code = cv::COLOR_BayerGR2BGR;
+        break;
+    case patternGR:
+        code = cv::COLOR_BayerGB2BGR;
+        break;
+    case patternBG:
+        code = cv::COLOR_BayerRG2BGR;
+        break;
+    default:
+        throw Poco::InvalidArgumentException("BayerConverter::demosaic",
+                "not a Bayer image");
+    }
+
+    cv::cvtColor(raw, bgr, code);
+}
+
+void BayerConverter::binHalf(const cv::Mat& raw, Pattern pattern, cv::Mat& half)
+{
+    if (raw.type() != CV_8UC1 && raw.type() != CV_16UC1)
+        throw Poco::InvalidArgumentException("BayerConverter::binHalf",
+                "the raw image should be CV_8UC1 or CV_16UC1");
+
+    int rows = raw.rows / 2;
+    int cols = raw.cols / 2;
+
+    if (pattern == patternNone)
+    {
+        cv::resize(raw(cv::Rect(0, 0, 2*cols, 2*rows)), half,
+                cv::Size(cols, rows), 0, 0, cv::INTER_AREA);
+        return;
+    }
+
+    int r0, c0; // red sample position
+    switch (pattern)
+    {
+    case patternRG:
+        r0 = 0; c0 = 0;
+        break;
+    case patternGR:
+        r0 = 0; c0 = 1;
+        break;
+    case patternGB:
+        r0 = 1; c0 = 0;
+        break;
+    default: // patternBG
+        r0 = 1; c0 = 1;
+        break;
+    }
+
+    // bypass a possible custom allocator of half (e.g. lent buffer)
+    half = cv::Mat(rows, cols, CV_MAKETYPE(raw.depth(), 3));
+
+    if (raw.depth() == CV_8U)
+        cv::parallel_for_(cv::Range(0, rows),
+                BinBayerBody<unsigned char>(raw, r0, c0, half),
+                rows / 64 + 1);
+    else
+        cv::parallel_for_(cv::Range(0, rows),
+                BinBayerBody<unsigned short>(raw, r0, c0, half),
+                rows / 64 + 1);
+}
+
+#endif /* HAVE_GENAPI */
+#endif /* HAVE_OPENCV */
@@ -0,0 +1,99 @@
+/**
+ * @file	src/modules/devices/genicam/BayerConverter.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_MODULES_DEVICES_GENICAM_BAYERCONVERTER_H_
+#define SRC_MODULES_DEVICES_GENICAM_BAYERCONVERTER_H_
+
+#ifdef HAVE_OPENCV
+#ifdef HAVE_GENAPI
+
+#include "opencv2/opencv.hpp"
+
+#include <string>
+
+/**
+ * BayerConverter
+ *
+ * Convert the raw images of the color cameras (Bayer mosaic, 8 or 16 bits)
+ *  - to a full resolution BGR image (demosaicing, parallel and
+ *    vectorized by OpenCV),
+ *  - to a half resolution image with 2x2 binning: each 2x2 block gives
+ *    a BGR pixel (the two green samples are averaged). No interpolation
+ *    is needed: much cheaper, e.g. for display or analysis branches.
+ *
+ * The half resolution conversion is also available for the mono images
+ * (2x2 averaging).
+ */
+class BayerConverter
+{
+public:
+    /// color of the top-left pixel, and of its right neighbor
+    enum Pattern
+    {
+        patternNone, ///< mono
+        patternRG,
+        patternGB,
+        patternGR,
+        patternBG
+    };
+
+    /**
+     * Get the Bayer pattern from the GenICam PixelFormat symbolic name
+     *
+     * @return patternNone if this is not a Bayer format
+     */
+    static Pattern patternFromName(const std::string& name);
+
+    /**
+     * Full resolution demosaicing
+     *
+     * @param raw CV_8UC1 or CV_16UC1 mosaic image
+     * @param[out] bgr CV_8UC3 or CV_16UC3 image
+     */
+    static void demosaic(const cv::Mat& raw, Pattern pattern, cv::Mat& bgr);
+
+    /**
+     * Half resolution conversion with 2x2 binning
+     *
+     * The last row (resp. column) is dropped if the image height
+     * (resp. width) is odd.
+     *
+     * @param raw CV_8UC1 or CV_16UC1 image
+     * @param pattern Bayer pattern, or patternNone for mono images
+     * @param[out] half CV_8UC3 or CV_16UC3 image for Bayer patterns,
+     * same type as raw for mono images
+     */
+    static void binHalf(const cv::Mat& raw, Pattern pattern, cv::Mat& half);
+
+private:
+    BayerConverter();
+};
+
+#endif /* HAVE_GENAPI */
+#endif /* HAVE_OPENCV */
+#endif /* SRC_MODULES_DEVICES_GENICAM_BAYERCONVERTER_H_ */
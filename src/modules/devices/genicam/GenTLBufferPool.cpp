@@ -0,0 +1,289 @@
+/**
+ * @file	src/modules/devices/genicam/GenTLBufferPool.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+#ifdef HAVE_GENAPI
+
+#include "GenTLBufferPool.h"
+
+#include "Poco/NumberFormatter.h"
+
+GenTLBufferPool::GenTLBufferPool(GenTLLib* genTL, Poco::Logger& logger):
+    mGenTL(genTL), log(logger),
+    hDataStream(GENTL_INVALID_HANDLE),
+    bufSize(0), lent(0)
+{
+}
+
+GenTLBufferPool::~GenTLBufferPool()
+{
+    // revoke() shall have been called by the owner.
+    // the remaining buffers can not be lent: they would hold a reference
+    for (std::vector<Buffer*>::iterator it = buffers.begin(),
+            ite = buffers.end(); it != ite; it++)
+    {
+        delete[] (*it)->data;
+        delete *it;
+    }
+}
+
+void GenTLBufferPool::announce(GenTL::DS_HANDLE hDS, size_t count, size_t size)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+
+    if (!buffers.empty())
+        poco_bugcheck_msg("GenTLBufferPool::announce: buffers were not revoked");
+
+    hDataStream = hDS;
+    bufSize = size;
+    lent = 0;
+
+    for (size_t ind = 0; ind < count; ind++)
+    {
+        Buffer* pBuf = new Buffer;
+        pBuf->handle = GENTL_INVALID_HANDLE;
+        pBuf->lent = false;
+
+        try
+        {
+            pBuf->data = new char[bufSize];
+        }
+        catch (std::bad_alloc&) // error in `new char[]`
+        {
+            delete pBuf;
+            for (std::vector<Buffer*>::iterator it = buffers.begin(),
+                    ite = buffers.end(); it != ite; it++)
+            {
+                delete[] (*it)->data;
+                delete *it;
+            }
+            buffers.clear();
+            bufSize = 0;
+            throw Poco::OutOfMemoryException("AllocImageBuffer",
+                "Not able to allocate enough memory");
+        }
+
+        buffers.push_back(pBuf);
+    }
+
+    for (size_t ind = 0; ind < count; ind++)
+        mGenTL->DSAnnounceBuffer(
+            hDataStream,
+            buffers[ind]->data,
+            bufSize,
+            NULL,
+            &buffers[ind]->handle);
+
+    for (size_t ind = 0; ind < count; ind++)
+        mGenTL->DSQueueBuffer(hDataStream, buffers[ind]->handle);
+
+    poco_information(log, Poco::NumberFormatter::format(count)
+        + " image buffer(s) announced and enqueued");
+}
+
+void GenTLBufferPool::revoke()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+
+    // revoke all announced buffer, not regarding if they are still referenced
+    for (size_t ind = 0; ind < buffers.size(); ind++)
+    {
+        Buffer* pBuf = buffers[ind];
+
+        if (pBuf->handle != GENTL_INVALID_HANDLE)
+        {
+            try
+            {
+                poco_information(log, "revoking buffer#"
+                    + Poco::NumberFormatter::format(ind));
+                mGenTL->DSRevokeBuffer(hDataStream, pBuf->handle, NULL, NULL);
+            }
+            catch (GenTLException& e)
+            {
+                poco_error(log, e.displayText());
+            }
+        }
+
+        pBuf->handle = GENTL_INVALID_HANDLE;
+
+        if (pBuf->lent)
+        {
+            poco_information(log, "buffer#" + Poco::NumberFormatter::format(ind)
+                + " is still used downstream. It will be freed later. ");
+        }
+        else
+        {
+            delete[] pBuf->data;
+            delete pBuf;
+        }
+    }
+
+    buffers.clear();
+    lent = 0;
+    bufSize = 0;
+}
+
+bool GenTLBufferPool::wrap(GenTL::BUFFER_HANDLE hBuffer,
+        int rows, int cols, int type, cv::Mat& img)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+
+    size_t ind;
+    Buffer* pBuf = find(hBuffer, ind);
+
+    if (static_cast<size_t>(rows) * cols * CV_ELEM_SIZE(type) > bufSize)
+        throw Poco::DataException("GenTLBufferPool::wrap",
+                "The image does not fit in the buffer");
+
+    // keep at least one buffer for the producer
+    if (lent + 1 >= buffers.size())
+    {
+        poco_notice(log, "no free image buffer left: copy buffer#"
+            + Poco::NumberFormatter::format(ind));
+
+        cv::Mat(rows, cols, type, pBuf->data).copyTo(img);
+        recycle(pBuf);
+        return false;
+    }
+
+    poco_information(log, "lend buffer#" + Poco::NumberFormatter::format(ind));
+
+    lend(pBuf->data, bufSize, rows, cols, type, img, pBuf);
+
+    pBuf->lent = true;
+    lent++;
+
+    return true;
+}
+
+void GenTLBufferPool::unpack(GenTL::BUFFER_HANDLE hBuffer,
+        PixelUnpacker::Format format, int bitDepth,
+        int rows, int cols, int type, cv::Mat& img)
+{
+    Buffer* pBuf;
+    size_t size;
+
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+
+        size_t ind;
+        pBuf = find(hBuffer, ind);
+        size = bufSize;
+
+        // not counted in `lent`, but kept alive if revoked meanwhile
+        pBuf->lent = true;
+    }
+
+    try
+    {
+        PixelUnpacker::unpack(reinterpret_cast<unsigned char*>(pBuf->data),
+                size, format, bitDepth, rows, cols, type, img);
+    }
+    catch (...)
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+        pBuf->lent = false;
+        recycle(pBuf);
+        throw;
+    }
+
+    Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+    pBuf->lent = false;
+    recycle(pBuf);
+}
+
+void GenTLBufferPool::discard(GenTL::BUFFER_HANDLE hBuffer)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+
+    size_t ind;
+    Buffer* pBuf = find(hBuffer, ind);
+
+    poco_information(log, "discard buffer#" + Poco::NumberFormatter::format(ind));
+    recycle(pBuf);
+}
+
+GenTLBufferPool::Buffer* GenTLBufferPool::find(GenTL::BUFFER_HANDLE hBuffer, size_t& index)
+{
+    for (index = 0; index < buffers.size(); index++)
+    {
+        if (buffers[index]->handle == hBuffer)
+            return buffers[index];
+    }
+
+    throw Poco::NotFoundException("GenTLBufferPool", "Unrecognized buffer");
+}
+
+size_t GenTLBufferPool::count()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+    return buffers.size();
+}
+
+size_t GenTLBufferPool::lentCount()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+    return lent;
+}
+
+void GenTLBufferPool::reclaim(void* userdata) const
+{
+    Buffer* pBuf = reinterpret_cast<Buffer*>(userdata);
+
+    Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+
+    if (pBuf->handle != GENTL_INVALID_HANDLE)
+        lent--;
+
+    pBuf->lent = false;
+    recycle(pBuf);
+}
+
+void GenTLBufferPool::recycle(Buffer* pBuf) const
+{
+    if (pBuf->handle == GENTL_INVALID_HANDLE)
+    {
+        // revoked while lent
+        delete[] pBuf->data;
+        delete pBuf;
+        return;
+    }
+
+    // can be called from any thread, in any destructor: do not throw
+    try
+    {
+        mGenTL->DSQueueBuffer(hDataStream, pBuf->handle);
+    }
+    catch (GenTLException& e)
+    {
+        poco_warning(log, std::string("requeue buffer: ") + e.displayText());
+    }
+}
+
+#endif /* HAVE_GENAPI */
+#endif /* HAVE_OPENCV */
@@ -0,0 +1,167 @@
+/**
+ * @file	src/modules/devices/genicam/GenTLBufferPool.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_MODULES_DEVICES_GENICAM_GENTLBUFFERPOOL_H_
+#define SRC_MODULES_DEVICES_GENICAM_GENTLBUFFERPOOL_H_
+
+#ifdef HAVE_OPENCV
+#ifdef HAVE_GENAPI
+
+#include "GenTLLib.h"
+#include "PixelUnpacker.h"
+
+#include "tools/LentMatAllocator.h"
+
+#include "Poco/Mutex.h"
+#include "Poco/Logger.h"
+
+#include "opencv2/opencv.hpp"
+
+#include <vector>
+
+/**
+ * GenTLBufferPool
+ *
+ * Own the image buffers announced to a GenTL datastream and lend them
+ * to the dataflow without copy.
+ *
+ * A filled buffer is lent as a cv::Mat (see LentMatAllocator):
+ * when the last cv::Mat referencing it is released, the buffer is
+ * requeued to the datastream via DSQueueBuffer.
+ *
+ * If lending the buffer would leave the datastream without any queued
+ * buffer, the image is copied and the buffer requeued at once
+ * (fallback, see wrap()).
+ *
+ * The pool is reference counted: each lent buffer holds a reference,
+ * so that the memory stays valid if the owning device is deleted
+ * while images are still used downstream.
+ */
+class GenTLBufferPool: public LentMatAllocator
+{
+public:
+    GenTLBufferPool(GenTLLib* genTL, Poco::Logger& logger);
+
+    /**
+     * Allocate, announce and queue the buffers
+     *
+     * @throw Poco::OutOfMemoryException if the allocation fails
+     * @throw GenTLException from the GenTL calls
+     */
+    void announce(GenTL::DS_HANDLE hDataStream, size_t count, size_t bufSize);
+
+    /**
+     * Revoke the announced buffers
+     *
+     * The memory of the buffers that are not lent is freed.
+     * The lent ones are freed when the last cv::Mat releases them.
+     *
+     * The datastream queue has to be flushed before.
+     */
+    void revoke();
+
+    /**
+     * Wrap the given filled buffer in a cv::Mat
+     *
+     * @param hBuffer handle of the filled buffer, as returned by the
+     * new buffer event
+     * @param rows, cols, type image geometry
+     * @param[out] img image data
+     * @return true if the buffer is lent, false if the image was copied
+     *
+     * @throw Poco::NotFoundException if the handle is not one of this pool
+     */
+    bool wrap(GenTL::BUFFER_HANDLE hBuffer,
+            int rows, int cols, int type, cv::Mat& img);
+
+    /**
+     * Unpack the given filled buffer in a new cv::Mat and requeue it
+     *
+     * Used when the buffer can not be lent as is (packed pixel formats,
+     * conversion to 8 bits): the conversion is then the only copy
+     * of the image data. The pool mutex is not held while converting.
+     *
+     * @see PixelUnpacker::unpack
+     * @throw Poco::NotFoundException if the handle is not one of this pool
+     */
+    void unpack(GenTL::BUFFER_HANDLE hBuffer,
+            PixelUnpacker::Format format, int bitDepth,
+            int rows, int cols, int type, cv::Mat& img);
+
+    /**
+     * Requeue the given filled buffer without using its data
+     *
+     * e.g. if the buffer is incomplete
+     */
+    void discard(GenTL::BUFFER_HANDLE hBuffer);
+
+    /// number of announced buffers
+    size_t count();
+
+    /// number of buffers currently lent to the dataflow
+    size_t lentCount();
+
+    /// size of each buffer
+    size_t bufferSize() { return bufSize; }
+
+protected:
+    ~GenTLBufferPool();
+
+    /// requeue the lent buffer, or free it if it was revoked
+    void reclaim(void* userdata) const;
+
+private:
+    GenTLBufferPool();
+
+    struct Buffer
+    {
+        GenTL::BUFFER_HANDLE handle; ///< GENTL_INVALID_HANDLE once revoked
+        char* data;
+        bool lent;
+    };
+
+    /// requeue the buffer or free it if it was revoked. mutex is locked
+    void recycle(Buffer* pBuf) const;
+
+    /// find the buffer given its handle. mutex is locked
+    Buffer* find(GenTL::BUFFER_HANDLE hBuffer, size_t& index);
+
+    GenTLLib* mGenTL;
+    Poco::Logger& log;
+
+    GenTL::DS_HANDLE hDataStream;
+    size_t bufSize;
+
+    mutable std::vector<Buffer*> buffers; ///< announced buffers
+    mutable size_t lent; ///< number of lent buffers among the announced ones
+    mutable Poco::FastMutex mutex;
+};
+
+#endif /* HAVE_GENAPI */
+#endif /* HAVE_OPENCV */
+#endif /* SRC_MODULES_DEVICES_GENICAM_GENTLBUFFERPOOL_H_ */
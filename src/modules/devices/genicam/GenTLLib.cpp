@@ -35,6 +35,7 @@
 #include"GenTLLib.h"
 
 #include <typeinfo>
+#include <cstring>
 POCO_IMPLEMENT_EXCEPTION( GenTLException, Poco::Exception,"Genicam Transport Layer error")
 
 GenTLLib::GenTLLib(Poco::Path libTLPath):
@@ -84,71 +85,71 @@ void GenTLLib::genTLCheckError(GenTL::GC_ERROR retValue)
     switch (retValue)
     {
         case GenTL::GC_ERR_ERROR               :
-            throw GenTLException("GenTL","generic error");
+            throw GenTLException("GenTL","generic error", retValue);
             break;
         case GenTL::GC_ERR_NOT_INITIALIZED     :
-            throw GenTLException("GenTL","not initialized");
+            throw GenTLException("GenTL","not initialized", retValue);
             break;
         case GenTL::GC_ERR_NOT_IMPLEMENTED     :
-            throw GenTLException("GenTL","not implemented");
+            throw GenTLException("GenTL","not implemented", retValue);
             break;
         case GenTL::GC_ERR_RESOURCE_IN_USE     :
-            throw GenTLException("GenTL","resource in use");
+            throw GenTLException("GenTL","resource in use", retValue);
             break;
         case GenTL::GC_ERR_ACCESS_DENIED       :
-            throw GenTLException("GenTL","access denied");
+            throw GenTLException("GenTL","access denied", retValue);
             break;
         case GenTL::GC_ERR_INVALID_HANDLE      :
-            throw GenTLException("GenTL","invalid handle");
+            throw GenTLException("GenTL","invalid handle", retValue);
             break;
         case GenTL::GC_ERR_INVALID_ID          :
-            throw GenTLException("GenTL","invalid ID");
+            throw GenTLException("GenTL","invalid ID", retValue);
             break;
         case GenTL::GC_ERR_NO_DATA             :
-            throw GenTLException("GenTL","no data");
+            throw GenTLException("GenTL","no data", retValue);
             break;
         case GenTL::GC_ERR_INVALID_PARAMETER   :
-            throw GenTLException("GenTL","invalid parameter");
+            throw GenTLException("GenTL","invalid parameter", retValue);
             break;
         case GenTL::GC_ERR_IO                  :
-            throw GenTLException("GenTL","IO error");
+            throw GenTLException("GenTL","IO error", retValue);
             break;
         case GenTL::GC_ERR_TIMEOUT             :
-            throw GenTLException("GenTL","timeout");
+            throw GenTLException("GenTL","timeout", retValue);
             break;
         case GenTL::GC_ERR_ABORT               : /* GenTL v1.1 */
-            throw GenTLException("GenTL","abort");
+            throw GenTLException("GenTL","abort", retValue);
             break;
         case GenTL::GC_ERR_INVALID_BUFFER      : /* GenTL v1.1 */
-            throw GenTLException("GenTL","invalid buffer");
+            throw GenTLException("GenTL","invalid buffer", retValue);
             break;
         case GenTL::GC_ERR_NOT_AVAILABLE       : /* GenTL v1.2 */
-            throw GenTLException("GenTL","not available");
+            throw GenTLException("GenTL","not available", retValue);
             break;
         case GenTL::GC_ERR_INVALID_ADDRESS     : /* GenTL v1.3 */
-            throw GenTLException("GenTL","invalid address");
+            throw GenTLException("GenTL","invalid address", retValue);
             break;
         case GenTL::GC_ERR_BUFFER_TOO_SMALL    : /* GenTL v1.4 */
-            throw GenTLException("GenTL","buffer too small");
+            throw GenTLException("GenTL","buffer too small", retValue);
             break;
         case GenTL::GC_ERR_INVALID_INDEX       : /* GenTL v1.4 */
-            throw GenTLException("GenTL","invalid index");
+            throw GenTLException("GenTL","invalid index", retValue);
             break;
         case GenTL::GC_ERR_PARSING_CHUNK_DATA  : /* GenTL v1.4 */
-            throw GenTLException("GenTL","parsing chunk data");
+            throw GenTLException("GenTL","parsing chunk data", retValue);
             break;
         case GenTL::GC_ERR_INVALID_VALUE       : /* GenTL v1.4 */
-            throw GenTLException("GenTL","invalid value");
+            throw GenTLException("GenTL","invalid value", retValue);
             break;
         case GenTL::GC_ERR_RESOURCE_EXHAUSTED  : /* GenTL v1.4 */
-            throw GenTLException("GenTL","resource exhausted");
+            throw GenTLException("GenTL","resource exhausted", retValue);
             break;
         case GenTL::GC_ERR_OUT_OF_MEMORY       : /* GenTL v1.4 */
-            throw GenTLException("GenTL","out of memory");
+            throw GenTLException("GenTL","out of memory", retValue);
             break;
 
         case GenTL::GC_ERR_CUSTOM_ID           :
-            throw GenTLException("GenTL","custom ID error");
+            throw GenTLException("GenTL","custom ID error", retValue);
             break;
 
         default:
@@ -504,7 +505,31 @@ void GenTLLib::genTLPortExInfo(GenTL::PORT_HANDLE hPort, Poco::Logger& log)
 }
 
 #ifdef HAVE_GENAPI
-void GenTLLib::retrieveNodeMap(GenTL::PORT_HANDLE hPort, GenApi::CNodeMapRef& nodeMap, Poco::Logger& log)
+void GenTLLib::retrieveNodeMap(GenTL::PORT_HANDLE hPort, GenApi::CNodeMapRef& nodeMap,
+		Poco::Logger& log, std::string* xmlKey)
+{
+	bool zipped;
+	std::string xml = retrieveXml(hPort, zipped, log, xmlKey);
+
+	GenICam::gcstring xmlString(xml.data(), xml.size());
+
+	try
+	{
+		if (!zipped)
+			nodeMap._LoadXMLFromString(xmlString);
+		else
+			nodeMap._LoadXMLFromZIPData(xml.data(), xml.size());
+
+		poco_information(log, "XML file loaded...");
+	}
+	catch (GenICam::GenericException& e)
+	{
+		throw GenTLException("loadXML", e.GetDescription());
+	}
+}
+
+std::string GenTLLib::retrieveXml(GenTL::PORT_HANDLE hPort, bool& zipped,
+		Poco::Logger& log, std::string* xmlKey)
 {
 	uint32_t numURLs;
 
@@ -519,16 +544,28 @@ void GenTLLib::retrieveNodeMap(GenTL::PORT_HANDLE hPort, GenApi::CNodeMapRef& no
 
         GenTL::INFO_DATATYPE dataType;
 
-        GCGetPortURLInfo( hPort, iPort,
-            GenTL::URL_INFO_URL,
-            &dataType,
-            pBuffer,
-            &bufferSize ) ;
+        try
+        {
+            GCGetPortURLInfo( hPort, iPort,
+                GenTL::URL_INFO_URL,
+                &dataType,
+                pBuffer,
+                &bufferSize ) ;
+        }
+        catch (GenTLException&)
+        {
+            delete[] pBuffer;
+            throw;
+        }
 
         if (dataType != GenTL::INFO_DATATYPE_STRING)
+        {
+            delete[] pBuffer;
             throw GenTLException("genTLExInfo", "type error: should be string");
+        }
 
-		std::string sURL(pBuffer, bufferSize);
+		// the returned size includes the terminating null character
+		std::string sURL(pBuffer);
 		delete[] pBuffer;
 
         poco_information(log,
@@ -569,10 +606,19 @@ void GenTLLib::retrieveNodeMap(GenTL::PORT_HANDLE hPort, GenApi::CNodeMapRef& no
 		}
 
 		std::string extension(sURL, posVec[1].offset, posVec[1].length);
-		bool zipped = false;
+		zipped = (Poco::icompare(extension,"zip") == 0);
 
-		if (Poco::icompare(extension,"zip") == 0)
-			zipped = true;
+		std::string cacheKey = GenicamXmlCache::makeKey(
+				xmlDescription(hPort, iPort, sURL));
+		if (xmlKey)
+			*xmlKey = cacheKey;
+
+		std::string xml;
+		if (xmlCache.get(cacheKey, xml))
+		{
+			poco_information(log, "XML file retrieved from the cache");
+			return xml;
+		}
 
 		std::string sAddress(sURL, posVec[2].offset, posVec[2].length);
 		size_t address = Poco::NumberParser::parseHex64(sAddress);
@@ -588,33 +634,74 @@ void GenTLLib::retrieveNodeMap(GenTL::PORT_HANDLE hPort, GenApi::CNodeMapRef& no
 		}
         catch (GenTLException& e)
         {
+            delete[] pBuffer;
             poco_warning(log, "Cannot retrieve XML from register map: " 
 				+ e.displayText());
             continue;
         }
 
-		// poco_information(log, std::string(pBuffer, length));
+		xml.assign(pBuffer, length);
+		delete[] pBuffer;
 
-		GenICam::gcstring xmlString(pBuffer, length);
+		xmlCache.put(cacheKey, xml);
+		return xml;
+    }
+
+	throw GenTLException("RetrieveNodeMap", "Unable to find a supported port URL. ");
+}
 
+std::string GenTLLib::xmlDescription(GenTL::PORT_HANDLE hPort, uint32_t iURL,
+		const std::string& url)
+{
+	std::string description(url);
+	GenTL::INFO_DATATYPE dataType;
+
+	GenTL::PORT_INFO_CMD portCmds[] = { GenTL::PORT_INFO_VENDOR, GenTL::PORT_INFO_MODEL };
+	for (size_t ind = 0; ind < sizeof(portCmds)/sizeof(portCmds[0]); ind++)
+	{
+		char buffer[256];
+		size_t size = sizeof(buffer);
 		try
 		{
-			if (!zipped)
-				nodeMap._LoadXMLFromString(xmlString);
-			else
-				nodeMap._LoadXMLFromZIPData(xmlString, length);
-
-			poco_information(log, "XML file loaded...");
-			return;
+			GCGetPortInfo(hPort, portCmds[ind], &dataType, buffer, &size);
+			buffer[sizeof(buffer) - 1] = 0;
+			description += ";" + std::string(buffer);
 		}
-		catch (GenICam::GenericException& e)
+		catch (GenTLException&)
 		{
-			throw GenTLException("loadXML", e.GetDescription());
+			description += ";";
 		}
-
-		delete[] pBuffer;
-    }
-
-	throw GenTLException("RetrieveNodeMap", "Unable to find a supported port URL. ");
+	}
+
+	GenTL::URL_INFO_CMD versionCmds[] = { GenTL::URL_INFO_FILE_VER_MAJOR,
+			GenTL::URL_INFO_FILE_VER_MINOR, GenTL::URL_INFO_FILE_VER_SUBMINOR };
+	for (size_t ind = 0; ind < sizeof(versionCmds)/sizeof(versionCmds[0]); ind++)
+	{
+		int32_t version = 0;
+		size_t size = sizeof(version);
+		try
+		{
+			GCGetPortURLInfo(hPort, iURL, versionCmds[ind], &dataType, &version, &size);
+			description += ";" + Poco::NumberFormatter::format(version);
+		}
+		catch (GenTLException&)
+		{
+			description += ";";
+		}
+	}
+
+	unsigned char sha1[20];
+	size_t size = sizeof(sha1);
+	try
+	{
+		GCGetPortURLInfo(hPort, iURL, GenTL::URL_INFO_FILE_SHA1_HASH, &dataType, sha1, &size);
+		for (size_t ind = 0; ind < size && ind < sizeof(sha1); ind++)
+			description += Poco::NumberFormatter::formatHex(sha1[ind], 2);
+	}
+	catch (GenTLException&)
+	{
+	}
+
+	return description;
 }
 #endif /* HAVE_GENAPI */
\ No newline at end of file
@@ -30,6 +30,7 @@
 #define SRC_GENICAM_GENTLLIB_H_
 
 #include "GenTL_v1_5.h"
+#include "GenicamXmlCache.h"
 #ifdef HAVE_GENAPI
 #    include "GenICam.h"
 #endif
@@ -217,6 +218,13 @@ public:
      */
     void genTLPortExInfo(GenTL::PORT_HANDLE hPort, Poco::Logger& log);
 
+	/**
+	 * Startup cache: description files, device lists, parameter lists
+	 *
+	 * Shared by the factories and the devices using this library.
+	 */
+	GenicamXmlCache& cache() { return xmlCache; }
+
 #ifdef HAVE_GENAPI
 	/**
 	 * Retrieve the nodeMap of the given port
@@ -225,12 +233,43 @@ public:
 	 * 
 	 * The XML is loaded, but the nodeMap is not connected to the transport layer. 
 	 * 
+	 * @param[out] xmlKey if not NULL, cache key of the description file,
+	 * to derive the keys of the data depending on it
 	 * @throw GenTLException on error
 	 */
-	void retrieveNodeMap(GenTL::PORT_HANDLE hPort, GenApi::CNodeMapRef& nodeMap, Poco::Logger& log);
+	void retrieveNodeMap(GenTL::PORT_HANDLE hPort, GenApi::CNodeMapRef& nodeMap,
+			Poco::Logger& log, std::string* xmlKey = NULL);
+
+	/**
+	 * Retrieve the XML description file of the given port
+	 *
+	 * The file is read from the cache if it was already retrieved,
+	 * else via GCReadPort, and then cached.
+	 *
+	 * Can be called from a background thread to prefetch the file.
+	 *
+	 * @param[out] zipped true if the file is zipped
+	 * @param[out] xmlKey if not NULL, cache key of the file
+	 * @throw GenTLException if no supported URL is found
+	 */
+	std::string retrieveXml(GenTL::PORT_HANDLE hPort, bool& zipped,
+			Poco::Logger& log, std::string* xmlKey = NULL);
 #endif
 
 private:
+#ifdef HAVE_GENAPI
+	/**
+	 * Description of the XML file given by the URL
+	 *
+	 * Used as cache key: URL, port vendor and model,
+	 * file version and SHA1 if available
+	 */
+	std::string xmlDescription(GenTL::PORT_HANDLE hPort, uint32_t iURL,
+			const std::string& url);
+#endif
+
+	GenicamXmlCache xmlCache;
+
     Poco::Path _libTLPath; ///< path of the GenTL library
     Poco::SharedLibrary _libTL; ///< GenTL shared lib object
 
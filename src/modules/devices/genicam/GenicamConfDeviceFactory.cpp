@@ -29,6 +29,7 @@
 #ifdef HAVE_GENAPI
 
 #include "GenicamConfDeviceFactory.h"
+#include "GenicamDeviceFactory.h"
 
 #include "GenicamDevice.h"
 
@@ -56,6 +57,8 @@ size_t GenicamConfDeviceFactory::countRemain()
 
 Module* GenicamConfDeviceFactory::newChildModule(std::string customName)
 {
+    static_cast<GenicamDeviceFactory*>(parent())->waitPrefetch();
+
     return new GenicamDevice(mGenTL, _TLhInterface, _TLhDevice, this, customName);
 }
 
@@ -35,14 +35,23 @@
 #include "core/ModuleFactoryBranch.h"
 
 #include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
 #include "Poco/String.h" // toUpper, cat
 #include "Poco/RegularExpression.h"
 #include "Poco/StringTokenizer.h"
 
 #include "Poco/ByteOrder.h"
+#include "Poco/Timestamp.h"
+#include "Poco/SharedPtr.h"
+
+#include <algorithm>
+#include <limits>
 
 using namespace GenApi;
 
+/// upper limit of the memory allocated for one burst (4 GiB)
+static const Poco::UInt64 maxBurstBytes = static_cast<Poco::UInt64>(4) << 30;
+
 GenicamDevice::GenicamDevice(GenTLLib* genTL,
         GenTL::IF_HANDLE TLhInterface,
         GenTL::DEV_HANDLE TLhDevice, ModuleFactory* parent,
@@ -54,24 +63,82 @@ GenicamDevice::GenicamDevice(GenTLLib* genTL,
     hDataStream(GENTL_INVALID_HANDLE),
     hEvent(GENTL_INVALID_HANDLE),
     hRemoteDevPort(GENTL_INVALID_HANDLE),
-    imgBufSize(0),
-    bPixFormatMono8(true),
+    bufferCount(0),
+    acqMode(acqSingle), streamFrames(0), burstFrames(0), grabTimeout(0),
+    grabRunnable(*this, &GenicamDevice::grabLoop),
+    grabbing(false),
+    framesDelivered(0), framesDropped(0), framesIncomplete(0),
+    pixFormat(PixelUnpacker::fmtMono8), pixBitDepth(8),
+    downshift8(false), imgType(CV_8UC1),
+    bayerPattern(BayerConverter::patternNone), demosaic(true),
     imgWidth(0), imgHeight(0),
     acquiring(false),
 	transportObj(genTL, hRemoteDevPort),
+	nodeCacheGeneration(0),
 	seqIndex(0),
 	pOutAttr(NULL)
 {
-	for (size_t ind = 0; ind < BUFFER_COUNT; ind++)
-	{
-		hBuffer[ind] = GENTL_INVALID_HANDLE;
-		pImgBuffer[ind] = NULL;
-	}
-
     setInternalName(static_cast<ModuleFactoryBranch*>(static_cast<ModuleFactoryBranch*>(parent)->parent())->getSelector());
     setCustomName(customName);
     setLogger("module." + name());
 
+    bufferPool = new GenTLBufferPool(genTL, logger());
+
+    setParameterCount(paramCnt);
+    addParameter(paramBufferCount, "bufferCount",
+            "Number of image buffers announced to the GenTL datastream. "
+            "The images are lent to the dataflow without copy, "
+            "and copied only when no free buffer is left. "
+            "Applied at the next acquisition start. ",
+            ParamItem::typeInteger, "4");
+    addParameter(paramAcqMode, "acquisitionMode",
+            "Acquisition mode: "
+            "\"single\": one image per trigger; "
+            "\"stream\": free-running acquisition, "
+            "delivering a data sequence of streamFrames images per trigger; "
+            "\"burst\": burstFrames images per trigger, "
+            "delivered at once as an image array",
+            ParamItem::typeString, "single");
+    addParameter(paramStreamFrames, "streamFrames",
+            "Number of frames delivered per trigger in stream mode. "
+            "If 0: endless stream, until cancellation. ",
+            ParamItem::typeInteger, "0");
+    addParameter(paramBurstFrames, "burstFrames",
+            "Number of frames acquired per trigger in burst mode. "
+            "The frames are stored in one contiguous block, "
+            "limited to 4 GiB. ",
+            ParamItem::typeInteger, "10");
+    addParameter(paramGrabTimeout, "grabTimeout",
+            "Timeout in milliseconds used by the grab thread "
+            "when waiting for a new buffer in stream or burst mode",
+            ParamItem::typeInteger, "100");
+    addParameter(paramFramesDelivered, "framesDelivered",
+            "Number of frames delivered in stream or burst mode. Set to 0 to reset",
+            ParamItem::typeInteger, "0");
+    addParameter(paramFramesDropped, "framesDropped",
+            "Number of frames dropped in stream or burst mode: "
+            "lost by the producer or overwritten before delivery. "
+            "Set to 0 to reset",
+            ParamItem::typeInteger, "0");
+    addParameter(paramFramesIncomplete, "framesIncomplete",
+            "Number of incomplete frames discarded in stream or burst mode. "
+            "Set to 0 to reset",
+            ParamItem::typeInteger, "0");
+    addParameter(paramDownshift8, "downshift8",
+            "Deliver 8-bit images, keeping the most significant bits "
+            "whatever the pixel format (ON), e.g. for preview. "
+            "Deliver the native bit depth elsewhere (OFF). "
+            "Applied at the next acquisition start. ",
+            ParamItem::typeString, "OFF");
+    addParameter(paramDemosaic, "demosaic",
+            "Bayer pixel formats: deliver full resolution BGR images "
+            "on the image port (ON), or the raw mosaic images (OFF). "
+            "The imageHalf port always delivers BGR images. ",
+            ParamItem::typeString, "ON");
+
+    // only the own parameters are defined yet
+    setParametersDefaultValue();
+
 	connectNodeMap();
 
 	std::string config(reinterpret_cast<ModuleFactoryBranch*>(parent)->getSelector());
@@ -86,6 +153,13 @@ GenicamDevice::GenicamDevice(GenTLLib* genTL,
 
     addOutPort("acqReady", "acquisition ready trigger", DataItem::typeInt32, acqReadyOutPort);
     addOutPort("image", "image delivered by the camera", DataItem::typeCvMat, imgOutPort);
+    addOutPort("timestamp", "image timestamp in nanoseconds", DataItem::typeUInt64, timestampOutPort);
+    addOutPort("imageHalf", "half resolution image (2x2 binning, BGR for the Bayer formats). "
+            "Only computed if used", DataItem::typeCvMat, halfImgOutPort);
+    addOutPort("burst", "burst mode: array of the acquired images, "
+            "stored in one contiguous block", DataItem::typeCvMat | DataItem::contVector, burstOutPort);
+    addOutPort("burstTimestamps", "burst mode: array of the image timestamps in nanoseconds",
+            DataItem::typeUInt64 | DataItem::contVector, burstTimestampsOutPort);
 
     retrieveDataStream();
 
@@ -94,6 +168,8 @@ GenicamDevice::GenicamDevice(GenTLLib* genTL,
 
 GenicamDevice::~GenicamDevice()
 {
+    releaseNodeCache();
+
     if (acquiring)
         stopAcq();
 
@@ -119,7 +195,7 @@ void GenicamDevice::connectNodeMap()
 
          poco_information(logger(), "Port retrieved via DevGetPort()");
          // mGenTL->genTLPortInfo(_genTLhRemoteDevPort, logger()); // device info. device dependant
-		 mGenTL->retrieveNodeMap(hRemoteDevPort, nodeMap, logger());
+		 mGenTL->retrieveNodeMap(hRemoteDevPort, nodeMap, logger(), &xmlKey);
 
 		 try
 		 {
@@ -142,72 +218,96 @@ void GenicamDevice::loadConf(std::string filePath)
 {
     simpleYamlParse(filePath);
 
-	// populate parameters using genParamList
-	setParameterCount(genParamList.size());
+	// the parameter definitions only depend on the description file
+	// and on the selected nodes
+	std::string paramKey = "parameters:" + xmlKey;
+	for (size_t ind = 0; ind < genParamList.size(); ind++)
+		paramKey += std::string(":") + genParamList[ind]->GetName().c_str();
+	paramKey = GenicamXmlCache::makeKey(paramKey);
+
+	std::vector<std::string> paramDefs;
+	if (!xmlKey.empty() && mGenTL->cache().getList(paramKey, paramDefs)
+			&& keepDescribedNodes(paramDefs))
+	{
+		poco_information(logger(), "parameter definitions retrieved from the cache");
+	}
+	else
+	{
+		paramDefs = describeNodes();
+		if (!xmlKey.empty())
+			mGenTL->cache().putList(paramKey, paramDefs);
+	}
+
+	// populate parameters using genParamList, after the own parameters
+	setParameterCount(paramCnt + genParamList.size());
 
 	for (size_t ind = 0; ind < genParamList.size(); ind++)
 	{
-		bool errored = false;
+		addParameter(paramCnt + ind, paramDefs[3*ind], paramDefs[3*ind + 2],
+			static_cast<ParamItem::ParamType>(
+					Poco::NumberParser::parse(paramDefs[3*ind + 1])));
+		poco_debug(logger(), "parameter added: " + paramDefs[3*ind]);
+	}
 
-		switch (genParamList[ind]->GetPrincipalInterfaceType())
+	poco_information(logger(), Poco::NumberFormatter::format(genParamList.size())
+		+ " genicam parameters added from " + filePath);
+
+	initNodeCache();
+
+//    // default values === TODO: set all, then apply together. 
+//    setIntParameterValue(paramPixelFormat, getIntParameterDefaultValue(paramPixelFormat));
+//    setFloatParameterValue(paramExposure, getFloatParameterDefaultValue(paramExposure));
+//    setStrParameterValue(paramTrigAct, getStrParameterDefaultValue(paramTrigAct));
+}
+
+std::vector<std::string> GenicamDevice::describeNodes()
+{
+	// remove the unsupported nodes from the genParamList
+	for (std::vector<GenApi::CNodePtr>::iterator it = genParamList.begin();
+			it != genParamList.end(); )
+	{
+		switch ((*it)->GetPrincipalInterfaceType())
 		{
-		case  intfIValue:
-			addParameter(ind, genParamList[ind]->GetName().c_str(), 
-				genParamList[ind]->GetDescription().c_str(), 
-				ParamItem::typeString);
-			poco_information(logger(), std::string("string (IValue) parameter added: ") 
-				+ genParamList[ind]->GetName().c_str());
-			break;
-		case intfIBase:
-			poco_information(logger(), "IBase interface");
-			errored = true;
-			break;
+		case intfIValue:
 		case intfIInteger:
-			addParameter(ind, genParamList[ind]->GetName().c_str(), 
-				genParamList[ind]->GetDescription().c_str(), 
-				ParamItem::typeInteger);
-			poco_information(logger(), std::string("integer parameter added: ") 
-				+ genParamList[ind]->GetName().c_str());
-			break;
 		case intfIBoolean:
-			addParameter(ind, genParamList[ind]->GetName().c_str(), 
-				genParamList[ind]->GetDescription().c_str(), 
-				ParamItem::typeInteger);
-			poco_information(logger(), std::string("integer (boolean) parameter added: ") 
-				+ genParamList[ind]->GetName().c_str());
-			break;
 		case intfICommand:
-			addParameter(ind, genParamList[ind]->GetName().c_str(), 
-				genParamList[ind]->GetDescription().c_str(), 
-				ParamItem::typeInteger);
-			poco_information(logger(), std::string("integer (command) parameter added: ") 
-				+ genParamList[ind]->GetName().c_str());
-			break;
 		case intfIFloat:
-			addParameter(ind, genParamList[ind]->GetName().c_str(), 
-				genParamList[ind]->GetDescription().c_str(), 
-				ParamItem::typeFloat);
-			poco_information(logger(), std::string("float parameter added: ") 
-				+ genParamList[ind]->GetName().c_str());
+		case intfIString:
+		case intfIEnumeration:
+			it++;
 			break;
+		default:
+			poco_information(logger(), std::string("unsupported interface type for: ")
+				+ (*it)->GetName().c_str());
+			it = genParamList.erase(it);
+		}
+	}
+
+	std::vector<std::string> paramDefs;
+
+	for (size_t ind = 0; ind < genParamList.size(); ind++)
+	{
+		std::string descr = genParamList[ind]->GetDescription().c_str();
+		ParamItem::ParamType type;
+
+		switch (genParamList[ind]->GetPrincipalInterfaceType())
+		{
+		case intfIValue:
 		case intfIString:
-			addParameter(ind, genParamList[ind]->GetName().c_str(), 
-				genParamList[ind]->GetDescription().c_str(), 
-				ParamItem::typeString);
-			poco_information(logger(), std::string("string parameter added: ") 
-				+ genParamList[ind]->GetName().c_str());
+			type = ParamItem::typeString;
 			break;
-		case intfIRegister:
-			poco_information(logger(), "IRegister interface");
-			errored = true;
+		case intfIInteger:
+		case intfIBoolean:
+		case intfICommand:
+			type = ParamItem::typeInteger;
 			break;
-		case intfICategory:
-			poco_information(logger(), "ICategory interface");
-			errored = true;
+		case intfIFloat:
+			type = ParamItem::typeFloat;
 			break;
 		case intfIEnumeration:
 			{
-				std::string descr = genParamList[ind]->GetDescription().c_str();
+				type = ParamItem::typeString;
 				descr += "\nPossible values: \n";
 				// get symbolics
 
@@ -221,38 +321,40 @@ void GenicamDevice::loadConf(std::string filePath)
 					descr += it->c_str();
 					descr += " ; ";
 				}
-
-				addParameter(ind, genParamList[ind]->GetName().c_str(), 
-					descr, 
-					ParamItem::typeString);
-				poco_information(logger(), std::string("string (enumeration) parameter added: ") 
-					+ genParamList[ind]->GetName().c_str());
 				break;
 			}
-		case intfIEnumEntry:
-			poco_information(logger(), "IEnumEntry interface");
-			errored = true;
-			break;
-		case intfIPort:
-			poco_information(logger(), "IPort interface");
-			errored = true;
-			break;
 		default:
-			poco_information(logger(), "unknown interface type");
-			errored = true;
+			poco_bugcheck_msg("unsupported genicam node should have been removed");
 		}
 
-		if (errored)
-		{
-			// remove the entry from the genParamList
-			genParamList.erase(genParamList.begin() + ind);
-		}
+		paramDefs.push_back(genParamList[ind]->GetName().c_str());
+		paramDefs.push_back(Poco::NumberFormatter::format(static_cast<int>(type)));
+		paramDefs.push_back(descr);
 	}
 
-//    // default values === TODO: set all, then apply together. 
-//    setIntParameterValue(paramPixelFormat, getIntParameterDefaultValue(paramPixelFormat));
-//    setFloatParameterValue(paramExposure, getFloatParameterDefaultValue(paramExposure));
-//    setStrParameterValue(paramTrigAct, getStrParameterDefaultValue(paramTrigAct));
+	return paramDefs;
+}
+
+bool GenicamDevice::keepDescribedNodes(const std::vector<std::string>& paramDefs)
+{
+	if (paramDefs.size() % 3)
+		return false;
+
+	// the unsupported nodes are not in paramDefs
+	std::vector<GenApi::CNodePtr> described;
+	for (size_t ind = 0; ind < genParamList.size(); ind++)
+	{
+		size_t defInd = 3 * described.size();
+		if (defInd < paramDefs.size()
+				&& paramDefs[defInd].compare(genParamList[ind]->GetName().c_str()) == 0)
+			described.push_back(genParamList[ind]);
+	}
+
+	if (3 * described.size() != paramDefs.size())
+		return false;
+
+	genParamList.swap(described);
+	return true;
 }
 
 void GenicamDevice::process(int startCond)
@@ -284,6 +386,24 @@ void GenicamDevice::process(int startCond)
         releaseInPort(trigPort);
     }
 
+    if (acqMode == acqStream)
+    {
+        if (trigged)
+            processStream(DataAttributeOut(inAttr));
+        else
+            processStream(DataAttributeOut());
+        return;
+    }
+
+    if (acqMode == acqBurst)
+    {
+        if (trigged)
+            processBurst(DataAttributeOut(inAttr));
+        else
+            processBurst(DataAttributeOut());
+        return;
+    }
+
     if (inAttr.isStartSequence(seqIndex))
     {
         if (startAcq())
@@ -326,12 +446,6 @@ void GenicamDevice::process(int startCond)
 
     poco_information(logger(),"Image awaiting preparation");
 
-    int dataType;
-    if (bPixFormatMono8)
-        dataType = CV_8UC1;
-    else
-        dataType = CV_16UC1;
-
     poco_information(logger(),"time is (to)");
     Poco::Timestamp now;
 
@@ -397,23 +511,19 @@ void GenicamDevice::process(int startCond)
 		+ ". Call processingTerminated(). ");
     processingTerminated();
 
-    char* buffer = NULL; // temporary image buffer address
-
-	for (size_t ind = 0; ind < BUFFER_COUNT; ind++)
-	{
-		if (data.BufferHandle == hBuffer[ind])
-		{
-			poco_information(logger(),"buffer#" 
-				+ Poco::NumberFormatter::format(ind) + " was filled");
-			buffer = pImgBuffer[ind];
-			lastUsed = ind;
-		}
-    }
-    if (buffer == NULL)
-        throw Poco::RuntimeException(name() + ".process", "Unrecognized buffer");
+    Poco::UInt64 timestamp = bufferTimestamp(data.BufferHandle);
 
     cv::Mat imgOut;
-	cv::Mat(imgHeight, imgWidth, dataType, buffer).copyTo(imgOut);
+
+    try
+    {
+        // the buffer is requeued when imgOut is released downstream
+        bufferToImage(data.BufferHandle, imgOut);
+    }
+    catch (Poco::NotFoundException& e)
+    {
+        throw Poco::RuntimeException(name() + ".process", e.message());
+    }
 
     if(!imgOut.data )   // Check for invalid input
     {
@@ -427,20 +537,26 @@ void GenicamDevice::process(int startCond)
 
 	if (stopAfterImage)
 		stopAcq();
-	else
-		requeueBuffers();
 
-	reserveOutPort(imgOutPort);
+    bool half = isHalfImageUsed();
 
-    cv::Mat* pMat;
-    getDataToWrite<cv::Mat>(imgOutPort, pMat);
+    std::set<size_t> outPorts;
+    outPorts.insert(imgOutPort);
+    outPorts.insert(timestampOutPort);
+    if (half)
+        outPorts.insert(halfImgOutPort);
+	reserveOutPorts(outPorts);
 
-	*pMat = imgOut;
+    writeImages(imgOut, half);
 
-    if (!pMat->data)
-        poco_warning(logger(), "Empty image. Check the given file name. ");
+    Poco::UInt64* pTimestamp;
+    getDataToWrite<Poco::UInt64>(timestampOutPort, pTimestamp);
+    *pTimestamp = timestamp;
 
     notifyOutPortReady(imgOutPort, *pOutAttr);
+    notifyOutPortReady(timestampOutPort, *pOutAttr);
+    if (half)
+        notifyOutPortReady(halfImgOutPort, *pOutAttr);
 
     if (stopAfterImage)
     {
@@ -453,37 +569,432 @@ void GenicamDevice::process(int startCond)
     }
 }
 
-void GenicamDevice::requeueBuffers()
+void GenicamDevice::processStream(DataAttributeOut outAttr)
 {
-	GenTL::INFO_DATATYPE dataType;
-	bool flag;
-	size_t flagSize = 1;
+    startAcq();
 
-	for (size_t ind = 0; ind < BUFFER_COUNT; ind++)
-	{
-	    mGenTL->DSGetBufferInfo( hDataStream, hBuffer[ind],
-                GenTL::BUFFER_INFO_IS_QUEUED,
-                &dataType,
-                &flag, &flagSize);
+    try
+    {
+        startGrabbing();
 
-		if (!flag)
-		{
-			poco_information(logger(), "requeue buffer#"
-				+ Poco::NumberFormatter::format(ind));
-			try
-			{
-				mGenTL->DSQueueBuffer(
-					hDataStream,
-					hBuffer[ind]
-					);
-			}
-			catch (GenTLException& e)
-			{
-				poco_warning(logger(), e.displayText());
-			}
-		}
-	}
-	poco_information(logger(), "requeuing done. ");
+        Poco::Int32* pInt32;
+        reserveOutPort(acqReadyOutPort);
+        getDataToWrite<Poco::Int32>(acqReadyOutPort, pInt32);
+        *pInt32 = 1;
+        notifyOutPortReady(acqReadyOutPort, outAttr);
+
+        if (streamFrames != 1)
+            outAttr.startSequence();
+
+        // the half resolution image is used (or not) for the whole stream
+        bool half = isHalfImageUsed();
+
+        std::set<size_t> outPorts;
+        outPorts.insert(imgOutPort);
+        outPorts.insert(timestampOutPort);
+        if (half)
+            outPorts.insert(halfImgOutPort);
+
+        for (Poco::Int64 ind = 0; (streamFrames == 0) || (ind < streamFrames); ind++)
+        {
+            Frame frame;
+
+            while (!popFrame(frame, static_cast<long>(grabTimeout)))
+            {
+                if (yield())
+                    throw ExecutionAbortedException(name(), "Cancelled upon user request" );
+
+                if (!grabThread.isRunning())
+                    throw Poco::RuntimeException(name() + ".processStream",
+                            "The grab thread stopped unexpectedly");
+            }
+
+            if ((streamFrames > 1) && (ind == streamFrames - 1))
+                outAttr.endSequence();
+
+            reserveOutPorts(outPorts);
+
+            writeImages(frame.image, half);
+
+            Poco::UInt64* pTimestamp;
+            getDataToWrite<Poco::UInt64>(timestampOutPort, pTimestamp);
+            *pTimestamp = frame.timestamp;
+
+            notifyOutPortReady(imgOutPort, outAttr);
+            notifyOutPortReady(timestampOutPort, outAttr);
+            if (half)
+                notifyOutPortReady(halfImgOutPort, outAttr);
+            outAttr++;
+
+            {
+                Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+                framesDelivered++;
+            }
+
+            if (streamFrames)
+                setProgress(static_cast<float>(ind + 1) / static_cast<float>(streamFrames));
+
+            if (yield())
+                throw ExecutionAbortedException(name(), "Cancelled upon user request" );
+        }
+    }
+    catch (...)
+    {
+        stopAcq();
+        throw;
+    }
+
+    stopAcq();
+}
+
+void GenicamDevice::processBurst(DataAttributeOut outAttr)
+{
+    startAcq();
+
+    int frameType = burstFrameType();
+
+    // one block for the whole burst. The frames are views on it.
+    cv::Mat block;
+    std::vector<cv::Mat> stack;
+    std::vector<Poco::UInt64> timestamps;
+
+    try
+    {
+        // the image size is updated at the acquisition start
+        checkBurstSize(burstFrames);
+        block.create(static_cast<int>(burstFrames) * imgHeight, imgWidth, frameType);
+        stack.reserve(static_cast<size_t>(burstFrames));
+        timestamps.reserve(static_cast<size_t>(burstFrames));
+
+        Poco::Int32* pInt32;
+        reserveOutPort(acqReadyOutPort);
+        getDataToWrite<Poco::Int32>(acqReadyOutPort, pInt32);
+        *pInt32 = 1;
+        notifyOutPortReady(acqReadyOutPort, outAttr);
+
+        bool firstFrame = true;
+        Poco::UInt64 lastFrameID = 0;
+
+        while (stack.size() < static_cast<size_t>(burstFrames))
+        {
+            GenTL::EVENT_NEW_BUFFER_DATA data;
+            size_t tmpSize = sizeof(data);
+
+            try
+            {
+                mGenTL->EventGetData(hEvent, &data, &tmpSize,
+                        static_cast<uint64_t>(grabTimeout));
+            }
+            catch (GenTLException& e)
+            {
+                if (e.code() != GenTL::GC_ERR_TIMEOUT)
+                    throw;
+
+                if (yield())
+                    throw ExecutionAbortedException(name(), "Cancelled upon user request" );
+
+                continue;
+            }
+
+            if (isBufferIncomplete(data.BufferHandle))
+            {
+                bufferPool->discard(data.BufferHandle);
+
+                Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+                framesIncomplete++;
+                continue;
+            }
+
+            Poco::UInt64 frameID;
+            if (bufferFrameID(data.BufferHandle, frameID))
+            {
+                if (!firstFrame && (frameID > lastFrameID + 1))
+                {
+                    Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+                    framesDropped += static_cast<Poco::Int64>(frameID - lastFrameID - 1);
+                }
+
+                lastFrameID = frameID;
+                firstFrame = false;
+            }
+
+            int row = static_cast<int>(stack.size()) * imgHeight;
+            cv::Mat frame = block.rowRange(row, row + imgHeight);
+
+            timestamps.push_back(bufferTimestamp(data.BufferHandle));
+            bufferToFrame(data.BufferHandle, frame);
+            stack.push_back(frame);
+
+            setProgress(static_cast<float>(stack.size()) / static_cast<float>(burstFrames));
+
+            if (yield())
+                throw ExecutionAbortedException(name(), "Cancelled upon user request" );
+        }
+    }
+    catch (...)
+    {
+        stopAcq();
+        throw;
+    }
+
+    stopAcq();
+
+    std::set<size_t> outPorts;
+    outPorts.insert(burstOutPort);
+    outPorts.insert(burstTimestampsOutPort);
+    reserveOutPorts(outPorts);
+
+    std::vector<cv::Mat>* pStack;
+    getDataToWrite< std::vector<cv::Mat> >(burstOutPort, pStack);
+    pStack->swap(stack);
+
+    std::vector<Poco::UInt64>* pTimestamps;
+    getDataToWrite< std::vector<Poco::UInt64> >(burstTimestampsOutPort, pTimestamps);
+    pTimestamps->swap(timestamps);
+
+    notifyOutPortReady(burstOutPort, outAttr);
+    notifyOutPortReady(burstTimestampsOutPort, outAttr);
+
+    Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+    framesDelivered += burstFrames;
+}
+
+int GenicamDevice::burstFrameType()
+{
+    // the frames have the type of the images delivered on the image port
+    if (bayerPattern != BayerConverter::patternNone && demosaic)
+        return CV_MAKETYPE(CV_MAT_DEPTH(imgType), 3);
+    else
+        return imgType;
+}
+
+void GenicamDevice::checkBurstSize(Poco::Int64 frames)
+{
+    if (imgHeight <= 0 || imgWidth <= 0)
+        return; // image size not known yet
+
+    if (frames > std::numeric_limits<int>::max() / imgHeight)
+        throw Poco::RangeException("burstFrames",
+                Poco::NumberFormatter::format(frames)
+                + " frames of height " + Poco::NumberFormatter::format(imgHeight)
+                + " exceed the maximum block height");
+
+    Poco::UInt64 frameBytes = static_cast<Poco::UInt64>(imgWidth)
+            * static_cast<Poco::UInt64>(imgHeight)
+            * CV_ELEM_SIZE(burstFrameType());
+
+    if (static_cast<Poco::UInt64>(frames) > maxBurstBytes / frameBytes)
+        throw Poco::RangeException("burstFrames",
+                Poco::NumberFormatter::format(frames)
+                + " frames of " + Poco::NumberFormatter::format(frameBytes)
+                + " bytes exceed the burst memory limit of "
+                + Poco::NumberFormatter::format(maxBurstBytes) + " bytes");
+}
+
+void GenicamDevice::startGrabbing()
+{
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+
+        if (grabbing)
+            return;
+
+        grabbing = true;
+    }
+
+    frameReady.reset();
+    grabThread.start(grabRunnable);
+}
+
+void GenicamDevice::stopGrabbing()
+{
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+
+        if (!grabbing)
+            return;
+
+        grabbing = false;
+    }
+
+    // the thread returns at the latest after grabTimeout
+    grabThread.join();
+}
+
+bool GenicamDevice::isGrabbing()
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+    return grabbing;
+}
+
+void GenicamDevice::grabLoop()
+{
+    poco_information(logger(), "grab thread started");
+
+    // keep at least one buffer to be lent to the dataflow
+    size_t maxQueue = (bufferCount > 1) ? bufferCount - 1 : 1;
+
+    bool firstFrame = true;
+    Poco::UInt64 lastFrameID = 0;
+
+    while (isGrabbing())
+    {
+        GenTL::EVENT_NEW_BUFFER_DATA data;
+        size_t tmpSize = sizeof(data);
+
+        try
+        {
+            mGenTL->EventGetData(hEvent, &data, &tmpSize,
+                    static_cast<uint64_t>(grabTimeout));
+        }
+        catch (GenTLException& e)
+        {
+            if (e.code() == GenTL::GC_ERR_TIMEOUT)
+                continue;
+
+            if (e.code() != GenTL::GC_ERR_ABORT) // abort: EventKill in stopAcq
+                poco_error(logger(), "grab thread: " + e.displayText());
+
+            break;
+        }
+
+        try
+        {
+            if (isBufferIncomplete(data.BufferHandle))
+            {
+                bufferPool->discard(data.BufferHandle);
+
+                Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+                framesIncomplete++;
+                continue;
+            }
+
+            Frame frame;
+            frame.timestamp = bufferTimestamp(data.BufferHandle);
+
+            Poco::UInt64 frameID;
+            if (bufferFrameID(data.BufferHandle, frameID))
+            {
+                if (!firstFrame && (frameID > lastFrameID + 1))
+                {
+                    Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+                    framesDropped += static_cast<Poco::Int64>(frameID - lastFrameID - 1);
+                }
+
+                lastFrameID = frameID;
+                firstFrame = false;
+            }
+
+            bufferToImage(data.BufferHandle, frame.image);
+
+            {
+                Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+
+                while (frameQueue.size() >= maxQueue)
+                {
+                    frameQueue.pop_front(); // the buffer is requeued here
+                    framesDropped++;
+                }
+
+                frameQueue.push_back(frame);
+            }
+
+            frameReady.set();
+        }
+        catch (Poco::Exception& e)
+        {
+            poco_error(logger(), "grab thread: " + e.displayText());
+        }
+    }
+
+    poco_information(logger(), "grab thread stopped");
+}
+
+bool GenicamDevice::popFrame(Frame& frame, long timeout)
+{
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+
+        if (!frameQueue.empty())
+        {
+            frame = frameQueue.front();
+            frameQueue.pop_front();
+            return true;
+        }
+    }
+
+    if (!frameReady.tryWait(timeout))
+        return false;
+
+    Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+
+    if (frameQueue.empty())
+        return false;
+
+    frame = frameQueue.front();
+    frameQueue.pop_front();
+    return true;
+}
+
+Poco::UInt64 GenicamDevice::bufferTimestamp(GenTL::BUFFER_HANDLE hBuffer)
+{
+    GenTL::INFO_DATATYPE dataType;
+    uint64_t value;
+    size_t valueSize = sizeof(value);
+
+    try
+    {
+        mGenTL->DSGetBufferInfo(hDataStream, hBuffer,
+                GenTL::BUFFER_INFO_TIMESTAMP_NS,
+                &dataType, &value, &valueSize);
+        return value;
+    }
+    catch (GenTLException&)
+    {
+        // not supported by the producer. use host time
+        return static_cast<Poco::UInt64>(Poco::Timestamp().epochMicroseconds()) * 1000;
+    }
+}
+
+bool GenicamDevice::isBufferIncomplete(GenTL::BUFFER_HANDLE hBuffer)
+{
+    GenTL::INFO_DATATYPE dataType;
+    bool8_t flag;
+    size_t flagSize = sizeof(flag);
+
+    try
+    {
+        mGenTL->DSGetBufferInfo(hDataStream, hBuffer,
+                GenTL::BUFFER_INFO_IS_INCOMPLETE,
+                &dataType, &flag, &flagSize);
+    }
+    catch (GenTLException&)
+    {
+        return false;
+    }
+
+    return (flag != 0);
+}
+
+bool GenicamDevice::bufferFrameID(GenTL::BUFFER_HANDLE hBuffer, Poco::UInt64& frameID)
+{
+    GenTL::INFO_DATATYPE dataType;
+    uint64_t value;
+    size_t valueSize = sizeof(value);
+
+    try
+    {
+        mGenTL->DSGetBufferInfo(hDataStream, hBuffer,
+                GenTL::BUFFER_INFO_FRAMEID,
+                &dataType, &value, &valueSize);
+    }
+    catch (GenTLException&)
+    {
+        return false;
+    }
+
+    frameID = value;
+    return true;
 }
 
 bool GenicamDevice::startAcq()
@@ -526,6 +1037,8 @@ void GenicamDevice::stopAcq()
 		mGenTL->EventKill(hEvent);
 		poco_information(logger(),"GenTL event killed...");
 
+		stopGrabbing();
+
 		Poco::Thread::yield();
 
 		mGenTL->DSStopAcquisition(hDataStream,0);
@@ -555,6 +1068,12 @@ void GenicamDevice::stopAcq()
 
 	revokeBuffers();
 
+	{
+		// the frames not delivered are freed with their revoked buffer
+		Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+		frameQueue.clear();
+	}
+
 	acquiring = false;
 }
 
@@ -598,44 +1117,13 @@ void GenicamDevice::allocBuffers()
 	if (pPayload == NULL)
 		throw GenTLException("AllocBuffer", "Unable to retrieve the payload size");
 
-	imgBufSize = pPayload->GetValue() ;
+	size_t imgBufSize = pPayload->GetValue() ;
 
     poco_information(logger(),"Calculated payload size is: "
         + Poco::NumberFormatter::format(imgBufSize));
 
     genTLDSBufferInfo();
 
-	for (size_t ind = 0; ind < BUFFER_COUNT; ind++)
-	{
-		try
-		{
-			pImgBuffer[ind] = new char[imgBufSize];
-		}
-		catch (std::bad_alloc&) // error in `new char[]`
-		{
-			pImgBuffer[ind] = NULL;
-			imgBufSize = 0;
-			while (--ind >= 0)
-			{
-				delete[] pImgBuffer[ind];
-				pImgBuffer[ind] = NULL;
-			}
-			throw Poco::OutOfMemoryException("AllocImageBuffer",
-				"Not able to allocate enough memory");
-		}
-	}
-
-	for (size_t ind = 0; ind < BUFFER_COUNT; ind++)
-	{
-		hBuffer[ind] = GENTL_INVALID_HANDLE;
-		mGenTL->DSAnnounceBuffer(
-			hDataStream,
-			pImgBuffer[ind],
-			imgBufSize,
-			NULL,
-			&hBuffer[ind]);
-	}
-
     // register new buffer ready event
     mGenTL->GCRegisterEvent(
         hDataStream,
@@ -643,15 +1131,10 @@ void GenicamDevice::allocBuffers()
         &hEvent)  ;
 
     poco_information(logger(),"New buffer event is now registered. "
-		"Enqueuing all buffers. ");
+		"Announcing and enqueuing all buffers. ");
+
+    bufferPool->announce(hDataStream, bufferCount, imgBufSize);
 
-	for (size_t ind = 0; ind < BUFFER_COUNT; ind++)
-	{
-		mGenTL->DSQueueBuffer(
-			hDataStream,
-			hBuffer[ind]
-			);
-	}
     genTLDSBufferInfo();
 
     poco_information(logger(),"image buffer enqueued for acquisition");
@@ -673,32 +1156,9 @@ void GenicamDevice::revokeBuffers()
     genTLDSBufferInfo();
 
 	// revoke all announced buffer, not regarding if they are still referenced
-	// as announced by DSGetInfo
-
-    for (size_t ind = 0; ind < BUFFER_COUNT; ind++)
-    {
-		if (hBuffer[ind] == GENTL_INVALID_HANDLE)
-			break;
-		
-        try
-        {
-			poco_information(logger(),"revoking buffer#" 
-				+ Poco::NumberFormatter::format(ind));
-            mGenTL->DSRevokeBuffer(
-                    hDataStream,
-                    hBuffer[ind], NULL,NULL );
-        }
-        catch (GenTLException& e)
-        {
-            poco_error(logger(),e.displayText());
-        }
-
-		hBuffer[ind] = GENTL_INVALID_HANDLE;
-        delete[] pImgBuffer[ind];
-        pImgBuffer[ind] = NULL;
-    }
-
-    imgBufSize = 0;
+	// as announced by DSGetInfo.
+	// The buffers still used downstream are freed when released.
+	bufferPool->revoke();
 }
 
 void GenicamDevice::dispGCDataType(GenTL::INFO_DATATYPE dataType)
@@ -980,32 +1440,525 @@ void GenicamDevice::genTLDSBufferInfo()
 
 std::string GenicamDevice::getStrParameterValue(size_t paramIndex)
 {
-	return getGenicamStrProperty(genParamList[paramIndex]);
+	switch (paramIndex)
+	{
+	case paramAcqMode:
+		switch (acqMode)
+		{
+		case acqStream:
+			return "stream";
+		case acqBurst:
+			return "burst";
+		default:
+			return "single";
+		}
+	case paramDownshift8:
+		if (downshift8)
+			return "ON";
+		else
+			return "OFF";
+	case paramDemosaic:
+		if (demosaic)
+			return "ON";
+		else
+			return "OFF";
+	default:
+		if (paramIndex < paramCnt)
+		{
+			poco_bugcheck_msg("wrong parameter index");
+			throw Poco::BugcheckException();
+		}
+
+		{
+			size_t nodeIndex = paramIndex - paramCnt;
+			Poco::Any cached;
+			Poco::UInt64 generation;
+			if (readNodeCache(nodeIndex, cached, generation))
+				return Poco::AnyCast<std::string>(cached);
+
+			std::string value = getGenicamStrProperty(genParamList[nodeIndex]);
+			writeNodeCache(nodeIndex, value, generation);
+			return value;
+		}
+	}
 }
 
 void GenicamDevice::setStrParameterValue(size_t paramIndex, std::string value)
 {
-	setGenicamProperty(genParamList[paramIndex], value);
+	switch (paramIndex)
+	{
+	case paramAcqMode:
+		if (Poco::icompare(value, "single") == 0)
+			acqMode = acqSingle;
+		else if (Poco::icompare(value, "stream") == 0)
+			acqMode = acqStream;
+		else if (Poco::icompare(value, "burst") == 0)
+			acqMode = acqBurst;
+		else
+			throw Poco::InvalidArgumentException("setParameterValue",
+					"acquisitionMode should be \"single\", \"stream\" or \"burst\"");
+		break;
+	case paramDownshift8:
+		if (Poco::icompare(value, "ON") == 0)
+			downshift8 = true;
+		else if (Poco::icompare(value, "OFF") == 0)
+			downshift8 = false;
+		else
+			throw Poco::InvalidArgumentException("setParameterValue",
+					"downshift8 can only be set to ON or OFF");
+		break;
+	case paramDemosaic:
+		if (Poco::icompare(value, "ON") == 0)
+			demosaic = true;
+		else if (Poco::icompare(value, "OFF") == 0)
+			demosaic = false;
+		else
+			throw Poco::InvalidArgumentException("setParameterValue",
+					"demosaic can only be set to ON or OFF");
+		break;
+	default:
+		if (paramIndex < paramCnt)
+			poco_bugcheck_msg("wrong parameter index");
+
+		setGenicamProperty(genParamList[paramIndex - paramCnt], value);
+	}
 }
 
 Poco::Int64 GenicamDevice::getIntParameterValue(size_t paramIndex)
 {
-	return getGenicamIntProperty(genParamList[paramIndex]);
+	switch (paramIndex)
+	{
+	case paramBufferCount:
+		return static_cast<Poco::Int64>(bufferCount);
+	case paramStreamFrames:
+		return streamFrames;
+	case paramBurstFrames:
+		return burstFrames;
+	case paramGrabTimeout:
+		return grabTimeout;
+	case paramFramesDelivered:
+	{
+		Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+		return framesDelivered;
+	}
+	case paramFramesDropped:
+	{
+		Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+		return framesDropped;
+	}
+	case paramFramesIncomplete:
+	{
+		Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+		return framesIncomplete;
+	}
+	default:
+	{
+		size_t nodeIndex = paramIndex - paramCnt;
+		Poco::Any cached;
+		Poco::UInt64 generation;
+		if (readNodeCache(nodeIndex, cached, generation))
+			return Poco::AnyCast<Poco::Int64>(cached);
+
+		Poco::Int64 value = getGenicamIntProperty(genParamList[nodeIndex]);
+		writeNodeCache(nodeIndex, value, generation);
+		return value;
+	}
+	}
 }
 
 void GenicamDevice::setIntParameterValue(size_t paramIndex, Poco::Int64 value)
 {
-	setGenicamIntProperty(genParamList[paramIndex], value);
+	switch (paramIndex)
+	{
+	case paramBufferCount:
+		if (value < 1)
+			throw Poco::RangeException("setParameterValue",
+					"bufferCount should be strictly positive");
+		bufferCount = static_cast<size_t>(value);
+		break;
+	case paramStreamFrames:
+		if (value < 0)
+			throw Poco::RangeException("setParameterValue",
+					"streamFrames has to be positive or null");
+		streamFrames = value;
+		break;
+	case paramBurstFrames:
+		if (value < 1)
+			throw Poco::RangeException("setParameterValue",
+					"burstFrames should be strictly positive");
+		checkBurstSize(value);
+		burstFrames = value;
+		break;
+	case paramGrabTimeout:
+		if (value <= 0)
+			throw Poco::RangeException("setParameterValue",
+					"grabTimeout should be strictly positive");
+		grabTimeout = value;
+		break;
+	case paramFramesDelivered:
+	case paramFramesDropped:
+	case paramFramesIncomplete:
+	{
+		if (value != 0)
+			throw Poco::RangeException("setParameterValue",
+					"frame counters can only be reset to 0");
+
+		Poco::ScopedLock<Poco::FastMutex> lock(frameQueueMutex);
+		if (paramIndex == paramFramesDelivered)
+			framesDelivered = 0;
+		else if (paramIndex == paramFramesDropped)
+			framesDropped = 0;
+		else
+			framesIncomplete = 0;
+		break;
+	}
+	default:
+		setGenicamIntProperty(genParamList[paramIndex - paramCnt], value);
+	}
 }
 
 double GenicamDevice::getFloatParameterValue(size_t paramIndex)
 {
-	return getGenicamFloatProperty(genParamList[paramIndex]);
+	if (paramIndex < paramCnt)
+	{
+		poco_bugcheck_msg("wrong parameter index");
+		throw Poco::BugcheckException();
+	}
+
+	size_t nodeIndex = paramIndex - paramCnt;
+	Poco::Any cached;
+	Poco::UInt64 generation;
+	if (readNodeCache(nodeIndex, cached, generation))
+		return Poco::AnyCast<double>(cached);
+
+	double value = getGenicamFloatProperty(genParamList[nodeIndex]);
+	writeNodeCache(nodeIndex, value, generation);
+	return value;
 }
 
 void GenicamDevice::setFloatParameterValue(size_t paramIndex, double value)
 {
-	setGenicamFloatProperty(genParamList[paramIndex], value);
+	if (paramIndex < paramCnt)
+		poco_bugcheck_msg("wrong parameter index");
+
+	setGenicamFloatProperty(genParamList[paramIndex - paramCnt], value);
+}
+
+void GenicamDevice::applyParameters()
+{
+	ParameterSet paramSet;
+	getParameterSet(&paramSet);
+
+	Poco::SharedPtr<Poco::Exception> error;
+
+	// own parameters
+	for (size_t index = 0; index < paramCnt; index++)
+	{
+		try
+		{
+			switch (paramSet[index].datatype)
+			{
+			case ParamItem::typeInteger:
+			{
+				Poco::Int64 value;
+				if (getInternalIntParameterValue(index, value))
+					setIntParameterValue(index, value);
+				break;
+			}
+			case ParamItem::typeFloat:
+			{
+				double value;
+				if (getInternalFloatParameterValue(index, value))
+					setFloatParameterValue(index, value);
+				break;
+			}
+			case ParamItem::typeString:
+			{
+				std::string value;
+				if (getInternalStrParameterValue(index, value))
+					setStrParameterValue(index, value);
+				break;
+			}
+			default:
+				poco_bugcheck_msg("applyParameters, unknown parameter type");
+			}
+		}
+		catch (Poco::Exception& e)
+		{
+			poco_error(logger(), paramSet[index].name + ": " + e.displayText());
+			error = e.clone();
+		}
+	}
+
+	// collect the pending genicam parameters
+	std::vector<PendingWrite> writes;
+	bool locked = false;
+
+	for (size_t index = paramCnt; index < paramSet.size(); index++)
+	{
+		PendingWrite write;
+		write.paramIndex = index;
+		write.datatype = paramSet[index].datatype;
+		write.intValue = 0;
+		write.floatValue = 0;
+
+		bool pending;
+		switch (write.datatype)
+		{
+		case ParamItem::typeInteger:
+			pending = getInternalIntParameterValue(index, write.intValue);
+			break;
+		case ParamItem::typeFloat:
+			pending = getInternalFloatParameterValue(index, write.floatValue);
+			break;
+		case ParamItem::typeString:
+			pending = getInternalStrParameterValue(index, write.strValue);
+			break;
+		default:
+			poco_bugcheck_msg("applyParameters, unknown parameter type");
+			throw Poco::BugcheckException();
+		}
+
+		if (!pending)
+			continue;
+
+		GenApi::CNodePtr node = genParamList[index - paramCnt];
+		write.rank = writeRank(node);
+		writes.push_back(write);
+
+		if (acquiring && lockedByStreaming(node, write.rank))
+			locked = true;
+	}
+
+	if (writes.empty())
+	{
+		if (!error.isNull())
+			error->rethrow();
+		return;
+	}
+
+	std::stable_sort(writes.begin(), writes.end());
+
+	// stop the acquisition once for all the locked features
+	bool restart = false;
+	if (locked)
+	{
+		poco_information(logger(),
+				"Some features are locked by the acquisition: stop it to apply the parameters");
+		stopAcq();
+		restart = true;
+	}
+
+	std::vector<PendingWrite> failed;
+	for (std::vector<PendingWrite>::iterator it = writes.begin(),
+			ite = writes.end(); it != ite; it++)
+	{
+		try
+		{
+			writePending(*it);
+		}
+		catch (Poco::Exception&)
+		{
+			failed.push_back(*it);
+		}
+	}
+
+	// retry once: the failed writes can depend on values written afterwards
+	for (std::vector<PendingWrite>::iterator it = failed.begin(),
+			ite = failed.end(); it != ite; it++)
+	{
+		try
+		{
+			writePending(*it);
+		}
+		catch (Poco::Exception& e)
+		{
+			GenApi::CNodePtr node = genParamList[it->paramIndex - paramCnt];
+			if (it->rank != rankCommand && !IsWritable(node))
+			{
+				Poco::NoPermissionException notWritable(
+						paramSet[it->paramIndex].name,
+						restart ? "not writable, even with the acquisition stopped"
+								: "not writable");
+				poco_error(logger(), notWritable.displayText());
+				error = notWritable.clone();
+			}
+			else
+			{
+				poco_error(logger(), paramSet[it->paramIndex].name
+						+ ": " + e.displayText());
+				error = e.clone();
+			}
+		}
+	}
+
+	poco_debug(logger(), Poco::NumberFormatter::format(writes.size())
+			+ " genicam parameters written, "
+			+ Poco::NumberFormatter::format(failed.size()) + " retried");
+
+	// the writes can change the dependent nodes
+	invalidateNodeCache();
+
+	if (restart)
+		startAcq();
+
+	if (!error.isNull())
+		error->rethrow();
+}
+
+int GenicamDevice::writeRank(GenApi::CNodePtr node)
+{
+	if (node->GetPrincipalInterfaceType() == intfICommand)
+		return rankCommand;
+
+	CSelectorPtr selector = node;
+	if (selector.IsValid() && selector->IsSelector())
+		return rankSelector;
+
+	std::string name(node->GetName().c_str());
+
+	if (name == "PixelFormat"
+			|| name.compare(0, 7, "Binning") == 0
+			|| name.compare(0, 10, "Decimation") == 0)
+		return rankFormat;
+
+	if (name == "Width" || name == "Height")
+		return rankSize;
+
+	if (name.compare(0, 6, "Offset") == 0)
+		return rankOffset;
+
+	return rankOther;
+}
+
+bool GenicamDevice::lockedByStreaming(GenApi::CNodePtr node, int rank)
+{
+	if (rank == rankCommand || node->GetAccessMode() != RO)
+		return false;
+
+	if (rank == rankFormat || rank == rankSize)
+		return true;
+
+	try
+	{
+		CIntegerPtr pLocked = nodeMap._GetNode("TLParamsLocked");
+		return pLocked.IsValid() && IsReadable(pLocked)
+				&& pLocked->GetValue() != 0;
+	}
+	catch (GenICam::GenericException&)
+	{
+		return false;
+	}
+}
+
+void GenicamDevice::writePending(const PendingWrite& write)
+{
+	GenApi::CNodePtr node = genParamList[write.paramIndex - paramCnt];
+
+	switch (write.datatype)
+	{
+	case ParamItem::typeInteger:
+		setGenicamIntProperty(node, write.intValue);
+		break;
+	case ParamItem::typeFloat:
+		setGenicamFloatProperty(node, write.floatValue);
+		break;
+	case ParamItem::typeString:
+		setGenicamProperty(node, write.strValue);
+		break;
+	default:
+		poco_bugcheck_msg("writePending, unknown parameter type");
+	}
+}
+
+void GenicamDevice::initNodeCache()
+{
+	nodeCacheable.clear();
+
+	for (size_t ind = 0; ind < genParamList.size(); ind++)
+	{
+		INode* pNode = genParamList[ind];
+
+		bool cacheable = (pNode->GetPrincipalInterfaceType() != intfICommand)
+				&& (pNode->GetCachingMode() != NoCache)
+				&& (pNode->GetPollingTime() <= 0);
+		nodeCacheable.push_back(cacheable);
+
+		nodeIndexes[pNode] = ind;
+		nodeCallbacks.push_back(std::make_pair(pNode,
+				Register(pNode, *this, &GenicamDevice::onNodeInvalidated)));
+	}
+}
+
+void GenicamDevice::releaseNodeCache()
+{
+	for (size_t ind = 0; ind < nodeCallbacks.size(); ind++)
+	{
+		try
+		{
+			nodeCallbacks[ind].first->DeregisterCallback(nodeCallbacks[ind].second);
+		}
+		catch (GenICam::GenericException& e)
+		{
+			poco_warning(logger(), std::string("Node callback deregistration: ")
+					+ e.GetDescription());
+		}
+	}
+
+	nodeCallbacks.clear();
+	nodeIndexes.clear();
+	invalidateNodeCache();
+}
+
+bool GenicamDevice::readNodeCache(size_t nodeIndex, Poco::Any& value,
+		Poco::UInt64& generation)
+{
+	Poco::ScopedLock<Poco::FastMutex> lock(nodeCacheMutex);
+
+	generation = nodeCacheGeneration;
+
+	std::map<size_t, Poco::Any>::iterator it = nodeCache.find(nodeIndex);
+	if (it == nodeCache.end())
+		return false;
+
+	value = it->second;
+	return true;
+}
+
+void GenicamDevice::writeNodeCache(size_t nodeIndex, const Poco::Any& value,
+		Poco::UInt64 generation)
+{
+	if (nodeIndex >= nodeCacheable.size() || !nodeCacheable[nodeIndex])
+		return;
+
+	Poco::ScopedLock<Poco::FastMutex> lock(nodeCacheMutex);
+
+	// invalidated while reading the device?
+	if (generation != nodeCacheGeneration)
+		return;
+
+	nodeCache[nodeIndex] = value;
+}
+
+void GenicamDevice::invalidateNodeCache()
+{
+	Poco::ScopedLock<Poco::FastMutex> lock(nodeCacheMutex);
+
+	nodeCache.clear();
+	nodeCacheGeneration++;
+}
+
+void GenicamDevice::onNodeInvalidated(GenApi::INode* pNode)
+{
+	// called by GenApi: do not access the node map here
+	std::map<GenApi::INode*, size_t>::iterator it = nodeIndexes.find(pNode);
+	if (it == nodeIndexes.end())
+		return;
+
+	Poco::ScopedLock<Poco::FastMutex> lock(nodeCacheMutex);
+
+	nodeCache.erase(it->second);
+	nodeCacheGeneration++;
 }
 
 void GenicamDevice::setGenicamProperty(GenApi::CNodePtr node, std::string value)
@@ -1296,35 +2249,82 @@ Poco::Int64 GenicamDevice::getPixelFormat()
 	}
 
 	std::string format = (**pFormat).c_str();
-	
-	if (format == "Mono8")
-	{
-        bPixFormatMono8 = true;
-		return 8;
-	}
-	else if (format == "Mono10")
-	{
-        bPixFormatMono8 = false;
-		return 10;
-	}
-	else if (format == "Mono12")
-	{
-        bPixFormatMono8 = false;
-		return 12;
-	}
-	else if (format == "Mono14")
+
+	pixFormat = PixelUnpacker::fromName(format, pixBitDepth);
+
+	if (pixFormat == PixelUnpacker::fmtMono8 || downshift8)
+		imgType = CV_8UC1;
+	else
+		imgType = CV_16UC1;
+
+	bayerPattern = BayerConverter::patternFromName(format);
+
+	return pixBitDepth;
+}
+
+void GenicamDevice::bufferToImage(GenTL::BUFFER_HANDLE hBuffer, cv::Mat& img)
+{
+	bool asIs = (pixFormat == PixelUnpacker::fmtMono8)
+			|| (pixFormat == PixelUnpacker::fmtMono16 && imgType == CV_16UC1);
+
+	if (asIs)
+		bufferPool->wrap(hBuffer, imgHeight, imgWidth, imgType, img);
+	else
+		bufferPool->unpack(hBuffer, pixFormat, pixBitDepth,
+				imgHeight, imgWidth, imgType, img);
+}
+
+void GenicamDevice::bufferToFrame(GenTL::BUFFER_HANDLE hBuffer, cv::Mat& frame)
+{
+	bool color = (bayerPattern != BayerConverter::patternNone) && demosaic;
+	bool asIs = (pixFormat == PixelUnpacker::fmtMono8)
+			|| (pixFormat == PixelUnpacker::fmtMono16 && imgType == CV_16UC1);
+
+	if (!asIs && !color)
 	{
-        bPixFormatMono8 = false;
-		return 14;
+		// unpack directly into the frame (same size and type: no reallocation)
+		bufferPool->unpack(hBuffer, pixFormat, pixBitDepth,
+				imgHeight, imgWidth, imgType, frame);
+		return;
 	}
-	else if (format == "Mono16")
+
+	cv::Mat raw;
+	bufferToImage(hBuffer, raw);
+
+	if (color)
+		BayerConverter::demosaic(raw, bayerPattern, frame);
+	else
+		raw.copyTo(frame);
+}
+
+bool GenicamDevice::isHalfImageUsed()
+{
+	return !getOutPorts()[halfImgOutPort]->getDataTargets().empty();
+}
+
+void GenicamDevice::writeImages(const cv::Mat& raw, bool half)
+{
+	cv::Mat* pMat;
+	getDataToWrite<cv::Mat>(imgOutPort, pMat);
+
+	// the previous image may still be referenced downstream
+	// (e.g. queued by an asynchronous logger): do not write into it
+	pMat->release();
+
+	if (bayerPattern != BayerConverter::patternNone && demosaic)
+		BayerConverter::demosaic(raw, bayerPattern, *pMat);
+	else
+		*pMat = raw;
+
+	if (!pMat->data)
+		poco_warning(logger(), "Empty image. ");
+
+	if (half)
 	{
-        bPixFormatMono8 = false;
-		return 16;
+		getDataToWrite<cv::Mat>(halfImgOutPort, pMat);
+		pMat->release();
+		BayerConverter::binHalf(raw, bayerPattern, *pMat);
 	}
-	else
-        throw Poco::NotImplementedException("getPixelFormat",
-                                "unreckognized pixel format");
 }
 
 #include <fstream>
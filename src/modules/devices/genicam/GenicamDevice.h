@@ -36,13 +36,21 @@
 #include "core/DataAttributeOut.h"
 
 #include "GenDevTransportLayer.h"
+#include "GenTLBufferPool.h"
+#include "BayerConverter.h"
 
 #include "GenTLLib.h"
 #include "GenICam.h"
 
 #include "Poco/Path.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/Any.h"
 
-#define BUFFER_COUNT 4
+#include <deque>
+#include <map>
 
 /**
  * GenicamDevice
@@ -58,6 +66,23 @@
  *
  * @par hefVision 2.0.0-beta.4 fork:
  * Implementation of the start/stop features using the data sequences
+ *
+ * The image delivered on the output port wraps the GenTL buffer
+ * (no copy). The buffer is requeued when the last reader releases it.
+ * The number of buffers is given by the bufferCount parameter.
+ *
+ * Three acquisition modes are available (acquisitionMode parameter):
+ *  - "single": each trigger delivers one image (default)
+ *  - "stream": each trigger starts a free-running acquisition. A dedicated
+ *  grab thread drains the GenTL new buffer events and the frames are
+ *  delivered as a data sequence of streamFrames images (endless if 0)
+ *  - "burst": each trigger acquires burstFrames images into one
+ *  contiguous block, delivered at once as an image array
+ *  with the array of the frame timestamps
+ *
+ * The pending parameters are applied in one pass, in dependency order
+ * (see applyParameters). The genicam parameter values are read from a
+ * cache, invalidated by the writes and by the node map callbacks.
  */
 class GenicamDevice: public Module
 {
@@ -89,9 +114,32 @@ private:
 
     /**
      * Load the config file selected by the parent factory
+     *
+     * The parameter definitions derived from the selected nodes
+     * are cached (GenTLLib::cache()), keyed by the description file
+     * and the node names.
      */
     void loadConf(std::string filePath);
 
+    /**
+     * Define the parameters from the genParamList nodes
+     *
+     * Remove the unsupported nodes from the genParamList.
+     *
+     * @return name, type (ParamItem::ParamType) and description
+     * of each parameter
+     */
+    std::vector<std::string> describeNodes();
+
+    /**
+     * Keep the genParamList nodes of the cached parameter definitions
+     *
+     * @param paramDefs as returned by describeNodes()
+     * @return false, genParamList being unchanged, if the definitions
+     * do not correspond to the nodes
+     */
+    bool keepDescribedNodes(const std::vector<std::string>& paramDefs);
+
     /**
      * Retrieve the GenTL datastreams
      *
@@ -117,10 +165,93 @@ private:
      */
     void stopAcq();
 
+    /**
+     * Main logic in stream acquisition mode
+     *
+     * Start the acquisition and the grab thread,
+     * then forward the grabbed frames as a data sequence.
+     */
+    void processStream(DataAttributeOut outAttr);
+
+    /**
+     * Main logic in burst acquisition mode
+     *
+     * Start the acquisition, convert burstFrames frames into
+     * a pre-allocated contiguous block, stop the acquisition
+     * and deliver the frames (views on the block) as one array.
+     */
+    void processBurst(DataAttributeOut outAttr);
+
+    /// cv::Mat type of the frames delivered in burst mode
+    int burstFrameType();
+
+    /**
+     * Check that a burst of the given number of frames fits in
+     * one cv::Mat block (rows count in int) and in maxBurstBytes
+     *
+     * The current image size is used. It is known after the first
+     * acquisition start only.
+     *
+     * @throw Poco::RangeException if the block is too large
+     */
+    void checkBurstSize(Poco::Int64 frames);
+
+    /**
+     * Grab thread main loop
+     *
+     * Wait for the new buffer events with a finite timeout (grabTimeout)
+     * until stopGrabbing() is called, and push the frames in frameQueue.
+     */
+    void grabLoop();
+
+    /// Start the grab thread. The acquisition has to be started.
+    void startGrabbing();
+
+    /// Stop the grab thread and wait for its termination
+    void stopGrabbing();
+
+    /// Check the grab thread stop request (grabbing flag)
+    bool isGrabbing();
+
+    /**
+     * Image frame as pushed by the grab thread
+     */
+    struct Frame
+    {
+        cv::Mat image;
+        Poco::UInt64 timestamp;
+    };
+
+    /**
+     * Pop the oldest frame from frameQueue
+     *
+     * @param timeout maximum waiting time in milliseconds
+     * @return false if no frame was available before timeout
+     */
+    bool popFrame(Frame& frame, long timeout);
+
+    /**
+     * Timestamp of the given filled buffer
+     *
+     * in nanoseconds, as given by the producer (BUFFER_INFO_TIMESTAMP_NS)
+     * or host time if the producer does not support it
+     */
+    Poco::UInt64 bufferTimestamp(GenTL::BUFFER_HANDLE hBuffer);
+
+    /// Check the incomplete flag of the given filled buffer
+    bool isBufferIncomplete(GenTL::BUFFER_HANDLE hBuffer);
+
+    /**
+     * Retrieve the frame ID of the given filled buffer
+     *
+     * @return false if the producer does not support it
+     */
+    bool bufferFrameID(GenTL::BUFFER_HANDLE hBuffer, Poco::UInt64& frameID);
+
     /**
      * Allocate and announce the buffers
      *
-     * 2 rolling buffers will be used
+     * bufferCount rolling buffers will be used
      */
     void allocBuffers();
 
@@ -141,12 +272,25 @@ private:
      */
     void reset();
 
+    /**
+     * Indexes of the module own parameters
+     *
+     * The parameters defined by the conf file (genicam nodes)
+     * are appended after paramCnt.
+     */
     enum params
     {
-        paramExposure,
-        paramPixelFormat, ///< mono8 or mono12
-        paramTrigAct, ///< raising, falling edge
-        paramCnt ///< number of parameters in the parameter set
+        paramBufferCount, ///< number of GenTL buffers announced at acquisition start
+        paramAcqMode, ///< single or stream
+        paramStreamFrames, ///< number of frames per stream, 0: endless
+        paramBurstFrames, ///< number of frames per burst
+        paramGrabTimeout, ///< grab thread new buffer event timeout
+        paramFramesDelivered, ///< frames delivered to the dataflow in stream or burst mode
+        paramFramesDropped, ///< frames dropped in stream or burst mode
+        paramFramesIncomplete, ///< incomplete frames in stream or burst mode
+        paramDownshift8, ///< deliver 8-bit images whatever the pixel format
+        paramDemosaic, ///< deliver full resolution BGR images for the Bayer formats
+        paramCnt ///< number of own parameters in the parameter set
     };
 
     std::string getStrParameterValue(size_t paramIndex);
@@ -158,6 +302,71 @@ private:
     double getFloatParameterValue(size_t paramIndex);
     void setFloatParameterValue(size_t paramIndex, double value);
 
+    /**
+     * Apply the pending parameters in one pass
+     *
+     *  - the module own parameters are applied first,
+     *  - the genicam parameters are written in dependency order
+     *  (see writeRanks). The writes that failed are retried once
+     *  after the others, e.g. an offset waiting for a smaller width,
+     *  - if some of the features are locked by a running acquisition
+     *  (see lockedByStreaming), the acquisition is stopped once,
+     *  and restarted after the writes. The features that are still
+     *  not writable are reported.
+     *
+     * The last error, if any, is thrown after all the writes.
+     */
+    void applyParameters();
+
+    /**
+     * Genicam parameters write order in applyParameters
+     */
+    enum writeRanks
+    {
+        rankSelector, ///< selectors, e.g. TriggerSelector
+        rankFormat, ///< PixelFormat, Binning*, Decimation*
+        rankSize, ///< Width, Height
+        rankOffset, ///< Offset*
+        rankOther,
+        rankCommand ///< commands are executed last
+    };
+
+    /// Compute the write rank of the given genicam node
+    int writeRank(GenApi::CNodePtr node);
+
+    /**
+     * Check if the write access to the given node is locked by
+     * the running acquisition
+     *
+     * A node is locked by the streaming if it is read-only while
+     * - the device sets its TLParamsLocked feature (SFNC), or
+     * - it changes the payload size: PixelFormat, Binning*,
+     *   Decimation*, Width, Height (see rankFormat and rankSize).
+     *
+     * The nodes that are not available or not writable for another
+     * reason do not need the acquisition to be stopped.
+     */
+    bool lockedByStreaming(GenApi::CNodePtr node, int rank);
+
+    /**
+     * Genicam parameter write pending in applyParameters
+     */
+    struct PendingWrite
+    {
+        size_t paramIndex;
+        int rank;
+        ParamItem::ParamType datatype;
+        Poco::Int64 intValue;
+        double floatValue;
+        std::string strValue;
+
+        bool operator<(const PendingWrite& other) const
+            { return rank < other.rank; }
+    };
+
+    /// Write the value of a pending genicam parameter
+    void writePending(const PendingWrite& write);
+
     /// Indexes of the input ports
     enum inPorts
     {
@@ -170,6 +379,10 @@ private:
     {
         imgOutPort,
         acqReadyOutPort,
+        timestampOutPort,
+        halfImgOutPort,
+        burstOutPort,
+        burstTimestampsOutPort,
         outPortCnt
     };
 
@@ -178,16 +391,51 @@ private:
     /// image height
     int imgHeight;
 
-    /// pixel format storing variable
-    bool bPixFormatMono8;
+    PixelUnpacker::Format pixFormat; ///< pixel format of the GenTL buffers
+    int pixBitDepth; ///< number of significant bits per pixel
+    bool downshift8; ///< see paramDownshift8
+    int imgType; ///< cv::Mat type of the delivered images, set at acquisition start
+    BayerConverter::Pattern bayerPattern; ///< patternNone if the pixel format is mono
+    bool demosaic; ///< see paramDemosaic
 
     /**
      * Get the pixel format
      *
-     * if the module is not loaded, the function only reads the local storage
+     * Update pixFormat, pixBitDepth, imgType and bayerPattern.
+     *
+     * @return number of significant bits per pixel
      */
     Poco::Int64 getPixelFormat();
 
+    /**
+     * Convert the filled buffer to the delivered image
+     *
+     * The buffer is lent to the dataflow if its format can be used as is,
+     * else it is unpacked (or downshifted to 8 bits) and requeued.
+     */
+    void bufferToImage(GenTL::BUFFER_HANDLE hBuffer, cv::Mat& img);
+
+    /**
+     * Convert the filled buffer into the given burst frame
+     *
+     * The frame is a view on the burst block, with the type of the
+     * images delivered on the image port: it is written in place.
+     * The buffer is requeued at return.
+     */
+    void bufferToFrame(GenTL::BUFFER_HANDLE hBuffer, cv::Mat& frame);
+
+    /// true if the half resolution image port has targets
+    bool isHalfImageUsed();
+
+    /**
+     * Write the image output ports from the raw image
+     *
+     * The image port gets the raw image, or the demosaiced one.
+     * The half resolution image is only computed if required.
+     * The output ports shall be reserved.
+     */
+    void writeImages(const cv::Mat& raw, bool half);
+
     Poco::FastMutex acqControlMutex; ///< mutex locked during startAcq or stopAcq operations
     bool acquiring; ///< flag indicating if the camera is ready to be trigged
 
@@ -196,20 +444,47 @@ private:
     GenTL::IF_HANDLE hInterface; ///< handle on the GenTL interface module
     GenTL::DEV_HANDLE hDevice; ///< handle on the GenTL device module
     GenTL::DS_HANDLE hDataStream; ///< handle on the GenTL datastream module
-    GenTL::BUFFER_HANDLE hBuffer[BUFFER_COUNT]; ///< handle on the GenTL buffer
     GenTL::EVENT_HANDLE hEvent; ///< handle on the GenTL new buffer event handle
     GenTL::PORT_HANDLE hRemoteDevPort; ///< handle on the GenTL remote device port handle
+    std::string xmlKey; ///< cache key of the device description file
+
+    Poco::AutoPtr<GenTLBufferPool> bufferPool; ///< data buffers, lent to the dataflow
+    size_t bufferCount; ///< number of buffers to be announced
+
+    /// acquisition modes, see paramAcqMode
+    enum acqModes
+    {
+        acqSingle,
+        acqStream,
+        acqBurst
+    };
 
-    char* pImgBuffer[BUFFER_COUNT]; ///< data buffers
-    size_t imgBufSize; ///< data buffer size
-	size_t lastUsed; ///< last used buffer
+    int acqMode; ///< acquisition mode, from acqModes
+    Poco::Int64 streamFrames; ///< number of frames per stream
+    Poco::Int64 burstFrames; ///< number of frames per burst
+    Poco::Int64 grabTimeout; ///< grab thread new buffer event timeout in milliseconds
+
+    Poco::RunnableAdapter<GenicamDevice> grabRunnable;
+    Poco::Thread grabThread; ///< thread running grabLoop
+    bool grabbing; ///< set by startGrabbing, reset by stopGrabbing to stop the grab thread
+
+    /**
+     * Frames grabbed and not yet delivered
+     *
+     * Bounded to bufferCount-1 frames (at least 1).
+     * The oldest frame is dropped when full.
+     */
+    std::deque<Frame> frameQueue;
+    Poco::Event frameReady; ///< set by the grab thread when a frame is pushed
+    Poco::FastMutex frameQueueMutex; ///< lock frameQueue, grabbing and the frame counters
+
+    Poco::Int64 framesDelivered; ///< frame counter, see paramFramesDelivered
+    Poco::Int64 framesDropped; ///< frame counter, see paramFramesDropped
+    Poco::Int64 framesIncomplete; ///< frame counter, see paramFramesIncomplete
 
    /// get various about the buffers in the DS
     void genTLDSBufferInfo();
 
-	/// requeue dequeued buffers
-	void requeueBuffers();
-
     void dispGCDataType(GenTL::INFO_DATATYPE dataType);
  
 	GenApi::CNodeMapRef nodeMap; ///< GenAPI node map to access device properties
@@ -282,6 +557,49 @@ private:
 
 	std::vector<GenApi::CNodePtr> genParamList; ///< Store the genAPI nodes as defined by the conf file
 
+	/**
+	 * Register the node map callbacks of the genParamList nodes
+	 *
+	 * and define which of them can be cached: the commands,
+	 * the nodes with a NoCache caching mode or with a polling time
+	 * are always read from the device.
+	 */
+	void initNodeCache();
+
+	/// Deregister the node map callbacks
+	void releaseNodeCache();
+
+	/**
+	 * Get a genicam parameter value from the cache
+	 *
+	 * @param nodeIndex index in genParamList
+	 * @param[out] value cached value, if any
+	 * @param[out] generation cache generation, to be given to writeNodeCache
+	 * @return false if the value is not cached
+	 */
+	bool readNodeCache(size_t nodeIndex, Poco::Any& value, Poco::UInt64& generation);
+
+	/**
+	 * Store a genicam parameter value in the cache
+	 *
+	 * The value is not stored if the cache was invalidated since
+	 * readNodeCache returned the given generation.
+	 */
+	void writeNodeCache(size_t nodeIndex, const Poco::Any& value, Poco::UInt64 generation);
+
+	/// Invalidate all the cached values
+	void invalidateNodeCache();
+
+	/// Node map callback: the node value changed or was invalidated
+	void onNodeInvalidated(GenApi::INode* pNode);
+
+	std::vector<bool> nodeCacheable; ///< per genParamList node
+	std::map<GenApi::INode*, size_t> nodeIndexes; ///< genParamList indexes
+	std::vector< std::pair<GenApi::INode*, GenApi::CallbackHandleType> > nodeCallbacks;
+	std::map<size_t, Poco::Any> nodeCache; ///< cached values per genParamList index
+	Poco::UInt64 nodeCacheGeneration; ///< incremented at each invalidation
+	Poco::FastMutex nodeCacheMutex; ///< lock nodeCache and nodeCacheGeneration
+
 	Poco::Path confFile;
 
     size_t seqIndex; ///< input data attribute control
@@ -41,34 +41,23 @@ GenicamDeviceFactory::GenicamDeviceFactory(GenTLLib* genTL,
         ModuleFactory* parent, std::string selector):
         ModuleFactoryBranch(parent, selector, false),
         mGenTL(genTL), _TLhInterface(TLhInterface),
-        _TLhDevice(GENTL_INVALID_HANDLE)
+        _TLhDevice(GENTL_INVALID_HANDLE),
+        openRunnable(*this, &GenicamDeviceFactory::openAndPrefetch),
+        openDone(false), // manual reset
+        prefetchDone(false) // manual reset
 {
     setLogger(name());
 
-    try
-    {
-        mGenTL->IFOpenDevice(
-                _TLhInterface,
-                selector.c_str(),
-                // GenTL::DEVICE_ACCESS_CONTROL,
-                GenTL::DEVICE_ACCESS_EXCLUSIVE,
-                &_TLhDevice );
-        poco_information(logger(), "device: " + selector + " opened...");
-    }
-    catch (GenTLException& e)
-    {
-        throw Poco::RuntimeException("Cannot open the device "
-                + selector + ": " + e.displayText() );
-    }
-
-    if (_TLhDevice == GENTL_INVALID_HANDLE)
-        throw Poco::RuntimeException("Cannot create the device factory");
-    else
-        mGenTL->genTLPortInfo(_TLhDevice, logger()); // device port info. driver dependant? 
+    // the opening and the description file transfer can be slow
+    // (GigE, U3V): overlap them with the selection of the other
+    // devices and of the conf file
+    openThread.start(openRunnable);
 }
 
 GenicamDeviceFactory::~GenicamDeviceFactory()
 {
+    openThread.join();
+
     if (_TLhDevice != GENTL_INVALID_HANDLE)
     {
         try
@@ -118,6 +107,8 @@ std::string GenicamDeviceFactory::validateSelector(std::string selector)
 
 ModuleFactoryBranch* GenicamDeviceFactory::newChildFactory(std::string selector)
 {
+    waitOpen();
+
 #ifdef HAVE_GENAPI
     return new GenicamConfDeviceFactory(mGenTL, _TLhInterface, _TLhDevice, this, selector);
 #else
@@ -126,3 +117,80 @@ ModuleFactoryBranch* GenicamDeviceFactory::newChildFactory(std::string selector)
 #endif
 }
 
+void GenicamDeviceFactory::waitOpen()
+{
+    openDone.wait();
+
+    if (!openError.empty())
+        throw Poco::RuntimeException(openError);
+}
+
+void GenicamDeviceFactory::openAndPrefetch()
+{
+    // the waitOpen and waitPrefetch callers would be blocked forever
+    // if the events were not set
+    try
+    {
+        open();
+    }
+    catch (Poco::Exception& e)
+    {
+        openError = e.displayText();
+    }
+    catch (...)
+    {
+        openError = "Cannot open the device " + getSelector();
+    }
+
+    openDone.set();
+
+    if (openError.empty())
+        prefetch();
+    else
+        poco_error(logger(), openError);
+
+    prefetchDone.set();
+}
+
+void GenicamDeviceFactory::open()
+{
+    try
+    {
+        mGenTL->IFOpenDevice(
+                _TLhInterface,
+                getSelector().c_str(),
+                // GenTL::DEVICE_ACCESS_CONTROL,
+                GenTL::DEVICE_ACCESS_EXCLUSIVE,
+                &_TLhDevice );
+        poco_information(logger(), "device: " + getSelector() + " opened...");
+    }
+    catch (GenTLException& e)
+    {
+        throw Poco::RuntimeException("Cannot open the device "
+                + getSelector() + ": " + e.displayText() );
+    }
+
+    if (_TLhDevice == GENTL_INVALID_HANDLE)
+        throw Poco::RuntimeException("Cannot create the device factory");
+    else
+        mGenTL->genTLPortInfo(_TLhDevice, logger()); // device port info. driver dependant? 
+}
+
+void GenicamDeviceFactory::prefetch()
+{
+#ifdef HAVE_GENAPI
+    try
+    {
+        GenTL::PORT_HANDLE hPort = GENTL_INVALID_HANDLE;
+        mGenTL->DevGetPort(_TLhDevice, &hPort);
+
+        bool zipped;
+        mGenTL->retrieveXml(hPort, zipped, logger());
+    }
+    catch (Poco::Exception& e)
+    {
+        poco_warning(logger(), "Device description prefetch failed: "
+                + e.displayText());
+    }
+#endif
+}
@@ -33,6 +33,10 @@
 
 #include "GenTLLib.h"
 
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Event.h"
+
 /**
  * GenicamDeviceFactory
  *
@@ -74,6 +78,25 @@ public:
      */
     std::vector<std::string> selectValueList();
 
+    /**
+     * Wait for the device description prefetch to be done
+     *
+     * The prefetch is launched after the device opening. It reads the
+     * device description file into the GenTLLib cache, so that
+     * the node map creation does not have to wait for the transfer.
+     */
+    void waitPrefetch() { prefetchDone.wait(); }
+
+    /**
+     * Wait for the device to be opened
+     *
+     * The device is opened in the background, so that selecting
+     * several devices opens them in parallel.
+     *
+     * @throw Poco::RuntimeException if the device could not be opened
+     */
+    void waitOpen();
+
 private:
     GenicamDeviceFactory();
 	~GenicamDeviceFactory();
@@ -85,6 +108,26 @@ private:
     GenTLLib* mGenTL; ///< Interface to the shared lib
     GenTL::IF_HANDLE _TLhInterface; ///< handle on the GenTL interface module
     GenTL::DEV_HANDLE _TLhDevice; ///< handle on the GenTL device module
+
+    /**
+     * Open the device, then read its description file into the cache
+     *
+     * Run in openThread. Set openDone, then prefetchDone,
+     * whatever happens.
+     */
+    void openAndPrefetch();
+
+    /// open the device. called by openAndPrefetch()
+    void open();
+
+    /// read the device description file. called by openAndPrefetch()
+    void prefetch();
+
+    Poco::RunnableAdapter<GenicamDeviceFactory> openRunnable;
+    Poco::Thread openThread;
+    Poco::Event openDone; ///< set when the device is opened, or failed to
+    std::string openError; ///< empty if the device was opened
+    Poco::Event prefetchDone; ///< set at the end of prefetch()
 };
 
 #endif /* SRC_MODULES_DEVICES_GENICAM_GENICAMDEVICEFACTORY_H_ */
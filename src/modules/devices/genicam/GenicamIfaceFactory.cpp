@@ -34,7 +34,9 @@
 GenicamIfaceFactory::GenicamIfaceFactory(GenTLLib* genTL,
         ModuleFactory* parent, std::string selector):
         ModuleFactoryBranch(parent, selector, false),
-        _TLhInterface(GENTL_INVALID_HANDLE), mGenTL(genTL)
+        _TLhInterface(GENTL_INVALID_HANDLE), mGenTL(genTL),
+        discoverRunnable(*this, &GenicamIfaceFactory::discover),
+        discoveryDone(false) // manual reset
 {
     setLogger(name());
 
@@ -56,11 +58,17 @@ GenicamIfaceFactory::GenicamIfaceFactory(GenTLLib* genTL,
     else
         mGenTL->genTLPortInfo(_TLhInterface, logger());
 
-    discover();
+    // device list of the previous discovery, if any
+    mGenTL->cache().getList(cacheKey(), devices);
+
+    // IFUpdateDeviceList can take seconds: do not block the start-up
+    discoverThread.start(discoverRunnable);
 }
 
 GenicamIfaceFactory::~GenicamIfaceFactory()
 {
+    discoverThread.join();
+
      if (_TLhInterface != GENTL_INVALID_HANDLE)
      {
          try
@@ -77,16 +85,54 @@ GenicamIfaceFactory::~GenicamIfaceFactory()
 
 std::vector<std::string> GenicamIfaceFactory::selectValueList()
 {
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(devicesMutex);
+        if (!devices.empty())
+            return devices;
+    }
+
+    waitDiscovery();
+
+    Poco::ScopedLock<Poco::FastMutex> lock(devicesMutex);
     return devices;
 }
 
 ModuleFactoryBranch* GenicamIfaceFactory::newChildFactory(std::string selector)
 {
+    // the device list of the producer has to be updated before opening
+    waitDiscovery();
+
     return new GenicamDeviceFactory(mGenTL, _TLhInterface, this, selector);
 }
 
+std::string GenicamIfaceFactory::cacheKey()
+{
+    return GenicamXmlCache::makeKey("devices:"
+            + static_cast<ModuleFactoryBranch*>(parent())->getSelector()
+            + ":" + getSelector());
+}
+
 void GenicamIfaceFactory::discover()
 {
+    // the waitDiscovery callers would be blocked forever
+    // if discoveryDone was not set
+    try
+    {
+        discoverDevices();
+    }
+    catch (...)
+    {
+        discoveryDone.set();
+        throw;
+    }
+
+    discoveryDone.set();
+}
+
+void GenicamIfaceFactory::discoverDevices()
+{
+    std::vector<std::string> found;
+
     try
     {
     mGenTL->IFUpdateDeviceList(_TLhInterface, NULL,
@@ -115,8 +161,6 @@ void GenicamIfaceFactory::discover()
 
     for (uint32_t device=0 ; device < numDevices ; device++)
     {
-        char *pDeviceID;
-
         // get device ID
         size_t size;
         try
@@ -127,8 +171,12 @@ void GenicamIfaceFactory::discover()
         {
             poco_error(logger(), "Cannot retrieve the device#"
                     + Poco::NumberFormatter::format(device) + " device ID" );
+            continue;
         }
-        pDeviceID = new char[size];
+
+        // released even if an exception is thrown
+        std::vector<char> deviceID(size + 1, 0);
+        char *pDeviceID = &deviceID[0];
 
         try
         {
@@ -139,7 +187,7 @@ void GenicamIfaceFactory::discover()
             poco_information(logger(), "Device found: "
                     + std::string(pDeviceID));
 
-            devices.push_back(std::string(pDeviceID));
+            found.push_back(std::string(pDeviceID));
 
         }
         catch (GenTLException& e)
@@ -148,9 +196,14 @@ void GenicamIfaceFactory::discover()
                 std::string("deviceDiscover: ")
                 + e.displayText() );
         }
+    }
 
-        delete[] pDeviceID;
+    {
+        Poco::ScopedLock<Poco::FastMutex> lock(devicesMutex);
+        devices = found;
     }
+
+    mGenTL->cache().putList(cacheKey(), found);
 }
 
 void GenicamIfaceFactory::genTLDeviceExInfo(char* pDeviceID)
@@ -33,6 +33,11 @@
 
 #include "GenTLLib.h"
 
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+
 /**
  * GenicamIfaceFactory
  * 
@@ -50,7 +55,7 @@ public:
      * Constructor
      *
      * Open interface
-     * Launch devices discovery using deviceDiscover()
+     * Launch devices discovery using discover() in a background thread
      */
     GenicamIfaceFactory(GenTLLib* genTL, ModuleFactory* parent, std::string selector);
 
@@ -64,6 +69,11 @@ public:
 
     /**
      * Find the available genicam devices and expose it
+     *
+     * If the devices of this interface were already discovered
+     * (by a previous factory, or at a previous run: the list is kept
+     * in the GenTLLib::cache()), this list is returned
+     * without waiting for the background discovery.
      */
     std::vector<std::string> selectValueList();
 
@@ -75,9 +85,25 @@ private:
 
     /**
      * Discover the devices
+     *
+     * Run in discoverThread. Update devices and the cached list.
      */
     void discover();
 
+    /**
+     * Discovery logic, called by discover()
+     *
+     * discover() sets discoveryDone whatever happens here,
+     * exceptions included.
+     */
+    void discoverDevices();
+
+    /// wait for the end of the background discovery
+    void waitDiscovery() { discoveryDone.wait(); }
+
+    /// key of the cached device list: genTL lib path and interface ID
+    std::string cacheKey();
+
     /**
      * Retrieve extended info about a GenTL device
      */
@@ -92,6 +118,11 @@ private:
         char* pBuffer, size_t bufferSize);
 
     std::vector<std::string> devices;
+    Poco::FastMutex devicesMutex; ///< lock devices
+
+    Poco::RunnableAdapter<GenicamIfaceFactory> discoverRunnable;
+    Poco::Thread discoverThread; ///< thread running discover()
+    Poco::Event discoveryDone; ///< set at the end of discover()
 
     GenTLLib* mGenTL; ///< Interface to the shared lib
     GenTL::IF_HANDLE _TLhInterface; ///< handle on the GenTL interface module
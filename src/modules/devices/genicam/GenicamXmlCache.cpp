@@ -0,0 +1,268 @@
+/**
+ * @file	src/modules/devices/genicam/GenicamXmlCache.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "GenicamXmlCache.h"
+
+#ifdef HAVE_GENAPI
+#include "GenICam.h"
+#endif
+
+#include "Poco/Util/Application.h"
+#include "Poco/SHA1Engine.h"
+#include "Poco/DigestEngine.h"
+#include "Poco/Environment.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/File.h"
+#include "Poco/FileStream.h"
+#include "Poco/StreamCopier.h"
+
+#include <sstream>
+
+#define CONF_KEY_GENICAM_CACHE_DIR "genicam.cacheDir"
+#define CONF_KEY_GENICAM_GENAPI_CACHE "genicam.genApiCache"
+
+GenicamXmlCache::GenicamXmlCache():
+    diskCache(false)
+{
+    Poco::Util::Application& app = Poco::Util::Application::instance();
+
+    std::string dir;
+    if (app.config().hasProperty(CONF_KEY_GENICAM_CACHE_DIR))
+        dir = app.config().getString(CONF_KEY_GENICAM_CACHE_DIR);
+    else
+        dir = defaultCacheDir().toString();
+
+    if (dir.empty())
+    {
+        poco_information(logger(), "GenICam disk cache disabled");
+        return;
+    }
+
+    try
+    {
+        cacheDir = Poco::Path(dir).makeDirectory().makeAbsolute();
+        Poco::File(cacheDir).createDirectories();
+        diskCache = true;
+    }
+    catch (Poco::Exception& e)
+    {
+        poco_warning(logger(), "GenICam disk cache disabled: "
+                + e.displayText());
+        return;
+    }
+
+    poco_information(logger(), "GenICam cache: " + cacheDir.toString());
+
+#ifdef HAVE_GENAPI
+    // GenApi own cache of the preprocessed node maps. GenApi only reads
+    // it from the environment, which is process wide: opt-in only.
+    if (!app.config().getBool(CONF_KEY_GENICAM_GENAPI_CACHE, false))
+        return;
+
+    std::string genApiCacheVar = "GENICAM_CACHE_V"
+            + Poco::NumberFormatter::format(GENICAM_VERSION_MAJOR) + "_"
+            + Poco::NumberFormatter::format(GENICAM_VERSION_MINOR);
+
+    if (Poco::Environment::has(genApiCacheVar))
+    {
+        poco_information(logger(), "GenApi cache already set by "
+                + genApiCacheVar + ": " + Poco::Environment::get(genApiCacheVar));
+        return;
+    }
+
+    Poco::Path genApiDir(cacheDir);
+    genApiDir.pushDirectory("genapi");
+
+    try
+    {
+        Poco::File(genApiDir).createDirectories();
+        Poco::Environment::set(genApiCacheVar, genApiDir.toString());
+    }
+    catch (Poco::Exception& e)
+    {
+        poco_warning(logger(), "GenApi cache not set: " + e.displayText());
+    }
+#endif
+}
+
+Poco::Path GenicamXmlCache::defaultCacheDir()
+{
+    Poco::Path dir(Poco::Path::home());
+
+#ifdef WIN32
+    std::string localAppData = Poco::Environment::get("LOCALAPPDATA", "");
+    if (!localAppData.empty())
+        dir = Poco::Path(localAppData).makeDirectory();
+
+    dir.pushDirectory("instrumentall");
+    dir.pushDirectory("cache");
+#else
+    std::string xdgCacheHome = Poco::Environment::get("XDG_CACHE_HOME", "");
+    if (xdgCacheHome.empty())
+        dir.pushDirectory(".cache");
+    else
+        dir = Poco::Path(xdgCacheHome).makeDirectory();
+
+    dir.pushDirectory("instrumentall");
+#endif
+
+    dir.pushDirectory("genicam");
+    return dir;
+}
+
+bool GenicamXmlCache::get(const std::string& key, std::string& content)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+
+    std::map<std::string, std::string>::iterator it = memCache.find(key);
+    if (it != memCache.end())
+    {
+        content = it->second;
+        return true;
+    }
+
+    if (!diskCache)
+        return false;
+
+    Poco::File file(filePath(key));
+
+    try
+    {
+        if (!file.exists())
+            return false;
+
+        Poco::FileInputStream stream(file.path(), std::ios::in | std::ios::binary);
+        std::ostringstream buffer;
+        Poco::StreamCopier::copyStream(stream, buffer);
+        content = buffer.str();
+    }
+    catch (Poco::Exception& e)
+    {
+        poco_warning(logger(), "Unable to read " + file.path()
+                + ": " + e.displayText());
+        return false;
+    }
+
+    memCache.insert(std::make_pair(key, content));
+    return true;
+}
+
+void GenicamXmlCache::put(const std::string& key, const std::string& content)
+{
+    Poco::ScopedLock<Poco::FastMutex> lock(mutex);
+
+    memCache[key] = content;
+
+    if (!diskCache)
+        return;
+
+    // write in a temporary file first: an interrupted write
+    // shall not leave a truncated file in the cache
+    Poco::Path path(filePath(key));
+    Poco::Path tmpPath(path);
+    tmpPath.setExtension("tmp");
+
+    try
+    {
+        {
+            Poco::FileOutputStream stream(tmpPath.toString(),
+                    std::ios::out | std::ios::binary | std::ios::trunc);
+            stream.write(content.data(), content.size());
+        }
+
+        Poco::File(tmpPath).renameTo(path.toString());
+    }
+    catch (Poco::Exception& e)
+    {
+        poco_warning(logger(), "Unable to write " + path.toString()
+                + ": " + e.displayText());
+    }
+}
+
+bool GenicamXmlCache::getList(const std::string& key,
+        std::vector<std::string>& list)
+{
+    std::string content;
+    if (!get(key, content))
+        return false;
+
+    // items stored as <size>:<item> (see putList)
+    std::vector<std::string> items;
+    size_t pos = 0;
+    while (pos < content.size())
+    {
+        size_t sep = content.find(':', pos);
+        if (sep == std::string::npos)
+            break;
+
+        size_t size = 0;
+        std::istringstream sizeStream(content.substr(pos, sep - pos));
+        if (!(sizeStream >> size) || sep + 1 + size > content.size())
+            break;
+
+        items.push_back(content.substr(sep + 1, size));
+        pos = sep + 1 + size;
+    }
+
+    if (pos != content.size())
+    {
+        poco_warning(logger(), "Corrupted cache entry: " + key + ". Ignored. ");
+        return false;
+    }
+
+    list.swap(items);
+    return true;
+}
+
+void GenicamXmlCache::putList(const std::string& key,
+        const std::vector<std::string>& list)
+{
+    std::string content;
+    for (std::vector<std::string>::const_iterator it = list.begin(),
+            ite = list.end(); it != ite; it++)
+    {
+        content += Poco::NumberFormatter::format(it->size()) + ":";
+        content += *it;
+    }
+
+    put(key, content);
+}
+
+std::string GenicamXmlCache::makeKey(const std::string& description)
+{
+    Poco::SHA1Engine sha1;
+    sha1.update(description);
+    return Poco::DigestEngine::digestToHex(sha1.digest());
+}
+
+Poco::Path GenicamXmlCache::filePath(const std::string& key)
+{
+    Poco::Path path(cacheDir);
+    path.setFileName(key + ".bin");
+    return path;
+}
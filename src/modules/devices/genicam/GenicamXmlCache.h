@@ -0,0 +1,128 @@
+/**
+ * @file	src/modules/devices/genicam/GenicamXmlCache.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_MODULES_DEVICES_GENICAM_GENICAMXMLCACHE_H_
+#define SRC_MODULES_DEVICES_GENICAM_GENICAMXMLCACHE_H_
+
+#include "Poco/Path.h"
+#include "Poco/Mutex.h"
+#include "Poco/Logger.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * GenicamXmlCache
+ *
+ * Startup cache of the GenICam path:
+ *  - the device description files (GenICam XML, possibly zipped),
+ *  to avoid reading them again through the GenTL port registers at each
+ *  device opening, which can take seconds on slow links;
+ *  - the device lists found by the enumeration of the interfaces;
+ *  - the parameter lists derived from the node maps by the camera modules.
+ *
+ * The entries are kept in memory and in the cache directory, given by the
+ * `genicam.cacheDir` configuration key (default: defaultCacheDir(), a
+ * per-user directory; empty to disable the disk cache).
+ *
+ * The key is computed by the caller from the description of the entry
+ * (e.g. URL, vendor, model, file version, SHA1 hash if the producer
+ * gives it, for the description files), so that a new firmware
+ * description is fetched again.
+ *
+ * The GenApi preprocessed node map cache can also be enabled in a
+ * subdirectory, by setting `genicam.genApiCache` (see the constructor).
+ */
+class GenicamXmlCache
+{
+public:
+    /**
+     * Constructor
+     *
+     * If `genicam.genApiCache` is set and the GenApi cache environment
+     * variable (GENICAM_CACHE_V<major>_<minor>) is not, this variable is
+     * set to the `genapi` subdirectory of the cache directory. The
+     * environment of the process is not modified otherwise.
+     */
+    GenicamXmlCache();
+
+    /**
+     * Get a cached file
+     *
+     * @return false if the file is not in the cache
+     */
+    bool get(const std::string& key, std::string& content);
+
+    /**
+     * Store a file in the cache
+     *
+     * A failure to write the disk cache is only logged.
+     */
+    void put(const std::string& key, const std::string& content);
+
+    /**
+     * Get a cached list of strings
+     *
+     * @return false if the list is not in the cache
+     */
+    bool getList(const std::string& key, std::vector<std::string>& list);
+
+    /**
+     * Store a list of strings in the cache
+     *
+     * The items can contain any character.
+     */
+    void putList(const std::string& key, const std::vector<std::string>& list);
+
+    /// compute a key suitable as file name from the file description
+    static std::string makeKey(const std::string& description);
+
+    /**
+     * Default cache directory
+     *
+     * Per-user, since the application directory is often read-only:
+     *  - `%LOCALAPPDATA%/instrumentall/cache/genicam` on Windows,
+     *  - `$XDG_CACHE_HOME/instrumentall/genicam` elsewhere,
+     *  `$XDG_CACHE_HOME` defaulting to `~/.cache`.
+     */
+    static Poco::Path defaultCacheDir();
+
+private:
+    Poco::Path filePath(const std::string& key);
+
+    Poco::Logger& logger() { return Poco::Logger::get("GenicamXmlCache"); }
+
+    bool diskCache; ///< false if the cache directory can not be used
+    Poco::Path cacheDir;
+
+    std::map<std::string, std::string> memCache;
+    Poco::FastMutex mutex;
+};
+
+#endif /* SRC_MODULES_DEVICES_GENICAM_GENICAMXMLCACHE_H_ */
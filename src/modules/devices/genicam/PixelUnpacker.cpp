@@ -0,0 +1,496 @@
+/**
+ * @file	src/modules/devices/genicam/PixelUnpacker.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+#ifdef HAVE_GENAPI
+
+#include "PixelUnpacker.h"
+
+#include "Poco/Exception.h"
+#include "Poco/NumberFormatter.h"
+
+#include <cstring>
+
+// SSE2 is part of x86-64. MSVC does not define __SSE2__
+#if defined(__SSE2__) || defined(_M_X64) \
+        || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UNPACK_SSE2
+#include <emmintrin.h>
+#endif
+
+// The SSSE3 kernels are compiled for the SSSE3 target whatever the
+// build flags, and selected at runtime with cpuid
+#if defined(UNPACK_SSE2) && (defined(_MSC_VER) || defined(__clang__) \
+        || (defined(__GNUC__) && __GNUC__ >= 5))
+#define UNPACK_SSSE3
+#include <tmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define UNPACK_SSSE3_TARGET
+#else
+#define UNPACK_SSSE3_TARGET __attribute__((target("ssse3")))
+#endif
+#endif
+
+namespace
+{
+
+/// number of bits per pixel in the producer buffer
+size_t bufferBits(PixelUnpacker::Format format)
+{
+    switch (format)
+    {
+    case PixelUnpacker::fmtMono8:
+        return 8;
+    case PixelUnpacker::fmtMono16:
+        return 16;
+    case PixelUnpacker::fmtMono10p:
+        return 10;
+    default:
+        return 12;
+    }
+}
+
+/**
+ * Scalar unpacking of whole groups
+ *
+ * written to let the compiler vectorize the inner loops
+ */
+template <typename T>
+void unpackGroups(const unsigned char* src, PixelUnpacker::Format format,
+        size_t firstGroup, size_t lastGroup, int shift, T* dst)
+{
+    switch (format)
+    {
+    case PixelUnpacker::fmtMono8:
+        for (size_t ind = firstGroup; ind < lastGroup; ind++)
+            dst[ind] = static_cast<T>(src[ind] >> shift);
+        break;
+    case PixelUnpacker::fmtMono16:
+        for (size_t ind = firstGroup; ind < lastGroup; ind++)
+        {
+            unsigned int value = src[2*ind] | (src[2*ind + 1] << 8);
+            dst[ind] = static_cast<T>(value >> shift);
+        }
+        break;
+    case PixelUnpacker::fmtMono10p:
+        for (size_t ind = firstGroup; ind < lastGroup; ind++)
+        {
+            const unsigned char* s = src + 5*ind;
+            T* d = dst + 4*ind;
+            d[0] = static_cast<T>(((s[0] | (s[1] << 8)) & 0x3FF) >> shift);
+            d[1] = static_cast<T>((((s[1] >> 2) | (s[2] << 6)) & 0x3FF) >> shift);
+            d[2] = static_cast<T>((((s[2] >> 4) | (s[3] << 4)) & 0x3FF) >> shift);
+            d[3] = static_cast<T>(((s[3] >> 6) | (s[4] << 2)) >> shift);
+        }
+        break;
+    case PixelUnpacker::fmtMono12p:
+        for (size_t ind = firstGroup; ind < lastGroup; ind++)
+        {
+            const unsigned char* s = src + 3*ind;
+            T* d = dst + 2*ind;
+            d[0] = static_cast<T>(((s[0] | (s[1] << 8)) & 0xFFF) >> shift);
+            d[1] = static_cast<T>(((s[1] >> 4) | (s[2] << 4)) >> shift);
+        }
+        break;
+    case PixelUnpacker::fmtMono10Packed:
+        for (size_t ind = firstGroup; ind < lastGroup; ind++)
+        {
+            const unsigned char* s = src + 3*ind;
+            T* d = dst + 2*ind;
+            d[0] = static_cast<T>(((s[0] << 2) | (s[1] & 0x03)) >> shift);
+            d[1] = static_cast<T>(((s[2] << 2) | ((s[1] >> 4) & 0x03)) >> shift);
+        }
+        break;
+    case PixelUnpacker::fmtMono12Packed:
+        for (size_t ind = firstGroup; ind < lastGroup; ind++)
+        {
+            const unsigned char* s = src + 3*ind;
+            T* d = dst + 2*ind;
+            d[0] = static_cast<T>(((s[0] << 4) | (s[1] & 0x0F)) >> shift);
+            d[1] = static_cast<T>(((s[2] << 4) | (s[1] >> 4)) >> shift);
+        }
+        break;
+    }
+}
+
+#ifdef UNPACK_SSE2
+inline void store8(const __m128i& values, int shift, Poco::UInt16* dst)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+            _mm_srl_epi16(values, _mm_cvtsi32_si128(shift)));
+}
+
+inline void store8(const __m128i& values, int shift, unsigned char* dst)
+{
+    __m128i bytes = _mm_packus_epi16(
+            _mm_srl_epi16(values, _mm_cvtsi32_si128(shift)),
+            _mm_setzero_si128());
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), bytes);
+}
+
+/**
+ * SSE2 unpacking of 8 pixels per iteration
+ *
+ * Return the index of the first group that was not processed.
+ */
+template <typename T>
+size_t unpackGroupsSse2(const unsigned char* src, PixelUnpacker::Format format,
+        size_t firstGroup, size_t lastGroup, int shift, T* dst)
+{
+    size_t group = firstGroup;
+
+    if (format == PixelUnpacker::fmtMono16)
+    {
+        for (; group + 8 <= lastGroup; group += 8)
+        {
+            __m128i values = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(src + 2*group));
+            store8(values, shift, dst + group);
+        }
+    }
+
+    return group;
+}
+#endif /* UNPACK_SSE2 */
+
+#ifdef UNPACK_SSSE3
+/// true if the CPU supports SSSE3
+bool cpuHasSsse3()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") != 0;
+#endif
+}
+
+const bool ssse3Available = cpuHasSsse3();
+
+/**
+ * SSSE3 unpacking of the packed formats, 8 pixels per iteration
+ *
+ * Return the index of the first group that was not processed.
+ * The source is read by 16 bytes: the loops stop before reading
+ * beyond the last group of the range.
+ *
+ * Only called if ssse3Available.
+ */
+template <typename T>
+UNPACK_SSSE3_TARGET
+size_t unpackGroupsSsse3(const unsigned char* src, PixelUnpacker::Format format,
+        size_t firstGroup, size_t lastGroup, int shift, T* dst)
+{
+    size_t group = firstGroup;
+
+    switch (format)
+    {
+    case PixelUnpacker::fmtMono10p:
+    {
+        // 16-bit lanes: (b0,b1), (b1,b2), (b2,b3), (b3,b4), (b5,b6), ...
+        // pixel j of a group is at bit 2*j of its lane
+        const __m128i shuffle = _mm_setr_epi8(
+                0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9);
+        // left shift by 6 - 2*j, then right shift by 6
+        const __m128i align = _mm_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1);
+
+        // 2 groups (10 bytes) per iteration, 16 bytes read
+        for (; 5*group + 16 <= 5*lastGroup; group += 2)
+        {
+            __m128i lanes = _mm_shuffle_epi8(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(src + 5*group)), shuffle);
+            __m128i values = _mm_srli_epi16(_mm_mullo_epi16(lanes, align), 6);
+            store8(values, shift, dst + 4*group);
+        }
+        break;
+    }
+    case PixelUnpacker::fmtMono12p:
+    {
+        // 16-bit lanes: (b0,b1), (b1,b2), (b3,b4), (b4,b5), ...
+        const __m128i shuffle = _mm_setr_epi8(
+                0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11);
+        const __m128i evenMask = _mm_set1_epi32(0x00000FFF);
+        const __m128i oddMask = _mm_set1_epi32(static_cast<int>(0xFFFF0000));
+
+        // 4 groups (12 bytes) per iteration, 16 bytes read
+        for (; 3*group + 16 <= 3*lastGroup; group += 4)
+        {
+            __m128i lanes = _mm_shuffle_epi8(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(src + 3*group)), shuffle);
+            __m128i values = _mm_or_si128(
+                    _mm_and_si128(lanes, evenMask),
+                    _mm_and_si128(_mm_srli_epi16(lanes, 4), oddMask));
+            store8(values, shift, dst + 2*group);
+        }
+        break;
+    }
+    case PixelUnpacker::fmtMono12Packed:
+    {
+        // 16-bit lanes: (b1,b0), (b1,b2), (b4,b3), (b4,b5), ...
+        const __m128i shuffle = _mm_setr_epi8(
+                1, 0, 1, 2, 4, 3, 4, 5, 7, 6, 7, 8, 10, 9, 10, 11);
+        const __m128i highMask = _mm_set1_epi32(static_cast<int>(0xFFFF0FF0));
+        const __m128i lowMask = _mm_set1_epi32(0x0000000F);
+
+        for (; 3*group + 16 <= 3*lastGroup; group += 4)
+        {
+            __m128i lanes = _mm_shuffle_epi8(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(src + 3*group)), shuffle);
+            __m128i values = _mm_or_si128(
+                    _mm_and_si128(_mm_srli_epi16(lanes, 4), highMask),
+                    _mm_and_si128(lanes, lowMask));
+            store8(values, shift, dst + 2*group);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    return group;
+}
+#endif /* UNPACK_SSSE3 */
+
+template <typename T>
+void unpackRangeImpl(const unsigned char* src, PixelUnpacker::Format format,
+        size_t first, size_t last, int shift, T* dst)
+{
+    size_t groupPixels = PixelUnpacker::groupPixels(format);
+
+    if (first % groupPixels || last % groupPixels)
+        throw Poco::InvalidArgumentException("PixelUnpacker::unpackRange",
+                "the range has to be aligned on the packing groups");
+
+    size_t firstGroup = first / groupPixels;
+    size_t lastGroup = last / groupPixels;
+
+#ifdef UNPACK_SSE2
+    firstGroup = unpackGroupsSse2<T>(src, format, firstGroup, lastGroup, shift, dst);
+#endif
+#ifdef UNPACK_SSSE3
+    if (ssse3Available)
+        firstGroup = unpackGroupsSsse3<T>(src, format, firstGroup, lastGroup, shift, dst);
+#endif
+
+    unpackGroups<T>(src, format, firstGroup, lastGroup, shift, dst);
+}
+
+/// unpack stripes of groups in parallel
+template <typename T>
+class UnpackBody: public cv::ParallelLoopBody
+{
+public:
+    UnpackBody(const unsigned char* src, PixelUnpacker::Format format,
+            size_t groupPixels, int shift, T* dst):
+        mSrc(src), mFormat(format), mGroupPixels(groupPixels),
+        mShift(shift), mDst(dst)
+    {
+    }
+
+    void operator()(const cv::Range& range) const
+    {
+        unpackRangeImpl<T>(mSrc, mFormat,
+                range.start * mGroupPixels, range.end * mGroupPixels,
+                mShift, mDst);
+    }
+
+private:
+    const unsigned char* mSrc;
+    PixelUnpacker::Format mFormat;
+    size_t mGroupPixels;
+    int mShift;
+    T* mDst;
+};
+
+/// stripes of about 64kB of source data
+const size_t stripeBytes = 1 << 16;
+
+template <typename T>
+void unpackImage(const unsigned char* src, size_t srcSize,
+        PixelUnpacker::Format format, size_t pixels, int shift, T* dst)
+{
+    size_t groupPixels = PixelUnpacker::groupPixels(format);
+    size_t groupBytes = PixelUnpacker::groupBytes(format);
+    size_t groups = pixels / groupPixels;
+
+    if (groups)
+    {
+        double stripes = static_cast<double>(groups * groupBytes / stripeBytes);
+        if (stripes < 1)
+            unpackRangeImpl<T>(src, format, 0, groups * groupPixels, shift, dst);
+        else
+            cv::parallel_for_(cv::Range(0, static_cast<int>(groups)),
+                    UnpackBody<T>(src, format, groupPixels, shift, dst),
+                    stripes);
+    }
+
+    // last incomplete group (PFNC formats are packed along the whole image)
+    size_t tail = pixels - groups * groupPixels;
+    if (tail)
+    {
+        unsigned char lastGroup[8];
+        T values[4];
+
+        memset(lastGroup, 0, sizeof(lastGroup));
+        memcpy(lastGroup, src + groups * groupBytes, srcSize - groups * groupBytes);
+
+        unpackGroups<T>(lastGroup, format, 0, 1, shift, values);
+        memcpy(dst + groups * groupPixels, values, tail * sizeof(T));
+    }
+}
+
+}
+
+PixelUnpacker::Format PixelUnpacker::fromName(const std::string& name, int& bitDepth)
+{
+    // Bayer formats: same packing as the mono formats with the same suffix
+    if (name.size() > 7 && name.compare(0, 5, "Bayer") == 0)
+        return fromName("Mono" + name.substr(7), bitDepth);
+
+    if (name == "Mono8")
+    {
+        bitDepth = 8;
+        return fmtMono8;
+    }
+    else if (name == "Mono10")
+    {
+        bitDepth = 10;
+        return fmtMono16;
+    }
+    else if (name == "Mono12")
+    {
+        bitDepth = 12;
+        return fmtMono16;
+    }
+    else if (name == "Mono14")
+    {
+        bitDepth = 14;
+        return fmtMono16;
+    }
+    else if (name == "Mono16")
+    {
+        bitDepth = 16;
+        return fmtMono16;
+    }
+    else if (name == "Mono10p")
+    {
+        bitDepth = 10;
+        return fmtMono10p;
+    }
+    else if (name == "Mono12p")
+    {
+        bitDepth = 12;
+        return fmtMono12p;
+    }
+    else if (name == "Mono10Packed")
+    {
+        bitDepth = 10;
+        return fmtMono10Packed;
+    }
+    else if (name == "Mono12Packed")
+    {
+        bitDepth = 12;
+        return fmtMono12Packed;
+    }
+    else
+        throw Poco::NotImplementedException("PixelUnpacker",
+                "unrecognized pixel format: " + name);
+}
+
+size_t PixelUnpacker::groupPixels(Format format)
+{
+    switch (format)
+    {
+    case fmtMono8:
+    case fmtMono16:
+        return 1;
+    case fmtMono10p:
+        return 4;
+    default:
+        return 2;
+    }
+}
+
+size_t PixelUnpacker::groupBytes(Format format)
+{
+    return groupPixels(format) * bufferBits(format) / 8;
+}
+
+size_t PixelUnpacker::bufferSize(Format format, int rows, int cols)
+{
+    size_t pixels = static_cast<size_t>(rows) * cols;
+    return (pixels * bufferBits(format) + 7) / 8;
+}
+
+void PixelUnpacker::unpack(const unsigned char* src, size_t srcSize,
+        Format format, int bitDepth,
+        int rows, int cols, int type, cv::Mat& img)
+{
+    size_t needed = bufferSize(format, rows, cols);
+    if (srcSize < needed)
+        throw Poco::DataException("PixelUnpacker::unpack",
+                "The buffer is too small for the image: "
+                + Poco::NumberFormatter::format(srcSize) + " bytes, "
+                + Poco::NumberFormatter::format(needed) + " needed");
+
+    img.create(rows, cols, type);
+    size_t pixels = static_cast<size_t>(rows) * cols;
+
+    switch (type)
+    {
+    case CV_16UC1:
+        unpackImage<Poco::UInt16>(src, needed, format, pixels, 0,
+                img.ptr<Poco::UInt16>());
+        break;
+    case CV_8UC1:
+        unpackImage<unsigned char>(src, needed, format, pixels,
+                (bitDepth > 8) ? bitDepth - 8 : 0, img.ptr<unsigned char>());
+        break;
+    default:
+        throw Poco::InvalidArgumentException("PixelUnpacker::unpack",
+                "the image type should be CV_16UC1 or CV_8UC1");
+    }
+}
+
+void PixelUnpacker::unpackRange(const unsigned char* src, Format format,
+        size_t first, size_t last, int shift, Poco::UInt16* dst)
+{
+    unpackRangeImpl<Poco::UInt16>(src, format, first, last, shift, dst);
+}
+
+void PixelUnpacker::unpackRange(const unsigned char* src, Format format,
+        size_t first, size_t last, int shift, unsigned char* dst)
+{
+    unpackRangeImpl<unsigned char>(src, format, first, last, shift, dst);
+}
+
+#endif /* HAVE_GENAPI */
+#endif /* HAVE_OPENCV */
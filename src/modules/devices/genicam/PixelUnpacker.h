@@ -0,0 +1,135 @@
+/**
+ * @file	src/modules/devices/genicam/PixelUnpacker.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_MODULES_DEVICES_GENICAM_PIXELUNPACKER_H_
+#define SRC_MODULES_DEVICES_GENICAM_PIXELUNPACKER_H_
+
+#ifdef HAVE_OPENCV
+#ifdef HAVE_GENAPI
+
+#include "Poco/Types.h"
+
+#include "opencv2/opencv.hpp"
+
+#include <string>
+
+/**
+ * PixelUnpacker
+ *
+ * Convert the GenICam mono pixel formats to cv::Mat.
+ *
+ * The packed formats (Mono10p, Mono12p: PFNC, bits packed LSB first
+ * along the whole image; Mono10Packed, Mono12Packed: GigE Vision legacy,
+ * 2 pixels in 3 bytes) are unpacked to CV_16UC1 in a single pass,
+ * directly from the GenTL buffer to the output image. The image is
+ * split in stripes processed in parallel. Mono10p, Mono12p and
+ * Mono12Packed use SSSE3 byte shuffles if the CPU supports them (runtime
+ * check), Mono10/12/14/16 use SSE2 shifts on x86.
+ *
+ * Optionally, the image can be downshifted to CV_8UC1 (most significant
+ * bits) during the same pass, e.g. for preview branches.
+ */
+class PixelUnpacker
+{
+public:
+    enum Format
+    {
+        fmtMono8, ///< 8 bits per pixel
+        fmtMono16, ///< Mono10, Mono12, Mono14, Mono16: 16 bits containers
+        fmtMono10p, ///< PFNC, 4 pixels in 5 bytes
+        fmtMono12p, ///< PFNC, 2 pixels in 3 bytes
+        fmtMono10Packed, ///< GigE Vision, 2 pixels in 3 bytes
+        fmtMono12Packed ///< GigE Vision, 2 pixels in 3 bytes
+    };
+
+    /**
+     * Get the format from the GenICam PixelFormat symbolic name
+     *
+     * The Bayer formats (e.g. BayerRG12) are handled as the
+     * corresponding mono formats (e.g. Mono12), see BayerConverter.
+     *
+     * @param name PixelFormat enumeration entry
+     * @param[out] bitDepth number of significant bits per pixel
+     * @throw Poco::NotImplementedException if the format is not supported
+     */
+    static Format fromName(const std::string& name, int& bitDepth);
+
+    /// true if the format can not be wrapped as is in a cv::Mat
+    static bool isPacked(Format format)
+        { return format != fmtMono8 && format != fmtMono16; }
+
+    /// minimum buffer size for an image of the given format
+    static size_t bufferSize(Format format, int rows, int cols);
+
+    /**
+     * Unpack the given buffer into img
+     *
+     * @param src buffer filled by the producer
+     * @param srcSize size of the buffer
+     * @param format pixel format of the buffer
+     * @param bitDepth number of significant bits per pixel
+     * @param rows, cols image geometry
+     * @param type CV_16UC1, or CV_8UC1 to keep only the 8 most
+     * significant bits
+     * @param[out] img image, (re)allocated if needed
+     *
+     * @throw Poco::DataException if the buffer is too small
+     */
+    static void unpack(const unsigned char* src, size_t srcSize,
+            Format format, int bitDepth,
+            int rows, int cols, int type, cv::Mat& img);
+
+    /**
+     * Unpack a range of pixels
+     *
+     * The range is given in pixel indexes, along the whole image.
+     * first has to be a multiple of the packing group size
+     * (4 pixels for Mono10p, 2 for the other packed formats).
+     *
+     * @param shift right shift applied to the unpacked values
+     */
+    static void unpackRange(const unsigned char* src, Format format,
+            size_t first, size_t last, int shift, Poco::UInt16* dst);
+
+    /// 8-bit version of unpackRange
+    static void unpackRange(const unsigned char* src, Format format,
+            size_t first, size_t last, int shift, unsigned char* dst);
+
+    /// packing group size in pixels
+    static size_t groupPixels(Format format);
+
+    /// packing group size in bytes
+    static size_t groupBytes(Format format);
+
+private:
+    PixelUnpacker();
+};
+
+#endif /* HAVE_GENAPI */
+#endif /* HAVE_OPENCV */
+#endif /* SRC_MODULES_DEVICES_GENICAM_PIXELUNPACKER_H_ */
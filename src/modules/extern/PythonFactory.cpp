@@ -33,7 +33,11 @@
 #include "modules/GenericLeafFactory.h"
 #include "modules/extern/PythonModule.h"
 
+#include "core/DataItem.h"
+
 #include "Poco/RegularExpression.h"
+#include "Poco/StringTokenizer.h"
+#include "Poco/String.h"
 
 std::vector<std::string> PythonFactory::selectValueList()
 {
@@ -56,11 +60,28 @@ std::string PythonFactory::validateSelector(std::string selector)
     if (selector.empty())
         return "";
 
-    Poco::RegularExpression regex("^\\w+(\\s*;\\s*\\w+)*$");
+    Poco::RegularExpression regex(
+            "^\\w+(\\s*:\\s*\\w+)?(\\s*;\\s*\\w+(\\s*:\\s*\\w+)?)*$");
     if (!regex.match(selector))
         throw Poco::InvalidArgumentException("Unrecognized selector: " + selector);
-    else
-        return selector;
+
+    // check the output port types
+    Poco::StringTokenizer tok(selector, ";", Poco::StringTokenizer::TOK_TRIM);
+    for (Poco::StringTokenizer::Iterator it = tok.begin(), ite = tok.end();
+            it != ite; it++)
+    {
+        size_t colon = it->find(':');
+        if (colon == std::string::npos)
+            continue;
+
+        std::string type(Poco::trim(it->substr(colon + 1)));
+        if (DataItem::noContainerDataType(DataItem::getTypeFromShortStr(type))
+                == DataItem::typeUndefined)
+            throw Poco::InvalidArgumentException(
+                    "Unrecognized output port type: " + type);
+    }
+
+    return selector;
 }
 
 #endif /* HAVE_PYTHON27 */
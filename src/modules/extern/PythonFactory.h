@@ -56,7 +56,10 @@ public:
     {
         return "trig ports described as trig port names separated by semicolons, "
                 "e.g. \"trigA;trigB\". The names are trimmed "
-                "so that you can write: \"trigA ; trigB\" ";
+                "so that you can write: \"trigA ; trigB\". "
+                "Output ports, set by the script in a worker process, "
+                "are declared with their short data type, "
+                "e.g. \"trig;mean:dblFloat;image:cvMat\" ";
     }
 
     std::vector<std::string> selectValueList();
@@ -65,7 +68,8 @@ private:
     ModuleFactoryBranch* newChildFactory(std::string selector);
 
     /**
-     * Check that the selector is a semicolon separated token of alpha num chars
+     * Check that the selector is a semicolon separated token of alpha num chars,
+     * optionally followed by a colon and a data type (output ports)
      */
     std::string validateSelector(std::string selector);
 };
@@ -31,16 +31,21 @@
 #include "PythonModule.h"
 
 #include "core/ModuleFactoryBranch.h"
+#include "core/InPort.h"
+#include "core/OutPort.h"
+#include "core/DataSource.h"
 #include "UI/PythonManager.h"
 
 #include "Poco/NumberFormatter.h"
 #include "Poco/Path.h"
+#include "Poco/String.h"
 #include "Poco/StringTokenizer.h"
 
 size_t PythonModule::refCount = 0;
 
 PythonModule::PythonModule(ModuleFactory* parent, std::string customName):
-    Module(parent, customName)
+    Module(parent, customName),
+    inWorker(false)
 {
     if (refCount)
         setInternalName("PythonModule"
@@ -51,28 +56,59 @@ PythonModule::PythonModule(ModuleFactory* parent, std::string customName):
     setCustomName(customName);
     setLogger("module." + name());
 
-    // the input ports are defined by the parent factory selector.
+    // the ports are defined by the parent factory selector.
     std::string sel(static_cast<ModuleFactoryBranch*>(parent)->getSelector());
     if (!sel.empty())
     {
+        std::vector<std::string> trigNames;
+
         Poco::StringTokenizer tok(sel, ";", Poco::StringTokenizer::TOK_TRIM);
-        size_t tokCnt = tok.count();
+        for (Poco::StringTokenizer::Iterator it = tok.begin(), ite = tok.end();
+                it != ite; it++)
+        {
+            // output port declaration: name:type
+            size_t colon = it->find(':');
+            if (colon == std::string::npos)
+                trigNames.push_back(*it);
+            else
+                outputs.push_back(std::make_pair(
+                        Poco::trim(it->substr(0, colon)),
+                        DataItem::getTypeFromShortStr(
+                                Poco::trim(it->substr(colon + 1)))));
+        }
+
+        size_t tokCnt = trigNames.size();
         setInPortCount(tokCnt);
         for (size_t ind = 0; ind < tokCnt; ind++)
-            addTrigPort(tok[ind], "auto-generated trig port, "
+            addTrigPort(trigNames[ind], "auto-generated trig port, "
                     "retrieved from parent factory selector parsing", ind);
 
         poco_information(logger(), Poco::NumberFormatter::format(tokCnt)
             + " trig ports were created for " + name());
-    }
 
-    // no output port
+        setOutPortCount(outputs.size());
+        for (size_t ind = 0; ind < outputs.size(); ind++)
+            addOutPort(outputs[ind].first, "auto-generated output port, "
+                    "set by the script in a worker process, "
+                    "retrieved from parent factory selector parsing",
+                    outputs[ind].second, ind);
+
+        if (outputs.size())
+            poco_information(logger(), Poco::NumberFormatter::format(outputs.size())
+                + " output ports were created for " + name());
+    }
 
     // parameters
     setParameterCount(paramCnt);
     addParameter(paramScriptFilePath, "scriptFilePath",
             "path to the python script to be executed when trigged",
             ParamItem::typeString, "");
+    addParameter(paramExecution, "execution",
+            "Where to run the script: \"embedded\" (embedded interpreter, "
+            "instru module available) or \"worker\" (separate python process, "
+            "port data exchanged through the instru module shim of the worker). "
+            "Only \"worker\" is available if output ports are declared",
+            ParamItem::typeString, outputs.empty() ? "embedded" : "worker");
 
     // set parameter defaults
     setParametersDefaultValue();
@@ -87,33 +123,115 @@ std::string PythonModule::description()
 {
     return "Execute the given python script when all the input ports \n"
             "are trigged. You should consider using a dataGen module \n"
-            "if you need to ouput data. The input ports are locked \n"
-            "as long as the python script is executing. ";
+            "if you need to ouput data, or declare output ports, \n"
+            "set by the script in a worker process. The input ports \n"
+            "are locked as long as the python script is executing. ";
 }
 
 void PythonModule::process(int startCond)
 {
-    if (scriptPath.size())
-        Poco::Util::Application::instance().getSubsystem<PythonManager>().runScript(scriptPath);
-    else
+    if (scriptPath.empty())
         throw Poco::RuntimeException("process", "The script file path is not defined");
+
+    if (!inWorker)
+    {
+        Poco::Util::Application::instance().getSubsystem<PythonManager>().runScript(scriptPath);
+        return;
+    }
+
+    // the data of the caught trig ports are given to the script
+    PythonWorkerPool::Inputs inputs;
+    DataAttribute attr;
+
+    for (size_t ind = 0; ind < getInPortCount(); ind++)
+    {
+        if (!isInPortCaught(ind))
+            continue;
+
+        readLockInPort(ind);
+
+        DataAttributeIn portAttr;
+        readInPortDataAttribute(ind, &portAttr);
+        attr += portAttr;
+
+        InPort* port = getInPort(ind);
+        DataSource* source = port->getDataSource();
+        if (source->dataType() != DataItem::typeUndefined)
+            inputs.push_back(std::make_pair(port->name(),
+                    static_cast<TypeNeutralData*>(source)));
+    }
+
+    outAttr = attr;
+
+    // the inputs are released when the script returns, see releaseInputs
+    PythonWorkerPool::instance().runScript(scriptPath,
+            inputs, outputs, this, this);
 }
 
-std::string PythonModule::getStrParameterValue(size_t paramIndex)
+size_t PythonModule::outputIndex(const std::string& name)
 {
-    poco_assert(paramIndex == paramScriptFilePath);
+    for (size_t ind = 0; ind < outputs.size(); ind++)
+        if (outputs[ind].first == name)
+            return ind;
 
-    return scriptPath;
+    throw Poco::NotFoundException("PythonModule", "no output port " + name);
 }
 
-void PythonModule::setStrParameterValue(size_t paramIndex, std::string value)
+TypeNeutralData* PythonModule::reserveOutput(const std::string& name)
 {
-    poco_assert(paramIndex == paramScriptFilePath);
+    size_t index = outputIndex(name);
+    reserveOutPort(index);
+    return getOutPorts()[index];
+}
 
-    if (value.empty())
-        scriptPath.clear();
-    else
-        scriptPath = Poco::Path(value).absolute().toString();
+void PythonModule::outputReady(const std::string& name)
+{
+    notifyOutPortReady(outputIndex(name), outAttr);
+}
+
+std::string PythonModule::getStrParameterValue(size_t paramIndex)
+{
+    switch (paramIndex)
+    {
+    case paramScriptFilePath:
+        return scriptPath;
+    case paramExecution:
+        return inWorker ? "worker" : "embedded";
+    default:
+        poco_bugcheck_msg("wrong parameter index");
+        throw Poco::BugcheckException();
+    }
+}
+
+void PythonModule::setStrParameterValue(size_t paramIndex, std::string value)
+{
+    switch (paramIndex)
+    {
+    case paramScriptFilePath:
+        if (value.empty())
+            scriptPath.clear();
+        else
+            scriptPath = Poco::Path(value).absolute().toString();
+        break;
+    case paramExecution:
+        if (Poco::icompare(value, "embedded") == 0)
+        {
+            if (!outputs.empty())
+                throw Poco::InvalidArgumentException("setParameterValue",
+                        "the output ports are only set in the \"worker\" "
+                        "execution mode");
+            inWorker = false;
+        }
+        else if (Poco::icompare(value, "worker") == 0)
+            inWorker = true;
+        else
+            throw Poco::InvalidArgumentException("setParameterValue",
+                    "execution shall be \"embedded\" or \"worker\"");
+        break;
+    default:
+        poco_bugcheck_msg("wrong parameter index");
+        throw Poco::BugcheckException();
+    }
 }
 
 #endif /* HAVE_PYTHON27 */
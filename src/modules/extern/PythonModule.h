@@ -32,6 +32,7 @@
 #ifdef HAVE_PYTHON27
 
 #include "core/Module.h"
+#include "PythonWorkerPool.h"
 
 /**
  * Python Module
@@ -39,12 +40,27 @@
  * When all the input ports are trigged, the python script is launched.
  * The input ports are released when the script returns.
  *
- * There is no output port. DataGen modules should be used instead.
+ * The ports are determined using the factory selector.
+ * This selector is a semi-colon-separated list of trig port names,
+ * and of output port declarations "name:type", the type being a short
+ * data type name (see DataItem::dataTypeShortStr), e.g.
+ * "trig;mean:dblFloat;image:cvMat".
  *
- * The count of input ports is determined using the factory selector.
- * This selector is a semi-colon-separated list of trig port names.
+ * With the "worker" execution mode, the script runs in a separate
+ * python process (see PythonWorkerPool): the scripts of several
+ * modules can run in parallel. The script uses the instru module shim
+ * of the worker: it gets the data of the trig ports with
+ * instru.getInput(portName) and sets the output ports with
+ * instru.setOutput(portName, value). This mode is the only one
+ * available if output ports are declared. The worker is killed if
+ * the module is cancelled.
+ *
+ * In the default "embedded" mode, the output ports are not available:
+ * DataGen modules should be used instead.
  */
-class PythonModule: public Module
+class PythonModule: public Module,
+        private PythonWorkerPool::Canceller,
+        private PythonWorkerPool::OutputHandler
 {
 public:
     PythonModule(ModuleFactory* parent, std::string customName);
@@ -56,9 +72,23 @@ private:
 
     void process(int startCond);
 
+    /// PythonWorkerPool::Canceller implementation
+    bool cancelRequested() { return yield(); }
+
+    /// PythonWorkerPool::OutputHandler implementation
+    ///@{
+    void releaseInputs() { releaseAllInPorts(); }
+    TypeNeutralData* reserveOutput(const std::string& name);
+    void outputReady(const std::string& name);
+    ///@}
+
+    /// Index of the output port of the given name
+    size_t outputIndex(const std::string& name);
+
     enum params
     {
         paramScriptFilePath,
+        paramExecution,
         paramCnt
     };
 
@@ -66,6 +96,10 @@ private:
     void setStrParameterValue(size_t paramIndex, std::string value);
 
     std::string scriptPath;
+    bool inWorker; ///< run the script in a worker process
+
+    PythonWorkerPool::Outputs outputs; ///< output port names and types
+    DataAttributeOut outAttr; ///< output attribute of the current run
 };
 
 #endif /* HAVE_PYTHON27 */
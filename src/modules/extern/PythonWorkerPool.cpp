@@ -0,0 +1,1113 @@
+/**
+ * @file	src/modules/extern/PythonWorkerPool.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_PYTHON27
+
+#include "PythonWorkerPool.h"
+
+#include "core/ExecutionAbortedException.h"
+
+#include "Poco/Util/Application.h"
+#include "Poco/SingletonHolder.h"
+#include "Poco/Environment.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/StringTokenizer.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+
+#include <cstring>
+#include <climits>
+#include <algorithm>
+
+#ifdef WIN32
+#include "Poco/UnWindows.h"
+#else
+#include <poll.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+#endif
+
+#define CONF_KEY_PY_WORKER_EXEC   "python.workerExecutable"
+#define CONF_KEY_PY_WORKER_COUNT  "python.workerCount"
+#define CONF_KEY_PY_WORKER_XCHG   "python.workerExchangeDirectory"
+
+/// Alignment of the data in the exchange files, in bytes
+static const size_t exchangeAlign = 16;
+
+/// Minimum size of the input segment, in bytes
+static const size_t minSegmentSize = 65536;
+
+/**
+ * Worker main loop, given to the interpreter with -c, the result file
+ * path being the first argument
+ *
+ * Compatible with python 2.7 and python 3. The compiled scripts
+ * are cached by path, modification time and size. The request lines
+ * are parsed as they come; an error (e.g. unsupported input) is
+ * reported when the RUN line is received.
+ */
+static const char* workerCode =
+    "import sys, os, struct, mmap, types, traceback\n"
+    "ctrl = sys.stdout\n"
+    "sys.stdout = sys.stderr\n"
+    "resultPath = sys.argv[1]\n"
+    "try:\n"
+    "    import numpy\n"
+    "except ImportError:\n"
+    "    numpy = None\n"
+    "FORMATS = {'int32': 'i', 'uint32': 'I', 'int64': 'q', 'uint64': 'Q',\n"
+    "           'float': 'f', 'dblFloat': 'd'}\n"
+    "TYPESTR = {'B': 'u1', 'b': 'i1', 'H': 'u2', 'h': 'i2', 'i': 'i4',\n"
+    "           'I': 'u4', 'q': 'i8', 'Q': 'u8', 'f': 'f4', 'd': 'f8'}\n"
+    "ORDER = '<' if sys.byteorder == 'little' else '>'\n"
+    "class DataArray(object):\n"
+    "    '''Read-only array of the exchange segment, valid during the script run'''\n"
+    "    def __init__(self, data, format, shape):\n"
+    "        self.data = data\n"
+    "        self.format = format\n"
+    "        self.shape = tuple(shape)\n"
+    "    @property\n"
+    "    def __array_interface__(self):\n"
+    "        return {'shape': self.shape, 'typestr': ORDER + TYPESTR[self.format],\n"
+    "                'data': self.data, 'version': 3}\n"
+    "    def tolist(self):\n"
+    "        count = 1\n"
+    "        for dim in self.shape:\n"
+    "            count *= dim\n"
+    "        flat = list(struct.unpack('=%d%s' % (count, self.format), bytes(self.data)))\n"
+    "        for dim in reversed(self.shape[1:]):\n"
+    "            flat = [flat[i:i + dim] for i in range(0, len(flat), dim)]\n"
+    "        return flat\n"
+    "segment = None\n"
+    "inputs = {}\n"
+    "outputs = {}\n"
+    "results = {}\n"
+    "def view(offset, size):\n"
+    "    if sys.version_info[0] >= 3:\n"
+    "        return memoryview(segment)[offset:offset + size]\n"
+    "    return buffer(segment, offset, size)\n"
+    "def text(data):\n"
+    "    return data.decode('utf-8', 'replace') if sys.version_info[0] >= 3 else data\n"
+    "def readImage(args):\n"
+    "    offset, rows, cols, channels = int(args[0]), int(args[2]), int(args[3]), int(args[4])\n"
+    "    shape = (rows, cols) if channels == 1 else (rows, cols, channels)\n"
+    "    size = rows * cols * channels * struct.calcsize(args[1])\n"
+    "    return DataArray(view(offset, size), args[1], shape)\n"
+    "def readInput(kind, args):\n"
+    "    if kind in FORMATS:\n"
+    "        return struct.unpack_from('=' + FORMATS[kind], segment, int(args[0]))[0]\n"
+    "    if kind[:-4] in FORMATS:\n"
+    "        format = FORMATS[kind[:-4]]\n"
+    "        count = int(args[1])\n"
+    "        size = count * struct.calcsize(format)\n"
+    "        return DataArray(view(int(args[0]), size), format, (count,))\n"
+    "    if kind == 'str':\n"
+    "        offset = int(args[0])\n"
+    "        return text(segment[offset:offset + int(args[1])])\n"
+    "    if kind == 'strVect':\n"
+    "        offset, values = int(args[0]), []\n"
+    "        for size in args[2:]:\n"
+    "            values.append(text(segment[offset:offset + int(size)]))\n"
+    "            offset += int(size)\n"
+    "        return values\n"
+    "    if kind == 'cvMat':\n"
+    "        return readImage(args)\n"
+    "    if kind == 'cvMatVect':\n"
+    "        return [readImage(args[i:i + 5]) for i in range(1, len(args), 5)]\n"
+    "    raise TypeError('unsupported input type: ' + kind)\n"
+    "def arrayBytes(value, format):\n"
+    "    if numpy is not None:\n"
+    "        array = numpy.ascontiguousarray(value, dtype=numpy.dtype(format))\n"
+    "        return array.shape, array.tobytes()\n"
+    "    if isinstance(value, DataArray) and value.format == format:\n"
+    "        return value.shape, bytes(value.data)\n"
+    "    values = list(value)\n"
+    "    return (len(values),), struct.pack('=%d%s' % (len(values), format), *values)\n"
+    "def imageBytes(value):\n"
+    "    if numpy is not None:\n"
+    "        array = numpy.ascontiguousarray(value)\n"
+    "        typestr = array.dtype.kind + str(array.dtype.itemsize)\n"
+    "        format = [key for key in 'BbHhifd' if TYPESTR[key] == typestr]\n"
+    "        if not format:\n"
+    "            raise TypeError('unsupported image type: ' + str(array.dtype))\n"
+    "        return format[0], array.shape, array.tobytes()\n"
+    "    if not isinstance(value, DataArray):\n"
+    "        raise TypeError('an image output needs numpy or a DataArray')\n"
+    "    return value.format, value.shape, bytes(value.data)\n"
+    "def encode(value):\n"
+    "    return value if isinstance(value, bytes) else value.encode('utf-8')\n"
+    "class Writer(object):\n"
+    "    def __init__(self):\n"
+    "        self.chunks = []\n"
+    "        self.size = 0\n"
+    "    def put(self, data):\n"
+    "        offset = self.size\n"
+    "        padding = -len(data) % 16\n"
+    "        self.chunks.append(data + b'\\0' * padding)\n"
+    "        self.size += len(data) + padding\n"
+    "        return str(offset)\n"
+    "def writeImage(value, writer):\n"
+    "    format, shape, data = imageBytes(value)\n"
+    "    if len(shape) not in (2, 3):\n"
+    "        raise ValueError('an image shall have 2 or 3 dimensions')\n"
+    "    channels = shape[2] if len(shape) == 3 else 1\n"
+    "    return ' '.join([writer.put(data), format,\n"
+    "                     str(shape[0]), str(shape[1]), str(channels)])\n"
+    "def writeOutput(kind, value, writer):\n"
+    "    if kind in FORMATS:\n"
+    "        return writer.put(struct.pack('=' + FORMATS[kind], value))\n"
+    "    if kind[:-4] in FORMATS:\n"
+    "        format = FORMATS[kind[:-4]]\n"
+    "        shape, data = arrayBytes(value, format)\n"
+    "        return writer.put(data) + ' ' + str(len(data) // struct.calcsize(format))\n"
+    "    if kind == 'str':\n"
+    "        data = encode(value)\n"
+    "        return writer.put(data) + ' ' + str(len(data))\n"
+    "    if kind == 'strVect':\n"
+    "        values = [encode(item) for item in value]\n"
+    "        sizes = [str(len(item)) for item in values]\n"
+    "        return ' '.join([writer.put(b''.join(values)), str(len(values))] + sizes)\n"
+    "    if kind == 'cvMat':\n"
+    "        return writeImage(value, writer)\n"
+    "    if kind == 'cvMatVect':\n"
+    "        images = [writeImage(item, writer) for item in value]\n"
+    "        return ' '.join([str(len(value))] + images)\n"
+    "    raise TypeError('unsupported output type: ' + kind)\n"
+    "def setOutput(name, value):\n"
+    "    '''Set the value of the given output port of the module'''\n"
+    "    if name not in outputs:\n"
+    "        raise KeyError('no such output port: ' + name)\n"
+    "    results[name] = value\n"
+    "instru = types.ModuleType('instru')\n"
+    "instru.__doc__ = 'instru module shim of the python worker processes'\n"
+    "instru.DataArray = DataArray\n"
+    "instru.inputNames = lambda: sorted(inputs)\n"
+    "instru.getInput = lambda name: inputs[name]\n"
+    "instru.outputNames = lambda: sorted(outputs)\n"
+    "instru.setOutput = setOutput\n"
+    "sys.modules['instru'] = instru\n"
+    "cache = {}\n"
+    "failure = None\n"
+    "while True:\n"
+    "    line = sys.stdin.readline()\n"
+    "    if not line:\n"
+    "        break\n"
+    "    words = line.rstrip('\\r\\n').split(' ', 2)\n"
+    "    if words[0] != 'RUN':\n"
+    "        try:\n"
+    "            if words[0] == 'MAP':\n"
+    "                with open(words[2], 'rb') as f:\n"
+    "                    segment = mmap.mmap(f.fileno(), int(words[1]),\n"
+    "                                        access=mmap.ACCESS_READ)\n"
+    "            elif words[0] == 'OUT':\n"
+    "                outputs[words[1]] = words[2]\n"
+    "            elif words[0] == 'IN':\n"
+    "                args = words[2].split(' ')\n"
+    "                inputs[words[1]] = readInput(args[0], args[1:])\n"
+    "            else:\n"
+    "                raise ValueError('unknown request: ' + words[0])\n"
+    "        except BaseException as e:\n"
+    "            failure = failure or e\n"
+    "        continue\n"
+    "    path = line.rstrip('\\r\\n')[4:]\n"
+    "    lines = []\n"
+    "    try:\n"
+    "        if failure is not None:\n"
+    "            raise failure\n"
+    "        st = os.stat(path)\n"
+    "        key = (st.st_mtime, st.st_size)\n"
+    "        if path not in cache or cache[path][0] != key:\n"
+    "            with open(path) as f:\n"
+    "                cache[path] = (key, compile(f.read(), path, 'exec'))\n"
+    "        try:\n"
+    "            exec(cache[path][1], {'__name__': '__worker__',\n"
+    "                                  '__file__': path})\n"
+    "        except SystemExit:\n"
+    "            pass\n"
+    "        writer = Writer()\n"
+    "        for name in results:\n"
+    "            args = writeOutput(outputs[name], results[name], writer)\n"
+    "            lines.append(' '.join(['SET', name, outputs[name], args]))\n"
+    "        if results:\n"
+    "            with open(resultPath, 'wb') as f:\n"
+    "                f.write(b''.join(writer.chunks) or b'\\0')\n"
+    "        lines.append('OK')\n"
+    "    except BaseException as e:\n"
+    "        traceback.print_exc()\n"
+    "        lines = ['ERR ' + repr(e).replace('\\n', ' ')]\n"
+    "    failure = None\n"
+    "    inputs.clear()\n"
+    "    outputs.clear()\n"
+    "    results.clear()\n"
+    "    ctrl.write('\\n'.join(lines) + '\\n')\n"
+    "    ctrl.flush()\n";
+
+/// Size rounded up to the exchange alignment
+static size_t alignedSize(size_t size)
+{
+    return (size + exchangeAlign - 1) / exchangeAlign * exchangeAlign;
+}
+
+/**
+ * Placement of the inputs in the input segment
+ *
+ * Without base, the data is not copied: only the positions are
+ * computed, e.g. to get the segment size needed.
+ */
+struct SegmentWriter
+{
+    SegmentWriter(char* segmentBase = NULL): base(segmentBase), size(0) { }
+
+    /// Reserve the given byte count: return its offset
+    size_t reserve(size_t count)
+    {
+        size_t offset = size;
+        size += alignedSize(count);
+        return offset;
+    }
+
+    /// Copy the given bytes: return their offset
+    size_t put(const void* data, size_t count)
+    {
+        size_t offset = reserve(count);
+        if (base && count)
+            std::memcpy(base + offset, data, count);
+        return offset;
+    }
+
+    char* base;
+    size_t size;
+};
+
+/**
+ * Read access to the outputs in the result file
+ */
+struct ResultReader
+{
+    ResultReader(const char* resultBase, size_t resultSize):
+        base(resultBase), size(resultSize) { }
+
+    /**
+     * Get the given count of items of the given size
+     *
+     * @throw Poco::DataFormatException if they are not in the file
+     */
+    const char* get(size_t offset, size_t count, size_t itemSize) const
+    {
+        if (offset > size || (itemSize && count > (size - offset) / itemSize))
+            throw Poco::DataFormatException("PythonWorkerPool",
+                    "output data out of the result file");
+
+        return base + offset;
+    }
+
+    const char* base;
+    size_t size;
+};
+
+/// Arguments of an IN or SET line
+typedef std::vector<std::string> Args;
+
+/// Get the argument at the given index as a size
+static size_t sizeArg(const Args& args, size_t index)
+{
+    if (index >= args.size())
+        throw Poco::DataFormatException("PythonWorkerPool",
+                "missing output argument");
+
+    return static_cast<size_t>(Poco::NumberParser::parseUnsigned64(args[index]));
+}
+
+/// IN arguments of a number: offset, or of a vector: offset and count
+template<typename T>
+static std::string numberArgs(TypeNeutralData& data, SegmentWriter& writer)
+{
+    if (!TypeNeutralData::isVector(data.dataType()))
+        return Poco::NumberFormatter::format(
+                writer.put(data.getData<T>(), sizeof(T)));
+
+    std::vector<T>* pVect = data.getData< std::vector<T> >();
+    size_t offset = writer.put(pVect->empty() ? NULL : &(*pVect)[0],
+            pVect->size() * sizeof(T));
+
+    return Poco::NumberFormatter::format(offset) + " "
+            + Poco::NumberFormatter::format(pVect->size());
+}
+
+/// Read a number or a vector of numbers, see numberArgs
+template<typename T>
+static void readNumber(const Args& args, const ResultReader& reader,
+        TypeNeutralData& target)
+{
+    if (!TypeNeutralData::isVector(target.dataType()))
+    {
+        std::memcpy(target.getData<T>(),
+                reader.get(sizeArg(args, 0), 1, sizeof(T)), sizeof(T));
+        return;
+    }
+
+    size_t count = sizeArg(args, 1);
+    const char* values = reader.get(sizeArg(args, 0), count, sizeof(T));
+
+    std::vector<T>* pVect = target.getData< std::vector<T> >();
+    pVect->resize(count);
+    if (count)
+        std::memcpy(&(*pVect)[0], values, count * sizeof(T));
+}
+
+/**
+ * IN arguments of a string: offset and size,
+ * or of a vector of strings: offset, count, and the sizes
+ *
+ * The strings of a vector are contiguous.
+ */
+static std::string stringArgs(TypeNeutralData& data, SegmentWriter& writer)
+{
+    if (!TypeNeutralData::isVector(data.dataType()))
+    {
+        std::string* pStr = data.getData<std::string>();
+        return Poco::NumberFormatter::format(
+                    writer.put(pStr->data(), pStr->size())) + " "
+                + Poco::NumberFormatter::format(pStr->size());
+    }
+
+    std::vector<std::string>* pVect = data.getData< std::vector<std::string> >();
+
+    size_t total = 0;
+    for (std::vector<std::string>::iterator it = pVect->begin(),
+            ite = pVect->end(); it != ite; it++)
+        total += it->size();
+
+    size_t offset = writer.reserve(total);
+    char* pos = writer.base ? writer.base + offset : NULL;
+
+    std::string args(Poco::NumberFormatter::format(offset) + " "
+            + Poco::NumberFormatter::format(pVect->size()));
+
+    for (std::vector<std::string>::iterator it = pVect->begin(),
+            ite = pVect->end(); it != ite; it++)
+    {
+        args += " " + Poco::NumberFormatter::format(it->size());
+        if (pos)
+        {
+            std::memcpy(pos, it->data(), it->size());
+            pos += it->size();
+        }
+    }
+
+    return args;
+}
+
+/// Read a string or a vector of strings, see stringArgs
+static void readString(const Args& args, const ResultReader& reader,
+        TypeNeutralData& target)
+{
+    size_t offset = sizeArg(args, 0);
+    size_t count = sizeArg(args, 1);
+
+    if (!TypeNeutralData::isVector(target.dataType()))
+    {
+        target.getData<std::string>()->assign(
+                reader.get(offset, count, 1), count);
+        return;
+    }
+
+    if (args.size() != count + 2)
+        throw Poco::DataFormatException("PythonWorkerPool",
+                "wrong string count");
+
+    std::vector<std::string>* pVect = target.getData< std::vector<std::string> >();
+    pVect->resize(count);
+
+    for (size_t index = 0; index < count; index++)
+    {
+        size_t size = sizeArg(args, index + 2);
+        pVect->at(index).assign(reader.get(offset, size, 1), size);
+        offset += size;
+    }
+}
+
+#ifdef HAVE_OPENCV
+/// struct module format of the given image depth
+static char depthFormat(int depth)
+{
+    switch (depth)
+    {
+    case CV_8U:
+        return 'B';
+    case CV_8S:
+        return 'b';
+    case CV_16U:
+        return 'H';
+    case CV_16S:
+        return 'h';
+    case CV_32S:
+        return 'i';
+    case CV_32F:
+        return 'f';
+    case CV_64F:
+        return 'd';
+    default:
+        throw Poco::DataFormatException("PythonWorkerPool",
+                "unsupported image depth");
+    }
+}
+
+/// Image depth of the given struct module format
+static int formatDepth(const std::string& format)
+{
+    if (format.size() == 1)
+    {
+        for (int depth = CV_8U; depth <= CV_64F; depth++)
+            if (depthFormat(depth) == format[0])
+                return depth;
+    }
+
+    throw Poco::DataFormatException("PythonWorkerPool",
+            "unsupported image format: " + format);
+}
+
+/**
+ * IN arguments of an image: offset, format, rows, cols and channels
+ *
+ * The image is copied as a continuous image.
+ */
+static std::string imageArgs(const cv::Mat& image, SegmentWriter& writer)
+{
+    if (image.dims > 2)
+        throw Poco::DataFormatException("PythonWorkerPool",
+                "only 2D images can be exchanged");
+
+    size_t offset = writer.reserve(image.total() * image.elemSize());
+    if (writer.base && !image.empty())
+    {
+        cv::Mat stored(image.rows, image.cols, image.type(),
+                writer.base + offset);
+        image.copyTo(stored);
+    }
+
+    return Poco::NumberFormatter::format(offset) + " "
+            + depthFormat(image.depth()) + " "
+            + Poco::NumberFormatter::format(image.rows) + " "
+            + Poco::NumberFormatter::format(image.cols) + " "
+            + Poco::NumberFormatter::format(image.channels());
+}
+
+/// Read the image described by args from the given index, see imageArgs
+static void readImage(const Args& args, size_t index,
+        const ResultReader& reader, cv::Mat& target)
+{
+    if (index + 5 > args.size())
+        throw Poco::DataFormatException("PythonWorkerPool",
+                "missing image argument");
+
+    int depth = formatDepth(args[index + 1]);
+    size_t rows = sizeArg(args, index + 2);
+    size_t cols = sizeArg(args, index + 3);
+    size_t channels = sizeArg(args, index + 4);
+
+    if (rows > INT_MAX || cols > INT_MAX || channels < 1 || channels > CV_CN_MAX
+            || (cols && rows > static_cast<size_t>(-1) / cols))
+        throw Poco::DataFormatException("PythonWorkerPool",
+                "wrong image size");
+
+    int type = CV_MAKETYPE(depth, static_cast<int>(channels));
+    const char* pixels = reader.get(sizeArg(args, index),
+            rows * cols, CV_ELEM_SIZE(type));
+
+    cv::Mat(static_cast<int>(rows), static_cast<int>(cols), type,
+            const_cast<char*>(pixels)).copyTo(target);
+}
+#endif /* HAVE_OPENCV */
+
+/**
+ * IN arguments of the given data, copied by the writer
+ *
+ * The arguments of a vector of images are the image count, then the
+ * arguments of each image.
+ */
+static std::string inputArgs(TypeNeutralData& data, SegmentWriter& writer)
+{
+    switch (TypeNeutralData::noContainerDataType(data.dataType()))
+    {
+    case TypeNeutralData::typeInt32:
+        return numberArgs<Poco::Int32>(data, writer);
+    case TypeNeutralData::typeUInt32:
+        return numberArgs<Poco::UInt32>(data, writer);
+    case TypeNeutralData::typeInt64:
+        return numberArgs<Poco::Int64>(data, writer);
+    case TypeNeutralData::typeUInt64:
+        return numberArgs<Poco::UInt64>(data, writer);
+    case TypeNeutralData::typeFloat:
+        return numberArgs<float>(data, writer);
+    case TypeNeutralData::typeDblFloat:
+        return numberArgs<double>(data, writer);
+    case TypeNeutralData::typeString:
+        return stringArgs(data, writer);
+#ifdef HAVE_OPENCV
+    case TypeNeutralData::typeCvMat:
+    {
+        if (!TypeNeutralData::isVector(data.dataType()))
+            return imageArgs(*data.getData<cv::Mat>(), writer);
+
+        std::vector<cv::Mat>* pVect = data.getData< std::vector<cv::Mat> >();
+        std::string args(Poco::NumberFormatter::format(pVect->size()));
+        for (std::vector<cv::Mat>::iterator it = pVect->begin(),
+                ite = pVect->end(); it != ite; it++)
+            args += " " + imageArgs(*it, writer);
+
+        return args;
+    }
+#endif
+    default:
+        throw Poco::DataFormatException("PythonWorkerPool",
+                "unsupported data type: "
+                + TypeNeutralData::dataTypeStr(data.dataType()));
+    }
+}
+
+/// Read the output described by the given SET arguments, see inputArgs
+static void readOutput(const Args& args, const ResultReader& reader,
+        TypeNeutralData& target)
+{
+    switch (TypeNeutralData::noContainerDataType(target.dataType()))
+    {
+    case TypeNeutralData::typeInt32:
+        readNumber<Poco::Int32>(args, reader, target);
+        break;
+    case TypeNeutralData::typeUInt32:
+        readNumber<Poco::UInt32>(args, reader, target);
+        break;
+    case TypeNeutralData::typeInt64:
+        readNumber<Poco::Int64>(args, reader, target);
+        break;
+    case TypeNeutralData::typeUInt64:
+        readNumber<Poco::UInt64>(args, reader, target);
+        break;
+    case TypeNeutralData::typeFloat:
+        readNumber<float>(args, reader, target);
+        break;
+    case TypeNeutralData::typeDblFloat:
+        readNumber<double>(args, reader, target);
+        break;
+    case TypeNeutralData::typeString:
+        readString(args, reader, target);
+        break;
+#ifdef HAVE_OPENCV
+    case TypeNeutralData::typeCvMat:
+    {
+        if (!TypeNeutralData::isVector(target.dataType()))
+        {
+            readImage(args, 0, reader, *target.getData<cv::Mat>());
+            break;
+        }
+
+        size_t count = sizeArg(args, 0);
+        if (args.size() != 1 + 5 * count)
+            throw Poco::DataFormatException("PythonWorkerPool",
+                    "wrong image count");
+
+        std::vector<cv::Mat>* pVect = target.getData< std::vector<cv::Mat> >();
+        pVect->resize(count);
+        for (size_t index = 0; index < count; index++)
+            readImage(args, 1 + 5 * index, reader, pVect->at(index));
+
+        break;
+    }
+#endif
+    default:
+        throw Poco::DataFormatException("PythonWorkerPool",
+                "unsupported data type: "
+                + TypeNeutralData::dataTypeStr(target.dataType()));
+    }
+}
+
+PythonWorkerPool::PythonWorkerPool():
+        workerCount(0)
+{
+    setLogger("PythonWorkerPool");
+
+    Poco::Util::AbstractConfiguration& conf =
+            Poco::Util::Application::instance().config();
+
+    executable = conf.getString(CONF_KEY_PY_WORKER_EXEC, "python");
+
+    // memory file system: the exchange files are never written to disk
+    std::string defaultExchangeDir;
+    if (Poco::File("/dev/shm").exists())
+        defaultExchangeDir = "/dev/shm";
+
+    exchangeDir = conf.getString(CONF_KEY_PY_WORKER_XCHG, defaultExchangeDir);
+
+    int count = conf.getInt(CONF_KEY_PY_WORKER_COUNT,
+            static_cast<int>(Poco::Environment::processorCount()));
+    maxWorkerCount = (count > 0) ? static_cast<size_t>(count) : 1;
+}
+
+PythonWorkerPool::~PythonWorkerPool()
+{
+    Poco::Mutex::ScopedLock lock(mutex);
+
+    for (std::vector<Worker*>::iterator it = idleWorkers.begin(),
+            ite = idleWorkers.end(); it != ite; it++)
+    {
+        try
+        {
+            // end of input: the worker main loop exits
+            (*it)->toWorker.close(Poco::Pipe::CLOSE_WRITE);
+            (*it)->handle.wait();
+        }
+        catch (...)
+        {
+            // nothing to do
+        }
+
+        delete *it;
+    }
+
+    idleWorkers.clear();
+}
+
+PythonWorkerPool& PythonWorkerPool::instance()
+{
+    static Poco::SingletonHolder<PythonWorkerPool> holder;
+    return *holder.get();
+}
+
+void PythonWorkerPool::runScript(const std::string& scriptPath,
+        const Inputs& inputs, const Outputs& outputs,
+        OutputHandler* handler, Canceller* canceller)
+{
+    Worker* worker = acquire(canceller);
+    if (worker == NULL)
+        throw ExecutionAbortedException(scriptPath,
+                "Cancelled while waiting for a python worker");
+
+    std::string request;
+
+    try
+    {
+        request = writeInputs(worker, inputs);
+    }
+    catch (...)
+    {
+        release(worker, false);
+        throw;
+    }
+
+    for (Outputs::const_iterator it = outputs.begin(), ite = outputs.end();
+            it != ite; it++)
+        request += "OUT " + it->first + " "
+                + TypeNeutralData::dataTypeShortStr(it->second) + "\n";
+
+    request += "RUN " + scriptPath;
+
+    std::vector<std::string> settings;
+    std::string reply;
+    bool broken = false;
+    bool cancelled = false;
+
+    try
+    {
+        writeLine(worker, request);
+
+        // SET lines, then the status line
+        while (true)
+        {
+            if (!readLine(worker, reply, canceller))
+            {
+                cancelled = true;
+                break;
+            }
+
+            if (reply.compare(0, 4, "SET ") != 0)
+                break;
+
+            settings.push_back(reply);
+        }
+    }
+    catch (Poco::Exception& e)
+    {
+        poco_warning(logger(), "worker pipe error: " + e.displayText());
+        broken = true;
+    }
+
+    if (broken || cancelled)
+    {
+        // a cancelled worker is still running the script: kill it
+        release(worker, true);
+
+        if (cancelled)
+            throw ExecutionAbortedException(scriptPath,
+                    "Cancelled upon user request");
+        else
+            throw Poco::IOException("PythonWorkerPool",
+                    "the worker process exited while running " + scriptPath);
+    }
+
+    if (reply.compare(0, 3, "ERR") == 0)
+    {
+        release(worker, false);
+        throw Poco::RuntimeException(scriptPath,
+                (reply.size() > 4) ? reply.substr(4) : "error");
+    }
+
+    // the worker mapped the current input segment
+    worker->mapRequest.clear();
+    worker->retiredFiles.clear();
+
+    try
+    {
+        if (handler)
+        {
+            handler->releaseInputs();
+            readOutputs(worker, settings, outputs, handler);
+        }
+    }
+    catch (...)
+    {
+        release(worker, false);
+        throw;
+    }
+
+    // the result file is rewritten by the next script
+    release(worker, false);
+}
+
+std::string PythonWorkerPool::writeInputs(Worker* worker, const Inputs& inputs)
+{
+    SegmentWriter measure;
+    for (Inputs::const_iterator it = inputs.begin(), ite = inputs.end();
+            it != ite; it++)
+        inputArgs(*it->second, measure);
+
+    if (measure.size > worker->segmentSize)
+    {
+        size_t size = std::max(measure.size,
+                std::max(minSegmentSize, 2 * worker->segmentSize));
+
+        Poco::SharedPtr<Poco::TemporaryFile> file(
+                new Poco::TemporaryFile(exchangeDir));
+        file->createFile();
+        file->setSize(static_cast<Poco::File::FileSize>(size));
+
+        Poco::SharedMemory mapping(*file, Poco::SharedMemory::AM_WRITE);
+        if (static_cast<size_t>(mapping.end() - mapping.begin()) < size)
+            throw Poco::FileException(file->path(), "unable to map "
+                    + Poco::NumberFormatter::format(size) + " bytes");
+
+        // on Windows, a file mapped by the worker can not be removed
+        if (!worker->segmentFile.isNull())
+            worker->retiredFiles.push_back(worker->segmentFile);
+
+        worker->segmentFile = file;
+        worker->segment = mapping;
+        worker->segmentSize = size;
+        worker->mapRequest = "MAP " + Poco::NumberFormatter::format(size)
+                + " " + file->path() + "\n";
+    }
+
+    SegmentWriter writer(worker->segment.begin());
+    std::string request(worker->mapRequest);
+
+    for (Inputs::const_iterator it = inputs.begin(), ite = inputs.end();
+            it != ite; it++)
+        request += "IN " + it->first + " "
+                + TypeNeutralData::dataTypeShortStr(it->second->dataType())
+                + " " + inputArgs(*it->second, writer) + "\n";
+
+    return request;
+}
+
+void PythonWorkerPool::readOutputs(Worker* worker,
+        const std::vector<std::string>& settings,
+        const Outputs& outputs, OutputHandler* handler)
+{
+    if (settings.empty())
+        return;
+
+    Poco::SharedMemory mapping(*worker->resultFile,
+            Poco::SharedMemory::AM_READ);
+    ResultReader reader(mapping.begin(),
+            static_cast<size_t>(mapping.end() - mapping.begin()));
+
+    for (std::vector<std::string>::const_iterator it = settings.begin(),
+            ite = settings.end(); it != ite; it++)
+    {
+        // SET <name> <type> <args>
+        Poco::StringTokenizer tok(*it, " ",
+                Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+        if (tok.count() < 3)
+            throw Poco::DataFormatException("PythonWorkerPool",
+                    "wrong reply: " + *it);
+
+        Outputs::const_iterator output = outputs.begin();
+        while (output != outputs.end() && output->first != tok[1])
+            output++;
+
+        if (output == outputs.end())
+            throw Poco::DataFormatException("PythonWorkerPool",
+                    "undeclared output: " + tok[1]);
+
+        if (tok[2] != TypeNeutralData::dataTypeShortStr(output->second))
+            throw Poco::DataFormatException("PythonWorkerPool",
+                    tok[1] + " output type is not " + tok[2]);
+
+        Args args(tok.begin() + 3, tok.end());
+
+        readOutput(args, reader, *handler->reserveOutput(tok[1]));
+        handler->outputReady(tok[1]);
+    }
+}
+
+PythonWorkerPool::Worker* PythonWorkerPool::acquire(Canceller* canceller)
+{
+    Poco::Mutex::ScopedLock lock(mutex);
+
+    while (idleWorkers.empty() && workerCount >= maxWorkerCount)
+    {
+        if (canceller == NULL)
+        {
+            workerReleased.wait(mutex);
+            continue;
+        }
+
+        if (workerReleased.tryWait(mutex, pollPeriod))
+            continue;
+
+        // do not hold the pool lock while polling the canceller
+        Poco::ScopedUnlock<Poco::Mutex> unlock(mutex);
+        if (canceller->cancelRequested())
+            return NULL;
+    }
+
+    if (!idleWorkers.empty())
+    {
+        Worker* worker = idleWorkers.back();
+        idleWorkers.pop_back();
+        return worker;
+    }
+
+    workerCount++;
+
+    try
+    {
+        // the interpreter startup is slow: do not block the other callers
+        Poco::ScopedUnlock<Poco::Mutex> unlock(mutex);
+        return spawn();
+    }
+    catch (...)
+    {
+        workerCount--;
+        workerReleased.signal();
+        throw;
+    }
+}
+
+void PythonWorkerPool::release(Worker* worker, bool broken)
+{
+    if (broken)
+    {
+        poco_warning(logger(), "discarding the worker process "
+                + Poco::NumberFormatter::format(worker->handle.id()));
+
+        try
+        {
+            Poco::Process::kill(worker->handle);
+        }
+        catch (Poco::Exception&)
+        {
+            // already exited
+        }
+
+        try
+        {
+            worker->handle.wait();
+        }
+        catch (Poco::Exception&)
+        {
+            // nothing to do
+        }
+
+        delete worker;
+    }
+
+    Poco::Mutex::ScopedLock lock(mutex);
+
+    if (broken)
+        workerCount--;
+    else
+        idleWorkers.push_back(worker);
+
+    workerReleased.signal();
+}
+
+void PythonWorkerPool::writeLine(Worker* worker, const std::string& line)
+{
+    std::string data(line + "\n");
+
+#ifdef __unix__
+    // a write to a dead worker shall fail with EPIPE instead of killing
+    // the application: SIGPIPE is blocked in this thread during the
+    // write, and the signal raised by the write is discarded
+    sigset_t sigpipeSet, oldMask, pendingSet;
+    sigemptyset(&sigpipeSet);
+    sigaddset(&sigpipeSet, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipeSet, &oldMask);
+
+    sigpending(&pendingSet);
+    bool alreadyPending = (sigismember(&pendingSet, SIGPIPE) == 1);
+#endif
+
+    bool failed = false;
+    std::string errorMsg;
+
+    try
+    {
+        const char* ptr = data.data();
+        int remaining = static_cast<int>(data.size());
+
+        while (remaining > 0)
+        {
+            int written = worker->toWorker.writeBytes(ptr, remaining);
+            ptr += written;
+            remaining -= written;
+        }
+    }
+    catch (Poco::Exception& e)
+    {
+        failed = true;
+        errorMsg = e.displayText();
+    }
+
+#ifdef __unix__
+    if (failed && !alreadyPending)
+    {
+        struct timespec noWait = { 0, 0 };
+        while (sigtimedwait(&sigpipeSet, NULL, &noWait) < 0 && errno == EINTR)
+            continue;
+    }
+
+    pthread_sigmask(SIG_SETMASK, &oldMask, NULL);
+#endif
+
+    if (failed)
+        throw Poco::WriteFileException("worker standard input", errorMsg);
+}
+
+bool PythonWorkerPool::readLine(Worker* worker, std::string& line,
+        Canceller* canceller)
+{
+    while (true)
+    {
+        size_t eol = worker->received.find('\n');
+        if (eol != std::string::npos)
+        {
+            line = worker->received.substr(0, eol);
+            worker->received.erase(0, eol + 1);
+
+            // text mode output of the worker on Windows
+            if (!line.empty() && line[line.size() - 1] == '\r')
+                line.erase(line.size() - 1);
+
+            return true;
+        }
+
+        if (canceller == NULL || waitReadable(worker, pollPeriod))
+        {
+            char buffer[256];
+            int count = worker->fromWorker.readBytes(buffer,
+                    static_cast<int>(sizeof(buffer)));
+            if (count <= 0)
+                throw Poco::ReadFileException("worker standard output",
+                        "end of file");
+
+            worker->received.append(buffer, static_cast<size_t>(count));
+        }
+        else if (canceller->cancelRequested())
+        {
+            return false;
+        }
+    }
+}
+
+bool PythonWorkerPool::waitReadable(Worker* worker, long timeout)
+{
+#ifdef WIN32
+    DWORD available = 0;
+    if (!PeekNamedPipe(worker->fromWorker.readHandle(),
+            NULL, 0, NULL, &available, NULL))
+        return true; // broken pipe: the read fails at once
+
+    if (available)
+        return true;
+
+    Sleep(static_cast<DWORD>(timeout));
+    return false;
+#else
+    struct pollfd pfd;
+    pfd.fd = worker->fromWorker.readHandle();
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    // POLLHUP: end of file, the read returns at once
+    return poll(&pfd, 1, static_cast<int>(timeout)) > 0;
+#endif
+}
+
+PythonWorkerPool::Worker* PythonWorkerPool::spawn()
+{
+    Poco::Pipe inPipe, outPipe;
+
+    Poco::SharedPtr<Poco::TemporaryFile> resultFile(
+            new Poco::TemporaryFile(exchangeDir));
+
+    Poco::Process::Args args;
+    args.push_back("-u"); // unbuffered control output
+    args.push_back("-c");
+    args.push_back(workerCode);
+    args.push_back(resultFile->path());
+
+    Poco::ProcessHandle handle =
+            Poco::Process::launch(executable, args, &inPipe, &outPipe, NULL);
+
+#if !defined(WIN32) && !defined(__unix__) && defined(F_SETNOSIGPIPE)
+    // Mac OS X: no SIGPIPE on write to a dead worker, see writeLine
+    fcntl(inPipe.writeHandle(), F_SETNOSIGPIPE, 1);
+#endif
+
+    poco_information(logger(), "worker process "
+            + Poco::NumberFormatter::format(handle.id()) + " started");
+
+    return new Worker(handle, inPipe, outPipe, resultFile);
+}
+
+#endif /* HAVE_PYTHON27 */
@@ -0,0 +1,255 @@
+/**
+ * @file	src/modules/extern/PythonWorkerPool.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_MODULES_EXTERN_PYTHONWORKERPOOL_H_
+#define SRC_MODULES_EXTERN_PYTHONWORKERPOOL_H_
+
+#ifdef HAVE_PYTHON27
+
+#include "core/VerboseEntity.h"
+#include "core/TypeNeutralData.h"
+
+#include "Poco/Process.h"
+#include "Poco/Pipe.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/SharedMemory.h"
+#include "Poco/TemporaryFile.h"
+
+#include <vector>
+
+/**
+ * PythonWorkerPool
+ *
+ * Pool of python interpreter processes running script files,
+ * outside of the embedded interpreter: no GIL shared with the
+ * application, and a crashing script does not take the application
+ * down.
+ *
+ * The data (numbers, strings, vectors, images) are exchanged through
+ * files mapped by both processes, in a memory file system if possible
+ * (/dev/shm). The pipes only carry control lines. For each run, the
+ * worker standard input receives:
+ *  - "MAP <size> <path>" when the input segment file changed
+ *  - "IN <name> <type> <args>" for each input: data position in the
+ *    input segment (offset, sizes and image formats)
+ *  - "OUT <name> <type>" for each output that the script can set
+ *  - "RUN <script path>"
+ *
+ * and the worker answers on its standard output with the lines
+ * "SET <name> <type> <args>" for each output set by the script, the
+ * data being in the result file, then "OK", or "ERR" followed by the
+ * error message. The standard output of the scripts is redirected to
+ * the standard error of the worker.
+ *
+ * In the worker, the instru module is replaced by a minimal shim:
+ * inputNames(), getInput(name), outputNames(), setOutput(name, value)
+ * and DataArray. The input vectors and images are read-only DataArray
+ * of the input segment (buffer and numpy array interface), valid until
+ * the script returns. The output vectors and images can be DataArray,
+ * numpy arrays, or lists for the vectors.
+ *
+ * The workers are started on demand, up to the maximum worker count.
+ * A worker that exits while running a script is discarded. A worker
+ * whose script is cancelled is killed.
+ *
+ * Configuration keys:
+ *  - python.workerExecutable: python interpreter (default: "python")
+ *  - python.workerCount: maximum worker count (default: processor count)
+ *  - python.workerExchangeDirectory: directory of the data exchange
+ *    files (default: /dev/shm if present, else the temporary directory)
+ */
+class PythonWorkerPool: public VerboseEntity
+{
+public:
+    PythonWorkerPool();
+
+    /// Stop the idle workers
+    virtual ~PythonWorkerPool();
+
+    /**
+     * Cancellation check, polled while waiting for a worker
+     * or for the end of the script
+     */
+    class Canceller
+    {
+    public:
+        virtual ~Canceller() { }
+
+        /// return true to abort the script
+        virtual bool cancelRequested() = 0;
+    };
+
+    /**
+     * Receiver of the script outputs
+     */
+    class OutputHandler
+    {
+    public:
+        virtual ~OutputHandler() { }
+
+        /// The script returned: the inputs are not used anymore
+        virtual void releaseInputs() = 0;
+
+        /**
+         * Reserve the given output for writing
+         *
+         * @return the data to write, of the declared type
+         */
+        virtual TypeNeutralData* reserveOutput(const std::string& name) = 0;
+
+        /// The data returned by reserveOutput was written
+        virtual void outputReady(const std::string& name) = 0;
+    };
+
+    /// Script inputs: name and data, kept unchanged during the run
+    typedef std::vector< std::pair<std::string, TypeNeutralData*> > Inputs;
+
+    /// Outputs that the script can set: name and data type
+    typedef std::vector< std::pair<std::string, int> > Outputs;
+
+    /**
+     * Run the given script in a worker process
+     *
+     * Wait for a worker to be available, and for the end of the script.
+     * Then, the outputs set by the script are written through the
+     * handler, before the worker is given back to the pool.
+     *
+     * @param inputs data given to the script
+     * @param outputs declared outputs
+     * @param handler receiver of the outputs, if not NULL
+     * @param canceller polled every pollPeriod ms, if not NULL.
+     * On cancellation, the worker running the script is killed.
+     *
+     * @throw Poco::RuntimeException if the script raised an exception
+     * @throw Poco::IOException if the worker exited while running the script
+     * @throw Poco::DataFormatException if an input or output type is
+     * not supported
+     * @throw ExecutionAbortedException if cancelled
+     */
+    void runScript(const std::string& scriptPath,
+            const Inputs& inputs, const Outputs& outputs,
+            OutputHandler* handler = NULL, Canceller* canceller = NULL);
+
+    /// Application-wide pool
+    static PythonWorkerPool& instance();
+
+private:
+    /// Worker process, with its control pipes and exchange files
+    struct Worker
+    {
+        Worker(const Poco::ProcessHandle& processHandle,
+                const Poco::Pipe& inPipe, const Poco::Pipe& outPipe,
+                Poco::SharedPtr<Poco::TemporaryFile> result):
+            handle(processHandle), toWorker(inPipe), fromWorker(outPipe),
+            segmentSize(0), resultFile(result) { }
+
+        Poco::ProcessHandle handle;
+        Poco::Pipe toWorker; ///< standard input of the worker
+        Poco::Pipe fromWorker; ///< standard output of the worker
+        std::string received; ///< received bytes, not yet read as a line
+
+        Poco::SharedPtr<Poco::TemporaryFile> segmentFile; ///< input segment
+        Poco::SharedMemory segment; ///< mapping of segmentFile
+        size_t segmentSize; ///< 0 if no segment yet
+        std::string mapRequest; ///< MAP line not yet sent to the worker
+
+        /// previous input segments, until the worker maps the new one
+        std::vector< Poco::SharedPtr<Poco::TemporaryFile> > retiredFiles;
+
+        Poco::SharedPtr<Poco::TemporaryFile> resultFile; ///< written by the worker
+    };
+
+    /// Cancellation polling period, in ms
+    static const long pollPeriod = 50;
+
+    /**
+     * Copy the inputs into the input segment of the worker
+     *
+     * The segment is replaced by a larger one if needed.
+     *
+     * @return the IN request lines
+     */
+    std::string writeInputs(Worker* worker, const Inputs& inputs);
+
+    /**
+     * Write the outputs given by the SET reply lines
+     *
+     * The result file is mapped during the copy.
+     */
+    void readOutputs(Worker* worker, const std::vector<std::string>& settings,
+            const Outputs& outputs, OutputHandler* handler);
+
+    /**
+     * Get an idle worker, or start a new one
+     *
+     * @return NULL if cancelled
+     */
+    Worker* acquire(Canceller* canceller);
+
+    /**
+     * Write a line to the worker
+     *
+     * @throw Poco::WriteFileException if the worker exited
+     */
+    void writeLine(Worker* worker, const std::string& line);
+
+    /**
+     * Read a line from the worker
+     *
+     * @return false if cancelled
+     * @throw Poco::IOException if the worker exited
+     */
+    bool readLine(Worker* worker, std::string& line, Canceller* canceller);
+
+    /// Wait at most timeout ms for the worker output to be readable
+    static bool waitReadable(Worker* worker, long timeout);
+
+    /**
+     * Give the worker back to the pool
+     *
+     * @param broken the worker is not usable anymore: kill it
+     */
+    void release(Worker* worker, bool broken);
+
+    /// Start a new worker process
+    Worker* spawn();
+
+    std::string executable; ///< python interpreter
+    std::string exchangeDir; ///< directory of the exchange files
+    size_t maxWorkerCount;
+    size_t workerCount; ///< idle and busy workers
+    std::vector<Worker*> idleWorkers;
+
+    Poco::Mutex mutex;
+    Poco::Condition workerReleased;
+};
+
+#endif /* HAVE_PYTHON27 */
+#endif /* SRC_MODULES_EXTERN_PYTHONWORKERPOOL_H_ */
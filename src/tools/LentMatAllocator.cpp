@@ -0,0 +1,76 @@
+/**
+ * @file	src/tools/LentMatAllocator.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+
+#include "LentMatAllocator.h"
+
+void LentMatAllocator::lend(char* pixels, size_t size,
+        int rows, int cols, int type, cv::Mat& img, void* userdata) const
+{
+    cv::UMatData* u = new cv::UMatData(this);
+    u->data = u->origdata = reinterpret_cast<uchar*>(pixels);
+    u->size = size;
+    u->userdata = userdata;
+    u->refcount = 1;
+
+    // the owner is only referenced as u->currAllocator. Mat::allocator
+    // is left NULL so that img.create() does not try to use the owner
+    img = cv::Mat(rows, cols, type, pixels);
+    img.u = u;
+
+    duplicate(); // released in deallocate
+}
+
+cv::UMatData* LentMatAllocator::allocate(int dims, const int* sizes, int type,
+        void* data, size_t* step, int flags,
+        cv::UMatUsageFlags usageFlags) const
+{
+    return cv::Mat::getStdAllocator()->allocate(dims, sizes, type,
+            data, step, flags, usageFlags);
+}
+
+bool LentMatAllocator::allocate(cv::UMatData* data, int accessflags,
+        cv::UMatUsageFlags usageFlags) const
+{
+    return cv::Mat::getStdAllocator()->allocate(data, accessflags, usageFlags);
+}
+
+void LentMatAllocator::deallocate(cv::UMatData* u) const
+{
+    if (u == NULL)
+        return;
+
+    void* userdata = u->userdata;
+    delete u;
+
+    reclaim(userdata);
+    release(); // duplicated in lend
+}
+
+#endif /* HAVE_OPENCV */
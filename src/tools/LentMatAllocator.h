@@ -0,0 +1,89 @@
+/**
+ * @file	src/tools/LentMatAllocator.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_TOOLS_LENTMATALLOCATOR_H_
+#define SRC_TOOLS_LENTMATALLOCATOR_H_
+
+#ifdef HAVE_OPENCV
+
+#include "Poco/RefCountedObject.h"
+
+#include "opencv2/core/core.hpp"
+
+/**
+ * LentMatAllocator
+ *
+ * Base class of the owners of a memory lent to the dataflow as cv::Mat,
+ * without copy (e.g. memory mapped file, acquisition buffers).
+ *
+ * Each lent cv::Mat holds a reference to the owner (the owner is the
+ * allocator of the cv::Mat), so that the memory stays valid until
+ * the last cv::Mat referencing it is released. reclaim() is then
+ * called with the user data given to lend().
+ *
+ * The new allocations (e.g. cv::Mat::create on a lent image) use
+ * the standard allocator.
+ */
+class LentMatAllocator: public cv::MatAllocator, public Poco::RefCountedObject
+{
+public:
+    // cv::MatAllocator interface
+    cv::UMatData* allocate(int dims, const int* sizes, int type,
+            void* data, size_t* step, int flags,
+            cv::UMatUsageFlags usageFlags) const;
+    bool allocate(cv::UMatData* data, int accessflags,
+            cv::UMatUsageFlags usageFlags) const;
+    void deallocate(cv::UMatData* data) const;
+
+protected:
+    LentMatAllocator() { }
+    virtual ~LentMatAllocator() { }
+
+    /**
+     * Lend the given memory as a cv::Mat
+     *
+     * @param pixels start of the image data (continuous)
+     * @param size size of the lent memory, at least rows*cols*elemSize
+     * @param rows, cols, type image format
+     * @param[out] img header on the lent memory
+     * @param userdata passed to reclaim()
+     */
+    void lend(char* pixels, size_t size, int rows, int cols, int type,
+            cv::Mat& img, void* userdata = NULL) const;
+
+    /**
+     * Called when the last cv::Mat lent with the given user data
+     * is released
+     *
+     * Can be called from any thread, in any destructor: shall not throw.
+     */
+    virtual void reclaim(void* userdata) const { }
+};
+
+#endif /* HAVE_OPENCV */
+#endif /* SRC_TOOLS_LENTMATALLOCATOR_H_ */
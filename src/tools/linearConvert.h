@@ -0,0 +1,208 @@
+/**
+ * @file	src/tools/linearConvert.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_TOOLS_LINEARCONVERT_H_
+#define SRC_TOOLS_LINEARCONVERT_H_
+
+#include "Poco/Types.h"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// SSE2 is part of x86-64. MSVC does not define __SSE2__
+#if defined(__SSE2__) || defined(_M_X64) \
+        || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LINEARCONVERT_SSE2
+#include <emmintrin.h>
+#endif
+
+/**
+ * Vectorized linear conversion kernel
+ *
+ * Compute dst[i] = src[i] * scale + offset in double precision, the
+ * result being saturated to the destination range and rounded half away
+ * from zero for an integer destination, as the element-wise getters of
+ * LinearConverter and SimpleNumConverter do.
+ *
+ * The generic version does not process anything. The specializations
+ * for the common pairs of int32, float and double are implemented with
+ * SSE2 and process the elements by blocks of 4.
+ *
+ * @return count of processed elements, from the beginning. The
+ * remaining elements have to be converted by the caller.
+ */
+template <typename In, typename Out>
+inline size_t linearConvertKernel(const In* /* src */, Out* /* dst */,
+        size_t /* count */, double /* scale */, double /* offset */)
+{
+    return 0;
+}
+
+/**
+ * Hand the input vector over to the output, for an in-place conversion
+ *
+ * Only vectors of the same element type can exchange their buffers:
+ * the generic version does nothing.
+ *
+ * @return true if the vectors were swapped. The output then holds the
+ * input data, and the input gets the previous output buffer.
+ */
+template <typename In, typename Out>
+inline bool linearConvertSwap(std::vector<In>& /* input */,
+        std::vector<Out>& /* output */)
+{
+    return false;
+}
+
+template <typename T>
+inline bool linearConvertSwap(std::vector<T>& input, std::vector<T>& output)
+{
+    input.swap(output);
+    return true;
+}
+
+#ifdef LINEARCONVERT_SSE2
+
+/// load 4 int32 as 2 x 2 doubles
+inline void linearConvertLoad(const Poco::Int32* src, __m128d& lo, __m128d& hi)
+{
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    lo = _mm_cvtepi32_pd(values);
+    hi = _mm_cvtepi32_pd(_mm_shuffle_epi32(values, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+/// load 4 floats as 2 x 2 doubles
+inline void linearConvertLoad(const float* src, __m128d& lo, __m128d& hi)
+{
+    __m128 values = _mm_loadu_ps(src);
+    lo = _mm_cvtps_pd(values);
+    hi = _mm_cvtps_pd(_mm_movehl_ps(values, values));
+}
+
+/// load 4 doubles as 2 x 2 doubles
+inline void linearConvertLoad(const double* src, __m128d& lo, __m128d& hi)
+{
+    lo = _mm_loadu_pd(src);
+    hi = _mm_loadu_pd(src + 2);
+}
+
+/// store 2 x 2 doubles as 4 doubles
+inline void linearConvertStore(double* dst, __m128d lo, __m128d hi)
+{
+    _mm_storeu_pd(dst, lo);
+    _mm_storeu_pd(dst + 2, hi);
+}
+
+/// store 2 x 2 doubles as 4 floats, saturated to the float range
+inline void linearConvertStore(float* dst, __m128d lo, __m128d hi)
+{
+    // the NaN are kept: _mm_max_pd and _mm_min_pd return the second operand
+    const __m128d minVal = _mm_set1_pd(-std::numeric_limits<float>::max());
+    const __m128d maxVal = _mm_set1_pd(std::numeric_limits<float>::max());
+
+    lo = _mm_min_pd(maxVal, _mm_max_pd(minVal, lo));
+    hi = _mm_min_pd(maxVal, _mm_max_pd(minVal, hi));
+
+    _mm_storeu_ps(dst, _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi)));
+}
+
+/// round half away from zero 2 doubles in the int32 range
+inline __m128i linearConvertRound(__m128d values)
+{
+    __m128i truncated = _mm_cvttpd_epi32(values);
+    __m128d frac = _mm_sub_pd(values, _mm_cvtepi32_pd(truncated));
+
+    // 64-bit masks (-1 if true) moved to the 2 low 32-bit lanes
+    __m128i up = _mm_shuffle_epi32(_mm_castpd_si128(
+            _mm_cmpge_pd(frac, _mm_set1_pd(0.5))), _MM_SHUFFLE(3, 3, 2, 0));
+    __m128i down = _mm_shuffle_epi32(_mm_castpd_si128(
+            _mm_cmple_pd(frac, _mm_set1_pd(-0.5))), _MM_SHUFFLE(3, 3, 2, 0));
+
+    return _mm_add_epi32(_mm_sub_epi32(truncated, up), down);
+}
+
+/// store 2 x 2 doubles as 4 int32, saturated and rounded
+inline void linearConvertStore(Poco::Int32* dst, __m128d lo, __m128d hi)
+{
+    const __m128d minVal = _mm_set1_pd(std::numeric_limits<Poco::Int32>::min());
+    const __m128d maxVal = _mm_set1_pd(std::numeric_limits<Poco::Int32>::max());
+
+    lo = _mm_min_pd(maxVal, _mm_max_pd(minVal, lo));
+    hi = _mm_min_pd(maxVal, _mm_max_pd(minVal, hi));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi64(
+            linearConvertRound(lo), linearConvertRound(hi)));
+}
+
+/**
+ * SSE2 loop shared by the linearConvertKernel specializations
+ */
+template <typename In, typename Out>
+inline size_t linearConvertBlocks(const In* src, Out* dst, size_t count,
+        double scale, double offset)
+{
+    const __m128d scaleVal = _mm_set1_pd(scale);
+    const __m128d offsetVal = _mm_set1_pd(offset);
+
+    size_t index = 0;
+    for ( ; index + 4 <= count; index += 4)
+    {
+        __m128d lo, hi;
+        linearConvertLoad(src + index, lo, hi);
+
+        lo = _mm_add_pd(_mm_mul_pd(lo, scaleVal), offsetVal);
+        hi = _mm_add_pd(_mm_mul_pd(hi, scaleVal), offsetVal);
+
+        linearConvertStore(dst + index, lo, hi);
+    }
+
+    return index;
+}
+
+#define LINEARCONVERT_SSE2_PAIR(In, Out) \
+    template <> \
+    inline size_t linearConvertKernel<In, Out>(const In* src, Out* dst, \
+            size_t count, double scale, double offset) \
+    { return linearConvertBlocks<In, Out>(src, dst, count, scale, offset); }
+
+LINEARCONVERT_SSE2_PAIR(Poco::Int32, Poco::Int32)
+LINEARCONVERT_SSE2_PAIR(Poco::Int32, float)
+LINEARCONVERT_SSE2_PAIR(Poco::Int32, double)
+LINEARCONVERT_SSE2_PAIR(float, Poco::Int32)
+LINEARCONVERT_SSE2_PAIR(float, float)
+LINEARCONVERT_SSE2_PAIR(float, double)
+LINEARCONVERT_SSE2_PAIR(double, Poco::Int32)
+LINEARCONVERT_SSE2_PAIR(double, float)
+LINEARCONVERT_SSE2_PAIR(double, double)
+
+#undef LINEARCONVERT_SSE2_PAIR
+
+#endif /* LINEARCONVERT_SSE2 */
+
+#endif /* SRC_TOOLS_LINEARCONVERT_H_ */
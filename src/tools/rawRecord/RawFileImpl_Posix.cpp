@@ -0,0 +1,203 @@
+/**
+ * @file	src/tools/rawRecord/RawFileImpl_Posix.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef __unix__
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // O_DIRECT
+#endif
+
+#include "RawFileImpl_Posix.h"
+
+#include "Poco/Exception.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <string.h> // strerror
+#include <stdlib.h> // posix_memalign
+
+RawFileImpl::RawFileImpl():
+    fd(-1)
+{
+    // nothing to do
+}
+
+RawFileImpl::~RawFileImpl()
+{
+    try
+    {
+        close();
+    }
+    catch (Poco::IOException&)
+    {
+        // nothing to do
+    }
+}
+
+bool RawFileImpl::create(std::string path, bool directIO)
+{
+    if (isOpen())
+        close();
+
+    filePath = path;
+    bool direct = false;
+
+#ifdef O_DIRECT
+    if (directIO)
+    {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        direct = (fd >= 0);
+    }
+#endif
+
+    if (fd < 0)
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+        throw Poco::CreateFileException(path, strerror(errno));
+
+#ifdef F_NOCACHE
+    // Mac OS X equivalent of O_DIRECT
+    if (directIO && fcntl(fd, F_NOCACHE, 1) == 0)
+        direct = true;
+#endif
+
+    return direct;
+}
+
+void RawFileImpl::close()
+{
+    if (fd < 0)
+        return;
+
+    int ret = ::close(fd);
+    fd = -1;
+
+    if (ret < 0)
+        throw Poco::WriteFileException(filePath, strerror(errno));
+}
+
+void RawFileImpl::writeAt(const char* buffer, size_t size, Poco::UInt64 offset)
+{
+    while (size)
+    {
+        ssize_t written = ::pwrite(fd, buffer, size, static_cast<off_t>(offset));
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            throw Poco::WriteFileException(filePath, strerror(errno));
+        }
+
+        buffer += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<Poco::UInt64>(written);
+    }
+}
+
+void RawFileImpl::preallocate(Poco::UInt64 size)
+{
+#ifdef __linux__
+    int ret = posix_fallocate(fd, 0, static_cast<off_t>(size));
+    if (ret)
+        throw Poco::WriteFileException(filePath,
+                std::string("preallocation: ") + strerror(ret));
+#endif
+}
+
+void RawFileImpl::truncate(Poco::UInt64 size)
+{
+    if (::ftruncate(fd, static_cast<off_t>(size)) < 0)
+        throw Poco::WriteFileException(filePath, strerror(errno));
+}
+
+char* RawFileImpl::allocAligned(size_t size)
+{
+    void* ptr = NULL;
+    if (posix_memalign(&ptr, directAlignment(), size))
+        throw Poco::OutOfMemoryException("RawFileImpl::allocAligned");
+
+    return reinterpret_cast<char*>(ptr);
+}
+
+void RawFileImpl::freeAligned(char* buffer)
+{
+    free(buffer);
+}
+
+char* RawFileImpl::mapCopyOnWrite(std::string path, Poco::UInt64& size)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw Poco::OpenFileException(path, strerror(errno));
+
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+    {
+        int err = errno;
+        ::close(fd);
+        throw Poco::OpenFileException(path, strerror(err));
+    }
+
+    size = static_cast<Poco::UInt64>(st.st_size);
+    if (size == 0)
+    {
+        ::close(fd);
+        return NULL;
+    }
+
+    if (size != static_cast<size_t>(size))
+    {
+        ::close(fd);
+        throw Poco::OpenFileException(path, "file too large to be mapped");
+    }
+
+    // the mapping stays valid once the descriptor is closed
+    void* ptr = mmap(NULL, static_cast<size_t>(size),
+            PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    ::close(fd);
+
+    if (ptr == MAP_FAILED)
+        throw Poco::OpenFileException(path, strerror(err));
+
+    return reinterpret_cast<char*>(ptr);
+}
+
+void RawFileImpl::unmap(char* data, Poco::UInt64 size)
+{
+    if (data)
+        munmap(data, static_cast<size_t>(size));
+}
+
+#endif /* __unix__ */
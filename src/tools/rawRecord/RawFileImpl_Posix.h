@@ -0,0 +1,109 @@
+/**
+ * @file	src/tools/rawRecord/RawFileImpl_Posix.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_RAWFILEIMPL_POSIX_H_
+#define SRC_RAWFILEIMPL_POSIX_H_
+
+#ifdef __unix__
+
+#include "Poco/Types.h"
+
+#include <string>
+
+/**
+ * RawFileImpl
+ *
+ * Implementation of the raw record file access (POSIX systems)
+ *
+ * Positional writes on a file descriptor, optionally bypassing the
+ * page cache (O_DIRECT, Linux only). With direct I/O, the buffers,
+ * the sizes and the offsets shall be aligned on directAlignment().
+ */
+class RawFileImpl
+{
+public:
+    RawFileImpl();
+    virtual ~RawFileImpl();
+
+    /**
+     * Create (or truncate) the file for writing
+     *
+     * @param directIO try to bypass the page cache
+     * @return true if the page cache is effectively bypassed
+     */
+    bool create(std::string path, bool directIO);
+
+    /// Close the file
+    void close();
+
+    bool isOpen() { return fd >= 0; }
+
+    /// Write the whole buffer at the given offset
+    void writeAt(const char* buffer, size_t size, Poco::UInt64 offset);
+
+    /**
+     * Reserve the disk space
+     *
+     * Only supported on Linux. Ignored elsewhere.
+     */
+    void preallocate(Poco::UInt64 size);
+
+    /// Set the file size
+    void truncate(Poco::UInt64 size);
+
+    /// Alignment required by the direct I/O
+    static size_t directAlignment() { return 4096; }
+
+    /// Allocate a buffer aligned on directAlignment()
+    static char* allocAligned(size_t size);
+
+    /// Free a buffer allocated by allocAligned
+    static void freeAligned(char* buffer);
+
+    /**
+     * Map the whole given file in memory, copy-on-write
+     *
+     * The mapped memory can be modified: the modified pages are
+     * private to the process, the file is never written.
+     *
+     * @param[out] size file size, mapping size
+     * @return mapping start, NULL if the file is empty
+     * @throw Poco::OpenFileException if the file can not be mapped
+     */
+    static char* mapCopyOnWrite(std::string path, Poco::UInt64& size);
+
+    /// Unmap a mapping returned by mapCopyOnWrite
+    static void unmap(char* data, Poco::UInt64 size);
+
+private:
+    int fd; ///< file descriptor
+    std::string filePath;
+};
+
+#endif /* __unix__ */
+#endif /* SRC_RAWFILEIMPL_POSIX_H_ */
@@ -0,0 +1,202 @@
+/**
+ * @file	src/tools/rawRecord/RawFileImpl_Win32.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef WIN32
+
+#include "RawFileImpl_Win32.h"
+
+#include "Poco/Exception.h"
+#include "Poco/NumberFormatter.h"
+
+#include <malloc.h> // _aligned_malloc
+
+RawFileImpl::RawFileImpl():
+    hFile(INVALID_HANDLE_VALUE)
+{
+    // nothing to do
+}
+
+RawFileImpl::~RawFileImpl()
+{
+    try
+    {
+        close();
+    }
+    catch (Poco::IOException&)
+    {
+        // nothing to do
+    }
+}
+
+bool RawFileImpl::create(std::string path, bool directIO)
+{
+    if (isOpen())
+        close();
+
+    filePath = path;
+
+    DWORD flags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN;
+    if (directIO)
+        flags |= FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH;
+
+    hFile = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ,
+            NULL, CREATE_ALWAYS, flags, NULL);
+
+    if (hFile == INVALID_HANDLE_VALUE)
+        throw Poco::CreateFileException(path,
+                "error " + Poco::NumberFormatter::format(GetLastError()));
+
+    return directIO;
+}
+
+void RawFileImpl::close()
+{
+    if (hFile == INVALID_HANDLE_VALUE)
+        return;
+
+    BOOL ret = CloseHandle(hFile);
+    hFile = INVALID_HANDLE_VALUE;
+
+    if (!ret)
+        throw Poco::WriteFileException(filePath,
+                "error " + Poco::NumberFormatter::format(GetLastError()));
+}
+
+void RawFileImpl::writeAt(const char* buffer, size_t size, Poco::UInt64 offset)
+{
+    while (size)
+    {
+        OVERLAPPED overlapped;
+        memset(&overlapped, 0, sizeof(overlapped));
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        // WriteFile is limited to 4GB per call
+        DWORD toWrite = (size > 0x40000000) ? 0x40000000 : static_cast<DWORD>(size);
+        DWORD written = 0;
+
+        if (!WriteFile(hFile, buffer, toWrite, &written, &overlapped))
+            throw Poco::WriteFileException(filePath,
+                    "error " + Poco::NumberFormatter::format(GetLastError()));
+
+        buffer += written;
+        size -= written;
+        offset += written;
+    }
+}
+
+void RawFileImpl::preallocate(Poco::UInt64 size)
+{
+    // the file is extended without writing the data
+    truncate(size);
+}
+
+void RawFileImpl::truncate(Poco::UInt64 size)
+{
+    LARGE_INTEGER pos;
+    pos.QuadPart = static_cast<LONGLONG>(size);
+
+    if (!SetFilePointerEx(hFile, pos, NULL, FILE_BEGIN) || !SetEndOfFile(hFile))
+        throw Poco::WriteFileException(filePath,
+                "error " + Poco::NumberFormatter::format(GetLastError()));
+}
+
+char* RawFileImpl::allocAligned(size_t size)
+{
+    void* ptr = _aligned_malloc(size, directAlignment());
+    if (ptr == NULL)
+        throw Poco::OutOfMemoryException("RawFileImpl::allocAligned");
+
+    return reinterpret_cast<char*>(ptr);
+}
+
+void RawFileImpl::freeAligned(char* buffer)
+{
+    _aligned_free(buffer);
+}
+
+char* RawFileImpl::mapCopyOnWrite(std::string path, Poco::UInt64& size)
+{
+    HANDLE hMapFile = CreateFileA(path.c_str(), GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (hMapFile == INVALID_HANDLE_VALUE)
+        throw Poco::OpenFileException(path,
+                "error " + Poco::NumberFormatter::format(GetLastError()));
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hMapFile, &fileSize))
+    {
+        DWORD err = GetLastError();
+        CloseHandle(hMapFile);
+        throw Poco::OpenFileException(path,
+                "error " + Poco::NumberFormatter::format(err));
+    }
+
+    size = static_cast<Poco::UInt64>(fileSize.QuadPart);
+    if (size == 0)
+    {
+        CloseHandle(hMapFile);
+        return NULL;
+    }
+
+    if (size != static_cast<SIZE_T>(size))
+    {
+        CloseHandle(hMapFile);
+        throw Poco::OpenFileException(path, "file too large to be mapped");
+    }
+
+    HANDLE hMapping = CreateFileMappingA(hMapFile, NULL, PAGE_WRITECOPY,
+            0, 0, NULL);
+    DWORD err = GetLastError();
+    CloseHandle(hMapFile);
+
+    if (hMapping == NULL)
+        throw Poco::OpenFileException(path,
+                "error " + Poco::NumberFormatter::format(err));
+
+    // the view keeps the mapping object alive
+    void* ptr = MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0);
+    err = GetLastError();
+    CloseHandle(hMapping);
+
+    if (ptr == NULL)
+        throw Poco::OpenFileException(path,
+                "error " + Poco::NumberFormatter::format(err));
+
+    return reinterpret_cast<char*>(ptr);
+}
+
+void RawFileImpl::unmap(char* data, Poco::UInt64 size)
+{
+    if (data)
+        UnmapViewOfFile(data);
+}
+
+#endif /* WIN32 */
@@ -0,0 +1,106 @@
+/**
+ * @file	src/tools/rawRecord/RawFileImpl_Win32.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_RAWFILEIMPL_WIN32_H_
+#define SRC_RAWFILEIMPL_WIN32_H_
+
+#ifdef WIN32
+
+#include "Poco/Types.h"
+#include "Poco/UnWindows.h"
+
+#include <string>
+
+/**
+ * RawFileImpl
+ *
+ * Implementation of the raw record file access (Windows)
+ *
+ * Positional writes on a file handle, optionally bypassing the
+ * system cache (FILE_FLAG_NO_BUFFERING). With direct I/O, the buffers,
+ * the sizes and the offsets shall be aligned on directAlignment().
+ */
+class RawFileImpl
+{
+public:
+    RawFileImpl();
+    virtual ~RawFileImpl();
+
+    /**
+     * Create (or truncate) the file for writing
+     *
+     * @param directIO bypass the system cache
+     * @return true if the system cache is effectively bypassed
+     */
+    bool create(std::string path, bool directIO);
+
+    /// Close the file
+    void close();
+
+    bool isOpen() { return hFile != INVALID_HANDLE_VALUE; }
+
+    /// Write the whole buffer at the given offset
+    void writeAt(const char* buffer, size_t size, Poco::UInt64 offset);
+
+    /// Reserve the disk space
+    void preallocate(Poco::UInt64 size);
+
+    /// Set the file size
+    void truncate(Poco::UInt64 size);
+
+    /// Alignment required by the direct I/O
+    static size_t directAlignment() { return 4096; }
+
+    /// Allocate a buffer aligned on directAlignment()
+    static char* allocAligned(size_t size);
+
+    /// Free a buffer allocated by allocAligned
+    static void freeAligned(char* buffer);
+
+    /**
+     * Map the whole given file in memory, copy-on-write
+     *
+     * The mapped memory can be modified: the modified pages are
+     * private to the process, the file is never written.
+     *
+     * @param[out] size file size, mapping size
+     * @return mapping start, NULL if the file is empty
+     * @throw Poco::OpenFileException if the file can not be mapped
+     */
+    static char* mapCopyOnWrite(std::string path, Poco::UInt64& size);
+
+    /// Unmap a mapping returned by mapCopyOnWrite
+    static void unmap(char* data, Poco::UInt64 size);
+
+private:
+    HANDLE hFile;
+    std::string filePath;
+};
+
+#endif /* WIN32 */
+#endif /* SRC_RAWFILEIMPL_WIN32_H_ */
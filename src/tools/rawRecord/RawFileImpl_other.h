@@ -0,0 +1,89 @@
+/**
+ * @file	src/tools/rawRecord/RawFileImpl_other.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_RAWFILEIMPL_OTHER_H_
+#define SRC_RAWFILEIMPL_OTHER_H_
+
+#ifndef __unix__
+#ifndef WIN32
+
+#include "Poco/Types.h"
+#include "Poco/Exception.h"
+
+#include <string>
+#include <cstdlib>
+
+/**
+ * RawFileImpl
+ *
+ * (non-)Implementation of the raw record file access (unknown system)
+ */
+class RawFileImpl
+{
+public:
+    RawFileImpl() { }
+    virtual ~RawFileImpl() { }
+
+    bool create(std::string path, bool directIO)
+    {
+        throw Poco::NotImplementedException(
+            "RawRecordWriter is not implemented "
+            "for this platform");
+    }
+
+    void close() { }
+
+    bool isOpen() { return false; }
+
+    void writeAt(const char* buffer, size_t size, Poco::UInt64 offset) { }
+
+    void preallocate(Poco::UInt64 size) { }
+
+    void truncate(Poco::UInt64 size) { }
+
+    static size_t directAlignment() { return 4096; }
+
+    static char* allocAligned(size_t size)
+        { return reinterpret_cast<char*>(std::malloc(size)); }
+
+    static void freeAligned(char* buffer)
+        { std::free(buffer); }
+
+    static char* mapCopyOnWrite(std::string path, Poco::UInt64& size)
+    {
+        throw Poco::NotImplementedException(
+            "RawRecordMap is not implemented "
+            "for this platform");
+    }
+
+    static void unmap(char* data, Poco::UInt64 size) { }
+};
+
+#endif /* WIN32 */
+#endif /* __unix__ */
+#endif /* SRC_RAWFILEIMPL_OTHER_H_ */
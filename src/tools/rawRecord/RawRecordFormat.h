@@ -0,0 +1,106 @@
+/**
+ * @file	src/tools/rawRecord/RawRecordFormat.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_TOOLS_RAWRECORD_RAWRECORDFORMAT_H_
+#define SRC_TOOLS_RAWRECORD_RAWRECORDFORMAT_H_
+
+#include "Poco/Types.h"
+
+/**
+ * @file
+ * Raw frame container file format
+ *
+ * Written by RawRecordWriter, read by RawRecordMap. The numbers are
+ * stored in the native byte order (little endian on the supported platforms).
+ *
+ *  - file header (RawRecordFileHeader), padded to RAWREC_HEADER_SIZE bytes
+ *  - records, each one aligned on RawRecordFileHeader::alignment bytes:
+ *     - record header (RawRecordHeader)
+ *     - metaCount UInt64 metadata words: the data attribute as
+ *     [count, data indexes..., count, sequences..., count,
+ *     starting sequences..., count, ending sequences...]
+ *     - pixel data at dataOffset from the record start, the rows
+ *     being contiguous
+ *     - padding
+ *  - index: frameCount RawRecordIndexEntry
+ *  - trailer (RawRecordTrailer), at the very end of the file
+ *
+ * The index offset and the frame count are also written in the file
+ * header when the file is closed. If the file was not closed (0 in the
+ * header), the records can still be read sequentially.
+ */
+
+/// File header size, the first record begins at this offset
+#define RAWREC_HEADER_SIZE 4096
+#define RAWREC_VERSION 1
+
+#define RAWREC_FILE_MAGIC "IARAWREC"
+#define RAWREC_TRAILER_MAGIC "IARAWEND"
+#define RAWREC_RECORD_MAGIC 0x46524149 // "IARF"
+
+/// File header, at offset 0
+struct RawRecordFileHeader
+{
+    char magic[8]; ///< RAWREC_FILE_MAGIC
+    Poco::UInt32 version; ///< RAWREC_VERSION
+    Poco::UInt32 alignment; ///< record alignment in bytes
+    Poco::UInt64 indexOffset; ///< 0 if the file was not closed
+    Poco::UInt64 frameCount; ///< 0 if the file was not closed
+};
+
+/// Record header
+struct RawRecordHeader
+{
+    Poco::UInt32 magic; ///< RAWREC_RECORD_MAGIC
+    Poco::UInt32 metaCount; ///< number of UInt64 metadata words
+    Poco::UInt64 recordSize; ///< total record size, padding included
+    Poco::UInt64 frameIndex; ///< record number, from 0
+    Poco::UInt64 timestamp; ///< host time of the recording, in ns
+    Poco::Int32 rows; ///< image rows
+    Poco::Int32 cols; ///< image columns
+    Poco::Int32 type; ///< image type (cv::Mat::type())
+    Poco::UInt32 dataOffset; ///< pixel data offset from the record start
+    Poco::UInt64 dataSize; ///< pixel data size in bytes
+};
+
+/// Index entry
+struct RawRecordIndexEntry
+{
+    Poco::UInt64 offset; ///< record offset in the file
+    Poco::UInt64 timestamp; ///< see RawRecordHeader::timestamp
+};
+
+/// File trailer, written after the index
+struct RawRecordTrailer
+{
+    Poco::UInt64 indexOffset;
+    Poco::UInt64 frameCount;
+    char magic[8]; ///< RAWREC_TRAILER_MAGIC
+};
+
+#endif /* SRC_TOOLS_RAWRECORD_RAWRECORDFORMAT_H_ */
@@ -0,0 +1,184 @@
+/**
+ * @file	src/tools/rawRecord/RawRecordMap.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+
+#include "RawRecordMap.h"
+
+#ifdef WIN32
+#  include "RawFileImpl_Win32.h"
+#else /* WIN32 */
+#  ifdef __unix__
+#    include "RawFileImpl_Posix.h"
+#  else
+#    include "RawFileImpl_other.h"
+#  endif /* __unix__ */
+#endif /* WIN32 */
+
+#include "Poco/Exception.h"
+#include "Poco/NumberFormatter.h"
+
+#include <cstring>
+
+RawRecordMap::RawRecordMap(std::string path):
+    filePath(path),
+    data(NULL), size(0),
+    hasIndex(false)
+{
+    // copy-on-write: the consumers can modify the lent frames in place
+    data = RawFileImpl::mapCopyOnWrite(path, size);
+
+    try
+    {
+        init();
+    }
+    catch (...)
+    {
+        RawFileImpl::unmap(data, size);
+        throw;
+    }
+}
+
+RawRecordMap::~RawRecordMap()
+{
+    RawFileImpl::unmap(data, size);
+}
+
+void RawRecordMap::init()
+{
+    RawRecordFileHeader header;
+    if (size < RAWREC_HEADER_SIZE)
+        throw Poco::DataFormatException(filePath, "file too small");
+
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, RAWREC_FILE_MAGIC, sizeof(header.magic)))
+        throw Poco::DataFormatException(filePath, "not a raw record file");
+
+    if (header.version != RAWREC_VERSION)
+        throw Poco::DataFormatException(filePath, "unsupported version: "
+                + Poco::NumberFormatter::format(header.version));
+
+    hasIndex = readIndex();
+    if (!hasIndex)
+        scanRecords();
+}
+
+bool RawRecordMap::readIndex()
+{
+    RawRecordFileHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    Poco::UInt64 indexOffset = header.indexOffset;
+    Poco::UInt64 count = header.frameCount;
+
+    // the header is written last: fall back to the trailer
+    if (indexOffset == 0 && size >= RAWREC_HEADER_SIZE + sizeof(RawRecordTrailer))
+    {
+        RawRecordTrailer trailer;
+        memcpy(&trailer, data + size - sizeof(trailer), sizeof(trailer));
+
+        if (memcmp(trailer.magic, RAWREC_TRAILER_MAGIC, sizeof(trailer.magic)) == 0)
+        {
+            indexOffset = trailer.indexOffset;
+            count = trailer.frameCount;
+        }
+    }
+
+    if (indexOffset < RAWREC_HEADER_SIZE || indexOffset > size
+            || count > (size - indexOffset) / sizeof(RawRecordIndexEntry))
+        return false;
+
+    index.resize(static_cast<size_t>(count));
+    if (count)
+        memcpy(&index[0], data + indexOffset,
+                static_cast<size_t>(count) * sizeof(RawRecordIndexEntry));
+
+    return true;
+}
+
+void RawRecordMap::scanRecords()
+{
+    Poco::UInt64 offset = RAWREC_HEADER_SIZE;
+
+    while (offset + sizeof(RawRecordHeader) <= size)
+    {
+        RawRecordHeader header;
+        memcpy(&header, data + offset, sizeof(header));
+
+        // end of the written data (e.g. zeros of the preallocation)
+        if (header.magic != RAWREC_RECORD_MAGIC || header.recordSize == 0
+                || header.recordSize > size - offset)
+            break;
+
+        RawRecordIndexEntry entry;
+        entry.offset = offset;
+        entry.timestamp = header.timestamp;
+        index.push_back(entry);
+
+        offset += header.recordSize;
+    }
+}
+
+Poco::UInt64 RawRecordMap::timestamp(size_t frame)
+{
+    if (frame >= index.size())
+        throw Poco::RangeException(filePath, "frame index out of range");
+
+    return index[frame].timestamp;
+}
+
+void RawRecordMap::wrap(size_t frame, cv::Mat& img)
+{
+    if (frame >= index.size())
+        throw Poco::RangeException(filePath, "frame index out of range");
+
+    Poco::UInt64 offset = index[frame].offset;
+    if (offset + sizeof(RawRecordHeader) > size)
+        throw Poco::DataFormatException(filePath, "truncated record #"
+                + Poco::NumberFormatter::format(frame));
+
+    RawRecordHeader header;
+    memcpy(&header, data + offset, sizeof(header));
+
+    if (header.magic != RAWREC_RECORD_MAGIC
+            || header.dataOffset + header.dataSize > header.recordSize
+            || header.recordSize > size - offset
+            || header.rows < 0 || header.cols < 0
+            || static_cast<Poco::UInt64>(header.rows) * header.cols
+                    * CV_ELEM_SIZE(header.type) != header.dataSize)
+        throw Poco::DataFormatException(filePath, "corrupted record #"
+                + Poco::NumberFormatter::format(frame));
+
+    char* pixels = data + offset + header.dataOffset;
+
+    lend(pixels, static_cast<size_t>(header.dataSize),
+            header.rows, header.cols, header.type, img);
+}
+
+#endif /* HAVE_OPENCV */
@@ -0,0 +1,114 @@
+/**
+ * @file	src/tools/rawRecord/RawRecordMap.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_TOOLS_RAWRECORD_RAWRECORDMAP_H_
+#define SRC_TOOLS_RAWRECORD_RAWRECORDMAP_H_
+
+#ifdef HAVE_OPENCV
+
+#include "RawRecordFormat.h"
+
+#include "tools/LentMatAllocator.h"
+
+#include "opencv2/core/core.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * RawRecordMap
+ *
+ * Copy-on-write memory mapping of a raw frame container file.
+ * @see RawRecordFormat.h
+ *
+ * The frames are lent as cv::Mat headers pointing into the mapping,
+ * without copy: the data is read from the page cache when accessed.
+ * Each lent cv::Mat holds a reference to the mapping (see
+ * LentMatAllocator), so that the file stays mapped until the last
+ * frame is released.
+ *
+ * The lent images can be modified in place: the modified pages are
+ * copied in the process memory, the file is never written. The
+ * modification is seen by the other images lent on the same frame
+ * while the mapping is alive, as for any shared cv::Mat.
+ *
+ * If the file was not closed properly (no index), the records are
+ * scanned sequentially at the opening.
+ */
+class RawRecordMap: public LentMatAllocator
+{
+public:
+    /**
+     * Map the given container file and load its index
+     *
+     * @throw Poco::FileException if the file can not be mapped
+     * @throw Poco::DataFormatException if this is not a container file
+     */
+    RawRecordMap(std::string path);
+
+    std::string path() { return filePath; }
+
+    size_t frameCount() { return index.size(); }
+
+    /// false if the index was rebuilt by scanning the records
+    bool indexed() { return hasIndex; }
+
+    /// recording time of the given frame, in ns
+    Poco::UInt64 timestamp(size_t frame);
+
+    /**
+     * Lend the given frame
+     *
+     * @throw Poco::RangeException if the frame index is out of range
+     * @throw Poco::DataFormatException if the record is corrupted
+     */
+    void wrap(size_t frame, cv::Mat& img);
+
+protected:
+    ~RawRecordMap();
+
+private:
+    /// check the file header and load the index
+    void init();
+
+    /// read the index from the file header or from the trailer
+    bool readIndex();
+
+    /// rebuild the index from the records
+    void scanRecords();
+
+    std::string filePath;
+    char* data; ///< mapping start
+    Poco::UInt64 size; ///< file size, mapping size
+
+    std::vector<RawRecordIndexEntry> index;
+    bool hasIndex;
+};
+
+#endif /* HAVE_OPENCV */
+#endif /* SRC_TOOLS_RAWRECORD_RAWRECORDMAP_H_ */
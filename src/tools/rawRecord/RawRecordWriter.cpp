@@ -0,0 +1,394 @@
+/**
+ * @file	src/tools/rawRecord/RawRecordWriter.cpp
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifdef HAVE_OPENCV
+
+#include "RawRecordWriter.h"
+
+#include "Poco/Timestamp.h"
+
+#include <cstring>
+
+/// record alignment when direct I/O is not used (SIMD friendly)
+#define RAWREC_BUFFERED_ALIGNMENT 64
+
+RawRecordWriter::RawRecordWriter():
+    alignment(RAWREC_BUFFERED_ALIGNMENT), direct(false),
+    filling(0), pending(false), fileEnd(0),
+    writerThread("RawRecordWriter"), stopping(false),
+    appendedFrames(0), appendedBytes(0), writtenBytes(0), writeTime(0)
+{
+    for (int ind = 0; ind < 2; ind++)
+    {
+        chunks[ind].data = NULL;
+        chunks[ind].capacity = 0;
+        chunks[ind].used = 0;
+        chunks[ind].fileOffset = 0;
+    }
+}
+
+RawRecordWriter::~RawRecordWriter()
+{
+    try
+    {
+        close();
+    }
+    catch (Poco::Exception&)
+    {
+        // nothing to do
+    }
+
+    for (int ind = 0; ind < 2; ind++)
+        freeAligned(chunks[ind].data);
+}
+
+void RawRecordWriter::allocChunk(Chunk& chunk, size_t capacity)
+{
+    freeAligned(chunk.data);
+    chunk.data = NULL;
+    chunk.capacity = 0;
+
+    chunk.data = allocAligned(capacity);
+    chunk.capacity = capacity;
+}
+
+void RawRecordWriter::open(std::string path, size_t chunkSize,
+        Poco::UInt64 preallocSize, bool directIO)
+{
+    close();
+
+    recordPath = path;
+    direct = create(path, directIO);
+    alignment = direct ? directAlignment() : RAWREC_BUFFERED_ALIGNMENT;
+
+    try
+    {
+        if (preallocSize)
+            preallocate(preallocSize);
+
+        chunkSize = static_cast<size_t>(aligned(chunkSize ? chunkSize : alignment));
+        for (int ind = 0; ind < 2; ind++)
+        {
+            if (chunks[ind].capacity != chunkSize)
+                allocChunk(chunks[ind], chunkSize);
+
+            chunks[ind].used = 0;
+        }
+
+        writeFileHeader(0);
+    }
+    catch (...)
+    {
+        RawFileImpl::close();
+        throw;
+    }
+
+    filling = 0;
+    pending = false;
+    fileEnd = RAWREC_HEADER_SIZE;
+    index.clear();
+
+    stopping = false;
+    writeError = NULL;
+    appendedFrames = 0;
+    appendedBytes = 0;
+    writtenBytes = 0;
+    writeTime = 0;
+
+    writerThread.start(*this);
+}
+
+void RawRecordWriter::append(const cv::Mat& img, Poco::UInt64 timestamp,
+        const std::vector<Poco::UInt64>& meta)
+{
+    if (!isOpen())
+        throw Poco::IllegalStateException("RawRecordWriter",
+                "the container file is not opened");
+
+    checkWriteError();
+
+    size_t rowSize = img.cols * img.elemSize();
+    Poco::UInt64 dataSize = static_cast<Poco::UInt64>(rowSize) * img.rows;
+    size_t dataOffset = static_cast<size_t>(aligned(sizeof(RawRecordHeader)
+            + meta.size() * sizeof(Poco::UInt64)));
+    size_t recordSize = static_cast<size_t>(aligned(dataOffset + dataSize));
+
+    if (chunks[filling].used + recordSize > chunks[filling].capacity)
+    {
+        if (chunks[filling].used)
+            handOver();
+
+        // the filling chunk is not shared with the writer thread
+        if (recordSize > chunks[filling].capacity)
+            allocChunk(chunks[filling], recordSize);
+    }
+
+    Chunk& chunk = chunks[filling];
+    char* record = chunk.data + chunk.used;
+
+    RawRecordHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = RAWREC_RECORD_MAGIC;
+    header.metaCount = static_cast<Poco::UInt32>(meta.size());
+    header.recordSize = recordSize;
+    header.frameIndex = index.size();
+    header.timestamp = timestamp;
+    header.rows = img.rows;
+    header.cols = img.cols;
+    header.type = img.type();
+    header.dataOffset = static_cast<Poco::UInt32>(dataOffset);
+    header.dataSize = dataSize;
+
+    memset(record, 0, dataOffset);
+    memcpy(record, &header, sizeof(header));
+    if (!meta.empty())
+        memcpy(record + sizeof(header), &meta[0],
+                meta.size() * sizeof(Poco::UInt64));
+
+    char* data = record + dataOffset;
+    if (img.isContinuous())
+    {
+        memcpy(data, img.data, static_cast<size_t>(dataSize));
+    }
+    else
+    {
+        for (int row = 0; row < img.rows; row++)
+            memcpy(data + row * rowSize, img.ptr(row), rowSize);
+    }
+
+    memset(data + dataSize, 0, recordSize - dataOffset - static_cast<size_t>(dataSize));
+
+    RawRecordIndexEntry entry;
+    entry.offset = fileEnd + chunk.used;
+    entry.timestamp = timestamp;
+    index.push_back(entry);
+
+    chunk.used += recordSize;
+
+    Poco::Mutex::ScopedLock lock(mutex);
+    appendedFrames++;
+    appendedBytes += recordSize;
+}
+
+void RawRecordWriter::handOver()
+{
+    Poco::Mutex::ScopedLock lock(mutex);
+
+    while (pending && writeError.isNull())
+        chunkDone.wait(mutex);
+
+    if (!writeError.isNull())
+        writeError->rethrow();
+
+    chunks[filling].fileOffset = fileEnd;
+    fileEnd += chunks[filling].used;
+
+    pending = true;
+    filling = 1 - filling;
+    chunks[filling].used = 0;
+
+    chunkDone.broadcast();
+}
+
+void RawRecordWriter::run()
+{
+    while (true)
+    {
+        Chunk* chunk;
+
+        {
+            Poco::Mutex::ScopedLock lock(mutex);
+
+            while (!pending && !stopping)
+                chunkDone.wait(mutex);
+
+            if (!pending)
+                return;
+
+            chunk = &chunks[1 - filling];
+        }
+
+        Poco::Timestamp start;
+        Poco::SharedPtr<Poco::Exception> error;
+
+        try
+        {
+            writeAt(chunk->data, chunk->used, chunk->fileOffset);
+        }
+        catch (Poco::Exception& e)
+        {
+            error = e.clone();
+        }
+
+        Poco::Mutex::ScopedLock lock(mutex);
+
+        writeTime += start.elapsed();
+        if (error.isNull())
+            writtenBytes += chunk->used;
+        else
+            writeError = error;
+
+        pending = false;
+        chunkDone.broadcast();
+
+        if (!writeError.isNull())
+            return;
+    }
+}
+
+void RawRecordWriter::stopWriter()
+{
+    {
+        Poco::Mutex::ScopedLock lock(mutex);
+        stopping = true;
+        chunkDone.broadcast();
+    }
+
+    writerThread.join();
+}
+
+void RawRecordWriter::checkWriteError()
+{
+    Poco::Mutex::ScopedLock lock(mutex);
+
+    if (!writeError.isNull())
+        writeError->rethrow();
+}
+
+void RawRecordWriter::writeFileHeader(Poco::UInt64 indexOffset)
+{
+    char* buffer = allocAligned(RAWREC_HEADER_SIZE);
+    memset(buffer, 0, RAWREC_HEADER_SIZE);
+
+    RawRecordFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RAWREC_FILE_MAGIC, sizeof(header.magic));
+    header.version = RAWREC_VERSION;
+    header.alignment = static_cast<Poco::UInt32>(alignment);
+    header.indexOffset = indexOffset;
+    header.frameCount = indexOffset ? index.size() : 0;
+    memcpy(buffer, &header, sizeof(header));
+
+    try
+    {
+        writeAt(buffer, RAWREC_HEADER_SIZE, 0);
+    }
+    catch (...)
+    {
+        freeAligned(buffer);
+        throw;
+    }
+
+    freeAligned(buffer);
+}
+
+void RawRecordWriter::close()
+{
+    if (!isOpen())
+        return;
+
+    try
+    {
+        if (chunks[filling].used)
+            handOver();
+    }
+    catch (...)
+    {
+        stopWriter();
+        RawFileImpl::close();
+        throw;
+    }
+
+    stopWriter();
+
+    char* buffer = NULL;
+
+    try
+    {
+        checkWriteError();
+
+        // index and trailer
+        size_t indexSize = index.size() * sizeof(RawRecordIndexEntry);
+        size_t footerSize = indexSize + sizeof(RawRecordTrailer);
+        size_t paddedSize = static_cast<size_t>(aligned(footerSize));
+
+        buffer = allocAligned(paddedSize);
+        memset(buffer, 0, paddedSize);
+
+        if (indexSize)
+            memcpy(buffer, &index[0], indexSize);
+
+        RawRecordTrailer trailer;
+        trailer.indexOffset = fileEnd;
+        trailer.frameCount = index.size();
+        memcpy(trailer.magic, RAWREC_TRAILER_MAGIC, sizeof(trailer.magic));
+        memcpy(buffer + indexSize, &trailer, sizeof(trailer));
+
+        writeAt(buffer, paddedSize, fileEnd);
+        freeAligned(buffer);
+        buffer = NULL;
+
+        writeFileHeader(fileEnd);
+
+        // remove the padding and the preallocated space
+        truncate(fileEnd + footerSize);
+    }
+    catch (...)
+    {
+        freeAligned(buffer);
+        RawFileImpl::close();
+        throw;
+    }
+
+    RawFileImpl::close();
+}
+
+Poco::UInt64 RawRecordWriter::framesRecorded()
+{
+    Poco::Mutex::ScopedLock lock(mutex);
+    return appendedFrames;
+}
+
+double RawRecordWriter::throughput()
+{
+    Poco::Mutex::ScopedLock lock(mutex);
+
+    if (writeTime == 0)
+        return 0;
+
+    return static_cast<double>(writtenBytes) / (1024 * 1024)
+            / (static_cast<double>(writeTime) / 1000000);
+}
+
+Poco::UInt64 RawRecordWriter::backlog()
+{
+    Poco::Mutex::ScopedLock lock(mutex);
+    return appendedBytes - writtenBytes;
+}
+
+#endif /* HAVE_OPENCV */
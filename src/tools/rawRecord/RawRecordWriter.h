@@ -0,0 +1,180 @@
+/**
+ * @file	src/tools/rawRecord/RawRecordWriter.h
+ * @date	Oct. 2026
+ * @author	PhRG - opticalp.fr
+ */
+
+/*
+ Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef SRC_TOOLS_RAWRECORD_RAWRECORDWRITER_H_
+#define SRC_TOOLS_RAWRECORD_RAWRECORDWRITER_H_
+
+#ifdef HAVE_OPENCV
+
+#ifdef WIN32
+#  include "RawFileImpl_Win32.h"
+#else /* WIN32 */
+#  ifdef __unix__
+#    include "RawFileImpl_Posix.h"
+#  else
+#    include "RawFileImpl_other.h"
+#  endif /* __unix__ */
+#endif /* WIN32 */
+
+#include "RawRecordFormat.h"
+
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Exception.h"
+#include "Poco/Timestamp.h"
+
+#include "opencv2/core/core.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * RawRecordWriter
+ *
+ * Append raw frames to a single container file.
+ * @see RawRecordFormat.h
+ *
+ * The records are serialized into the filling chunk by append(). When
+ * full, the chunk is handed to the writer thread that writes it with a
+ * single large sequential write, while append() fills the other chunk
+ * (double buffering). append() blocks only if the writer is still
+ * busy with the previous chunk: the disk is then too slow.
+ *
+ * The index and the trailer are written by close().
+ */
+class RawRecordWriter: private RawFileImpl, public Poco::Runnable
+{
+public:
+    RawRecordWriter();
+    virtual ~RawRecordWriter();
+
+    /**
+     * Create the container file and start the writer thread
+     *
+     * @param path file path
+     * @param chunkSize size of each of the two write buffers, in bytes
+     * @param preallocSize disk space to reserve, in bytes. 0 to disable
+     * @param directIO bypass the system cache, if supported
+     */
+    void open(std::string path, size_t chunkSize,
+            Poco::UInt64 preallocSize, bool directIO);
+
+    /**
+     * Append a frame
+     *
+     * The image data is copied: the image can be released
+     * as soon as append returns.
+     *
+     * @param img frame to record
+     * @param timestamp host time in ns
+     * @param meta metadata words
+     * @throw Poco::IOException if the writer thread failed
+     */
+    void append(const cv::Mat& img, Poco::UInt64 timestamp,
+            const std::vector<Poco::UInt64>& meta);
+
+    /**
+     * Flush the buffers, write the index and close the file
+     *
+     * Nothing is done if the file is not opened.
+     */
+    void close();
+
+    bool isOpen() { return RawFileImpl::isOpen(); }
+
+    /// Path of the current (or last) container file
+    std::string path() { return recordPath; }
+
+    /// Count of frames appended since open()
+    Poco::UInt64 framesRecorded();
+
+    /// Mean write throughput since open(), in MB/s
+    double throughput();
+
+    /// Appended data that is not yet written, in bytes
+    Poco::UInt64 backlog();
+
+    /// Writer thread main loop
+    void run();
+
+private:
+    struct Chunk
+    {
+        char* data;
+        size_t capacity;
+        size_t used;
+        Poco::UInt64 fileOffset; ///< where to write the chunk
+    };
+
+    /// Round up to the record alignment
+    Poco::UInt64 aligned(Poco::UInt64 size)
+        { return (size + alignment - 1) / alignment * alignment; }
+
+    /// (Re)allocate the given chunk
+    void allocChunk(Chunk& chunk, size_t capacity);
+
+    /// Hand the filling chunk to the writer thread
+    void handOver();
+
+    /// Stop and join the writer thread
+    void stopWriter();
+
+    /// Write the file header, with the index position if closing
+    void writeFileHeader(Poco::UInt64 indexOffset);
+
+    /// Rethrow the writer thread error, if any
+    void checkWriteError();
+
+    std::string recordPath;
+    size_t alignment; ///< record alignment
+    bool direct; ///< direct I/O is effective
+
+    Chunk chunks[2];
+    int filling; ///< index of the chunk being filled by append()
+    bool pending; ///< the other chunk is being written
+
+    Poco::UInt64 fileEnd; ///< file offset of the filling chunk
+    std::vector<RawRecordIndexEntry> index;
+
+    Poco::Thread writerThread;
+    bool stopping;
+    Poco::Mutex mutex; ///< protect pending, stopping, writeError, stats
+    Poco::Condition chunkDone; ///< pending or stopping changed
+    Poco::SharedPtr<Poco::Exception> writeError;
+
+    Poco::UInt64 appendedFrames;
+    Poco::UInt64 appendedBytes;
+    Poco::UInt64 writtenBytes;
+    Poco::Timestamp::TimeDiff writeTime; ///< time spent in writes, us
+};
+
+#endif /* HAVE_OPENCV */
+#endif /* SRC_TOOLS_RAWRECORD_RAWRECORDWRITER_H_ */
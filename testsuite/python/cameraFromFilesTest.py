@@ -84,8 +84,62 @@ def myMain(baseDir):
     runModule(cam)
     time.sleep(1) 
 
+    logger.detach()
+
+    # image fingerprint: statistics of the delivered image
+    stats = ( Factory("ImageProcFactory").select("analyze")
+              .select("simpleStats").create("fingerprint") )
+    bind(cam.outPort("image"), stats.inPort("image"))
+
+    print("Decode the reference images without read-ahead nor cache")
+    cam.setParameterValue("readAhead", 0)
+    cam.setParameterValue("cacheSize", 0)
+    cam.setParameterValue("files", """001.png
+                                      002.png
+                                      003.png""")
+    reference = []
+    for ind in range(3):
+        runModule(cam)
+        waitAll()
+        reference.append(fingerprint(stats))
+
+    if len(set(reference)) != 3:
+        raise RuntimeError("The reference images should be different")
+
+    print("Replay at 20 images per second, from the decoded image cache")
+    cam.setParameterValue("cacheSize", 256)
+    cam.setParameterValue("readAhead", 2)
+    cam.setParameterValue("replayRate", 20.0)
+    cam.setParameterValue("files", """001.png
+                                      002.png
+                                      003.png""") # restart from 001
+    start = time.time()
+    replayed = []
+    for ind in range(10):
+        runModule(cam)
+        waitAll()
+        replayed.append(fingerprint(stats))
+    elapsed = time.time() - start
+    print("10 images replayed in " + str(elapsed) + "s")
+    if elapsed < 0.4:
+        raise RuntimeError("The replay rate was not respected")
+    cam.setParameterValue("replayRate", 0.0)
+
+    print("Check the replayed images order")
+    for ind in range(10):
+        if replayed[ind] != reference[ind % 3]:
+            raise RuntimeError("Replayed image " + str(ind)
+                               + " is not the file " + str(ind % 3 + 1))
+
+    unbind(stats.inPort("image"))
+
     print("End of script cameraFromFilesTest.py")
     
+def fingerprint(stats):
+    """Statistics of the image delivered to the given simpleStats module"""
+    return tuple([stats.outPort(port).getDataValue()
+                  for port in ["width", "height", "mean", "sigma", "min", "max"]])
+
 # main body    
 import sys
 import os
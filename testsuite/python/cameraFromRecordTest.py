@@ -0,0 +1,154 @@
+# -*- coding: utf-8 -*-
+
+## @file   testsuite/python/cameraFromRecordTest.py
+## @date   oct. 2026
+## @author PhRG - opticalp.fr
+##
+## Test the raw record replay module
+
+#
+# Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+def myMain(baseDir):
+    """Main function. Run the tests. """
+
+    from os.path import join
+    import os
+    import tempfile
+    import time
+
+    print("Test the basic features of the cameraFromRecord module. ")
+    
+    from instru import *
+    
+    fac = Factory("DeviceFactory")
+    print("Retrieved factory: " + fac.name)
+    
+    print("Create modules from CameraFromFilesFactory and CameraFromRecordFactory")
+    try:
+        cam = fac.select("camera").select("fromFiles").create("fakeCam")
+        player = fac.select("camera").select("fromRecord").create("player")
+    except RuntimeError as e:
+        print("Runtime error: {0}".format(e.message))
+        print("OpenCV is probably not present. Exiting. ")
+        exit(0)
+        
+    print("module " + player.name + " created (" + player.internalName + ") ")
+
+    # image fingerprints: statistics of the delivered images
+    analyze = Factory("ImageProcFactory").select("analyze")
+    camStats = analyze.select("simpleStats").create("camFingerprint")
+    bind(cam.outPort("image"), camStats.inPort("image"))
+    playerStats = analyze.select("simpleStats").create("playerFingerprint")
+    bind(player.outPort("image"), playerStats.inPort("image"))
+
+    print("Record 5 images from the fake camera, at 10 images per second")
+    cam.setParameterValues({ 
+        "directory": join(baseDir,"resources"), 
+        "files": "001.png\n002.png",
+        "forceGrayscale": "ON",
+        "replayRate": 10.0 })
+
+    recorder = DataLogger("RawRecordLogger")
+    recFile = join(tempfile.gettempdir(), "cameraFromRecordTest.rec")
+    recorder.setParameterValue("file", recFile)
+    cam.outPort("image").register(recorder)
+
+    recorded = []
+    for ind in range(5):
+        runModule(cam)
+        waitAll()
+        recorded.append(fingerprint(camStats))
+
+    recorder.setParameterValue("file", "") # finalize
+    recorder.detach()
+
+    if recorded[0] == recorded[1]:
+        raise RuntimeError("The recorded images should be different")
+
+    print("Map the record file")
+    player.setParameterValue("file", recFile)
+    frameCount = player.getParameterValue("frameCount")
+    print("frame count: " + str(frameCount))
+    if frameCount != 5:
+        raise RuntimeError("5 frames should have been recorded")
+
+    print("Replay as fast as possible")
+    runModule(player)
+    waitAll()
+    first = player.outPort("timestamp").getDataValue()
+    print("first frame timestamp: " + str(first) + " ns")
+
+    print("Seek to the last frame")
+    player.setParameterValue("position", 4)
+    runModule(player)
+    waitAll()
+    last = player.outPort("timestamp").getDataValue()
+    if last <= first:
+        raise RuntimeError("The timestamps should increase")
+
+    print("Replay following the recorded timestamps, twice faster")
+    player.setParameterValues({ "pacing": "timestamps", "speed": 2.0, "position": 0 })
+    replayed = []
+    start = time.time()
+    for ind in range(5):
+        runModule(player)
+        waitAll()
+        replayed.append(fingerprint(playerStats))
+    elapsed = time.time() - start
+    print("5 images replayed in " + str(elapsed) + "s")
+    if elapsed < 0.15:
+        raise RuntimeError("The recorded timestamps were not respected")
+
+    print("Compare the replayed images to the recorded ones")
+    if replayed != recorded:
+        raise RuntimeError("The replayed images differ from the recorded ones")
+
+    # unmap the record before removing it
+    player.setParameterValue("file", "")
+    os.remove(recFile)
+
+    print("End of script cameraFromRecordTest.py")
+    
+def fingerprint(stats):
+    """Statistics of the image delivered to the given simpleStats module"""
+    return tuple([stats.outPort(port).getDataValue()
+                  for port in ["width", "height", "mean", "sigma", "min", "max"]])
+
+# main body    
+import sys
+import os
+from os.path import dirname
+    
+if len(sys.argv) >= 1:
+    # probably called from InstrumentAll
+    checker = os.path.basename(sys.argv[0])
+    if checker == "instrumentall" or checker == "instrumentall.exe":
+        print("current script: ",os.path.realpath(__file__))
+        
+        baseDir = dirname(dirname(__file__))
+        
+        myMain(baseDir)
+        exit(0)
+
+print("Presumably not called from InstrumentAll >> Exiting...")
+
+exit("This script has to be launched from inside InstrumentAll")
@@ -120,6 +120,31 @@ def myMain(baseDir):
     files = os.listdir(".")
     if files.count("img_02.png")!=1:
         raise RuntimeError("image img_02.png not created")
+
+    print("try SaveImageLogger parallel encoding, with ordered file names")
+    saver.setParameterValues({ 
+        "prefix": "enc_", 
+        "nextIndex": 1, 
+        "workers": 4, 
+        "queueSize": 4, 
+        "compression": 9 })
+
+    for ind in range(1, 9):
+        if files.count("enc_%02d.png" % ind)>0:
+            os.remove("enc_%02d.png" % ind)
+
+    for ind in range(8):
+        runModule(imgGen)
+        waitAll()
+
+    files = os.listdir(".")
+    for ind in range(1, 9):
+        if files.count("enc_%02d.png" % ind)!=1:
+            raise RuntimeError("image enc_%02d.png not created" % ind)
+
+    print("queue depth after waitAll: " + str(saver.getParameterValue("queueDepth")))
+    if saver.getParameterValue("queueDepth") != 0:
+        raise RuntimeError("the encoding queue should be empty")
         
     print("End of script cvMatTest.py")
     
@@ -0,0 +1,122 @@
+# -*- coding: utf-8 -*-
+
+## @file   testsuite/python/dataArrayTest.py
+## @date   oct. 2026
+## @author PhRG - opticalp.fr
+##
+## Test the DataArray access to the port data (buffer protocol)
+
+#
+# Copyright (c) 2026 Ph. Renaud-Goud / Opticalp
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+def myMain(baseDir):
+    """Main function. Run the tests. """
+
+    print("Test the DataArray access to the numeric port data. ")
+
+    from instru import *
+
+    fac = Factory("DataGenFactory")
+    print("Retrieved factory: " + fac.name)
+
+    print("Retrieve a vector generator")
+    vectGen = fac.select("int32Vect").create("vectGen")
+
+    print("prepare the data buffer with range(10)")
+    for value in range(10):
+        vectGen.setParameterValue("value", value)
+
+    print("Run")
+    runModule(vectGen)
+    waitAll()
+
+    array = vectGen.outPort("data").getDataArray()
+    print("DataArray shape: " + str(array.shape) + ", format: " + array.format)
+    if array.shape != (10,) or array.format != "i":
+        raise RuntimeError("Wrong DataArray shape or format")
+
+    if array.tolist() != range(10):
+        raise RuntimeError("Wrong DataArray content")
+
+    import struct
+    view = memoryview(array)
+    if (view.shape != (10,) or not view.readonly
+            or list(struct.unpack("10i", view.tobytes())) != range(10)):
+        raise RuntimeError("Wrong buffer view")
+
+    print("The list access is unchanged: " + str(vectGen.outPort("data").getDataValue()))
+    if vectGen.outPort("data").getDataValue() != range(10):
+        raise RuntimeError("Wrong return value")
+
+    print("Create an image generator")
+    try:
+        imgGen = fac.select("cvMat").create("imgGen")
+    except RuntimeError as e:
+        print("Runtime error: " + str(e))
+        print("OpenCV is probably not present. Exiting. ")
+        return
+
+    imgGen.setParameterValue("value", 127)
+    runModule(imgGen)
+    waitAll()
+
+    image = imgGen.outPort("data").getDataValue()
+    print("Image DataArray shape: " + str(image.shape) + ", format: " + image.format)
+    if image.shape != (640, 1024) or image.format != "B":
+        raise RuntimeError("Wrong image DataArray shape or format")
+
+    pixels = bytearray(memoryview(image).tobytes())
+    print("Image max value: " + str(max(pixels)))
+    if max(pixels) != 127:
+        raise RuntimeError("Wrong image content")
+
+    try:
+        import numpy
+    except ImportError:
+        print("numpy is not present, skipping the numpy test")
+    else:
+        npImage = numpy.asarray(image)
+        print("numpy array: " + str(npImage.shape) + " " + str(npImage.dtype))
+        if npImage.shape != (640, 1024) or npImage.max() != 127:
+            raise RuntimeError("Wrong numpy array")
+
+    print("End of script dataArrayTest.py")
+
+# main body    
+import sys
+import os
+from os.path import dirname
+    
+if len(sys.argv) >= 1:
+    # probably called from InstrumentAll
+    checker = os.path.basename(sys.argv[0])
+    if checker == "instrumentall" or checker == "instrumentall.exe":
+        print("current script: ",os.path.realpath(__file__))
+        
+        baseDir = dirname(dirname(__file__))
+        
+        myMain(baseDir)
+        exit(0)
+
+print("Presumably not called from InstrumentAll >> Exiting...")
+
+exit("This script has to be launched from inside InstrumentAll")
+
@@ -31,6 +31,7 @@ def myMain(baseDir):
     """Main function. Run the tests. """
     
     from os.path import join
+    import time
 
     print("Test the basic features of the data logging system. ")
 
@@ -99,6 +100,44 @@ def myMain(baseDir):
     runModule(mod1)
     waitAll()
 
+    print("Snapshot mode: the 2nd logger releases its source at once")
+    logger1.setSnapshotQueue(4)
+    if logger1.getSnapshotQueue() != 4:
+        raise RuntimeError("the snapshot queue size should be 4")
+
+    runModule(mod1)
+    waitAll()
+
+    print("dropped snapshots: " + str(logger1.droppedSnapshots()))
+    logger1.setSnapshotQueue(0)
+
+    print("Snapshot mode with a slow logger on mod1 output")
+    slowLogger = DataLogger("DataPocoLogger")
+    slowLogger.setParameterValue("delay", 3000) # ms per log() call
+    slowLogger.setSnapshotQueue(1)
+    mod1.outPorts()[0].register(slowLogger)
+
+    # mod1 sends 9 values, every 150 ms. If the source was held during
+    # log(), mod1 would wait 3 s before sending the next value
+    start = time.time()
+    task = runModule(mod1)
+    task.wait()
+    elapsed = time.time() - start
+    print("mod1 done after " + str(elapsed) + "s")
+    if elapsed > 2.5:
+        raise RuntimeError("The source was not released before the end of log()")
+    waitAll()
+
+    # the 1st value is logged at once. The 7 next ones are dropped
+    # (the queue holds one snapshot) while it is logged, the last
+    # one is logged afterwards.
+    dropped = slowLogger.droppedSnapshots()
+    print("dropped snapshots: " + str(dropped))
+    if dropped != 7:
+        raise RuntimeError("7 snapshots should have been dropped, got " + str(dropped))
+
+    removeDataLogger(slowLogger)
+
     print("Detach the 1st logger and re-run")
     logger.detach()
 
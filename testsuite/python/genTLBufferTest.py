@@ -0,0 +1,130 @@
+# -*- coding: utf-8 -*-
+
+## @file   testsuite/python/genTLBufferTest.py
+## @date   Oct. 2026
+## @author PhRG - opticalp.fr
+##
+## Test the GenTL buffer lending of the genicam camera module
+
+#
+# Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+def myMain(binDir):
+    """Main function. Run the tests. """
+
+    from os.path import join, isfile
+
+    print("Test the GenTL buffer lending with the simulated GenTL producer. ")
+
+    from instru import *
+
+    cti = join(binDir, "SimGenTL.cti")
+    if not isfile(cti):
+        print("Test skipped: SimGenTL.cti not found in " + binDir
+              + " (the simulated producer is built with the sim-genTL option)")
+        return
+
+    try:
+        cam = ( Factory("DeviceFactory").select("camera").select("genicam")
+                .select(cti).select("SimInterface").select("SimCam0")
+                .select(join(binDir, "simCam.yml")).create("simCam") )
+    except RuntimeError as e:
+        print("Runtime error: {0}".format(e.message))
+        print("Test skipped: GenICam is probably not present")
+        return
+
+    print("module " + cam.name + " created (" + cam.internalName + ") ")
+
+    print("bufferCount has to be strictly positive")
+    if cam.getParameterValue("bufferCount") != 4:
+        raise RuntimeError("The default bufferCount should be 4")
+    try:
+        cam.setParameterValue("bufferCount", 0)
+    except RuntimeError:
+        print("bufferCount 0 refused, as expected")
+    else:
+        raise RuntimeError("bufferCount 0 should be refused")
+
+    cam.setParameterValue("bufferCount", 2)
+    cam.setParameterValue("PixelFormat", "Mono8")
+
+    print("Hold 8 images with 2 buffers: the images are compared")
+    print("when they are delivered and once they are all held")
+    seqGen = Factory("DataGenFactory").select("seq").create("seqGen")
+    seqGen.setParameterValue("seqSize", 8)
+    bind(seqGen.outPort("data"), cam.inPort("trig"))
+
+    dataShaping = Factory("ControlFactory").select("dataShaping")
+    analyze = Factory("ImageProcFactory").select("analyze")
+
+    # mean of each image, when delivered
+    direct = analyze.select("simpleStats").create("directStats")
+    bind(cam.outPort("image"), direct.inPort("image"))
+    directMeans = dataShaping.select("accu").select("dblFloat").create("directMeans")
+    bind(direct.outPort("mean"), directMeans.inPort("elements"))
+    seqBind(seqGen.outPort("data"), directMeans.inPort("elements"))
+
+    # the same images, held until the end of the sequence
+    images = dataShaping.select("accu").select("cvMat").create("images")
+    bind(cam.outPort("image"), images.inPort("elements"))
+    seqBind(seqGen.outPort("data"), images.inPort("elements"))
+
+    spliter = dataShaping.select("unstack").select("cvMat").create("spliter")
+    bind(images.outPort("array"), spliter.inPort("array"))
+    held = analyze.select("simpleStats").create("heldStats")
+    bind(spliter.outPort("elements"), held.inPort("image"))
+    heldMeans = dataShaping.select("accu").select("dblFloat").create("heldMeans")
+    bind(held.outPort("mean"), heldMeans.inPort("elements"))
+    seqBind(spliter.outPort("elements"), heldMeans.inPort("elements"))
+
+    runModule(seqGen)
+    waitAll()
+
+    delivered = directMeans.outPort("array").getDataValue()
+    kept = heldMeans.outPort("array").getDataValue()
+    print("image means when delivered: " + str(delivered))
+    print("image means once held:      " + str(kept))
+    if len(delivered) != 8:
+        raise RuntimeError("8 images should have been delivered")
+    if kept != delivered:
+        raise RuntimeError("A held image was overwritten by a later frame")
+
+    print("End of script genTLBufferTest.py")
+    
+# main body    
+import sys
+import os
+from os.path import dirname, realpath
+    
+if len(sys.argv) >= 1:
+    # probably called from InstrumentAll
+    checker = os.path.basename(sys.argv[0])
+    if checker == "instrumentall" or checker == "instrumentall.exe":
+        print("current script: ",os.path.realpath(__file__))
+        
+        binDir = dirname(realpath(sys.argv[0]))
+        
+        myMain(binDir)
+        exit(0)
+
+print("Presumably not called from InstrumentAll >> Exiting...")
+
+exit("This script has to be launched from inside InstrumentAll")
@@ -0,0 +1,245 @@
+# -*- coding: utf-8 -*-
+
+## @file   testsuite/python/genicamSimTest.py
+## @date   Oct. 2026
+## @author PhRG - opticalp.fr
+##
+## Test the genicam camera module with the simulated GenTL producer
+
+#
+# Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+def rampHistograms(width, height):
+    """Histograms of the simulated diagonal ramp, for each frame offset
+
+    The simulated producer sets the pixel (x, y) to
+    ((x + y + offset) & 0xFF) << (bitDepth - 8), offset depending on
+    the frame ID. """
+
+    diagCount = [ min(s + 1, width, height, width + height - 1 - s)
+                  for s in range(width + height - 1) ]
+
+    hists = []
+    for offset in range(256):
+        hist = [0] * 256
+        for s in range(len(diagCount)):
+            hist[(s + offset) & 0xFF] += diagCount[s]
+        hists.append(hist)
+    return hists
+
+def checkRamp(stats, histo, shift, hists):
+    """Check the unpacked pixels against the simulated diagonal ramp
+
+    The image statistics (simpleStats module) have to match the ramp
+    of one of the frame offsets, once scaled by 2^shift. For 8-bit
+    images, the histogram (histogram module) is compared too. """
+
+    from math import sqrt
+
+    count = float( stats.outPort("width").getDataValue()
+                   * stats.outPort("height").getDataValue() )
+    scale = float(1 << shift)
+
+    if stats.outPort("min").getDataValue() != 0:
+        raise RuntimeError("Wrong unpacked min value")
+    if stats.outPort("max").getDataValue() != 255 * scale:
+        raise RuntimeError("Wrong unpacked max value: "
+                           + str(stats.outPort("max").getDataValue()))
+
+    mean = stats.outPort("mean").getDataValue() / scale
+    sigma = stats.outPort("sigma").getDataValue() / scale
+    if shift == 0:
+        values = histo.outPort("histogram").getDataValue()
+
+    for hist in hists:
+        refMean = sum(v * hist[v] for v in range(256)) / count
+        refSigma = sqrt(sum((v - refMean)**2 * hist[v]
+                            for v in range(256)) / count)
+        if abs(mean - refMean) > 1e-3 or abs(sigma - refSigma) > 1e-3:
+            continue
+        if shift == 0 and any(abs(values[v] - hist[v] / count) > 1e-5
+                              for v in range(256)):
+            continue
+        return
+
+    raise RuntimeError("The unpacked image does not match the simulated ramp "
+                       + "(mean: " + str(mean) + ", sigma: " + str(sigma) + ")")
+
+def myMain(binDir):
+    """Main function. Run the tests. """
+
+    from os.path import join, isfile
+    import time
+
+    print("Test the genicam camera module with the simulated GenTL producer. ")
+    
+    from instru import *
+    
+    cti = join(binDir, "SimGenTL.cti")
+    if not isfile(cti):
+        print("Test skipped: SimGenTL.cti not found in " + binDir
+              + " (the simulated producer is built with the sim-genTL option)")
+        return
+    
+    fac = Factory("DeviceFactory")
+    print("Retrieved factory: " + fac.name)
+    
+    print("Create the simulated camera through the genicam factories")
+    try:
+        cam = ( fac.select("camera").select("genicam")
+                .select(cti).select("SimInterface").select("SimCam0")
+                .select(join(binDir, "simCam.yml")).create("simCam") )
+    except RuntimeError as e:
+        print("Runtime error: {0}".format(e.message))
+        print("Test skipped: GenICam is probably not present")
+        return
+        
+    print("module " + cam.name + " created (" + cam.internalName + ") ")
+
+    print("Single image acquisition")
+    runModule(cam)
+    waitAll()
+    
+    timestamp = cam.outPort("timestamp").getDataValue()
+    print("Image timestamp: " + str(timestamp))
+    if timestamp <= 0:
+        raise RuntimeError("The image timestamp is not set")
+    
+    print("Packed pixel formats")
+    analyze = Factory("ImageProcFactory").select("analyze")
+    stats = analyze.select("simpleStats").create("rampStats")
+    histo = analyze.select("histogram").create("rampHisto")
+    bind(cam.outPort("image"), stats.inPort("image"))
+    bind(cam.outPort("image"), histo.inPort("image"))
+    hists = rampHistograms(320, 240) # see simCam.yml
+    
+    bitDepths = { "Mono10p": 10, "Mono12p": 12, "Mono12": 12 }
+    for pixFormat in ["Mono10p", "Mono12p", "Mono12"]:
+        cam.setParameterValue("PixelFormat", pixFormat)
+        for downshift in ["OFF", "ON"]:
+            print(" - " + pixFormat + ", downshift8 " + downshift)
+            cam.setParameterValue("downshift8", downshift)
+            runModule(cam)
+            waitAll()
+
+            if downshift == "ON":
+                checkRamp(stats, histo, 0, hists)
+            else:
+                checkRamp(stats, histo, bitDepths[pixFormat] - 8, hists)
+    
+    unbind(stats.inPort("image"))
+    unbind(histo.inPort("image"))
+    
+    print("Bayer pixel formats, with the half resolution output")
+    logger = DataLogger("ShowImageLogger")
+    cam.outPort("imageHalf").register(logger)
+    for pixFormat in ["BayerRG8", "BayerRG12"]:
+        cam.setParameterValue("PixelFormat", pixFormat)
+        for demosaic in ["ON", "OFF"]:
+            print(" - " + pixFormat + ", demosaic " + demosaic)
+            cam.setParameterValue("demosaic", demosaic)
+            runModule(cam)
+            waitAll()
+    logger.detach()
+    
+    print("Batched parameter writes")
+    params = { "PixelFormat": "Mono8", 
+               "AcquisitionFrameRate": 100.0, 
+               "downshift8": "OFF" }
+    cam.setParameterValues(params)
+    for name in params:
+        value = cam.getParameterValue(name)
+        print(" - " + name + ": " + str(value))
+        if value != params[name]:
+            raise RuntimeError(name + " was not applied")
+    # second read, from the node cache
+    if cam.getParameterValue("PixelFormat") != "Mono8":
+        raise RuntimeError("Wrong cached PixelFormat value")
+
+    print("Stream acquisition at 200fps, dropping one frame out of 5")
+    cam.setParameterValue("AcquisitionFrameRate", 200.0)
+    cam.setParameterValue("SimDropInterval", 5)
+    cam.setParameterValue("acquisitionMode", "stream")
+    cam.setParameterValue("streamFrames", 20)
+    
+    runModule(cam)
+    waitAll()
+    
+    delivered = cam.getParameterValue("framesDelivered")
+    dropped = cam.getParameterValue("framesDropped")
+    print("Frames delivered: " + str(delivered) + ", dropped: " + str(dropped))
+    if delivered != 20:
+        raise RuntimeError("20 frames should have been delivered")
+    if dropped < 4:
+        raise RuntimeError("The dropped frames were not all counted")
+
+    print("Burst acquisition, 8 frames per trigger")
+    cam.setParameterValue("acquisitionMode", "burst")
+    cam.setParameterValue("burstFrames", 8)
+    for pixFormat in ["Mono8", "Mono12p"]:
+        print(" - " + pixFormat)
+        cam.setParameterValue("PixelFormat", pixFormat)
+        runModule(cam)
+        waitAll()
+    
+        timestamps = cam.outPort("burstTimestamps").getDataValue()
+        print("   burst timestamps: " + str(timestamps))
+        if len(timestamps) != 8:
+            raise RuntimeError("8 frames should have been acquired")
+        if sorted(timestamps) != timestamps:
+            raise RuntimeError("The burst frames are not ordered")
+    cam.setParameterValue("PixelFormat", "Mono8")
+    cam.setParameterValue("acquisitionMode", "stream")
+
+    print("Free run benchmark, 200 frames")
+    cam.setParameterValue("AcquisitionFrameRate", 0.0)
+    cam.setParameterValue("SimDropInterval", 0)
+    cam.setParameterValue("framesDelivered", 0)
+    cam.setParameterValue("streamFrames", 200)
+    
+    start = time.time()
+    runModule(cam)
+    waitAll()
+    elapsed = time.time() - start
+    
+    print("200 frames delivered in " + str(elapsed) + "s")
+    
+    print("End of script genicamSimTest.py")
+    
+# main body    
+import sys
+import os
+from os.path import dirname, realpath
+    
+if len(sys.argv) >= 1:
+    # probably called from InstrumentAll
+    checker = os.path.basename(sys.argv[0])
+    if checker == "instrumentall" or checker == "instrumentall.exe":
+        print("current script: ",os.path.realpath(__file__))
+        
+        binDir = dirname(realpath(sys.argv[0]))
+        
+        myMain(binDir)
+        exit(0)
+
+print("Presumably not called from InstrumentAll >> Exiting...")
+
+exit("This script has to be launched from inside InstrumentAll")
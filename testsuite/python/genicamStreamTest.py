@@ -0,0 +1,137 @@
+# -*- coding: utf-8 -*-
+
+## @file   testsuite/python/genicamStreamTest.py
+## @date   Oct. 2026
+## @author PhRG - opticalp.fr
+##
+## Test the stream acquisition mode and the frame counters of the genicam camera module
+
+#
+# Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+def myMain(binDir):
+    """Main function. Run the tests. """
+
+    from os.path import join, isfile
+
+    print("Test the genicam stream acquisition with the simulated GenTL producer. ")
+
+    from instru import *
+
+    cti = join(binDir, "SimGenTL.cti")
+    if not isfile(cti):
+        print("Test skipped: SimGenTL.cti not found in " + binDir
+              + " (the simulated producer is built with the sim-genTL option)")
+        return
+
+    try:
+        cam = ( Factory("DeviceFactory").select("camera").select("genicam")
+                .select(cti).select("SimInterface").select("SimCam0")
+                .select(join(binDir, "simCam.yml")).create("simCam") )
+    except RuntimeError as e:
+        print("Runtime error: {0}".format(e.message))
+        print("Test skipped: GenICam is probably not present")
+        return
+
+    print("module " + cam.name + " created (" + cam.internalName + ") ")
+
+    try:
+        cam.setParameterValue("acquisitionMode", "continuous")
+    except RuntimeError:
+        print("unknown acquisitionMode refused, as expected")
+    else:
+        raise RuntimeError("acquisitionMode continuous should be refused")
+
+    print("Accumulate the timestamps of the stream sequence")
+    timestamps = ( Factory("ControlFactory").select("dataShaping")
+                   .select("accu").select("uint64").create("timestamps") )
+    bind(cam.outPort("timestamp"), timestamps.inPort("elements"))
+    seqBind(cam.outPort("timestamp"), timestamps.inPort("elements"))
+
+    print("Stream of 20 frames at 200fps, dropping one frame out of 5")
+    cam.setParameterValue("acquisitionMode", "stream")
+    cam.setParameterValue("streamFrames", 20)
+    cam.setParameterValue("AcquisitionFrameRate", 200.0)
+    cam.setParameterValue("SimDropInterval", 5)
+
+    runModule(cam)
+    waitAll()
+
+    delivered = cam.getParameterValue("framesDelivered")
+    dropped = cam.getParameterValue("framesDropped")
+    print("Frames delivered: " + str(delivered) + ", dropped: " + str(dropped))
+    if delivered != 20:
+        raise RuntimeError("20 frames should have been delivered")
+    if dropped < 4:
+        raise RuntimeError("The dropped frames were not all counted")
+
+    values = timestamps.outPort("array").getDataValue()
+    if len(values) != 20:
+        raise RuntimeError("The sequence should hold 20 frames, got "
+                           + str(len(values)))
+    for ind in range(1, 20):
+        if values[ind] <= values[ind - 1]:
+            raise RuntimeError("The frame timestamps should increase")
+
+    print("Reset the counters")
+    for counter in ["framesDelivered", "framesDropped", "framesIncomplete"]:
+        cam.setParameterValue(counter, 0)
+        if cam.getParameterValue(counter) != 0:
+            raise RuntimeError(counter + " was not reset")
+
+    print("Stream of 20 frames, one incomplete frame out of 4")
+    cam.setParameterValue("SimDropInterval", 0)
+    cam.setParameterValue("SimIncompleteInterval", 4)
+
+    runModule(cam)
+    waitAll()
+
+    delivered = cam.getParameterValue("framesDelivered")
+    incomplete = cam.getParameterValue("framesIncomplete")
+    print("Frames delivered: " + str(delivered) + ", incomplete: " + str(incomplete))
+    if delivered != 20:
+        raise RuntimeError("20 complete frames should have been delivered")
+    if incomplete < 4:
+        raise RuntimeError("The incomplete frames were not all counted")
+
+    cam.setParameterValue("SimIncompleteInterval", 0)
+
+    print("End of script genicamStreamTest.py")
+    
+# main body    
+import sys
+import os
+from os.path import dirname, realpath
+    
+if len(sys.argv) >= 1:
+    # probably called from InstrumentAll
+    checker = os.path.basename(sys.argv[0])
+    if checker == "instrumentall" or checker == "instrumentall.exe":
+        print("current script: ",os.path.realpath(__file__))
+        
+        binDir = dirname(realpath(sys.argv[0]))
+        
+        myMain(binDir)
+        exit(0)
+
+print("Presumably not called from InstrumentAll >> Exiting...")
+
+exit("This script has to be launched from inside InstrumentAll")
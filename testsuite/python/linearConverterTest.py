@@ -132,8 +132,107 @@ def myMain(baseDir):
     if forwarder.outPorts()[0].getDataValue() != 0 :
         raise RuntimeError("Wrong return value: 0 expected. ")
 
+    print("Vector conversion: dbl float vector to int32 vector")
+    dblVectGen = Factory("DataGenFactory").select("dblFloatVect").create("dblVectGen")
+    values = [ind * 0.75 - 3 for ind in range(11)] + [1e10, -1e10]
+    for value in values:
+        dblVectGen.setParameterValue("value", value)
+
+    print("Use an int32 unstacking module in chunk mode as vector target")
+    spliter = Factory("ControlFactory").select("dataShaping").select("unstack").select("int32").create("vectSpliter")
+    spliter.setParameterValue("chunkSize", 100)
+    chunks = spliter.outPort("chunks").subscribe()
+
+    vectProxy = DataProxy("LinearConverter")
+    vectProxy.setParameterValue("scale", 2.)
+    vectProxy.setParameterValue("offset", 0.5)
+    bind(dblVectGen.outPort("data"), spliter.inPort("array"), vectProxy)
+
+    runModule(dblVectGen)
+    waitAll()
+
+    result = chunks.get(timeout=1)
+    chunks.close()
+    print("Converted vector is: " + str(result))
+
+    # rounded half away from zero, saturated to the int32 range
+    expected = [int(round(value * 2 + 0.5)) for value in values[:-2]]
+    expected += [2147483647, -2147483648]
+    if result != expected:
+        raise RuntimeError("Wrong converted vector: " + str(expected) + " expected. ")
+
+    # the lengths are not multiples of 4, to check the tails too
+
+    print("Vector conversion: int32 vector to float vector")
+    values = range(-3, 4)
+    result = convertVector("int32ToFloat", "int32", "float", values, 0.5, 0.25)
+    expected = [value * 0.5 + 0.25 for value in values]
+    if result != expected:
+        raise RuntimeError("Wrong converted vector: " + str(expected) + " expected. ")
+
+    print("Vector conversion: float vector to dbl float vector")
+    values = [ind * 0.75 - 3 for ind in range(6)]
+    result = convertVector("floatToDbl", "float", "dblFloat", values, -2., 1.)
+    expected = [value * -2 + 1 for value in values]
+    if result != expected:
+        raise RuntimeError("Wrong converted vector: " + str(expected) + " expected. ")
+
+    fltMax = 3.4028234663852886e+38
+
+    print("Vector conversion: dbl float vector to float vector, with overflows")
+    values = [1.5, 1e39, -2.5, -1e39, 3.25, 1e300, -1e300]
+    result = convertVector("dblToFloat", "dblFloat", "float", values, 1., 0.)
+    expected = [1.5, fltMax, -2.5, -fltMax, 3.25, fltMax, -fltMax]
+    if result != expected:
+        raise RuntimeError("Wrong converted vector: " + str(expected) + " expected. ")
+
+    print("Vector conversion: float vector to float vector, with overflows")
+    values = [1., 3e38, -2., -3e38, 0.5, 3e38, -3e38]
+    result = convertVector("floatToFloat", "float", "float", values, 10., 0.)
+    expected = [10., fltMax, -20., -fltMax, 5., fltMax, -fltMax]
+    if result != expected:
+        raise RuntimeError("Wrong converted vector: " + str(expected) + " expected. ")
+
+    print("In-place vector conversion: float vector to float vector")
+    values = [ind * 0.75 - 3 for ind in range(7)]
+    result = convertVector("floatInPlace", "float", "float", values, 2., 1., "yes")
+    expected = [value * 2 + 1 for value in values]
+    if result != expected:
+        raise RuntimeError("Wrong converted vector: " + str(expected) + " expected. ")
+
+    # the input vector was handed over to the output: the generator
+    # got the previous output buffer of the proxy, empty
+    if len(Module("floatInPlaceGen").outPort("data").getDataValue()) != 0:
+        raise RuntimeError("The vector was not converted in place")
+
     print("End of script linearConverterTest.py")
     
+def convertVector(name, srcType, dstType, values, scale, offset, alter="no"):
+    """Convert a vector of the given values through a LinearConverter"""
+    from instru import *
+
+    gen = Factory("DataGenFactory").select(srcType + "Vect").create(name + "Gen")
+    for value in values:
+        gen.setParameterValue("value", value)
+
+    target = Factory("ControlFactory").select("dataShaping").select("unstack").select(dstType).create(name + "Spliter")
+    target.setParameterValue("chunkSize", 100)
+    converted = target.outPort("chunks").subscribe()
+
+    proxy = DataProxy("LinearConverter")
+    proxy.setParameterValue("scale", scale)
+    proxy.setParameterValue("offset", offset)
+    proxy.setParameterValue("alter", alter)
+    bind(gen.outPort("data"), target.inPort("array"), proxy)
+
+    runModule(gen)
+    waitAll()
+
+    result = converted.get(timeout=1)
+    converted.close()
+    print("Converted vector is: " + str(result))
+    return result
+
 # main body    
 import sys
 import os
@@ -0,0 +1,157 @@
+# -*- coding: utf-8 -*-
+
+## @file   testsuite/python/loadGenTest.py
+## @date   oct. 2026
+## @author PhRG - opticalp.fr
+##
+## Test the rate-controlled synthetic load generator
+
+#
+# Copyright (c) 2026 Ph. Renaud-Goud / Opticalp
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+
+def myMain(baseDir):
+    """Main function. Run the tests. """
+
+    import time
+    from instru import *
+
+    print("Test the rate-controlled load generator. ")
+
+    loadGen = Factory("DataGenFactory").select("load").create("loadGen")
+    print("module " + loadGen.name + " created. ")
+
+    print("Scalars at 200 Hz: 101 data <=> 0.5 s")
+    loadGen.setParameterValue("payload", "scalar")
+    loadGen.setParameterValue("rate", 200.)
+    loadGen.setParameterValue("count", 101)
+
+    scalars = loadGen.outPort("scalar").subscribe()
+
+    t0 = time.time()
+    runModule(loadGen)
+    waitAll()
+    elapsed = time.time() - t0
+
+    print("elapsed time was: " + str(elapsed) + " seconds")
+    if elapsed < 0.45 or elapsed > 1:
+        raise RuntimeError("the rate was not effective")
+
+    achieved = loadGen.getParameterValue("achievedRate")
+    print("achieved rate: " + str(achieved) + " Hz")
+    if abs(achieved - 200) > 20:
+        raise RuntimeError("wrong achieved rate")
+
+    values = scalars.getBatch(200, timeout=1)
+    scalars.close()
+    if values != [float(ind) for ind in range(101)]:
+        raise RuntimeError("wrong emitted values")
+
+    print("Bursts of 10 vectors of 50 elements at 400 Hz, with jitter")
+    loadGen.setParameterValue("payload", "vector")
+    loadGen.setParameterValue("vectorSize", 50)
+    loadGen.setParameterValue("rate", 400.)
+    loadGen.setParameterValue("burstSize", 10)
+    loadGen.setParameterValue("jitter", 0.2)
+
+    vectors = loadGen.outPort("vector").subscribe()
+
+    runModule(loadGen)
+    waitAll()
+
+    achieved = loadGen.getParameterValue("achievedRate")
+    print("achieved rate: " + str(achieved) + " Hz")
+    if abs(achieved - 400) > 80:
+        raise RuntimeError("wrong achieved rate")
+
+    vect = vectors.get(timeout=1)
+    vectors.close()
+    if len(vect) != 50 or vect[0] != 0:
+        raise RuntimeError("wrong vector payload")
+
+    print("Same run without busy wait")
+    loadGen.setParameterValue("spinTime", 0)
+
+    runModule(loadGen)
+    waitAll()
+
+    achieved = loadGen.getParameterValue("achievedRate")
+    print("achieved rate: " + str(achieved) + " Hz")
+    if abs(achieved - 400) > 80:
+        raise RuntimeError("wrong achieved rate without busy wait")
+
+    try:
+        loadGen.setParameterValue("spinTime", -1)
+    except:
+        print("negative spinTime setting failed, as expected")
+    else:
+        raise RuntimeError("spinTime should be positive or null")
+
+    print("Read-only parameters can not be set")
+    try:
+        loadGen.setParameterValue("achievedRate", 1.)
+    except:
+        print("achievedRate setting failed, as expected")
+    else:
+        raise RuntimeError("achievedRate should be read-only")
+
+    print("One image with one spot, checked with the center of mass")
+    loadGen.setParameterValue("payload", "image")
+    loadGen.setParameterValue("rate", 0.)
+    loadGen.setParameterValue("count", 1)
+    loadGen.setParameterValue("imageWidth", 64)
+    loadGen.setParameterValue("imageHeight", 48)
+    loadGen.setParameterValue("spotCount", 1)
+    loadGen.setParameterValue("spotSigma", 3.)
+
+    cOfM = Factory("ImageProcFactory").select("analyze").select("centerOfMass").create("centerOfMass")
+    bind(loadGen.outPort("image"), cOfM.inPort("image"))
+
+    runModule(loadGen)
+    waitAll()
+
+    xPos = cOfM.outPort("xPosition").getDataValue()
+    yPos = cOfM.outPort("yPosition").getDataValue()
+    print("spot position: " + str(xPos) + ", " + str(yPos))
+    if abs(xPos - 31.5) > 0.1 or abs(yPos - 23.5) > 0.1:
+        raise RuntimeError("wrong spot position")
+
+    print("End of script loadGenTest.py")
+
+# main body
+import sys
+import os
+from os.path import dirname
+
+if len(sys.argv) >= 1:
+    # probably called from InstrumentAll
+    checker = os.path.basename(sys.argv[0])
+    if checker == "instrumentall" or checker == "instrumentall.exe":
+        print("current script: ",os.path.realpath(__file__))
+
+        baseDir = dirname(dirname(__file__))
+
+        myMain(baseDir)
+        exit(0)
+
+print("Presumably not called from InstrumentAll >> Exiting...")
+
+exit("This script has to be launched from inside InstrumentAll")
@@ -70,6 +70,82 @@ def myMain(baseDir):
     runModule(floatGen)
     waitAll()
 
+    print("Compiled script cache: the script is run again, then modified")
+    import tempfile
+    global cacheProbe
+    cacheProbe = 0
+    probeFile = join(tempfile.gettempdir(), "pyModCacheProbe.py")
+    with open(probeFile, "w") as f:
+        f.write("global cacheProbe\ncacheProbe = cacheProbe + 1\n")
+    pyMod.setParameterValue("scriptFilePath", probeFile)
+
+    for run in range(3):
+        runModule(floatGen)
+        waitAll()
+
+    print("cacheProbe = " + str(cacheProbe))
+    if cacheProbe != 3:
+        raise RuntimeError("The cached script was not run each time")
+
+    # different size: the change is detected even within the mtime resolution
+    with open(probeFile, "w") as f:
+        f.write("global cacheProbe\ncacheProbe = cacheProbe + 100\n")
+
+    runModule(floatGen)
+    waitAll()
+
+    print("cacheProbe = " + str(cacheProbe))
+    if cacheProbe != 103:
+        raise RuntimeError("The modified script was not recompiled")
+
+    os.remove(probeFile)
+
+    print("Run the script in a worker process")
+    workerFile = join(tempfile.gettempdir(), "pyModWorkerProbe.py")
+    with open(workerFile, "w") as f:
+        f.write("with open(__file__ + '.out', 'a') as out:\n"
+                "    out.write('x')\n")
+    if os.path.exists(workerFile + ".out"):
+        os.remove(workerFile + ".out")
+
+    pyMod.setParameterValue("scriptFilePath", workerFile)
+    pyMod.setParameterValue("execution", "worker")
+
+    for run in range(3):
+        runModule(floatGen)
+        waitAll()
+
+    with open(workerFile + ".out") as f:
+        runs = len(f.read())
+    print("The worker ran the script " + str(runs) + " times")
+    if runs != 3:
+        raise RuntimeError("The worker did not run the script each time")
+
+    os.remove(workerFile)
+    os.remove(workerFile + ".out")
+
+    print("Cancel a script running in a worker process")
+    import time
+    with open(workerFile, "w") as f:
+        f.write("import time\n"
+                "time.sleep(30)\n")
+
+    start = time.time()
+    runModule(floatGen)
+    time.sleep(1)
+    cancelAll()
+    try:
+        waitAll()
+    except RuntimeError as e:
+        print(e)
+    elapsed = time.time() - start
+    print("Cancelled after " + str(elapsed) + "s")
+    if elapsed > 10:
+        raise RuntimeError("The worker script was not cancelled")
+
+    os.remove(workerFile)
+    pyMod.setParameterValue("execution", "embedded")
+
     print("Cancellation inside pyMod")
 
     scriptFile = join(join(baseDir,"resources"),"pyModCancelScript.py")
@@ -85,6 +161,65 @@ def myMain(baseDir):
     except RuntimeError as e:
         print(e)
 
+    print("Exchange data with a script running in a worker process")
+    unbind(pyMod.inPort("trig"))
+
+    pyModOut = fac.select("python").select("trig;sum:dblFloat;twice:dblFloatVect").create("pyModOut")
+    if len(pyModOut.outPorts()) != 2:
+        raise RuntimeError("Bad output port count")
+
+    if pyModOut.getParameterValue("execution") != "worker":
+        raise RuntimeError("A module with output ports shall run in a worker")
+
+    exchangeFile = join(tempfile.gettempdir(), "pyModExchange.py")
+    with open(exchangeFile, "w") as f:
+        f.write("import instru\n"
+                "value = instru.getInput('trig')\n"
+                "instru.setOutput('sum', value + 1)\n"
+                "instru.setOutput('twice', [value, 2 * value])\n")
+    pyModOut.setParameterValue("scriptFilePath", exchangeFile)
+    bind(floatGen.outPort("data"), pyModOut.inPort("trig"))
+
+    runModule(floatGen)
+    waitAll()
+
+    total = pyModOut.outPort("sum").getDataValue()
+    twice = pyModOut.outPort("twice").getDataValue()
+    print("sum: " + str(total) + ", twice: " + str(twice))
+    if abs(total - 4.14) > 1e-5 or len(twice) != 2 or abs(twice[1] - 6.28) > 1e-5:
+        raise RuntimeError("Wrong worker outputs")
+
+    unbind(pyModOut.inPort("trig"))
+
+    print("Exchange an image with a worker process")
+    try:
+        imgGen = Factory("DataGenFactory").select("cvMat").create("imgGen")
+    except RuntimeError as e:
+        print("Runtime error: " + str(e))
+        print("OpenCV is probably not present. ")
+    else:
+        imgGen.setParameterValue("value", 127)
+        pyModImg = fac.select("python").select("trig;image:cvMat;peak:int32").create("pyModImg")
+        with open(exchangeFile, "w") as f:
+            f.write("import instru\n"
+                    "image = instru.getInput('trig')\n"
+                    "instru.setOutput('image', image)\n"
+                    "instru.setOutput('peak', max(bytearray(bytes(image.data))))\n")
+        pyModImg.setParameterValue("scriptFilePath", exchangeFile)
+        bind(imgGen.outPort("data"), pyModImg.inPort("trig"))
+
+        runModule(imgGen)
+        waitAll()
+
+        image = pyModImg.outPort("image").getDataValue()
+        peak = pyModImg.outPort("peak").getDataValue()
+        pixels = bytearray(memoryview(image).tobytes())
+        print("Image shape: " + str(image.shape) + ", peak: " + str(peak))
+        if image.shape != (640, 1024) or peak != 127 or max(pixels) != 127:
+            raise RuntimeError("Wrong image exchange")
+
+    os.remove(exchangeFile)
+
     print("End of script pyModTest.py")
     
 # main body    
@@ -0,0 +1,111 @@
+# -*- coding: utf-8 -*-
+
+## @file   testsuite/python/rawRecordLoggerTest.py
+## @date   oct. 2026
+## @author PhRG - opticalp.fr
+##
+## Test the raw record data logger
+
+#
+# Copyright (c) 2017 Ph. Renaud-Goud / Opticalp
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+def myMain(baseDir):
+    """Main function. Run the tests. """
+
+    from os.path import join, getsize
+    import tempfile
+    import struct
+
+    print("Test the basic features of the RawRecordLogger. ")
+    
+    from instru import *
+    
+    fac = Factory("DeviceFactory")
+    print("Retrieved factory: " + fac.name)
+    
+    print("Create module from CameraFromFilesFactory")
+    try:
+        cam = fac.select("camera").select("fromFiles").create("fakeCam")
+    except RuntimeError as e:
+        print("Runtime error: {0}".format(e.message))
+        print("OpenCV is probably not present. Exiting. ")
+        exit(0)
+        
+    print("module " + cam.name + " created (" + cam.internalName + ") ")
+
+    imgDir = join(baseDir,"resources")
+    cam.setParameterValue("directory", imgDir)
+    cam.setParameterValue("files", """001.png
+                                      002.png""")
+    cam.setParameterValue("forceGrayscale", "ON")
+
+    print('Logger creation using the constructor: DataLogger("RawRecordLogger")')
+    logger = DataLogger("RawRecordLogger") 
+    print("Logger description: " + logger.description)
+
+    recFile = join(tempfile.gettempdir(), "rawRecordLoggerTest.rec")
+    logger.setParameterValues({ "file": recFile, "chunkSize": 1 })
+    
+    cam.outPort("image").register(logger)
+
+    print("Record 10 images")
+    for ind in range(10):
+        runModule(cam)
+        waitAll()
+
+    print("frames recorded: " + str(logger.getParameterValue("framesRecorded")))
+    if logger.getParameterValue("framesRecorded") != 10:
+        raise RuntimeError("10 frames should have been recorded")
+
+    print("Finalize the container file")
+    logger.setParameterValue("file", "")
+    logger.detach()
+
+    with open(recFile, "rb") as f:
+        f.seek(-24, 2)
+        indexOffset, frameCount, magic = struct.unpack("<QQ8s", f.read(24))
+
+    print("container size: " + str(getsize(recFile)) + " bytes, "
+          + str(frameCount) + " frames indexed")
+    if magic != b"IARAWEND" or frameCount != 10:
+        raise RuntimeError("invalid container trailer")
+
+    print("End of script rawRecordLoggerTest.py")
+    
+# main body    
+import sys
+import os
+from os.path import dirname
+    
+if len(sys.argv) >= 1:
+    # probably called from InstrumentAll
+    checker = os.path.basename(sys.argv[0])
+    if checker == "instrumentall" or checker == "instrumentall.exe":
+        print("current script: ",os.path.realpath(__file__))
+        
+        baseDir = dirname(dirname(__file__))
+        
+        myMain(baseDir)
+        exit(0)
+
+print("Presumably not called from InstrumentAll >> Exiting...")
+
+exit("This script has to be launched from inside InstrumentAll")
@@ -0,0 +1,168 @@
+# -*- coding: utf-8 -*-
+
+## @file   testsuite/python/seqAccumulatorTest.py
+## @date   oct. 2026
+## @author PhRG - opticalp.fr
+##
+## Test the image accumulation of the SeqAccumulator (stack, compression, spill to disk)
+
+#
+# Copyright (c) 2026 Ph. Renaud-Goud / Opticalp
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+def myMain(baseDir):
+    """Main function. Run the tests. """
+
+    print("Test the image accumulation of the sequence accumulator. ")
+
+    import shutil
+    import tempfile
+
+    from instru import *
+
+    fac = Factory("DataGenFactory")
+    print("Retrieved factory: " + fac.name)
+
+    print("Create an image generator")
+    try:
+        imgGen = fac.select("cvMat").create("imgGen")
+    except RuntimeError as e:
+        print("Runtime error: " + str(e))
+        print("OpenCV is probably not present. Exiting. ")
+        return
+
+    print("Create a sequence generator to trig the image generator")
+    seqGen = fac.select("seq").create("seqGen")
+    seqGen.setParameterValue("seqSize", 6)
+    bind(seqGen.outPort("data"), imgGen.inPort("trig"))
+
+    print("Create the image accumulator")
+    accu = (Factory("ControlFactory").select("dataShaping")
+            .select("accu").select("cvMat").create("imgAccu"))
+    bind(imgGen.outPort("data"), accu.inPort("elements"))
+    seqBind(seqGen.outPort("data"), accu.inPort("elements"))
+
+    print("Accumulate in memory, the stack capacity is unknown")
+    values = [10, 20, 30, 40, 50, 60]
+    checkImages(runSeq(imgGen, seqGen, accu, values), values)
+
+    print("Accumulate again: the previous length is used as capacity")
+    values = [15, 25, 35, 45, 55, 65]
+    checkImages(runSeq(imgGen, seqGen, accu, values), values)
+
+    print("Limit the memory to 1 MiB: 1 image in memory, the others spilled")
+    spillDir = tempfile.mkdtemp(prefix="seqAccumulatorTest")
+    accu.setParameterValue("memoryBudget", 1)
+    accu.setParameterValue("spillDirectory", spillDir)
+    values = [11, 21, 31, 41, 51, 61]
+    images = runSeq(imgGen, seqGen, accu, values)
+    checkImages(images, values)
+
+    print("Set a capacity lower than the sequence length: the spilled stack grows")
+    accu.setParameterValue("capacity", 2)
+    values = [12, 22, 32, 42, 52, 62]
+    checkImages(runSeq(imgGen, seqGen, accu, values), values)
+
+    print("The images of the previous sequence are still valid")
+    checkImages(images, [11, 21, 31, 41, 51, 61])
+
+    print("Release the spilled images and remove the spill directory")
+    del images
+    accu.setParameterValue("memoryBudget", 0)
+    accu.setParameterValue("spillDirectory", "")
+    values = [13, 23, 33, 43, 53, 63]
+    checkImages(runSeq(imgGen, seqGen, accu, values), values)
+    if os.listdir(spillDir):
+        raise RuntimeError("The spill files were not removed")
+    shutil.rmtree(spillDir)
+
+    print("Deflate the images beyond half of the 1 MiB memory budget")
+    try:
+        accu.setParameterValue("compression", "lz4")
+    except RuntimeError as e:
+        print("Unknown compression refused: " + str(e))
+    else:
+        raise RuntimeError("An unknown compression was accepted")
+
+    spillDir = tempfile.mkdtemp(prefix="seqAccumulatorTest")
+    accu.setParameterValue("memoryBudget", 1)
+    accu.setParameterValue("spillDirectory", spillDir)
+    accu.setParameterValue("compression", "deflate")
+    values = [14, 24, 34, 44, 54, 64]
+    checkImages(runSeq(imgGen, seqGen, accu, values), values)
+
+    # the uniform images are all deflated, then inflated at once
+    # into one spill file at the end of the sequence
+    spillFiles = len(os.listdir(spillDir))
+    print("spill files: " + str(spillFiles))
+    if spillFiles != 1:
+        raise RuntimeError("The deflated images were not inflated into one spill file")
+
+    accu.setParameterValue("compression", "none")
+    accu.setParameterValue("memoryBudget", 0)
+    accu.setParameterValue("spillDirectory", "")
+    values = [16, 26, 36, 46, 56, 66]
+    checkImages(runSeq(imgGen, seqGen, accu, values), values)
+    if os.listdir(spillDir):
+        raise RuntimeError("The spill files were not removed")
+    shutil.rmtree(spillDir)
+
+    print("End of script seqAccumulatorTest.py")
+
+def runSeq(imgGen, seqGen, accu, values):
+    """Accumulate a sequence of images of the given values"""
+    from instru import *
+
+    for value in values:
+        imgGen.setParameterValue("value", value)
+    runModule(seqGen)
+    waitAll()
+    return accu.outPort("array").getDataValue()
+
+def checkImages(images, values):
+    """Check the accumulated images against their expected values"""
+    print("accumulated images: " + str(len(images)))
+    if len(images) != len(values):
+        raise RuntimeError("Wrong image count")
+
+    for image, value in zip(images, values):
+        pixels = bytearray(memoryview(image).tobytes())
+        if image.shape != (640, 1024) or max(pixels) != value:
+            raise RuntimeError("Wrong accumulated image content")
+
+# main body    
+import sys
+import os
+from os.path import dirname
+    
+if len(sys.argv) >= 1:
+    # probably called from InstrumentAll
+    checker = os.path.basename(sys.argv[0])
+    if checker == "instrumentall" or checker == "instrumentall.exe":
+        print("current script: ",os.path.realpath(__file__))
+        
+        baseDir = dirname(dirname(__file__))
+        
+        myMain(baseDir)
+        exit(0)
+
+print("Presumably not called from InstrumentAll >> Exiting...")
+
+exit("This script has to be launched from inside InstrumentAll")
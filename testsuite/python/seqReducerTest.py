@@ -0,0 +1,146 @@
+# -*- coding: utf-8 -*-
+
+## @file   testsuite/python/seqReducerTest.py
+## @date   oct. 2026
+## @author PhRG - opticalp.fr
+##
+## Test the sequence reducers (min, max, argmax, mean, std...)
+
+#
+# Copyright (c) 2026 Ph. Renaud-Goud / Opticalp
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+def myMain(baseDir):
+    """Main function. Run the tests. """
+
+    print("Test the sequence reducer modules. ")
+
+    from instru import *
+
+    fac = Factory("DataGenFactory")
+    print("Retrieved factory: " + fac.name)
+
+    print("Create a sequence generator to trig an int32 generator")
+    seqGen = fac.select("seq").create("seqGen")
+    seqGen.setParameterValue("seqSize", 5)
+
+    intGen = fac.select("int32").create("intGen")
+    bind(seqGen.outPort("data"), intGen.inPort("trig"))
+
+    reduceFac = Factory("ControlFactory").select("dataShaping").select("reduce")
+    print("Available reductions: " + str(reduceFac.selectValueList()))
+
+    reducers = dict()
+    for op in ["min", "max", "argmax", "sum", "mean", "std"]:
+        print("Create the " + op + " reducer")
+        reducers[op] = reduceFac.select(op).select("int32").create(op + "Reducer")
+        bind(intGen.outPort("data"), reducers[op].inPort("elements"))
+        seqBind(seqGen.outPort("data"), reducers[op].inPort("elements"))
+
+    values = [3, 7, 1, 9, 5]
+    for value in values:
+        intGen.setParameterValue("value", value)
+
+    print("Run")
+    runModule(seqGen)
+    waitAll()
+
+    results = dict()
+    for op in reducers:
+        results[op] = reducers[op].outPort("result").getDataValue()
+        print(op + ": " + str(results[op]))
+
+    if results["min"] != 1 or results["max"] != 9 or results["argmax"] != 3:
+        raise RuntimeError("Wrong extremum")
+
+    if results["sum"] != 25 or abs(results["mean"] - 5) > 1e-9:
+        raise RuntimeError("Wrong sum or mean")
+
+    if abs(results["std"] - 8 ** 0.5) > 1e-9:
+        raise RuntimeError("Wrong standard deviation")
+
+    print("Reduce images")
+    try:
+        imgGen = fac.select("cvMat").create("imgGen")
+    except RuntimeError as e:
+        print("Runtime error: " + str(e))
+        print("OpenCV is probably not present. Exiting. ")
+        return
+
+    bind(seqGen.outPort("data"), imgGen.inPort("trig"))
+
+    imgReducers = dict()
+    for op in ["max", "argmax", "mean"]:
+        print("Create the image " + op + " reducer")
+        imgReducers[op] = reduceFac.select(op).select("cvMat").create(op + "ImgReducer")
+        bind(imgGen.outPort("data"), imgReducers[op].inPort("elements"))
+        seqBind(seqGen.outPort("data"), imgReducers[op].inPort("elements"))
+
+    for value in values:
+        intGen.setParameterValue("value", value)
+        imgGen.setParameterValue("value", value)
+
+    runModule(seqGen)
+    waitAll()
+
+    result = imgReducers["max"].outPort("result").getDataValue()
+    print("max image: " + str(result.shape) + ", max value: " + str(maxValue(result, "B")))
+    if maxValue(result, "B") != 9:
+        raise RuntimeError("Wrong max image")
+
+    result = imgReducers["argmax"].outPort("result").getDataValue()
+    print("argmax image format: " + result.format)
+    if result.format != "i" or maxValue(result, "i") != 3:
+        raise RuntimeError("Wrong argmax image")
+
+    result = imgReducers["mean"].outPort("result").getDataValue()
+    print("mean image format: " + result.format)
+    if result.format != "d" or abs(maxValue(result, "d") - 5) > 1e-9:
+        raise RuntimeError("Wrong mean image")
+
+    print("End of script seqReducerTest.py")
+
+def maxValue(image, fmt):
+    """Maximum of the values of the image buffer, of the given struct format"""
+    import struct
+
+    data = memoryview(image).tobytes()
+    count = len(data) // struct.calcsize(fmt)
+    return max(struct.unpack(str(count) + fmt, data))
+
+# main body    
+import sys
+import os
+from os.path import dirname
+    
+if len(sys.argv) >= 1:
+    # probably called from InstrumentAll
+    checker = os.path.basename(sys.argv[0])
+    if checker == "instrumentall" or checker == "instrumentall.exe":
+        print("current script: ",os.path.realpath(__file__))
+        
+        baseDir = dirname(dirname(__file__))
+        
+        myMain(baseDir)
+        exit(0)
+
+print("Presumably not called from InstrumentAll >> Exiting...")
+
+exit("This script has to be launched from inside InstrumentAll")
@@ -0,0 +1,131 @@
+# -*- coding: utf-8 -*-
+
+## @file   testsuite/python/subscriptionTest.py
+## @date   oct. 2026
+## @author PhRG - opticalp.fr
+##
+## Test the subscription to the port data (OutPort.subscribe)
+
+#
+# Copyright (c) 2026 Ph. Renaud-Goud / Opticalp
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+def myMain(baseDir):
+    """Main function. Run the tests. """
+
+    print("Test the subscription to the output port data. ")
+
+    from instru import *
+
+    fac = Factory("DataGenFactory")
+    print("Retrieved factory: " + fac.name)
+
+    intGen = fac.select("int32").create("intGen")
+
+    print("Subscribe to the generator output, with a queue of 5 items")
+    sub = intGen.outPort("data").subscribe(maxQueue=5)
+
+    print("Nothing is queued yet: get with a timeout returns None")
+    if sub.get(timeout=0.1) is not None:
+        raise RuntimeError("No item expected")
+
+    print("Run the generator 3 times")
+    for value in range(3):
+        intGen.setParameterValue("value", value)
+        runModule(intGen)
+        waitAll()
+
+    print("pending items: " + str(sub.pending()))
+    if sub.pending() != 3:
+        raise RuntimeError("3 pending items expected")
+
+    first = sub.get()
+    print("first item: " + str(first))
+    if first != 0:
+        raise RuntimeError("Wrong first item")
+
+    batch = sub.getBatch(10)
+    print("next items: " + str(batch))
+    if batch != [1, 2]:
+        raise RuntimeError("Wrong batch")
+
+    print("Run the generator 8 times: the 3 oldest items are dropped")
+    for value in range(8):
+        intGen.setParameterValue("value", value)
+        runModule(intGen)
+        waitAll()
+
+    print("dropped items: " + str(sub.dropped()))
+    if sub.dropped() != 3:
+        raise RuntimeError("3 dropped items expected")
+
+    batch = sub.getBatch(2)
+    print("batch of 2: " + str(batch))
+    if batch != [3, 4]:
+        raise RuntimeError("Wrong batch")
+
+    print("Close the subscription. The queued items are still retrieved")
+    sub.close()
+    intGen.setParameterValue("value", 100)
+    runModule(intGen)
+    waitAll()
+
+    remaining = [value for value in sub]
+    print("remaining items: " + str(remaining))
+    if remaining != [5, 6, 7]:
+        raise RuntimeError("Wrong remaining items")
+
+    print("Subscribe to a vector generator")
+    vectGen = fac.select("int32Vect").create("vectGen")
+    vectSub = vectGen.outPort("data").subscribe()
+
+    for value in range(4):
+        vectGen.setParameterValue("value", value)
+    runModule(vectGen)
+    waitAll()
+
+    vect = vectSub.get(timeout=1)
+    print("vector item: " + str(vect))
+    if vect != range(4):
+        raise RuntimeError("Wrong vector item")
+
+    vectSub.close()
+
+    print("End of script subscriptionTest.py")
+
+# main body    
+import sys
+import os
+from os.path import dirname
+    
+if len(sys.argv) >= 1:
+    # probably called from InstrumentAll
+    checker = os.path.basename(sys.argv[0])
+    if checker == "instrumentall" or checker == "instrumentall.exe":
+        print("current script: ",os.path.realpath(__file__))
+        
+        baseDir = dirname(dirname(__file__))
+        
+        myMain(baseDir)
+        exit(0)
+
+print("Presumably not called from InstrumentAll >> Exiting...")
+
+exit("This script has to be launched from inside InstrumentAll")
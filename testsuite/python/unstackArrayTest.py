@@ -96,6 +96,35 @@ def myMain(baseDir):
     if ( accuGen.outPort("array").getDataValue() != range(10) ):
         raise RuntimeError("Wrong return value")
 
+    print("Run again with a shorter sequence: the previous array is not kept")
+    print("Expected capacity: " + str(accuGen.getParameterValue("capacity")))
+    accuGen.setParameterValue("capacity", 5)
+    for value in range(5):
+        vectGen.setParameterValue("value", value)
+
+    runModule(vectGen)
+    waitAll()
+
+    print("Return value is: " + str(accuGen.outPort("array").getDataValue()))
+    if ( accuGen.outPort("array").getDataValue() != range(5) ):
+        raise RuntimeError("Wrong return value")
+
+    print("Chunked mode: send the array by sub-arrays of 4 elements")
+    spliter.setParameterValue("chunkSize", 4)
+    chunks = spliter.outPort("chunks").subscribe()
+
+    for value in range(10):
+        vectGen.setParameterValue("value", value)
+
+    runModule(vectGen)
+    waitAll()
+
+    received = chunks.getBatch(3, timeout=1)
+    chunks.close()
+    print("Received chunks: " + str(received))
+    if ( received != [range(4), range(4, 8), range(8, 10)] ):
+        raise RuntimeError("Wrong chunks")
+
     print("End of script unstackArrayTest.py")
     
 # main body    